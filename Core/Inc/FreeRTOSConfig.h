@@ -45,6 +45,7 @@
 
 /* USER CODE BEGIN Includes */
 /* Section where include file can be added */
+#include "MZ_gps_app_config.h"
 /* USER CODE END Includes */
 
 /* Ensure definitions are only used by the compiler, and not by the assembler. */
@@ -168,6 +169,24 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+#if(GPS_HEALTH_ENABLE == MZ_ENABLE)
+/* Per task run time for the health payload, counter in MZ_gps_health.c */
+#define configGENERATE_RUN_TIME_STATS            1
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  extern void gps_health_rt_init(void);
+  extern uint32_t gps_health_rt_now(void);
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() gps_health_rt_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()         gps_health_rt_now()
+#endif
+#if(GPS_LP_ENABLE == MZ_ENABLE)
+/* Tickless idle in STOP2, MZ_gps_lowpower.c */
+#define configUSE_TICKLESS_IDLE                  2
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  extern void gps_lp_suppress_ticks_and_sleep(uint32_t idle);
+#endif
+#define portSUPPRESS_TICKS_AND_SLEEP(x)          gps_lp_suppress_ticks_and_sleep(x)
+#endif
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
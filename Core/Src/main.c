@@ -26,6 +26,7 @@
 #include "MZ_error_handler.h"
 #include "MZ_Modem_public.h"
 #include "MZ_GPSSensor.h"
+#include "MZ_gps_trace.h"
 
 
 SD_HandleTypeDef hsd1;
@@ -220,6 +221,7 @@ void Error_Handler(void)
 {
   /* USER CODE BEGIN Error_Handler_Debug */
   /* User can add his own implementation to report the HAL error return state */
+  GPS_TRACE(GPS_TRACE_ERROR, (uintptr_t)__builtin_return_address(0));
   __disable_irq();
   while (1)
   {
@@ -24,6 +24,9 @@
 #include "MZ_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "MZ_gps_trace.h"
+#include "MZ_gps_lowpower.h"
+#include "MZ_gps_lpuart.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -90,6 +93,7 @@ void NMI_Handler(void)
 void HardFault_Handler(void)
 {
   /* USER CODE BEGIN HardFault_IRQn 0 */
+  GPS_TRACE(GPS_TRACE_HARDFAULT, 0);
 
   /* USER CODE END HardFault_IRQn 0 */
   while (1)
@@ -310,7 +314,9 @@ void SDMMC1_IRQHandler(void)
 void LPUART1_IRQHandler(void)
 {
   /* USER CODE BEGIN LPUART1_IRQn 0 */
-
+#if(GPS_LPUART_RING_ENABLE == MZ_ENABLE)
+  gps_lpuart_irq();
+#endif
   /* USER CODE END LPUART1_IRQn 0 */
   MZ_LPUART1_IRQHandler();
   /* USER CODE BEGIN LPUART1_IRQn 1 */
@@ -348,5 +354,23 @@ void I2C4_ER_IRQHandler(void)
 
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief This function handles DMA2 channel4 global interrupt (SDMMC1 TX).
+  */
+void DMA2_Channel4_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(hsd1.hdmatx);
+}
+
+#if(GPS_LP_ENABLE == MZ_ENABLE)
+/**
+  * @brief This function handles LPTIM1 global interrupt (STOP2 wake up).
+  */
+void LPTIM1_IRQHandler(void)
+{
+  gps_lp_lptim_irq();
+}
+#endif
+
 /* USER CODE END 1 */
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
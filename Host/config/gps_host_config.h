@@ -0,0 +1,62 @@
+/*
+ * gps_host_config.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Feature switches of the host build, forced in front of every source
+ *  (-include). The firmware configuration is read first, its include guard
+ *  keeps the later includes out, then the modules the host tools exercise
+ *  are switched on. A tool that needs other values names a header of its
+ *  own in GPS_HOST_CONFIG, read last.
+ */
+
+#ifndef GPS_HOST_CONFIG_H_
+#define GPS_HOST_CONFIG_H_
+
+#include "MZ_gps_app_config.h"
+
+/* Portable GPS pipeline - START */
+#undef GPS_SDLOG_ENABLE
+#define GPS_SDLOG_ENABLE				(MZ_ENABLE)
+#undef GPS_GEOFENCE_ENABLE
+#define GPS_GEOFENCE_ENABLE				(MZ_ENABLE)
+#undef GPS_REPORT_POLICY_ENABLE
+#define GPS_REPORT_POLICY_ENABLE		(MZ_ENABLE)
+#undef GPS_TRACK_BATCH_ENABLE
+#define GPS_TRACK_BATCH_ENABLE			(MZ_ENABLE)
+#undef GPS_KALMAN_ENABLE
+#define GPS_KALMAN_ENABLE				(MZ_ENABLE)
+#undef GPS_REPLAY_ENABLE
+#define GPS_REPLAY_ENABLE				(MZ_ENABLE)
+#undef GPS_PROF_ENABLE
+#define GPS_PROF_ENABLE					(MZ_ENABLE)
+#undef GPS_LATENCY_ENABLE
+#define GPS_LATENCY_ENABLE				(MZ_ENABLE)
+#undef GPS_TRACE_ENABLE
+#define GPS_TRACE_ENABLE				(MZ_ENABLE)
+#undef GPS_LOG_ENABLE
+#define GPS_LOG_ENABLE					(MZ_ENABLE)
+#undef GPS_TWHEEL_ENABLE
+#define GPS_TWHEEL_ENABLE				(MZ_ENABLE)
+#undef GPS_RXPM_ENABLE
+#define GPS_RXPM_ENABLE					(MZ_ENABLE)
+#undef GPS_LPUART_RING_ENABLE
+#define GPS_LPUART_RING_ENABLE			(MZ_ENABLE)
+/* Portable GPS pipeline - END */
+
+/* Modem behind the emulator - START */
+#undef GPS_MODEM_EMU_ENABLE
+#define GPS_MODEM_EMU_ENABLE			(MZ_ENABLE)
+#undef GPS_RADIO_ENABLE
+#define GPS_RADIO_ENABLE				(MZ_ENABLE)
+/* Not in the firmware configuration, the +QIURC ACKs only come from the emulator */
+#define GPS_UDP_ENABLE					(MZ_ENABLE)
+/* Not in the firmware configuration, the +QMTPUB PUBACKs only come from the emulator */
+#define GPS_MQTT_QOS1_ENABLE			(MZ_ENABLE)
+/* Modem behind the emulator - END */
+
+#if defined(GPS_HOST_CONFIG)
+#include GPS_HOST_CONFIG
+#endif
+
+#endif /* GPS_HOST_CONFIG_H_ */
@@ -0,0 +1,11 @@
+/*
+ * gps_host_grid1.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Geofence index of a single cell: every fix tests every fence. Used by
+ *  gps_geofence_scan to compare against the grid of the firmware.
+ */
+
+#undef GPS_GEOFENCE_GRID_DIM
+#define GPS_GEOFENCE_GRID_DIM			(1)
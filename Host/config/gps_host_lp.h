@@ -0,0 +1,12 @@
+/*
+ * gps_host_lp.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Tickless idle conversion built for the host. Only gps_lp_clock_enter()
+ *  and gps_lp_clock_ticks() compile, the STOP2 entry and the stop locks
+ *  are target only. Used by gps_lp_drift.
+ */
+
+#undef GPS_LP_ENABLE
+#define GPS_LP_ENABLE					(MZ_ENABLE)
@@ -0,0 +1,12 @@
+/*
+ * gps_host_noeph.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Receiver power management without the periodic ephemeris refresh, the
+ *  receiver only tracks for the reports. Used by gps_rxpm_noeph to show
+ *  the lead adapting to warm starts.
+ */
+
+#undef GPS_RXPM_EPH_REFRESH_MS
+#define GPS_RXPM_EPH_REFRESH_MS			(0xFFFFFFFFUL)
@@ -0,0 +1,11 @@
+/*
+ * gps_host_qos0.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  BG96 backend with QoS 0 publishes and a session per upload, as the
+ *  firmware is configured by default. Used by gps_backend_bench.
+ */
+
+#undef GPS_MQTT_QOS1_ENABLE
+#define GPS_MQTT_QOS1_ENABLE			(MZ_DISABLE)
@@ -0,0 +1,10 @@
+/*
+ * gps_host_qos1w2.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  QoS 1 window of 2 messages. Used by gps_qos_sim_w2.
+ */
+
+#undef GPS_MQTT_QOS1_WINDOW
+#define GPS_MQTT_QOS1_WINDOW			(2)
@@ -0,0 +1,10 @@
+/*
+ * gps_host_qos1w8.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  QoS 1 window of 8 messages. Used by gps_qos_sim_w8.
+ */
+
+#undef GPS_MQTT_QOS1_WINDOW
+#define GPS_MQTT_QOS1_WINDOW			(8)
@@ -0,0 +1,41 @@
+/*
+ * gps_host_rtos.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  The firmware as configured in MZ_gps_app_config.h, for the FreeRTOS
+ *  simulation (gps_host_rtos). The pipeline switches of the host build go
+ *  back to their firmware values, the BG96 backend publishes with QoS 0.
+ *  On top of the firmware : the modem emulator, since there is no modem,
+ *  the latency and probe reports, and the deferred CLI log, whose drain
+ *  thread is the second application thread. Used by gps_rtos_sim.
+ */
+
+/* Firmware pipeline - START */
+#undef GPS_SDLOG_ENABLE
+#define GPS_SDLOG_ENABLE				(MZ_DISABLE)
+#undef GPS_GEOFENCE_ENABLE
+#define GPS_GEOFENCE_ENABLE				(MZ_DISABLE)
+#undef GPS_REPORT_POLICY_ENABLE
+#define GPS_REPORT_POLICY_ENABLE		(MZ_DISABLE)
+#undef GPS_TRACK_BATCH_ENABLE
+#define GPS_TRACK_BATCH_ENABLE			(MZ_DISABLE)
+#undef GPS_KALMAN_ENABLE
+#define GPS_KALMAN_ENABLE				(MZ_DISABLE)
+#undef GPS_REPLAY_ENABLE
+#define GPS_REPLAY_ENABLE				(MZ_DISABLE)
+#undef GPS_TRACE_ENABLE
+#define GPS_TRACE_ENABLE				(MZ_DISABLE)
+#undef GPS_TWHEEL_ENABLE
+#define GPS_TWHEEL_ENABLE				(MZ_DISABLE)
+#undef GPS_RXPM_ENABLE
+#define GPS_RXPM_ENABLE					(MZ_DISABLE)
+#undef GPS_LPUART_RING_ENABLE
+#define GPS_LPUART_RING_ENABLE			(MZ_DISABLE)
+#undef GPS_RADIO_ENABLE
+#define GPS_RADIO_ENABLE				(MZ_DISABLE)
+#undef GPS_UDP_ENABLE
+#define GPS_UDP_ENABLE					(MZ_DISABLE)
+#undef GPS_MQTT_QOS1_ENABLE
+#define GPS_MQTT_QOS1_ENABLE			(MZ_DISABLE)
+/* Firmware pipeline - END */
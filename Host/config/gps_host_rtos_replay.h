@@ -0,0 +1,14 @@
+/*
+ * gps_host_rtos_replay.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  FreeRTOS simulation of the firmware with GPS_REPLAY_ENABLE : the GPS
+ *  thread takes its epochs from gps_replay_poll() instead of LPUART1.
+ *  Used by gps_rtos_replay.
+ */
+
+#include "gps_host_rtos.h"
+
+#undef GPS_REPLAY_ENABLE
+#define GPS_REPLAY_ENABLE				(MZ_ENABLE)
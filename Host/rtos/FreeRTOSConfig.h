@@ -0,0 +1,71 @@
+/*
+ * FreeRTOSConfig.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Kernel configuration of the simulation build (gps_host_rtos). The
+ *  firmware configuration of Core/Inc is read first and kept : priorities,
+ *  tick rate, stack sizes, timer task and queue, heap_4 and the CMSIS-RTOS2
+ *  options are those of the target. Only what the POSIX port needs or the
+ *  simulation measures differs :
+ *
+ *  - newlib reentrancy off, glibc keeps its own per thread state
+ *  - idle hook (host_rtos.c) sleeps the process until the next tick
+ *  - tick hook, the simulated peripherals of the tool
+ *  - run time stats on the host microsecond counter of the port
+ *  - trace macros feeding the scheduling latency and queue depth
+ *    tables of host_rtos.c
+ *  - configASSERT reports and aborts instead of spinning
+ */
+
+#ifndef HOST_FREERTOS_CONFIG_H_
+#define HOST_FREERTOS_CONFIG_H_
+
+#include <stdint.h>
+
+/* Cortex-M core registers the CMSIS-RTOS2 wrappers use, on the port */
+#define CMSIS_device_header						"host_cmsis.h"
+
+#include_next "FreeRTOSConfig.h"
+
+/* Port - START */
+#undef configUSE_NEWLIB_REENTRANT
+#define configUSE_NEWLIB_REENTRANT				0
+#undef configUSE_IDLE_HOOK
+#define configUSE_IDLE_HOOK						1
+#undef configUSE_TICK_HOOK
+#define configUSE_TICK_HOOK						1
+#undef configASSERT
+extern void host_rtos_assert(const char * file, int line);
+#define configASSERT(x)							if((x) == 0) { host_rtos_assert(__FILE__, __LINE__); }
+/* Port - END */
+
+/* Run time stats - START */
+#undef configGENERATE_RUN_TIME_STATS
+#define configGENERATE_RUN_TIME_STATS			1
+#undef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#undef portGET_RUN_TIME_COUNTER_VALUE
+extern uint32_t ulPortGetRunTimeCounter(void);
+#define portGET_RUN_TIME_COUNTER_VALUE()		ulPortGetRunTimeCounter()
+/* Run time stats - END */
+
+/* Trace hooks, host_rtos.h - START */
+extern void host_rtos_trace_ready(uint32_t task);
+extern void host_rtos_trace_run(uint32_t task);
+extern void host_rtos_trace_queue(void * queue, uint32_t depth, uint32_t length);
+extern void host_rtos_trace_queue_full(void * queue, uint8_t failed);
+
+/* Task number (configUSE_TRACE_FACILITY) of a task made ready / switched in */
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB)	host_rtos_trace_ready((uint32_t)(pxTCB)->uxTCBNumber)
+#define traceTASK_SWITCHED_IN()					host_rtos_trace_run((uint32_t)pxCurrentTCB->uxTCBNumber)
+
+/* Depth of data queues after the item is copied in, semaphores and mutexes have no items */
+#define traceQUEUE_SEND(pxQueue)				do { if((pxQueue)->uxItemSize != 0) { host_rtos_trace_queue((pxQueue), (uint32_t)(pxQueue)->uxMessagesWaiting + 1, (uint32_t)(pxQueue)->uxLength); } } while(0)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue)		traceQUEUE_SEND(pxQueue)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue)	do { if((pxQueue)->uxItemSize != 0) { host_rtos_trace_queue_full((pxQueue), 0); } } while(0)
+#define traceQUEUE_SEND_FAILED(pxQueue)			do { if((pxQueue)->uxItemSize != 0) { host_rtos_trace_queue_full((pxQueue), 1); } } while(0)
+#define traceQUEUE_SEND_FROM_ISR_FAILED(pxQueue)	traceQUEUE_SEND_FAILED(pxQueue)
+/* Trace hooks, host_rtos.h - END */
+
+#endif /* HOST_FREERTOS_CONFIG_H_ */
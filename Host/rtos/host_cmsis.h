@@ -0,0 +1,29 @@
+/*
+ * host_cmsis.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  CMSIS device header of the simulation build (CMSIS_device_header of
+ *  Host/rtos/FreeRTOSConfig.h). The STM32L4 header is read as on the
+ *  target, then the Cortex-M core accesses the CMSIS-RTOS2 wrappers make
+ *  are taken by the POSIX port : IPSR reads the tick handler state of the
+ *  port, PRIMASK is never set (the kernel masks through BASEPRI on the
+ *  target), the global interrupt switch is the tick signal mask and the
+ *  SVCall priority set by osKernelStart() has nothing to act on.
+ */
+
+#ifndef HOST_CMSIS_H_
+#define HOST_CMSIS_H_
+
+#include "stm32l4xx.h"
+
+/* Core accesses of cmsis_os2.c - START */
+#define __get_IPSR()							((uint32_t)((xPortIsInsideInterrupt() != pdFALSE) ? 15U : 0U))
+#define __get_PRIMASK()							(0U)
+#define __disable_irq()							vPortDisableInterrupts()
+#define __enable_irq()							vPortEnableInterrupts()
+#undef NVIC_SetPriority
+#define NVIC_SetPriority(IRQn, priority)		do { (void)(IRQn); (void)(priority); } while(0)
+/* Core accesses of cmsis_os2.c - END */
+
+#endif /* HOST_CMSIS_H_ */
@@ -0,0 +1,411 @@
+/*
+ * host_rtos.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "host_rtos.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include "cmsis_os2.h"
+#include "MZ_sys_cmsis_os2.h"
+#include "MZ_timer.h"
+#include "stm32l4xx_hal.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "unistd.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define HOST_RTOS_LINE_SIZE			(128)						///< One report line
+#define HOST_RTOS_TM_WAIT			(pdMS_TO_TICKS(100))		///< Timer command queue wait of a task
+/* Define some common use MACRO - END */
+
+/**
+ * @struct st_host_rtos_lat
+ * @brief Ready to running latency of one task
+ */
+typedef struct
+{
+	uint32_t		ready_us;									/*!< Ready stamp, valid while pending */
+	uint8_t			pending;									/*!< Ready, not run yet */
+	uint32_t		count;										/*!< Latencies recorded */
+	uint64_t		sum_us;										/*!< Their sum */
+	uint32_t		max_us;										/*!< Longest */
+	uint32_t		bins[HOST_RTOS_LAT_BINS];					/*!< bins[b] : below 2^(b+1) us */
+}st_host_rtos_lat;
+
+/**
+ * @struct st_host_rtos_queue
+ * @brief Depth of one data queue
+ */
+typedef struct
+{
+	void *			queue;										/*!< Queue handle, NULL = free entry */
+	uint32_t		length;										/*!< Queue length */
+	uint32_t		sends;										/*!< Items sent */
+	uint64_t		depth_sum;									/*!< Sum of the depths reached */
+	uint32_t		max_depth;									/*!< Deepest */
+	uint32_t		blocked;									/*!< Sends that waited on a full queue */
+	uint32_t		failed;										/*!< Sends that failed on a full queue */
+}st_host_rtos_queue;
+
+/* Global Variables - START */
+uint32_t SystemCoreClock = 80000000;							/* SystemClock_Config(), HSI 16 MHz PLL x10 / 2 */
+static st_host_rtos_lat host_rtos_lat[HOST_RTOS_TASKS];
+static st_host_rtos_queue host_rtos_queue[HOST_RTOS_QUEUES];
+static TaskStatus_t host_rtos_tasks[HOST_RTOS_TASKS];
+static UBaseType_t host_rtos_task_count;
+static uint32_t host_rtos_total_us;
+static TickType_t host_rtos_ticks;
+static TimerHandle_t host_rtos_tm[MZ_MAX_TIMER_COUNT];
+/* Global Variables - END */
+
+/** @fn static st_host_rtos_queue * host_rtos_queue_get(void * queue, uint32_t length)
+ * @brief Entry of a queue, taken on its first send. NULL when the table is full.
+ */
+static st_host_rtos_queue * host_rtos_queue_get(void * queue, uint32_t length)
+{
+	for(uint8_t i = 0; i < HOST_RTOS_QUEUES; i++)
+	{
+		st_host_rtos_queue * q = &host_rtos_queue[i];
+
+		if(q->queue == queue)
+		{
+			return q;
+		}
+		if(q->queue == NULL)
+		{
+			q->queue = queue;
+			q->length = length;
+			return q;
+		}
+	}
+	return NULL;
+}
+
+/** @fn static uint32_t host_rtos_bin(uint32_t us)
+ * @brief log2 bin of a latency
+ */
+static uint32_t host_rtos_bin(uint32_t us)
+{
+	uint32_t b = (us < 2) ? 0 : (31 - (uint32_t)__builtin_clz(us));
+
+	return (b < HOST_RTOS_LAT_BINS) ? b : (HOST_RTOS_LAT_BINS - 1);
+}
+
+/** @fn static uint32_t host_rtos_p99(const st_host_rtos_lat * l)
+ * @brief Upper bound of the bin the 99th percentile falls in
+ */
+static uint32_t host_rtos_p99(const st_host_rtos_lat * l)
+{
+	uint32_t seen = 0;
+	uint32_t b;
+
+	for(b = 0; b < (HOST_RTOS_LAT_BINS - 1); b++)
+	{
+		seen += l->bins[b];
+		if(((uint64_t)seen * 100) >= ((uint64_t)l->count * 99))
+		{
+			break;
+		}
+	}
+	return (b < (HOST_RTOS_LAT_BINS - 1)) ? (2UL << b) : l->max_us;
+}
+
+/** @fn static TickType_t host_rtos_tm_wait(void)
+ * @brief Command queue wait, none from the timer task, it would wait on itself
+ */
+static TickType_t host_rtos_tm_wait(void)
+{
+	return (xTaskGetCurrentTaskHandle() == xTimerGetTimerDaemonTaskHandle()) ? 0 : HOST_RTOS_TM_WAIT;
+}
+
+/** @fn static TimerHandle_t host_rtos_tm_get(size_t _id)
+ * @brief Timer of an id, NULL when not created
+ */
+static TimerHandle_t host_rtos_tm_get(size_t _id)
+{
+	return (_id < MZ_MAX_TIMER_COUNT) ? host_rtos_tm[_id] : NULL;
+}
+
+/*
+ * Trace hooks. - START
+ */
+void host_rtos_trace_ready(uint32_t task)
+{
+	st_host_rtos_lat * l;
+
+	if((task >= HOST_RTOS_TASKS) || (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED))
+	{
+		return;
+	}
+	l = &host_rtos_lat[task];
+	if(!l->pending)
+	{
+		l->ready_us = ulPortGetRunTimeCounter();
+		l->pending = 1;
+	}
+}
+
+void host_rtos_trace_run(uint32_t task)
+{
+	st_host_rtos_lat * l;
+	uint32_t us;
+
+	if((task >= HOST_RTOS_TASKS) || !host_rtos_lat[task].pending)
+	{
+		return;
+	}
+	l = &host_rtos_lat[task];
+	us = ulPortGetRunTimeCounter() - l->ready_us;
+	l->pending = 0;
+	l->count++;
+	l->sum_us += us;
+	if(us > l->max_us)
+	{
+		l->max_us = us;
+	}
+	l->bins[host_rtos_bin(us)]++;
+}
+
+void host_rtos_trace_queue(void * queue, uint32_t depth, uint32_t length)
+{
+	st_host_rtos_queue * q = host_rtos_queue_get(queue, length);
+
+	if(q == NULL)
+	{
+		return;
+	}
+	q->sends++;
+	q->depth_sum += depth;
+	if(depth > q->max_depth)
+	{
+		q->max_depth = depth;
+	}
+}
+
+void host_rtos_trace_queue_full(void * queue, uint8_t failed)
+{
+	st_host_rtos_queue * q = host_rtos_queue_get(queue, 0);
+
+	if(q == NULL)
+	{
+		return;
+	}
+	if(failed)
+	{
+		q->failed++;
+	}
+	else
+	{
+		q->blocked++;
+	}
+}
+
+void host_rtos_assert(const char * file, int line)
+{
+	fprintf(stderr, "configASSERT failed at %s:%d\n", file, line);
+	abort();
+}
+/* Trace hooks. - END */
+
+/*
+ * Take the run time of every task. - START
+ */
+void host_rtos_snapshot(void)
+{
+	host_rtos_task_count = uxTaskGetSystemState(host_rtos_tasks, HOST_RTOS_TASKS, &host_rtos_total_us);
+	host_rtos_ticks = xTaskGetTickCount();
+}
+/* Take the run time of every task. - END */
+
+/*
+ * Print the task and queue tables. - START
+ */
+void host_rtos_report(host_rtos_out_fn out)
+{
+	char line[HOST_RTOS_LINE_SIZE];
+	uint32_t total = (host_rtos_total_us != 0) ? host_rtos_total_us : 1;
+
+	sprintf(line,"rtos: %lu ticks, %lu.%03lu s of run time on the host\r\n",
+			(unsigned long)host_rtos_ticks,(unsigned long)(host_rtos_total_us / 1000000),
+			(unsigned long)((host_rtos_total_us / 1000) % 1000));
+	out(line);
+	out("task             prio  cpu%      wakes   avg us   p99 us   max us\r\n");
+	for(UBaseType_t i = 0; i < host_rtos_task_count; i++)
+	{
+		const TaskStatus_t * t = &host_rtos_tasks[i];
+		const st_host_rtos_lat * l = (t->xTaskNumber < HOST_RTOS_TASKS) ? &host_rtos_lat[t->xTaskNumber] : NULL;
+		uint32_t permille = (uint32_t)(((uint64_t)t->ulRunTimeCounter * 1000) / total);
+
+		sprintf(line,"%-16s %4lu %3lu.%lu",t->pcTaskName,(unsigned long)t->uxCurrentPriority,
+				(unsigned long)(permille / 10),(unsigned long)(permille % 10));
+		out(line);
+		if((l != NULL) && (l->count != 0))
+		{
+			sprintf(line," %10lu %8lu %8lu %8lu\r\n",(unsigned long)l->count,(unsigned long)(l->sum_us / l->count),
+					(unsigned long)host_rtos_p99(l),(unsigned long)l->max_us);
+		}
+		else
+		{
+			sprintf(line," %10u %8s %8s %8s\r\n",0U,"-","-","-");
+		}
+		out(line);
+	}
+
+	out("queue            length   sends  avg depth  max  blocked  failed\r\n");
+	for(uint8_t i = 0; (i < HOST_RTOS_QUEUES) && (host_rtos_queue[i].queue != NULL); i++)
+	{
+		const st_host_rtos_queue * q = &host_rtos_queue[i];
+		const char * name = pcQueueGetName((QueueHandle_t)q->queue);
+		uint32_t avg_x100 = (q->sends != 0) ? (uint32_t)((q->depth_sum * 100) / q->sends) : 0;
+
+		sprintf(line,"%-16s %6lu %7lu %6lu.%02lu %4lu %8lu %7lu\r\n",(name != NULL) ? name : "-",
+				(unsigned long)q->length,(unsigned long)q->sends,(unsigned long)(avg_x100 / 100),
+				(unsigned long)(avg_x100 % 100),(unsigned long)q->max_depth,(unsigned long)q->blocked,
+				(unsigned long)q->failed);
+		out(line);
+	}
+}
+/* Print the task and queue tables. - END */
+
+/*
+ * FreeRTOS hooks - START
+ */
+void vApplicationIdleHook(void)
+{
+	/* Nothing ready, the host sleeps until the next tick */
+	pause();
+}
+/* FreeRTOS hooks - END */
+
+/*
+ * HAL - START
+ */
+uint32_t HAL_GetTick(void)
+{
+	/* The kernel tick is the HAL time base, 1 ms */
+	return xTaskGetTickCount();
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+	uint32_t start = HAL_GetTick();
+
+	/* Busy wait as on the target, the tick interrupt keeps counting */
+	while((HAL_GetTick() - start) < Delay)
+	{
+	}
+}
+/* HAL - END */
+
+/*
+ * MZ_sys_cmsis_os2.h - START
+ */
+uint8_t mz_thread_create(mz_thread_t* t,const char* name,mz_fn thread_func,void* const arg,mz_thread_prio_t prio,StackType_t * stack_mem,size_t stack_size,StaticTask_t * cb_mem,uint32_t cb_size)
+{
+	osThreadAttr_t attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.name = name;
+	attr.priority = prio;
+	attr.cb_mem = cb_mem;
+	attr.cb_size = cb_size;
+	attr.stack_mem = stack_mem;
+	/* stack_size counts StackType_t, CMSIS-RTOS2 takes bytes */
+	attr.stack_size = stack_size * sizeof(StackType_t);
+	*t = osThreadNew((osThreadFunc_t)thread_func, arg, &attr);
+	return (*t != NULL);
+}
+/* MZ_sys_cmsis_os2.h - END */
+
+/*
+ * MZ_timer.h - START
+ */
+size_t mz_tm_create(char* _name,TickType_t _tick,UBaseType_t _auto,mz_tm_cb _cb)
+{
+	TimerHandle_t tm = xTimerCreate(_name, (_tick != 0) ? _tick : 1, _auto, NULL, _cb);
+	size_t id = MZ_TIMER_NOT_AVAILABLE;
+
+	if(tm == NULL)
+	{
+		return MZ_TIMER_NOT_AVAILABLE;
+	}
+	taskENTER_CRITICAL();
+	for(size_t i = 0; i < MZ_MAX_TIMER_COUNT; i++)
+	{
+		if(host_rtos_tm[i] == NULL)
+		{
+			host_rtos_tm[i] = tm;
+			id = i;
+			break;
+		}
+	}
+	taskEXIT_CRITICAL();
+	if(id == MZ_TIMER_NOT_AVAILABLE)
+	{
+		(void)xTimerDelete(tm, host_rtos_tm_wait());
+	}
+	return id;
+}
+
+size_t mz_tm_create_one(char* _name,TickType_t _tick,mz_tm_cb _cb)
+{
+	return mz_tm_create(_name, _tick, pdFALSE, _cb);
+}
+
+size_t mz_tm_create_recursive(char* _name,TickType_t _tick,mz_tm_cb _cb)
+{
+	return mz_tm_create(_name, _tick, pdTRUE, _cb);
+}
+
+mz_error_t mz_tm_start(size_t _id)
+{
+	TimerHandle_t tm = host_rtos_tm_get(_id);
+
+	return ((tm != NULL) && (pdPASS == xTimerStart(tm, host_rtos_tm_wait()))) ? MZ_OK : MZ_FAIL;
+}
+
+mz_error_t mz_tm_create_start(char* _name,TickType_t _tick,UBaseType_t _auto,mz_tm_cb _cb)
+{
+	size_t id = mz_tm_create(_name, _tick, _auto, _cb);
+
+	return (id == MZ_TIMER_NOT_AVAILABLE) ? MZ_FAIL : mz_tm_start(id);
+}
+
+mz_error_t mz_tm_create_start_one(char* _name,TickType_t _tick,mz_tm_cb _cb)
+{
+	return mz_tm_create_start(_name, _tick, pdFALSE, _cb);
+}
+
+mz_error_t mz_tm_create_start_recursive(char* _name,TickType_t _tick,mz_tm_cb _cb)
+{
+	return mz_tm_create_start(_name, _tick, pdTRUE, _cb);
+}
+
+mz_error_t mz_tm_stop(size_t _id)
+{
+	TimerHandle_t tm = host_rtos_tm_get(_id);
+
+	return ((tm != NULL) && (pdPASS == xTimerStop(tm, host_rtos_tm_wait()))) ? MZ_OK : MZ_FAIL;
+}
+
+mz_error_t mz_tm_delete(size_t _id)
+{
+	TimerHandle_t tm = host_rtos_tm_get(_id);
+
+	if((tm == NULL) || (pdPASS != xTimerDelete(tm, host_rtos_tm_wait())))
+	{
+		return MZ_FAIL;
+	}
+	host_rtos_tm[_id] = NULL;
+	return MZ_OK;
+}
+/* MZ_timer.h - END */
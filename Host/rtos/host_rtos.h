@@ -0,0 +1,89 @@
+/*
+ * host_rtos.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Simulation build of the GPS firmware (gps_host_rtos, GPS_HOST_RTOS) :
+ *  MZ_GPSSensor.c, the CMSIS-RTOS2 wrappers and the FreeRTOS kernel of the
+ *  tree on the POSIX port of Host/rtos. The HAL and MonoZ library calls
+ *  that touch the RTOS are provided here on the real kernel, the others
+ *  stay in Host/stub.
+ *
+ *  - HAL_GetTick		FreeRTOS tick count
+ *  - HAL_Delay			busy wait on the tick, as the HAL does
+ *  - mz_thread_create	osThreadNew() with the caller's static memory
+ *  - mz_tm_*			MZ_MAX_TIMER_COUNT FreeRTOS software timers
+ *
+ *  The trace hooks of Host/rtos/FreeRTOSConfig.h measure, in host
+ *  microseconds of ulPortGetRunTimeCounter() :
+ *  - per task, the time from being made ready (delay or timeout expired,
+ *    queue item, notification) to running, count, average, log2
+ *    histogram and maximum
+ *  - per data queue, e.g. the timer command queue, the depth reached
+ *    by every send, and the sends that blocked or failed on a full queue
+ *  host_rtos_snapshot() adds the run time of every task (CPU share) and
+ *  host_rtos_report() prints both tables.
+ */
+
+#ifndef HOST_RTOS_H_
+#define HOST_RTOS_H_
+
+#include "stdint.h"
+
+#define HOST_RTOS_TASKS				(16)						///< Tasks measured, by task number
+#define HOST_RTOS_QUEUES			(8)							///< Data queues measured
+#define HOST_RTOS_LAT_BINS			(24)						///< log2 us latency bins, the last one open
+
+/** @brief Output function of the report, gps_log_cli compatible */
+typedef int (*host_rtos_out_fn)(const char * s);
+
+/** @fn void host_rtos_trace_ready(uint32_t task)
+ * @brief traceMOVED_TASK_TO_READY_STATE, stamps the task ready unless it
+ * already waits to run. Ignored until the scheduler runs.
+ * @param task task number (uxTCBNumber)
+ */
+void host_rtos_trace_ready(uint32_t task);
+
+/** @fn void host_rtos_trace_run(uint32_t task)
+ * @brief traceTASK_SWITCHED_IN, records the latency of a stamped task.
+ * @param task task number (uxTCBNumber)
+ */
+void host_rtos_trace_run(uint32_t task);
+
+/** @fn void host_rtos_trace_queue(void * queue, uint32_t depth, uint32_t length)
+ * @brief traceQUEUE_SEND / traceQUEUE_SEND_FROM_ISR of a data queue.
+ * @param queue queue handle
+ * @param depth items in the queue with the one being sent
+ * @param length queue length
+ */
+void host_rtos_trace_queue(void * queue, uint32_t depth, uint32_t length);
+
+/** @fn void host_rtos_trace_queue_full(void * queue, uint8_t failed)
+ * @brief traceBLOCKING_ON_QUEUE_SEND / traceQUEUE_SEND_FAILED of a data
+ * queue.
+ * @param queue queue handle
+ * @param failed 1 the send failed, 0 the sender blocks on the full queue
+ */
+void host_rtos_trace_queue_full(void * queue, uint8_t failed);
+
+/** @fn void host_rtos_assert(const char * file, int line)
+ * @brief configASSERT failure, printed on stderr, then abort().
+ * @param file source file
+ * @param line source line
+ */
+void host_rtos_assert(const char * file, int line);
+
+/** @fn void host_rtos_snapshot(void)
+ * @brief Take the run time of every task (uxTaskGetSystemState). Called
+ * from a task, e.g. right before vTaskEndScheduler().
+ */
+void host_rtos_snapshot(void);
+
+/** @fn void host_rtos_report(host_rtos_out_fn out)
+ * @brief Print the task table of the last snapshot, CPU share, ready to
+ * running latency (average, p99 bin and maximum), and the queue table.
+ * @param out output function
+ */
+void host_rtos_report(host_rtos_out_fn out);
+
+#endif /* HOST_RTOS_H_ */
@@ -0,0 +1,367 @@
+/*
+ *  port.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  FreeRTOS port for Linux / POSIX hosts (portmacro.h).
+ *
+ *  Each task runs on a pthread of its own. The FreeRTOS stack of a task
+ *  only holds the thread bookkeeping at its top, the task code runs on
+ *  the pthread stack. A thread that is not the running task waits on its
+ *  event, a context switch signals the thread of the next task and waits
+ *  on the event of its own. One task thread runs at a time.
+ *
+ *  The tick is SIGALRM from ITIMER_REAL. Only the running task thread has
+ *  it unblocked, outside of critical sections, so the tick interrupts the
+ *  running task wherever it is as SysTick does on the target. The handler
+ *  runs xTaskIncrementTick() and switches from inside the handler when a
+ *  task of a higher priority is ready, the interrupted thread resumes in
+ *  the handler later. Ticks that fall into a critical section are merged
+ *  into one, the kernel time then falls behind the host time.
+ */
+
+/* Include Header Files - START */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pthread.h"
+#include "signal.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "sys/time.h"
+#include "time.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define PORT_TICK_SIGNAL			(SIGALRM)					///< Tick interrupt
+#define PORT_THREAD_STACK			(256 * 1024)				///< pthread stack of a task
+/* Define some common use MACRO - END */
+
+/**
+ * @struct st_port_event
+ * @brief Run permission of one thread
+ */
+typedef struct
+{
+	pthread_mutex_t		mutex;									/*!< Protects set */
+	pthread_cond_t		cond;									/*!< Signalled with set */
+	uint8_t				set;									/*!< Pending run permission */
+}st_port_event;
+
+/**
+ * @struct st_port_thread
+ * @brief Thread of a task, at the top of its FreeRTOS stack
+ */
+typedef struct
+{
+	pthread_t			thread;									/*!< Host thread */
+	TaskFunction_t		code;									/*!< Task function */
+	void *				params;									/*!< Its argument */
+	st_port_event		ev;										/*!< Run permission */
+}st_port_thread;
+
+/* Global Variables - START */
+static volatile UBaseType_t port_critical_nesting = 0;			/* Of the running task, saved over a switch */
+static volatile BaseType_t port_in_isr = pdFALSE;				/* Tick handler running */
+static uint32_t port_tick_us = 1000000 / configTICK_RATE_HZ;	/* Host time of one tick */
+static sigset_t port_tick_set;									/* PORT_TICK_SIGNAL only */
+static st_port_event port_end_ev;								/* vTaskEndScheduler() to the main thread */
+static pthread_once_t port_once = PTHREAD_ONCE_INIT;
+static uint64_t port_rt_start = 0;								/* Host us of the first run time read */
+/* Global Variables - END */
+
+/* static function prototypes - START */
+static void port_tick_handler(int sig);
+/* static function prototypes - END */
+
+/** @fn static void port_event_init(st_port_event * ev)
+ * @brief Event without permission
+ */
+static void port_event_init(st_port_event * ev)
+{
+	pthread_mutex_init(&ev->mutex, NULL);
+	pthread_cond_init(&ev->cond, NULL);
+	ev->set = 0;
+}
+
+/** @fn static void port_event_signal(st_port_event * ev)
+ * @brief Let the thread of the event run
+ */
+static void port_event_signal(st_port_event * ev)
+{
+	pthread_mutex_lock(&ev->mutex);
+	ev->set = 1;
+	pthread_cond_signal(&ev->cond);
+	pthread_mutex_unlock(&ev->mutex);
+}
+
+/** @fn static void port_event_wait(st_port_event * ev)
+ * @brief Wait for the run permission and take it
+ */
+static void port_event_wait(st_port_event * ev)
+{
+	pthread_mutex_lock(&ev->mutex);
+	while(!ev->set)
+	{
+		pthread_cond_wait(&ev->cond, &ev->mutex);
+	}
+	ev->set = 0;
+	pthread_mutex_unlock(&ev->mutex);
+}
+
+/** @fn static st_port_thread * port_thread_of(TaskHandle_t task)
+ * @brief Thread of a task, pxTopOfStack is the first member of the TCB
+ */
+static st_port_thread * port_thread_of(TaskHandle_t task)
+{
+	return (st_port_thread *)(*(StackType_t **)task + 1);
+}
+
+/** @fn static void port_setup(void)
+ * @brief Tick signal handler, once
+ */
+static void port_setup(void)
+{
+	struct sigaction sa;
+
+	sigemptyset(&port_tick_set);
+	sigaddset(&port_tick_set, PORT_TICK_SIGNAL);
+
+	sa.sa_handler = port_tick_handler;
+	sa.sa_flags = SA_RESTART;
+	sigemptyset(&sa.sa_mask);
+	sigaction(PORT_TICK_SIGNAL, &sa, NULL);
+}
+
+/** @fn static void port_switch(st_port_thread * from, st_port_thread * to)
+ * @brief Run the thread of the new current task, wait until the calling
+ * one is current again
+ */
+static void port_switch(st_port_thread * from, st_port_thread * to)
+{
+	UBaseType_t nesting;
+
+	if(from == to)
+	{
+		return;
+	}
+	nesting = port_critical_nesting;
+	port_event_signal(&to->ev);
+	port_event_wait(&from->ev);
+	port_critical_nesting = nesting;
+}
+
+/** @fn static void * port_thread_start(void * arg)
+ * @brief Task thread, waits for its first switch
+ */
+static void * port_thread_start(void * arg)
+{
+	st_port_thread * t = (st_port_thread *)arg;
+
+	port_event_wait(&t->ev);
+
+	/* First run, the task starts with interrupts enabled */
+	port_critical_nesting = 0;
+	vPortEnableInterrupts();
+	t->code(t->params);
+
+	/* A task function does not return */
+	vTaskDelete(NULL);
+	return NULL;
+}
+
+/*
+ * Tick interrupt. - START
+ */
+void xPortSysTickHandler(void)
+{
+	st_port_thread * from = port_thread_of(xTaskGetCurrentTaskHandle());
+	BaseType_t switch_required;
+
+	port_in_isr = pdTRUE;
+	switch_required = xTaskIncrementTick();
+	port_in_isr = pdFALSE;
+	if(switch_required != pdFALSE)
+	{
+		vTaskSwitchContext();
+		port_switch(from, port_thread_of(xTaskGetCurrentTaskHandle()));
+	}
+}
+
+/** @fn static void port_tick_handler(int sig)
+ * @brief SIGALRM on the running task thread
+ */
+static void port_tick_handler(int sig)
+{
+	(void)sig;
+
+	/* The signal stays blocked until the handler returns */
+	port_critical_nesting++;
+	xPortSysTickHandler();
+	port_critical_nesting--;
+}
+/* Tick interrupt. - END */
+
+/*
+ * portable.h - START
+ */
+StackType_t * pxPortInitialiseStack(StackType_t * pxTopOfStack, TaskFunction_t pxCode, void * pvParameters)
+{
+	st_port_thread * t;
+	pthread_attr_t attr;
+	int err;
+
+	(void)pthread_once(&port_once, port_setup);
+
+	/* pxTopOfStack + 1 is aligned, the bookkeeping ends there */
+	t = (st_port_thread *)(pxTopOfStack + 1) - 1;
+	t->code = pxCode;
+	t->params = pvParameters;
+	port_event_init(&t->ev);
+
+	/* The new thread inherits the blocked tick, its first switch unblocks it */
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, PORT_THREAD_STACK);
+	vPortEnterCritical();
+	err = pthread_create(&t->thread, &attr, port_thread_start, t);
+	vPortExitCritical();
+	pthread_attr_destroy(&attr);
+	if(err != 0)
+	{
+		fprintf(stderr, "port: pthread_create failed (%d)\n", err);
+		abort();
+	}
+	return (StackType_t *)t - 1;
+}
+
+BaseType_t xPortStartScheduler(void)
+{
+	struct itimerval it;
+
+	(void)pthread_once(&port_once, port_setup);
+
+	/* The tick only interrupts task threads */
+	pthread_sigmask(SIG_BLOCK, &port_tick_set, NULL);
+	port_event_init(&port_end_ev);
+
+	it.it_interval.tv_sec = port_tick_us / 1000000;
+	it.it_interval.tv_usec = port_tick_us % 1000000;
+	it.it_value = it.it_interval;
+	setitimer(ITIMER_REAL, &it, NULL);
+
+	/* vTaskStartScheduler() made the first task current */
+	port_event_signal(&port_thread_of(xTaskGetCurrentTaskHandle())->ev);
+
+	/* Back here after vTaskEndScheduler() */
+	port_event_wait(&port_end_ev);
+	return pdFALSE;
+}
+
+void vPortEndScheduler(void)
+{
+	struct itimerval it = { 0 };
+
+	setitimer(ITIMER_REAL, &it, NULL);
+	port_event_signal(&port_end_ev);
+
+	/* The calling task stops here, every other one stays suspended */
+	pthread_exit(NULL);
+}
+/* portable.h - END */
+
+/*
+ * portmacro.h - START
+ */
+void vPortYieldFromISR(void)
+{
+	st_port_thread * from = port_thread_of(xTaskGetCurrentTaskHandle());
+
+	vTaskSwitchContext();
+	port_switch(from, port_thread_of(xTaskGetCurrentTaskHandle()));
+}
+
+void vPortYield(void)
+{
+	vPortEnterCritical();
+	vPortYieldFromISR();
+	vPortExitCritical();
+}
+
+void vPortDisableInterrupts(void)
+{
+	pthread_sigmask(SIG_BLOCK, &port_tick_set, NULL);
+}
+
+void vPortEnableInterrupts(void)
+{
+	pthread_sigmask(SIG_UNBLOCK, &port_tick_set, NULL);
+}
+
+void vPortEnterCritical(void)
+{
+	if(port_critical_nesting == 0)
+	{
+		vPortDisableInterrupts();
+	}
+	port_critical_nesting++;
+}
+
+void vPortExitCritical(void)
+{
+	port_critical_nesting--;
+	if(port_critical_nesting == 0)
+	{
+		vPortEnableInterrupts();
+	}
+}
+
+UBaseType_t xPortSetInterruptMask(void)
+{
+	sigset_t old;
+
+	pthread_sigmask(SIG_BLOCK, &port_tick_set, &old);
+	return (UBaseType_t)sigismember(&old, PORT_TICK_SIGNAL);
+}
+
+void vPortClearInterruptMask(UBaseType_t xMask)
+{
+	if(xMask == 0)
+	{
+		vPortEnableInterrupts();
+	}
+}
+
+void vPortCancelThread(void * pxTaskToDelete)
+{
+	st_port_thread * t = port_thread_of((TaskHandle_t)pxTaskToDelete);
+
+	/* Suspended in port_event_wait(), a cancellation point */
+	pthread_cancel(t->thread);
+	pthread_join(t->thread, NULL);
+}
+
+BaseType_t xPortIsInsideInterrupt(void)
+{
+	return port_in_isr;
+}
+
+void vPortSetTickPeriod(uint32_t us)
+{
+	port_tick_us = (us != 0) ? us : 1;
+}
+
+uint32_t ulPortGetRunTimeCounter(void)
+{
+	struct timespec ts;
+	uint64_t us;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	us = ((uint64_t)ts.tv_sec * 1000000ULL) + ((uint64_t)ts.tv_nsec / 1000);
+	if(port_rt_start == 0)
+	{
+		port_rt_start = us;
+	}
+	return (uint32_t)(us - port_rt_start);
+}
+/* portmacro.h - END */
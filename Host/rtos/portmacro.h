@@ -0,0 +1,120 @@
+/*
+ * portmacro.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  FreeRTOS port for Linux / POSIX hosts (Host/rtos/port.c), used by the
+ *  simulation build in place of portable/GCC/ARM_CM4F. Every task is a
+ *  pthread and only the thread of the running task is let run. The tick
+ *  interrupt is SIGALRM from an interval timer. Interrupts disabled means
+ *  SIGALRM blocked in the running thread.
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* Type definitions - START */
+#define portCHAR					char
+#define portFLOAT					float
+#define portDOUBLE					double
+#define portLONG					long
+#define portSHORT					short
+#define portSTACK_TYPE				unsigned long
+#define portBASE_TYPE				long
+#define portPOINTER_SIZE_TYPE		uintptr_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if(configUSE_16_BIT_TICKS == 1)
+	typedef uint16_t TickType_t;
+	#define portMAX_DELAY			(TickType_t)0xffff
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY			(TickType_t)0xffffffffUL
+	#define portTICK_TYPE_IS_ATOMIC	1
+#endif
+/* Type definitions - END */
+
+/* Architecture specifics - START */
+#define portSTACK_GROWTH			(-1)
+#define portTICK_PERIOD_MS			((TickType_t)1000 / configTICK_RATE_HZ)
+#define portBYTE_ALIGNMENT			8
+#define portNOP()
+#define portINLINE					__inline
+#define portFORCE_INLINE			inline __attribute__((always_inline))
+#define portMEMORY_BARRIER()		__asm volatile("" ::: "memory")
+/* Architecture specifics - END */
+
+/* Scheduler utilities - START */
+void vPortYield(void);
+void vPortYieldFromISR(void);
+
+#define portYIELD()					vPortYield()
+/* The tick is the only interrupt, a task it unblocks runs when it returns */
+#define portEND_SWITCHING_ISR(xSwitchRequired)	(void)(xSwitchRequired)
+#define portYIELD_FROM_ISR(x)		portEND_SWITCHING_ISR(x)
+/* Scheduler utilities - END */
+
+/* Critical section management - START */
+void vPortDisableInterrupts(void);
+void vPortEnableInterrupts(void);
+void vPortEnterCritical(void);
+void vPortExitCritical(void);
+UBaseType_t xPortSetInterruptMask(void);
+void vPortClearInterruptMask(UBaseType_t xMask);
+
+#define portSET_INTERRUPT_MASK_FROM_ISR()		xPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortClearInterruptMask(x)
+#define portDISABLE_INTERRUPTS()				vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()					vPortEnableInterrupts()
+#define portENTER_CRITICAL()					vPortEnterCritical()
+#define portEXIT_CRITICAL()						vPortExitCritical()
+/* Critical section management - END */
+
+/* Task function macros - START */
+#define portTASK_FUNCTION_PROTO(vFunction, pvParameters) void vFunction(void * pvParameters)
+#define portTASK_FUNCTION(vFunction, pvParameters) void vFunction(void * pvParameters)
+/* Task function macros - END */
+
+/* Task deletion - START */
+void vPortCancelThread(void * pxTaskToDelete);
+
+/* The thread of a deleted task waits suspended until its TCB is freed */
+#define portCLEAN_UP_TCB(pxTCB)		vPortCancelThread(pxTCB)
+/* Task deletion - END */
+
+/* Host extensions - START */
+/** @fn BaseType_t xPortIsInsideInterrupt(void)
+ * @brief pdTRUE while the tick interrupt runs, as IPSR != 0 on the target.
+ * @return pdTRUE/pdFALSE
+ */
+BaseType_t xPortIsInsideInterrupt(void);
+
+/** @fn void vPortSetTickPeriod(uint32_t us)
+ * @brief Host time of one tick, set before the scheduler starts. The
+ * default is the real time of a tick, a shorter one runs the kernel time
+ * faster than real time.
+ * @param us tick period in microseconds
+ */
+void vPortSetTickPeriod(uint32_t us);
+
+/** @fn uint32_t ulPortGetRunTimeCounter(void)
+ * @brief Run time stats counter, host microseconds since the first call.
+ * @return counter, wraps after 71 minutes
+ */
+uint32_t ulPortGetRunTimeCounter(void);
+/* Host extensions - END */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
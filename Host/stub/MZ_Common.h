@@ -0,0 +1,11 @@
+/*
+ * MZ_Common.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  MZ_Modem_public.h includes "MZ_Common.h", the file is MZ_common.h. The
+ *  target toolchain runs on a case insensitive file system, a Linux host
+ *  does not.
+ */
+
+#include "MZ_common.h"
@@ -0,0 +1,80 @@
+/*
+ * host_alloc.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Heap calls of the linked code, counted through the linker
+ *  (-Wl,--wrap=malloc ... in Host/CMakeLists.txt). Calls made inside the
+ *  C library itself are not seen.
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "stddef.h"
+
+/* Include Header Files - END */
+
+/* Global Variables - START */
+static uint32_t host_alloc_n;
+static uint64_t host_alloc_sum;
+/* Global Variables - END */
+
+void * __real_malloc(size_t size);
+void * __real_calloc(size_t nmemb, size_t size);
+void * __real_realloc(void * ptr, size_t size);
+void __real_free(void * ptr);
+
+/*
+ * Clear the allocation counters. - START
+ */
+void host_alloc_reset(void)
+{
+	host_alloc_n = 0;
+	host_alloc_sum = 0;
+}
+/* Clear the allocation counters. - END */
+
+/*
+ * Allocation counters. - START
+ */
+uint32_t host_alloc_calls(void)
+{
+	return host_alloc_n;
+}
+
+uint64_t host_alloc_bytes(void)
+{
+	return host_alloc_sum;
+}
+/* Allocation counters. - END */
+
+/*
+ * Wrapped heap calls - START
+ */
+void * __wrap_malloc(size_t size)
+{
+	host_alloc_n++;
+	host_alloc_sum += size;
+	return __real_malloc(size);
+}
+
+void * __wrap_calloc(size_t nmemb, size_t size)
+{
+	host_alloc_n++;
+	host_alloc_sum += (uint64_t)nmemb * size;
+	return __real_calloc(nmemb, size);
+}
+
+void * __wrap_realloc(void * ptr, size_t size)
+{
+	host_alloc_n++;
+	host_alloc_sum += size;
+	return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void * ptr)
+{
+	__real_free(ptr);
+}
+/* Wrapped heap calls - END */
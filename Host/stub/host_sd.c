@@ -0,0 +1,199 @@
+/*
+ * host_sd.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  SDMMC1 card on the host, backed by an image file of 512 byte blocks.
+ *  Reads are blocking. A DMA write lands in the file at once, the card
+ *  then stays busy (HAL_SD_CARD_PROGRAMMING) for the time the timing
+ *  model gives, and HAL_SD_TxCpltCallback() runs on the simulated tick
+ *  the transfer ends, the way the SDMMC1 interrupt calls it on target.
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_gps_sdlog.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Global Variables - START */
+SD_HandleTypeDef hsd1;
+
+static FILE * host_sd_file;
+static uint32_t host_sd_blocks;
+static uint32_t host_sd_kbs = 1000;
+static uint32_t host_sd_busy;
+static uint32_t host_sd_spike;
+static uint32_t host_sd_spike_every;
+static uint8_t host_sd_in_flight;
+static uint32_t host_sd_done_ms;
+static st_host_sd_stats host_sd_stats;
+/* Global Variables - END */
+
+/*
+ * Attach an image file. - START
+ */
+mz_error_t host_sd_open(const char * path, uint32_t blocks)
+{
+	host_sd_close();
+	host_sd_file = fopen(path, "r+b");
+	if(host_sd_file == NULL)
+	{
+		host_sd_file = fopen(path, "w+b");
+	}
+	if(host_sd_file == NULL)
+	{
+		return MZ_FAIL;
+	}
+	host_sd_blocks = blocks;
+	host_sd_in_flight = 0;
+	memset(&host_sd_stats, 0, sizeof(host_sd_stats));
+	return MZ_OK;
+}
+/* Attach an image file. - END */
+
+/*
+ * Detach the image file. - START
+ */
+void host_sd_close(void)
+{
+	if(host_sd_file != NULL)
+	{
+		fclose(host_sd_file);
+		host_sd_file = NULL;
+	}
+}
+/* Detach the image file. - END */
+
+/*
+ * Card write timing. - START
+ */
+void host_sd_timing(uint32_t kbytes_s, uint32_t busy_ms, uint32_t spike_ms, uint32_t spike_every)
+{
+	host_sd_kbs = (kbytes_s != 0) ? kbytes_s : 1;
+	host_sd_busy = busy_ms;
+	host_sd_spike = spike_ms;
+	host_sd_spike_every = spike_every;
+}
+/* Card write timing. - END */
+
+/*
+ * Card counters. - START
+ */
+void host_sd_get_stats(st_host_sd_stats * stats)
+{
+	*stats = host_sd_stats;
+}
+/* Card counters. - END */
+
+/*
+ * End the transfer in flight when its time is up. - START
+ */
+void host_sd_run(void)
+{
+	if(host_sd_in_flight && ((int32_t)(HAL_GetTick() - host_sd_done_ms) >= 0))
+	{
+		host_sd_in_flight = 0;
+		HAL_SD_TxCpltCallback(&hsd1);
+	}
+}
+/* End the transfer in flight when its time is up. - END */
+
+/*
+ * stm32l4xx_hal_sd.h - START
+ */
+HAL_StatusTypeDef HAL_SD_Init(SD_HandleTypeDef *hsd)
+{
+	return (host_sd_file != NULL) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_SD_ConfigWideBusOperation(SD_HandleTypeDef *hsd, uint32_t WideMode)
+{
+	return HAL_OK;
+}
+
+HAL_SD_CardStateTypeDef HAL_SD_GetCardState(SD_HandleTypeDef *hsd)
+{
+	return host_sd_in_flight ? HAL_SD_CARD_PROGRAMMING : HAL_SD_CARD_TRANSFER;
+}
+
+HAL_StatusTypeDef HAL_SD_ReadBlocks(SD_HandleTypeDef *hsd, uint8_t *pData, uint32_t BlockAdd, uint32_t NumberOfBlocks, uint32_t Timeout)
+{
+	size_t len = (size_t)NumberOfBlocks * GPS_SDLOG_BLOCK_SIZE;
+	size_t got;
+
+	if((host_sd_file == NULL) || ((BlockAdd + NumberOfBlocks) > host_sd_blocks))
+	{
+		return HAL_ERROR;
+	}
+	/* Blocks never written read as zero, like an erased card */
+	memset(pData, 0, len);
+	if(0 != fseek(host_sd_file, (long)BlockAdd * GPS_SDLOG_BLOCK_SIZE, SEEK_SET))
+	{
+		return HAL_ERROR;
+	}
+	got = fread(pData, 1, len, host_sd_file);
+	(void)got;
+	host_sd_stats.reads++;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SD_WriteBlocks_DMA(SD_HandleTypeDef *hsd, uint8_t *pData, uint32_t BlockAdd, uint32_t NumberOfBlocks)
+{
+	size_t len = (size_t)NumberOfBlocks * GPS_SDLOG_BLOCK_SIZE;
+	uint32_t ms;
+
+	if((host_sd_file == NULL) || host_sd_in_flight || ((BlockAdd + NumberOfBlocks) > host_sd_blocks))
+	{
+		return HAL_ERROR;
+	}
+	if((0 != fseek(host_sd_file, (long)BlockAdd * GPS_SDLOG_BLOCK_SIZE, SEEK_SET)) ||
+	   (len != fwrite(pData, 1, len, host_sd_file)))
+	{
+		return HAL_ERROR;
+	}
+
+	host_sd_stats.writes++;
+	host_sd_stats.blocks_written += NumberOfBlocks;
+	ms = host_sd_busy + (uint32_t)((len + host_sd_kbs - 1) / host_sd_kbs);
+	if((host_sd_spike_every != 0) && ((host_sd_stats.writes % host_sd_spike_every) == 0))
+	{
+		ms += host_sd_spike;
+	}
+	host_sd_stats.busy_ms += ms;
+	if(ms > host_sd_stats.max_busy_ms)
+	{
+		host_sd_stats.max_busy_ms = ms;
+	}
+	host_sd_in_flight = 1;
+	host_sd_done_ms = HAL_GetTick() + ms;
+	return HAL_OK;
+}
+
+__attribute__((weak)) void HAL_SD_TxCpltCallback(SD_HandleTypeDef *hsd)
+{
+}
+
+__attribute__((weak)) void HAL_SD_ErrorCallback(SD_HandleTypeDef *hsd)
+{
+}
+/* stm32l4xx_hal_sd.h - END */
+
+/*
+ * DMA and NVIC set up - START
+ */
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma)
+{
+	return HAL_OK;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+}
+/* DMA and NVIC set up - END */
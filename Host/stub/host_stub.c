@@ -0,0 +1,136 @@
+/*
+ * host_stub.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_Modem_public.h"
+#include "MZ_print.h"
+#include "cmsis_os2.h"
+#include "string.h"
+#include "time.h"
+#if defined(GPS_HOST_RTOS)
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+/* Include Header Files - END */
+
+/* Global Variables - START */
+#if !defined(GPS_HOST_RTOS)
+static uint32_t host_ms;
+#endif
+static FILE * host_cli;
+static uint8_t host_cli_set;
+static host_at_fp host_at;
+/* Global Variables - END */
+
+#if !defined(GPS_HOST_RTOS)
+/*
+ * Set the simulated millisecond counter. - START
+ */
+void host_tick_set(uint32_t ms)
+{
+	host_ms = ms;
+}
+/* Set the simulated millisecond counter. - END */
+
+/*
+ * Move the simulated counter forward. - START
+ */
+void host_tick_advance(uint32_t ms)
+{
+	/* One tick at a time, a timer callback sees its own expiry tick */
+	while(ms-- != 0)
+	{
+		host_ms++;
+		host_sd_run();
+		host_tm_run();
+	}
+}
+/* Move the simulated counter forward. - END */
+#endif //!defined(GPS_HOST_RTOS)
+
+/*
+ * Wall clock for benchmarks. - START
+ */
+uint64_t host_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+/* Wall clock for benchmarks. - END */
+
+/*
+ * Destination of mz_puts(). - START
+ */
+void host_cli_file(FILE * f)
+{
+	host_cli = f;
+	host_cli_set = 1;
+}
+/* Destination of mz_puts(). - END */
+
+/*
+ * Modem behind MZ_init_cmd_direct(). - START
+ */
+void host_at_handler(host_at_fp fp)
+{
+	host_at = fp;
+}
+/* Modem behind MZ_init_cmd_direct(). - END */
+
+#if !defined(GPS_HOST_RTOS)
+/*
+ * HAL / CMSIS-RTOS - START
+ */
+uint32_t HAL_GetTick(void)
+{
+	return host_ms;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+	host_tick_advance(Delay);
+}
+
+osStatus_t osDelay(uint32_t ticks)
+{
+	/* configTICK_RATE_HZ is 1000 */
+	host_tick_advance(ticks);
+	return osOK;
+}
+/* HAL / CMSIS-RTOS - END */
+#endif //!defined(GPS_HOST_RTOS)
+
+/*
+ * MonoZ CLI and modem - START
+ */
+int mz_puts(void * __ch)
+{
+	FILE * f = host_cli_set ? host_cli : stdout;
+
+	if(f != NULL)
+	{
+#if defined(GPS_HOST_RTOS)
+		/* No task switch while the stream lock is held */
+		taskENTER_CRITICAL();
+		fputs((const char *)__ch, f);
+		taskEXIT_CRITICAL();
+#else
+		fputs((const char *)__ch, f);
+#endif
+	}
+	return 1;
+}
+
+mz_error_t MZ_init_cmd_direct(char * dbuffer, mzInt32 to, mzInt32 twn)
+{
+	return (host_at != NULL) ? host_at(dbuffer, to, twn) : MZ_OK;
+}
+/* MonoZ CLI and modem - END */
@@ -0,0 +1,178 @@
+/*
+ * host_stub.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Host stand-ins for the HAL, CMSIS-RTOS and MonoZ library calls used by
+ *  the GPS modules, so the portable part of Lib/tool_gen links into PC
+ *  tools (Host/CMakeLists.txt).
+ *
+ *  Time is simulated : HAL_GetTick() returns a millisecond counter that
+ *  only moves through host_tick_advance(), HAL_Delay() and osDelay(), so
+ *  a day of device time runs in a fraction of a second and every run is
+ *  repeatable. MonoZ timers (mz_tm_*) expire and SD card writes end
+ *  while the counter moves.
+ *  Benchmarks take wall time from host_ns().
+ *
+ *  In the simulation build (GPS_HOST_RTOS, Host/rtos/host_rtos.h) the
+ *  kernel keeps the time : HAL_GetTick, HAL_Delay, osDelay and mz_tm_*
+ *  run on FreeRTOS there, and host_tick_* / host_tm_* do not exist.
+ *
+ *  - HAL_GetTick / HAL_Delay / osDelay	simulated millisecond counter
+ *  - mz_puts							host_cli_file(), stdout by default
+ *  - MZ_init_cmd_direct				host_at_handler(), OK by default
+ *  - MZ_UART_*							host_uart_feed() / host_uart_sink()
+ *  - mz_tm_*							MZ_MAX_TIMER_COUNT FreeRTOS style timers
+ *  - HAL_SD_* (hsd1)					image file, host_sd_open()
+ *  - malloc / calloc / realloc / free	counted, host_alloc_*()
+ */
+
+#ifndef HOST_STUB_H_
+#define HOST_STUB_H_
+
+#include "stdint.h"
+#include "stdio.h"
+#include "MZ_error_handler.h"
+#include "MZ_common.h"
+
+/**
+ * @struct st_host_sd_stats
+ * @brief Card counters
+ */
+typedef struct
+{
+	uint32_t		writes;										/*!< DMA write transfers */
+	uint32_t		blocks_written;								/*!< Blocks written */
+	uint32_t		reads;										/*!< Blocking reads */
+	uint32_t		busy_ms;									/*!< Time the card was busy writing */
+	uint32_t		max_busy_ms;								/*!< Longest write */
+}st_host_sd_stats;
+
+/** @brief Answer of the emulated modem to MZ_init_cmd_direct() */
+typedef mz_error_t (*host_at_fp)(char * dbuffer, mzInt32 to, mzInt32 twn);
+
+#if !defined(GPS_HOST_RTOS)
+/** @fn void host_tick_set(uint32_t ms)
+ * @brief Set the simulated millisecond counter, no timer runs.
+ * @param ms new HAL_GetTick() value
+ */
+void host_tick_set(uint32_t ms);
+
+/** @fn void host_tick_advance(uint32_t ms)
+ * @brief Move the simulated counter forward, the MonoZ timers due on the
+ * way run at their own tick.
+ * @param ms milliseconds
+ */
+void host_tick_advance(uint32_t ms);
+#endif //!defined(GPS_HOST_RTOS)
+
+/** @fn uint64_t host_ns(void)
+ * @brief Wall clock for benchmarks.
+ * @return CLOCK_MONOTONIC in ns
+ */
+uint64_t host_ns(void);
+
+/** @fn void host_cli_file(FILE * f)
+ * @brief Destination of mz_puts().
+ * @param f stream, NULL discards the CLI output
+ */
+void host_cli_file(FILE * f);
+
+/** @fn void host_at_handler(host_at_fp fp)
+ * @brief Modem behind MZ_init_cmd_direct().
+ * @param fp handler, NULL answers every command with MZ_OK
+ */
+void host_at_handler(host_at_fp fp);
+
+/** @fn void host_uart_feed(uint8_t uart_no, const uint8_t * data, uint16_t len)
+ * @brief Bytes received on a UART. An armed MZ_UART_Receive_IT() is filled
+ * and its receive callback called, the bytes left are read by
+ * MZ_UART_Receive() until the next feed. data must stay valid until then.
+ * @param uart_no en_uart_no
+ * @param data received bytes
+ * @param len number of bytes
+ */
+void host_uart_feed(uint8_t uart_no, const uint8_t * data, uint16_t len);
+
+/** @fn void host_uart_sink(uint8_t uart_no, FILE * f)
+ * @brief Destination of the bytes transmitted on a UART.
+ * @param uart_no en_uart_no
+ * @param f stream, NULL discards them
+ */
+void host_uart_sink(uint8_t uart_no, FILE * f);
+
+/** @fn uint32_t host_uart_overrun(uint8_t uart_no)
+ * @brief Bytes fed while no MZ_UART_Receive_IT() was armed, lost to an
+ * interrupt driven reader as in an overrun.
+ * @param uart_no en_uart_no
+ * @return bytes
+ */
+uint32_t host_uart_overrun(uint8_t uart_no);
+
+#if !defined(GPS_HOST_RTOS)
+/** @fn uint32_t host_tm_active(void)
+ * @brief MonoZ timers running.
+ * @return running timers
+ */
+uint32_t host_tm_active(void);
+
+/** @fn void host_tm_run(void)
+ * @brief Run the MonoZ timers due at the current tick.
+ */
+void host_tm_run(void);
+#endif //!defined(GPS_HOST_RTOS)
+
+/** @fn mz_error_t host_sd_open(const char * path, uint32_t blocks)
+ * @brief Attach an image file as the SDMMC1 card, created when missing.
+ * @param path image file
+ * @param blocks card size in 512 byte blocks
+ * @return MZ_OK/MZ_FAIL
+ */
+mz_error_t host_sd_open(const char * path, uint32_t blocks);
+
+/** @fn void host_sd_close(void)
+ * @brief Detach the image file, HAL_SD_Init() fails until the next open.
+ */
+void host_sd_close(void);
+
+/** @fn void host_sd_timing(uint32_t kbytes_s, uint32_t busy_ms, uint32_t spike_ms, uint32_t spike_every)
+ * @brief Card write timing : a write keeps the card busy for busy_ms plus
+ * its length at kbytes_s, every spike_every-th write spike_ms longer
+ * (flash management of the card).
+ * @param kbytes_s sustained write rate, 1000 bytes/s units
+ * @param busy_ms fixed cost of one write
+ * @param spike_ms extra time of a slow write
+ * @param spike_every every Nth write is slow, 0 = none
+ */
+void host_sd_timing(uint32_t kbytes_s, uint32_t busy_ms, uint32_t spike_ms, uint32_t spike_every);
+
+/** @fn void host_sd_run(void)
+ * @brief End the write in flight when its time is up, called on every
+ * simulated tick.
+ */
+void host_sd_run(void);
+
+/** @fn void host_sd_get_stats(st_host_sd_stats * stats)
+ * @brief Copy the card counters.
+ * @param stats destination
+ */
+void host_sd_get_stats(st_host_sd_stats * stats);
+
+/** @fn void host_alloc_reset(void)
+ * @brief Clear the allocation counters.
+ */
+void host_alloc_reset(void);
+
+/** @fn uint32_t host_alloc_calls(void)
+ * @brief malloc / calloc / realloc calls since host_alloc_reset().
+ * @return calls
+ */
+uint32_t host_alloc_calls(void);
+
+/** @fn uint64_t host_alloc_bytes(void)
+ * @brief Bytes requested since host_alloc_reset().
+ * @return bytes
+ */
+uint64_t host_alloc_bytes(void);
+
+#endif /* HOST_STUB_H_ */
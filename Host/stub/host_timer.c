@@ -0,0 +1,239 @@
+/*
+ * host_timer.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  MonoZ timers on the host. The library keeps MZ_MAX_TIMER_COUNT
+ *  FreeRTOS software timers, modelled here the way the FreeRTOS timer
+ *  task keeps them : one list of running timers sorted by expiry, a start
+ *  inserts by walking it, a stop unlinks, each tick looks at the head.
+ *  The command queue to the timer task is not modelled, a start or stop
+ *  takes effect at once.
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_timer.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/**
+ * @struct tmrTimerControl
+ * @brief One MonoZ timer, TimerHandle_t points to it
+ */
+struct tmrTimerControl
+{
+	struct tmrTimerControl *	next;							/*!< Running list, sorted by expiry */
+	struct tmrTimerControl *	prev;							/*!< Running list */
+	const char *				name;							/*!< Timer name */
+	uint32_t					period;							/*!< Ticks */
+	uint32_t					expires;						/*!< Tick of expiry */
+	uint8_t						used;							/*!< Created */
+	uint8_t						running;						/*!< In the running list */
+	uint8_t						reload;							/*!< Restarted at expiry */
+	mz_tm_cb					cb;								/*!< Expiry callback */
+};
+
+/* Global Variables - START */
+static struct tmrTimerControl host_tm[MZ_MAX_TIMER_COUNT];
+static struct tmrTimerControl * host_tm_head;
+static uint32_t host_tm_running;
+static uint8_t host_tm_in_run;
+/* Global Variables - END */
+
+/** @fn static void host_tm_unlink(struct tmrTimerControl * t)
+ * @brief Take a timer out of the running list
+ */
+static void host_tm_unlink(struct tmrTimerControl * t)
+{
+	if(!t->running)
+	{
+		return;
+	}
+	if(t->prev != NULL)
+	{
+		t->prev->next = t->next;
+	}
+	else
+	{
+		host_tm_head = t->next;
+	}
+	if(t->next != NULL)
+	{
+		t->next->prev = t->prev;
+	}
+	t->running = 0;
+	host_tm_running--;
+}
+
+/** @fn static void host_tm_link(struct tmrTimerControl * t, uint32_t now)
+ * @brief Insert a timer in expiry order, behind timers of the same expiry
+ */
+static void host_tm_link(struct tmrTimerControl * t, uint32_t now)
+{
+	struct tmrTimerControl * prev = NULL;
+	struct tmrTimerControl * cur = host_tm_head;
+
+	t->expires = now + t->period;
+	while((cur != NULL) && ((int32_t)(cur->expires - t->expires) <= 0))
+	{
+		prev = cur;
+		cur = cur->next;
+	}
+	t->prev = prev;
+	t->next = cur;
+	if(prev != NULL)
+	{
+		prev->next = t;
+	}
+	else
+	{
+		host_tm_head = t;
+	}
+	if(cur != NULL)
+	{
+		cur->prev = t;
+	}
+	t->running = 1;
+	host_tm_running++;
+}
+
+/** @fn static struct tmrTimerControl * host_tm_get(size_t _id)
+ * @brief Timer of an id, NULL when not created
+ */
+static struct tmrTimerControl * host_tm_get(size_t _id)
+{
+	if((_id >= MZ_MAX_TIMER_COUNT) || !host_tm[_id].used)
+	{
+		return NULL;
+	}
+	return &host_tm[_id];
+}
+
+/*
+ * Run the MonoZ timers due at the current tick. - START
+ */
+void host_tm_run(void)
+{
+	uint32_t now = HAL_GetTick();
+
+	/* A callback that delays moves the clock, it does not run timers */
+	if(host_tm_in_run)
+	{
+		return;
+	}
+	host_tm_in_run = 1;
+	while((host_tm_head != NULL) && ((int32_t)(now - host_tm_head->expires) >= 0))
+	{
+		struct tmrTimerControl * t = host_tm_head;
+
+		host_tm_unlink(t);
+		if(t->reload)
+		{
+			/* FreeRTOS reloads from the expiry tick, not from now */
+			host_tm_link(t, t->expires);
+		}
+		t->cb(t);
+	}
+	host_tm_in_run = 0;
+}
+/* Run the MonoZ timers due at the current tick. - END */
+
+/*
+ * MonoZ timers running. - START
+ */
+uint32_t host_tm_active(void)
+{
+	return host_tm_running;
+}
+/* MonoZ timers running. - END */
+
+/*
+ * MZ_timer.h - START
+ */
+size_t mz_tm_create(char* _name,TickType_t _tick,UBaseType_t _auto,mz_tm_cb _cb)
+{
+	for(size_t i = 0; i < MZ_MAX_TIMER_COUNT; i++)
+	{
+		if(!host_tm[i].used)
+		{
+			memset(&host_tm[i], 0, sizeof(host_tm[i]));
+			host_tm[i].used = 1;
+			host_tm[i].name = _name;
+			host_tm[i].period = (_tick != 0) ? _tick : 1;
+			host_tm[i].reload = (_auto != pdFALSE);
+			host_tm[i].cb = _cb;
+			return i;
+		}
+	}
+	return MZ_TIMER_NOT_AVAILABLE;
+}
+
+size_t mz_tm_create_one(char* _name,TickType_t _tick,mz_tm_cb _cb)
+{
+	return mz_tm_create(_name, _tick, pdFALSE, _cb);
+}
+
+size_t mz_tm_create_recursive(char* _name,TickType_t _tick,mz_tm_cb _cb)
+{
+	return mz_tm_create(_name, _tick, pdTRUE, _cb);
+}
+
+mz_error_t mz_tm_start(size_t _id)
+{
+	struct tmrTimerControl * t = host_tm_get(_id);
+
+	if(t == NULL)
+	{
+		return MZ_FAIL;
+	}
+	/* xTimerStart on a running timer restarts it */
+	host_tm_unlink(t);
+	host_tm_link(t, HAL_GetTick());
+	return MZ_OK;
+}
+
+mz_error_t mz_tm_create_start(char* _name,TickType_t _tick,UBaseType_t _auto,mz_tm_cb _cb)
+{
+	size_t id = mz_tm_create(_name, _tick, _auto, _cb);
+
+	return (id == MZ_TIMER_NOT_AVAILABLE) ? MZ_FAIL : mz_tm_start(id);
+}
+
+mz_error_t mz_tm_create_start_one(char* _name,TickType_t _tick,mz_tm_cb _cb)
+{
+	return mz_tm_create_start(_name, _tick, pdFALSE, _cb);
+}
+
+mz_error_t mz_tm_create_start_recursive(char* _name,TickType_t _tick,mz_tm_cb _cb)
+{
+	return mz_tm_create_start(_name, _tick, pdTRUE, _cb);
+}
+
+mz_error_t mz_tm_stop(size_t _id)
+{
+	struct tmrTimerControl * t = host_tm_get(_id);
+
+	if(t == NULL)
+	{
+		return MZ_FAIL;
+	}
+	host_tm_unlink(t);
+	return MZ_OK;
+}
+
+mz_error_t mz_tm_delete(size_t _id)
+{
+	struct tmrTimerControl * t = host_tm_get(_id);
+
+	if(t == NULL)
+	{
+		return MZ_FAIL;
+	}
+	host_tm_unlink(t);
+	t->used = 0;
+	return MZ_OK;
+}
+/* MZ_timer.h - END */
@@ -0,0 +1,238 @@
+/*
+ * host_uart.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  MonoZ UART driver on the host. Received bytes come from
+ *  host_uart_feed(), transmitted bytes go to the stream of
+ *  host_uart_sink(). The receive and transmit callbacks get an
+ *  st_uart_intr the way the library interrupt handler passes it.
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_uart.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/**
+ * @struct st_host_uart
+ * @brief Host side of one UART
+ */
+typedef struct
+{
+	MZ_UARTX		uart;										/*!< Library view of the UART */
+	FILE *			sink;										/*!< Transmitted bytes, NULL = discarded */
+	uint8_t *		rx_ptr;										/*!< Armed MZ_UART_Receive_IT() buffer */
+	uint16_t		rx_size;									/*!< Its size */
+	uint16_t		rx_count;									/*!< Bytes already in it */
+	const uint8_t *	feed;										/*!< Bytes for MZ_UART_Receive() */
+	uint16_t		feed_len;									/*!< Bytes left in feed */
+	uint32_t		overrun;									/*!< Bytes fed while no receive was armed */
+}st_host_uart;
+
+/* Global Variables - START */
+static st_host_uart host_uart[UART_MAX_COUNT];
+/* Global Variables - END */
+
+/** @fn static st_host_uart * host_uart_get(uint8_t uart_no)
+ * @brief UART of a number, NULL when out of range
+ */
+static st_host_uart * host_uart_get(uint8_t uart_no)
+{
+	return (uart_no < UART_MAX_COUNT) ? &host_uart[uart_no] : NULL;
+}
+
+/** @fn static void host_uart_event(st_host_uart * u, _uart_api api)
+ * @brief Call a driver callback the way the interrupt handler does
+ */
+static void host_uart_event(st_host_uart * u, _uart_api api)
+{
+	st_uart_intr ev;
+
+	if(api == NULL)
+	{
+		return;
+	}
+	ev.uart_ptr = &u->uart._handler;
+	ev.event = FULL_COMPLETE;
+	api(&ev);
+}
+
+/*
+ * Bytes received on a UART. - START
+ */
+void host_uart_feed(uint8_t uart_no, const uint8_t * data, uint16_t len)
+{
+	st_host_uart * u = host_uart_get(uart_no);
+
+	if(u == NULL)
+	{
+		return;
+	}
+	/* Blocking receives read the fed bytes, interrupt receives take them now */
+	u->feed = data;
+	u->feed_len = len;
+	while((u->feed_len != 0) && (u->rx_ptr != NULL))
+	{
+		u->rx_ptr[u->rx_count++] = *u->feed++;
+		u->feed_len--;
+		if(u->rx_count == u->rx_size)
+		{
+			/* The callback may arm the next receive */
+			u->rx_ptr = NULL;
+			host_uart_event(u, u->uart.rx_intr_api);
+		}
+	}
+	u->overrun += u->feed_len;
+}
+/* Bytes received on a UART. - END */
+
+/*
+ * Bytes fed while no receive was armed. - START
+ */
+uint32_t host_uart_overrun(uint8_t uart_no)
+{
+	st_host_uart * u = host_uart_get(uart_no);
+
+	return (u != NULL) ? u->overrun : 0;
+}
+/* Bytes fed while no receive was armed. - END */
+
+/*
+ * Destination of the bytes transmitted on a UART. - START
+ */
+void host_uart_sink(uint8_t uart_no, FILE * f)
+{
+	st_host_uart * u = host_uart_get(uart_no);
+
+	if(u != NULL)
+	{
+		u->sink = f;
+	}
+}
+/* Destination of the bytes transmitted on a UART. - END */
+
+/*
+ * MZ_uart.h - START
+ */
+MZ_UART_BTYPE_PTR MZ_UART_get_base_address(void)
+{
+	return &host_uart[0].uart;
+}
+
+MZ_UART_BTYPE_PTR MZ_UART_reference(en_uart_no uart_no)
+{
+	st_host_uart * u = host_uart_get(uart_no);
+
+	return (u != NULL) ? &u->uart : NULL;
+}
+
+mz_error_t MZ_UART_init(MZ_UART_INIT_PTR _cfg)
+{
+	(void)_cfg;
+	return MZ_OK;
+}
+
+mz_error_t MZ_UART_register_callback(uint8_t uart_no, _uart_api cb)
+{
+	st_host_uart * u = host_uart_get(uart_no);
+
+	if(u == NULL)
+	{
+		return MZ_FAIL;
+	}
+	u->uart.UART_ev_call_back = cb;
+	return MZ_OK;
+}
+
+mz_error_t MZ_UART_register_intr_cb_tx(uint8_t uart_no, _uart_api cb)
+{
+	st_host_uart * u = host_uart_get(uart_no);
+
+	if(u == NULL)
+	{
+		return MZ_FAIL;
+	}
+	u->uart.tx_intr_api = cb;
+	u->uart._tx_intr = 1;
+	return MZ_OK;
+}
+
+mz_error_t MZ_UART_register_intr_cb_rx(uint8_t uart_no, _uart_api cb)
+{
+	st_host_uart * u = host_uart_get(uart_no);
+
+	if(u == NULL)
+	{
+		return MZ_FAIL;
+	}
+	u->uart.rx_intr_api = cb;
+	u->uart._rx_intr = 1;
+	return MZ_OK;
+}
+
+mz_error_t MZ_UART_Transmit(uint8_t uart_no,uint8_t *pData,uint16_t Size,uint32_t Timeout)
+{
+	st_host_uart * u = host_uart_get(uart_no);
+
+	(void)Timeout;
+	if(u == NULL)
+	{
+		return MZ_FAIL;
+	}
+	if(u->sink != NULL)
+	{
+		fwrite(pData, 1, Size, u->sink);
+	}
+	return MZ_OK;
+}
+
+mz_error_t MZ_UART_Receive(uint8_t uart_no,uint8_t *pData,uint16_t Size,uint32_t Timeout)
+{
+	st_host_uart * u = host_uart_get(uart_no);
+
+	/* Bytes not fed yet never come, the timeout is not waited for */
+	(void)Timeout;
+	if((u == NULL) || (u->feed_len < Size))
+	{
+		return MZ_FAIL;
+	}
+	memcpy(pData, u->feed, Size);
+	u->feed += Size;
+	u->feed_len -= Size;
+	return MZ_OK;
+}
+
+mz_error_t MZ_UART_Transmit_IT(uint8_t uart_no, uint8_t *pData, uint16_t Size)
+{
+	mz_error_t ret = MZ_UART_Transmit(uart_no, pData, Size, 0);
+
+	if(MZ_OK == ret)
+	{
+		host_uart_event(&host_uart[uart_no], host_uart[uart_no].uart.tx_intr_api);
+	}
+	return ret;
+}
+
+mz_error_t MZ_UART_Receive_IT(uint8_t uart_no, uint8_t *pData, uint16_t Size)
+{
+	st_host_uart * u = host_uart_get(uart_no);
+
+	if((u == NULL) || (Size == 0) || (u->rx_ptr != NULL))
+	{
+		return MZ_FAIL;
+	}
+	u->rx_ptr = pData;
+	u->rx_size = Size;
+	u->rx_count = 0;
+	return MZ_OK;
+}
+
+void MZ_HAL_UART_IRQHandler(uint8_t uart_no)
+{
+	(void)uart_no;
+}
+/* MZ_uart.h - END */
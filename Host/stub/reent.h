@@ -0,0 +1,24 @@
+/*
+ * reent.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  FreeRTOS.h includes the newlib reent.h for configUSE_NEWLIB_REENTRANT,
+ *  glibc has none. Only the names FreeRTOS uses are declared, no task
+ *  runs on the host.
+ */
+
+#ifndef HOST_REENT_H_
+#define HOST_REENT_H_
+
+struct _reent
+{
+	int		_errno;
+};
+
+#define _REENT_INIT_PTR(x)
+#define _reclaim_reent(x)
+
+extern struct _reent * _impure_ptr;
+
+#endif /* HOST_REENT_H_ */
@@ -0,0 +1,112 @@
+/*
+ * gps_aid_sim.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Receiver aiding harness (MZ_gps_aid.h). The NMEA generator tracks for
+ *  SIM_TRACK_S while every fix updates a checkpoint, then takes the
+ *  CFG-RST of gps_aid_rst() and restarts hot, warm or cold. With aiding
+ *  the AID-INI of gps_aid_ini() follows one second later, as
+ *  gps_aid_poll() sends it. Prints the seconds to the first fix with and
+ *  without aiding; the start times are those of the NEO-6M emulation of
+ *  the generator, not of a real receiver.
+ *
+ *  Then an AID-INI built from the checkpoint ten minutes later is checked
+ *  and decoded, and the checkpoint CRC is tested against a changed field.
+ *
+ *  gps_aid_sim
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_gps_aid.h"
+#include "MZ_gps_nmea_gen.h"
+#include "MZ_gps_ubx.h"
+#include "stdio.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define SIM_TRACK_S					(120)						///< Tracking before the restart
+#define SIM_TTFF_MAX_S				(100)						///< Give up on a fix after this
+#define SIM_EPOCH_SIZE				(2048)						///< Largest generated epoch
+#define SIM_FRAME_SIZE				(64)						///< Largest UBX frame sent
+#define SIM_AGE_S					(600)						///< Checkpoint age of the decoded AID-INI
+/* Define some common use MACRO - END */
+
+/** @fn static uint32_t sim_ttff(uint16_t bbr, uint8_t aid, st_gps_aid_ckpt * ck)
+ * @brief Seconds from a receiver restart to its first fix
+ */
+static uint32_t sim_ttff(uint16_t bbr, uint8_t aid, st_gps_aid_ckpt * ck)
+{
+	st_gps_nmea_gen_cfg cfg =
+	{
+		.lat_e7 = 356812000, .lon_e7 = 1397671000, .utc_time = 101500, .utc_date = 191026,
+		.speed_cms = 0, .hdop_x100 = 90, .rate_hz = 1, .sentences = GPS_NMEA_GEN_ALL,
+	};
+	static st_gps_nmea_gen gen;
+	static char epoch[SIM_EPOCH_SIZE];
+	uint8_t frame[SIM_FRAME_SIZE];
+	uint16_t n;
+
+	gps_nmea_gen_init(&gen, &cfg);
+	for(uint32_t s = 0; s < SIM_TRACK_S; s++)
+	{
+		gps_nmea_gen_epoch(&gen, epoch, sizeof(epoch));
+		gps_aid_update(ck, &gen.fix);
+	}
+
+	n = gps_aid_rst(bbr, frame, sizeof(frame));
+	gps_nmea_gen_ubx_input(&gen, frame, n);
+	for(uint32_t s = 0; s < SIM_TTFF_MAX_S; s++)
+	{
+		if((s == 1) && aid)
+		{
+			n = gps_aid_ini(ck, gps_fix_to_unix(&gen.fix), 0, GPS_AID_TIME_ACC_MS, frame, sizeof(frame));
+			if(!gps_nmea_gen_ubx_input(&gen, frame, n))
+			{
+				printf("AID-INI rejected by the receiver\n");
+			}
+		}
+		gps_nmea_gen_epoch(&gen, epoch, sizeof(epoch));
+		if(gen.tracking)
+		{
+			return s;
+		}
+	}
+	return SIM_TTFF_MAX_S;
+}
+
+/*
+ * Simulation entry - START
+ */
+int main(void)
+{
+	static const char * const start[] = { "hot", "warm", "cold" };
+	static const uint16_t bbr[] = { GPS_AID_BBR_HOT, GPS_AID_BBR_WARM, GPS_AID_BBR_COLD };
+	st_gps_aid_ckpt ck;
+	uint8_t frame[SIM_FRAME_SIZE];
+	uint16_t n;
+
+	memset(&ck, 0, sizeof(ck));
+	for(uint8_t i = 0; i < (sizeof(bbr) / sizeof(bbr[0])); i++)
+	{
+		uint32_t unaided = sim_ttff(bbr[i], 0, &ck);
+		uint32_t aided = sim_ttff(bbr[i], 1, &ck);
+
+		printf("%-4s start: unaided %lu s, aided %lu s\n", start[i], (unsigned long)unaided, (unsigned long)aided);
+	}
+
+	n = gps_aid_ini(&ck, ck.fix_s + SIM_AGE_S, 250, GPS_AID_TIME_ACC_MS, frame, sizeof(frame));
+	printf("AID-INI %u bytes, frame %s, checkpoint seq %lu %s\n", n, gps_ubx_check(frame, n) ? "ok" : "bad",
+			(unsigned long)ck.seq, gps_aid_valid(&ck) ? "valid" : "invalid");
+	printf("  week %u, tow %lu ms, flags 0x%lx, position accuracy %lu cm after %u s\n",
+			frame[6 + 18] | (frame[6 + 19] << 8), (unsigned long)gps_ubx_get_u32(&frame[6 + 20]),
+			(unsigned long)gps_ubx_get_u32(&frame[6 + 44]), (unsigned long)gps_ubx_get_u32(&frame[6 + 12]), SIM_AGE_S);
+	ck.lat_e7++;
+	printf("changed latitude: checkpoint %s\n", gps_aid_valid(&ck) ? "valid" : "invalid");
+	return 0;
+}
+/* Simulation entry - END */
@@ -0,0 +1,178 @@
+/*
+ * gps_backend_bench.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Telemetry backends side by side (MZ_gps_backend.h). The same report,
+ *  a fix snapshot of gps_payload_fix(), is uploaded BENCH_UPLOADS
+ *  times through each AT backend against the modem emulator of
+ *  MZ_gps_at.c and through the sink. Prints the AT commands and bytes per
+ *  report and the simulated time one report takes, then a batch of three
+ *  messages on BG96 in one session.
+ *
+ *  The sink writes with mz_puts, which goes to host_cli_file(): the sink
+ *  file, stdout discarded otherwise. A track batch payload longer than a
+ *  log record is also sunk and read back whole.
+ *
+ *  Built on gps_host_qos0, the BG96 backend in its default QoS 0 mode.
+ *
+ *  gps_backend_bench [sink file]
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_gps_backend.h"
+#include "MZ_gps_payload.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define BENCH_UPLOADS				(100)						///< Reports per backend
+#define BENCH_PAYLOAD_SIZE			(GPS_PAYLOAD_BATCH_SIZE(BENCH_LONG_FIXES))	///< Largest payload
+#define BENCH_BATCH					(3)							///< Messages of the batch run
+#define BENCH_LONG_FIXES			(8)							///< Fixes of the long sink payload
+#define BENCH_TOPIC					GPS_PAYLOAD_TOPIC
+#define BENCH_SINK_FILE				"gps_backend_sink.txt"		///< Default sink file
+/* Define some common use MACRO - END */
+
+/* Global Variables - START */
+static char bench_topic[] = BENCH_TOPIC;
+static char bench_payload[GPS_PAYLOAD_FIX_SIZE];
+static char bench_long[BENCH_PAYLOAD_SIZE];
+static st_gps_fix bench_track[BENCH_LONG_FIXES];
+/* Global Variables - END */
+
+/** @fn static void bench_messages(st_gps_fix * fix)
+ * @brief One fix report and a track batch, as MZ_GPSSensor.c builds them
+ */
+static void bench_messages(st_gps_fix * fix)
+{
+	fix->lat_e7 = 356812360;
+	fix->lon_e7 = 1397671250;
+	fix->utc_date = 191026;
+	fix->utc_time = 123456;
+	fix->pdop_x100 = 150;
+	fix->hdop_x100 = 95;
+	fix->vdop_x100 = 120;
+	fix->valid = GPS_FIX_VALID;
+	gps_payload_fix(fix, fix, bench_payload);
+
+	for(uint8_t i = 0; i < BENCH_LONG_FIXES; i++)
+	{
+		bench_track[i] = *fix;
+		bench_track[i].utc_time += i;
+		bench_track[i].lat_e7 += i * 1000;
+	}
+	gps_payload_batch(bench_track, BENCH_LONG_FIXES, bench_long);
+}
+
+/** @fn static int bench_sink_check(const char * path, uint32_t lines, const char * last)
+ * @brief Read the sink file back: line count and the last payload whole
+ */
+static int bench_sink_check(const char * path, uint32_t lines, const char * last)
+{
+	static char line[BENCH_PAYLOAD_SIZE + 64];
+	char expect[BENCH_PAYLOAD_SIZE + 64];
+	FILE * f = fopen(path, "r");
+	uint32_t n = 0;
+	int ok;
+
+	if(f == NULL)
+	{
+		return 0;
+	}
+	while(fgets(line, sizeof(line), f) != NULL)
+	{
+		n++;
+	}
+	fclose(f);
+	snprintf(expect, sizeof(expect), "%s %.*s\r\n", BENCH_TOPIC, (int)(strlen(last) - 1), last);
+	ok = ((n == lines) && (0 == strcmp(line, expect)));
+	printf("sink file %s: %lu lines, last %lu bytes %s\n", path, (unsigned long)n, (unsigned long)strlen(line),
+			ok ? "whole" : "DIFFERENT");
+	return ok;
+}
+
+/*
+ * Benchmark entry - START
+ */
+int main(int argc, char ** argv)
+{
+	static const uint8_t ids[] = { GPS_BACKEND_BG96, GPS_BACKEND_SIM7080, GPS_BACKEND_SINK };
+	const char * path = (argc > 1) ? argv[1] : BENCH_SINK_FILE;
+	st_gps_fix fix = {0};
+	st_gps_backend_msg msg;
+	st_gps_backend_msg batch[BENCH_BATCH];
+	st_gps_backend_stats s0;
+	st_gps_backend_stats s1;
+	FILE * sink;
+	uint32_t t0;
+
+	sink = fopen(path, "w");
+	if(sink == NULL)
+	{
+		fprintf(stderr, "%s: cannot write\n", path);
+		return 1;
+	}
+	bench_messages(&fix);
+	msg.topic = bench_topic;
+	msg.payload = bench_payload;
+	msg.fixes = &fix;
+	msg.n_fixes = 1;
+	host_tick_set(0);
+
+	printf("%-8s %8s %8s %8s %8s %10s\n", "backend", "uploads", "fails", "at cmds", "at B/rep", "ms/rep");
+	for(uint8_t k = 0; k < (sizeof(ids) / sizeof(ids[0])); k++)
+	{
+		host_cli_file((ids[k] == GPS_BACKEND_SINK) ? sink : NULL);
+		if(gps_backend_select(ids[k]) != MZ_OK)
+		{
+			fprintf(stderr, "backend %u not built\n", ids[k]);
+			return 1;
+		}
+		t0 = HAL_GetTick();
+		for(uint32_t r = 0; r < BENCH_UPLOADS; r++)
+		{
+			gps_backend_upload(&msg, 1, HAL_GetTick());
+		}
+		gps_backend_get_stats(ids[k], &s1);
+		printf("%-8s %8lu %8lu %8lu %8lu %10lu\n", gps_backend_get(ids[k])->name, (unsigned long)s1.uploads,
+				(unsigned long)s1.fails, (unsigned long)s1.at_cmds, (unsigned long)(s1.at_bytes / s1.uploads),
+				(unsigned long)((HAL_GetTick() - t0) / BENCH_UPLOADS));
+		if(bench_payload[strlen(bench_payload) - 1] != 26)
+		{
+			fprintf(stderr, "Ctrl-Z not restored\n");
+			return 1;
+		}
+	}
+
+	/* Longer than a log record */
+	msg.payload = bench_long;
+	gps_backend_upload(&msg, 1, HAL_GetTick());
+	fclose(sink);
+	host_cli_file(NULL);
+	if(!bench_sink_check(path, BENCH_UPLOADS + 1, bench_long))
+	{
+		return 1;
+	}
+
+	/* One session for a batch */
+	msg.payload = bench_payload;
+	for(uint8_t i = 0; i < BENCH_BATCH; i++)
+	{
+		batch[i] = msg;
+	}
+	gps_backend_select(GPS_BACKEND_BG96);
+	gps_backend_get_stats(GPS_BACKEND_BG96, &s0);
+	t0 = HAL_GetTick();
+	gps_backend_upload(batch, BENCH_BATCH, t0);
+	gps_backend_get_stats(GPS_BACKEND_BG96, &s1);
+	printf("bg96 batch of %u: %lu at cmds, %lu bytes, %lu ms\n", BENCH_BATCH, (unsigned long)(s1.at_cmds - s0.at_cmds),
+			(unsigned long)(s1.at_bytes - s0.at_bytes), (unsigned long)(HAL_GetTick() - t0));
+	return 0;
+}
+/* Benchmark entry - END */
@@ -0,0 +1,357 @@
+/*
+ * gps_bench.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  NMEA parser benchmark. Receive buffers of generated epochs
+ *  (MZ_gps_nmea_gen.c) go through gps_nmea_parse_buffer() the way
+ *  gps_app_thread hands them over, one epoch per call. Prints the decode
+ *  counters, the wall time per sentence and per byte, and the heap calls
+ *  made while parsing.
+ *
+ *  With a file from gps_tracegen the stream is read back instead, in the
+ *  receive buffers of its .rx list (RX_BUF_SIZE cuts without one), and
+ *  once more through a simulated LPUART1: the bytes are fed to host_uart
+ *  in the same buffers and every full MZ_UART_Receive_IT() buffer is
+ *  parsed from its receive callback, as gps_lpuart1_rx_intr flags it.
+ *
+ *  gps_bench [epochs] [rounds]
+ *  gps_bench <nmea file> [rounds]
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_gps_nmea.h"
+#include "MZ_gps_nmea_gen.h"
+#include "MZ_uart.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define BENCH_EPOCHS				(600)						///< Epochs per stream
+#define BENCH_ROUNDS				(200)						///< Passes over the stream
+#define BENCH_EPOCH_SIZE			(1024)						///< Largest epoch, $GN with GLGSV fits
+#define BENCH_RX_BUF_SIZE			(255)						///< RX_BUF_SIZE of MZ_GPSSensor.c
+/* Define some common use MACRO - END */
+
+/**
+ * @struct st_bench_stream
+ * @brief One receiver output shape
+ */
+typedef struct
+{
+	const char *		name;									/*!< Printed name */
+	uint8_t				rate_hz;								/*!< Epochs per second */
+	uint8_t				sentences;								/*!< GPS_NMEA_GEN_* mask */
+	uint8_t				glonass;								/*!< $GN talker and $GLGSV */
+	uint16_t			corrupt_every;							/*!< Bad checksum every Nth sentence */
+}st_bench_stream;
+
+static const st_bench_stream bench_streams[] =
+{
+	{ "neo6m 1Hz all",		1,	GPS_NMEA_GEN_ALL,								0,	0 },
+	{ "gnss 1Hz all",		1,	GPS_NMEA_GEN_ALL,								1,	0 },
+	{ "10Hz rmc+gga+gsa",	10,	GPS_NMEA_GEN_RMC | GPS_NMEA_GEN_GGA | GPS_NMEA_GEN_GSA,	0,	0 },
+	{ "1Hz all, 1/50 bad",	1,	GPS_NMEA_GEN_ALL,								0,	50 },
+};
+
+/**
+ * @struct st_bench_file
+ * @brief Receiver stream read from a file
+ */
+typedef struct
+{
+	char *				data;									/*!< Whole stream */
+	uint32_t			size;									/*!< Its length */
+	uint16_t *			lens;									/*!< Receive buffer lengths */
+	uint32_t			count;									/*!< Receive buffers */
+}st_bench_file;
+
+/* Global Variables - START */
+static char bench_rx[BENCH_RX_BUF_SIZE];						/* MZ_UART_Receive_IT() buffer */
+static st_gps_fix bench_rx_fix;
+static st_gps_nmea_stats * bench_rx_stats;
+/* Global Variables - END */
+
+/** @fn static uint32_t bench_count_sentences(const char * buf, uint16_t len)
+ * @brief Sentence starts in a buffer
+ */
+static uint32_t bench_count_sentences(const char * buf, uint16_t len)
+{
+	uint32_t n = 0;
+
+	for(uint16_t i = 0; i < len; i++)
+	{
+		n += (buf[i] == '$');
+	}
+	return n;
+}
+
+/** @fn static void bench_stream(const st_bench_stream * bs, uint32_t epochs, uint32_t rounds)
+ * @brief Generate one stream and time its parsing
+ */
+static void bench_stream(const st_bench_stream * bs, uint32_t epochs, uint32_t rounds)
+{
+	st_gps_nmea_gen_cfg cfg =
+	{
+		.lat_e7 = 298653100,
+		.lon_e7 = 778731228,
+		.utc_time = 101902,
+		.utc_date = 300322,
+		.speed_cms = 1400,
+		.course_cdeg = 4500,
+		.turn_cdeg_s = 150,
+		.hdop_x100 = 120,
+		.rate_hz = bs->rate_hz,
+		.sentences = bs->sentences,
+		.glonass = bs->glonass,
+		.corrupt_every = bs->corrupt_every,
+		.hot_s = 1,
+		.warm_s = 1,
+		.cold_s = 1,
+	};
+	static st_gps_nmea_gen gen;
+	char * bufs = malloc((size_t)epochs * BENCH_EPOCH_SIZE);
+	uint16_t * lens = malloc(epochs * sizeof(uint16_t));
+	st_gps_nmea_stats stats = { 0 };
+	st_gps_fix fix = { 0 };
+	uint64_t bytes = 0;
+	uint32_t sentences = 0;
+	uint64_t t0;
+	uint64_t ns;
+
+	if((bufs == NULL) || (lens == NULL))
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+
+	gps_nmea_gen_init(&gen, &cfg);
+	for(uint32_t e = 0; e < epochs; e++)
+	{
+		char * b = &bufs[(size_t)e * BENCH_EPOCH_SIZE];
+
+		lens[e] = gps_nmea_gen_epoch(&gen, b, BENCH_EPOCH_SIZE);
+		bytes += lens[e];
+		sentences += bench_count_sentences(b, lens[e]);
+	}
+
+	/* One counted pass, then timed passes without counters */
+	for(uint32_t e = 0; e < epochs; e++)
+	{
+		gps_nmea_parse_buffer(&bufs[(size_t)e * BENCH_EPOCH_SIZE], lens[e], &fix, &stats);
+	}
+
+	host_alloc_reset();
+	t0 = host_ns();
+	for(uint32_t r = 0; r < rounds; r++)
+	{
+		for(uint32_t e = 0; e < epochs; e++)
+		{
+			gps_nmea_parse_buffer(&bufs[(size_t)e * BENCH_EPOCH_SIZE], lens[e], &fix, NULL);
+		}
+	}
+	ns = host_ns() - t0;
+
+	printf("%-20s %6lu %5lu %7lu %6lu %6lu %7.1f %6.2f %6lu\n",
+			bs->name,
+			(unsigned long)sentences,
+			(unsigned long)(bytes / epochs),
+			(unsigned long)stats.decoded,
+			(unsigned long)stats.other,
+			(unsigned long)stats.invalid,
+			(double)ns / ((double)rounds * sentences),
+			(double)ns / ((double)rounds * bytes),
+			(unsigned long)host_alloc_calls());
+
+	free(bufs);
+	free(lens);
+}
+
+/** @fn static mz_error_t bench_file_open(st_bench_file * bf, const char * path)
+ * @brief Read a stream and its receive buffer list
+ */
+static mz_error_t bench_file_open(st_bench_file * bf, const char * path)
+{
+	char rx_path[256];
+	FILE * f = fopen(path, "rb");
+	uint32_t at = 0;
+	unsigned long len;
+
+	memset(bf, 0, sizeof(*bf));
+	if(f == NULL)
+	{
+		return MZ_FAIL;
+	}
+	fseek(f, 0, SEEK_END);
+	bf->size = (uint32_t)ftell(f);
+	fseek(f, 0, SEEK_SET);
+	bf->data = malloc(bf->size + 1);
+	bf->lens = malloc(((bf->size / BENCH_RX_BUF_SIZE) + 1) * sizeof(uint16_t));
+	if((bf->data == NULL) || (bf->lens == NULL) || (bf->size != fread(bf->data, 1, bf->size, f)))
+	{
+		fclose(f);
+		return MZ_FAIL;
+	}
+	fclose(f);
+
+	/* Buffers of the list, each of them fits the receive buffer */
+	snprintf(rx_path, sizeof(rx_path), "%s.rx", path);
+	f = fopen(rx_path, "r");
+	if(f != NULL)
+	{
+		while((1 == fscanf(f, "%lu", &len)) && ((at + len) <= bf->size))
+		{
+			if((len == 0) || (len > BENCH_RX_BUF_SIZE))
+			{
+				fprintf(stderr, "%s: buffer of %lu bytes, RX_BUF_SIZE is %u\n", rx_path, len, BENCH_RX_BUF_SIZE);
+				fclose(f);
+				return MZ_FAIL;
+			}
+			bf->lens = realloc(bf->lens, (bf->count + 1) * sizeof(uint16_t));
+			bf->lens[bf->count++] = (uint16_t)len;
+			at += len;
+		}
+		fclose(f);
+	}
+
+	/* The rest in full receive buffers */
+	while(at < bf->size)
+	{
+		len = ((bf->size - at) < BENCH_RX_BUF_SIZE) ? (bf->size - at) : BENCH_RX_BUF_SIZE;
+		bf->lens = realloc(bf->lens, (bf->count + 1) * sizeof(uint16_t));
+		bf->lens[bf->count++] = (uint16_t)len;
+		at += len;
+	}
+	return (bf->lens != NULL) ? MZ_OK : MZ_FAIL;
+}
+
+/** @fn static void bench_rx_intr(void * arg)
+ * @brief LPUART1 receive callback, parses the full buffer and arms the next
+ */
+static void bench_rx_intr(void * arg)
+{
+	(void)arg;
+	gps_nmea_parse_buffer(bench_rx, sizeof(bench_rx), &bench_rx_fix, bench_rx_stats);
+	(void)MZ_UART_Receive_IT(_LPUART1, (uint8_t *)bench_rx, sizeof(bench_rx));
+}
+
+/** @fn static void bench_file(const char * path, uint32_t rounds)
+ * @brief Time the parsing of a recorded stream, per receive buffer and
+ * through LPUART1
+ */
+static void bench_file(const char * path, uint32_t rounds)
+{
+	st_bench_file bf;
+	st_gps_nmea_stats stats = { 0 };
+	st_gps_fix fix = { 0 };
+	uint32_t sentences = 0;
+	uint32_t at;
+	uint64_t t0;
+	uint64_t ns;
+
+	if(MZ_OK != bench_file_open(&bf, path))
+	{
+		fprintf(stderr, "%s: cannot read\n", path);
+		exit(1);
+	}
+	for(uint32_t i = 0; i < bf.size; i++)
+	{
+		sentences += (bf.data[i] == '$');
+	}
+	printf("%s: %lu bytes, %lu sentences, %lu receive buffers, %lu rounds\n", path,
+			(unsigned long)bf.size, (unsigned long)sentences, (unsigned long)bf.count, (unsigned long)rounds);
+	printf("%-20s %7s %6s %6s %7s %6s %6s\n", "path", "decoded", "other", "inval", "ns/sen", "ns/B", "allocs");
+
+	/* Every receive buffer as one gps_nmea_parse_buffer() call */
+	at = 0;
+	for(uint32_t i = 0; i < bf.count; at += bf.lens[i++])
+	{
+		gps_nmea_parse_buffer(&bf.data[at], bf.lens[i], &fix, &stats);
+	}
+	host_alloc_reset();
+	t0 = host_ns();
+	for(uint32_t r = 0; r < rounds; r++)
+	{
+		at = 0;
+		for(uint32_t i = 0; i < bf.count; at += bf.lens[i++])
+		{
+			gps_nmea_parse_buffer(&bf.data[at], bf.lens[i], &fix, NULL);
+		}
+	}
+	ns = host_ns() - t0;
+	printf("%-20s %7lu %6lu %6lu %7.1f %6.2f %6lu\n", "receive buffers",
+			(unsigned long)stats.decoded, (unsigned long)stats.other, (unsigned long)stats.invalid,
+			(double)ns / ((double)rounds * sentences), (double)ns / ((double)rounds * bf.size),
+			(unsigned long)host_alloc_calls());
+
+	/* The same buffers fed to LPUART1, a partial last receive stays pending */
+	memset(&stats, 0, sizeof(stats));
+	bench_rx_stats = &stats;
+	(void)MZ_UART_register_intr_cb_rx(_LPUART1, bench_rx_intr);
+	(void)MZ_UART_Receive_IT(_LPUART1, (uint8_t *)bench_rx, sizeof(bench_rx));
+	for(uint32_t r = 0; r <= rounds; r++)
+	{
+		at = 0;
+		for(uint32_t i = 0; i < bf.count; at += bf.lens[i++])
+		{
+			host_uart_feed(_LPUART1, (const uint8_t *)&bf.data[at], bf.lens[i]);
+		}
+		if(r == 0)
+		{
+			/* Counted pass first, then the timed ones */
+			bench_rx_stats = NULL;
+			host_alloc_reset();
+			t0 = host_ns();
+		}
+	}
+	ns = host_ns() - t0;
+	printf("%-20s %7lu %6lu %6lu %7.1f %6.2f %6lu\n", "lpuart1",
+			(unsigned long)stats.decoded, (unsigned long)stats.other, (unsigned long)stats.invalid,
+			(double)ns / ((double)rounds * sentences), (double)ns / ((double)rounds * bf.size),
+			(unsigned long)host_alloc_calls());
+
+	free(bf.data);
+	free(bf.lens);
+}
+
+/*
+ * Benchmark entry - START
+ */
+int main(int argc, char ** argv)
+{
+	char * end = NULL;
+	uint32_t epochs = (argc > 1) ? (uint32_t)strtoul(argv[1], &end, 0) : BENCH_EPOCHS;
+	uint32_t rounds = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : BENCH_ROUNDS;
+
+	if((end != NULL) && (*end != '\0'))
+	{
+		/* Not a number, a recorded stream */
+		if(rounds == 0)
+		{
+			fprintf(stderr, "usage: gps_bench <nmea file> [rounds]\n");
+			return 1;
+		}
+		bench_file(argv[1], rounds);
+		return 0;
+	}
+	if((epochs == 0) || (rounds == 0))
+	{
+		fprintf(stderr, "usage: gps_bench [epochs] [rounds]\n       gps_bench <nmea file> [rounds]\n");
+		return 1;
+	}
+
+	printf("gps_nmea_parse_buffer, %lu epochs x %lu rounds\n", (unsigned long)epochs, (unsigned long)rounds);
+	printf("%-20s %6s %5s %7s %6s %6s %7s %6s %6s\n",
+			"stream", "sent", "B/ep", "decoded", "other", "inval", "ns/sen", "ns/B", "allocs");
+	for(uint32_t i = 0; i < (sizeof(bench_streams) / sizeof(bench_streams[0])); i++)
+	{
+		bench_stream(&bench_streams[i], epochs, rounds);
+	}
+	return 0;
+}
+/* Benchmark entry - END */
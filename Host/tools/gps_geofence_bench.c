@@ -0,0 +1,323 @@
+/*
+ * gps_geofence_bench.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Geofence cost per fix over whole tracks. For each track, sets of
+ *  circles and polygons are scattered over the area it covers and every
+ *  fix goes through gps_geofence_eval() as in gps_fix_commit(). The
+ *  events are checked against a plain floating point test of every fence,
+ *  and the time per fix is given as mean, 99th percentile and maximum.
+ *  gps_geofence_scan is the same tool built with a 1 x 1 grid, i.e. a
+ *  linear scan over all fences, for comparison.
+ *
+ *  gps_geofence_bench [rounds] [track | nmea log ...]
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "host_track.h"
+#include "MZ_gps_geofence.h"
+#include "math.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define BENCH_ROUNDS				(20)						///< Passes over a track for the mean
+#define BENCH_MARGIN_E7				(20000)						///< Fences reach 2 km around the track
+#define BENCH_POLY_MAX_PTS			(24)						///< Largest generated polygon
+#define BENCH_E7_PER_M				(89.832)					///< 1e-7 degree of latitude per metre
+/* Define some common use MACRO - END */
+
+/**
+ * @struct st_bench_fence
+ * @brief Fence as the reference test sees it
+ */
+typedef struct
+{
+	uint16_t			n;										/*!< Vertex count, 0 for a circle */
+	double				lat;									/*!< Circle centre in 1e-7 degree */
+	double				lon;
+	double				r;										/*!< Circle radius in 1e-7 degree of latitude */
+	double				cos_lat;								/*!< Longitude scale at the centre */
+	st_gps_geofence_pt	pt[BENCH_POLY_MAX_PTS];					/*!< Polygon */
+	uint8_t				inside;									/*!< Reference state */
+}st_bench_fence;
+
+static const uint16_t bench_counts[] = { 16, 64, 256 };
+
+/* Global Variables - START */
+static st_bench_fence bench_fence[GPS_GEOFENCE_MAX_FENCES];
+static uint16_t bench_fence_count;
+static uint32_t bench_seed;
+static uint32_t bench_events;
+/* Global Variables - END */
+
+/** @fn static uint32_t bench_rand(uint32_t n)
+ * @brief Repeatable pseudo random number below n
+ */
+static uint32_t bench_rand(uint32_t n)
+{
+	bench_seed = (bench_seed * 1103515245U) + 12345U;
+	return (bench_seed >> 8) % n;
+}
+
+/** @fn static void bench_cb(uint16_t id, en_gps_geofence_event ev)
+ * @brief Event counter
+ */
+static void bench_cb(uint16_t id, en_gps_geofence_event ev)
+{
+	bench_events++;
+}
+
+/** @fn static uint8_t bench_ref_test(const st_bench_fence * f, int32_t lat, int32_t lon)
+ * @brief Floating point point in fence test
+ */
+static uint8_t bench_ref_test(const st_bench_fence * f, int32_t lat, int32_t lon)
+{
+	uint8_t inside = 0;
+
+	if(f->n == 0)
+	{
+		double dlat = lat - f->lat;
+		double dlon = (lon - f->lon) * f->cos_lat;
+
+		return ((dlat * dlat) + (dlon * dlon)) <= (f->r * f->r);
+	}
+	for(uint16_t i = 0, j = f->n - 1; i < f->n; j = i++)
+	{
+		double yi = f->pt[i].lat_e7, xi = f->pt[i].lon_e7;
+		double yj = f->pt[j].lat_e7, xj = f->pt[j].lon_e7;
+
+		if(((yi > lat) != (yj > lat)) && (lon < (((xj - xi) * (lat - yi)) / (yj - yi)) + xi))
+		{
+			inside ^= 1;
+		}
+	}
+	return inside;
+}
+
+/** @fn static void bench_fences(const st_host_track * track, uint16_t count)
+ * @brief Scatter circles and polygons over the area of a track, sized so
+ * that together they cover about the area once
+ */
+static void bench_fences(const st_host_track * track, uint16_t count)
+{
+	int32_t min_lat = track->fix[0].lat_e7, max_lat = min_lat;
+	int32_t min_lon = track->fix[0].lon_e7, max_lon = min_lon;
+	uint32_t vertices = 0;
+	double cos_lat;
+	double r_m;
+
+	for(uint32_t i = 1; i < track->count; i++)
+	{
+		if(track->fix[i].lat_e7 < min_lat) min_lat = track->fix[i].lat_e7;
+		if(track->fix[i].lat_e7 > max_lat) max_lat = track->fix[i].lat_e7;
+		if(track->fix[i].lon_e7 < min_lon) min_lon = track->fix[i].lon_e7;
+		if(track->fix[i].lon_e7 > max_lon) max_lon = track->fix[i].lon_e7;
+	}
+	min_lat -= BENCH_MARGIN_E7;
+	max_lat += BENCH_MARGIN_E7;
+	min_lon -= BENCH_MARGIN_E7;
+	max_lon += BENCH_MARGIN_E7;
+	cos_lat = cos(min_lat * 1e-7 * M_PI / 180.0);
+	r_m = sqrt((((max_lat - min_lat) / BENCH_E7_PER_M) * (((max_lon - min_lon) * cos_lat) / BENCH_E7_PER_M)) / (M_PI * count));
+
+	bench_seed = count;
+	bench_fence_count = 0;
+	gps_geofence_reset();
+	for(uint16_t id = 0; id < count; id++)
+	{
+		st_bench_fence * f = &bench_fence[bench_fence_count];
+		int32_t lat = min_lat + (int32_t)bench_rand((uint32_t)(max_lat - min_lat));
+		int32_t lon = min_lon + (int32_t)bench_rand((uint32_t)(max_lon - min_lon));
+
+		memset(f, 0, sizeof(*f));
+		f->cos_lat = cos(lat * 1e-7 * M_PI / 180.0);
+		if((bench_rand(3) != 0) || ((vertices + BENCH_POLY_MAX_PTS) > GPS_GEOFENCE_MAX_VERTICES))
+		{
+			uint32_t radius_m = (uint32_t)(r_m * (50 + bench_rand(100))) / 100;
+
+			if(MZ_OK != gps_geofence_add_circle(id, lat, lon, radius_m))
+			{
+				continue;
+			}
+			f->lat = lat;
+			f->lon = lon;
+			f->r = floor(radius_m * BENCH_E7_PER_M);
+		}
+		else
+		{
+			/* Star shaped, a random radius on every spoke */
+			f->n = 4 + (uint16_t)bench_rand(BENCH_POLY_MAX_PTS - 3);
+			for(uint16_t k = 0; k < f->n; k++)
+			{
+				double a = (2.0 * M_PI * k) / f->n;
+				double r = (r_m * (50 + bench_rand(100)) * BENCH_E7_PER_M) / 100;
+
+				f->pt[k].lat_e7 = lat + (int32_t)(r * cos(a));
+				f->pt[k].lon_e7 = lon + (int32_t)((r * sin(a)) / f->cos_lat);
+			}
+			if(MZ_OK != gps_geofence_add_polygon(id, f->pt, f->n))
+			{
+				continue;
+			}
+			vertices += f->n;
+		}
+		bench_fence_count++;
+	}
+}
+
+/** @fn static int bench_cmp(const void * a, const void * b)
+ * @brief qsort order of the per fix times
+ */
+static int bench_cmp(const void * a, const void * b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/** @fn static void bench_run(const st_host_track * track, uint16_t count, uint32_t rounds)
+ * @brief Evaluate a track against one fence set
+ */
+static void bench_run(const st_host_track * track, uint16_t count, uint32_t rounds)
+{
+	uint32_t * ns = malloc(track->count * sizeof(uint32_t));
+	uint32_t ref_events = 0;
+	uint32_t events;
+	uint8_t max_inside = 0;
+	uint64_t t0;
+	uint64_t total;
+
+	if(ns == NULL)
+	{
+		exit(1);
+	}
+	bench_fences(track, count);
+
+	/* Events against the reference */
+	bench_events = 0;
+	if(MZ_OK != gps_geofence_build())
+	{
+		printf("%-10s %5u build failed\n", track->name, count);
+		free(ns);
+		return;
+	}
+	for(uint32_t i = 0; i < track->count; i++)
+	{
+		uint8_t inside = 0;
+
+		gps_geofence_eval(track->fix[i].lat_e7, track->fix[i].lon_e7, bench_cb);
+		for(uint16_t k = 0; k < bench_fence_count; k++)
+		{
+			uint8_t in = bench_ref_test(&bench_fence[k], track->fix[i].lat_e7, track->fix[i].lon_e7);
+
+			ref_events += (in != bench_fence[k].inside);
+			bench_fence[k].inside = in;
+			inside += in;
+		}
+		if(inside > max_inside)
+		{
+			max_inside = inside;
+		}
+	}
+	events = bench_events;
+
+	/* Time of every fix, the best of all rounds */
+	for(uint32_t i = 0; i < track->count; i++)
+	{
+		ns[i] = UINT32_MAX;
+	}
+	for(uint32_t r = 0; r < rounds; r++)
+	{
+		gps_geofence_build();
+		for(uint32_t i = 0; i < track->count; i++)
+		{
+			uint32_t dt;
+
+			t0 = host_ns();
+			gps_geofence_eval(track->fix[i].lat_e7, track->fix[i].lon_e7, bench_cb);
+			dt = (uint32_t)(host_ns() - t0);
+			if(dt < ns[i])
+			{
+				ns[i] = dt;
+			}
+		}
+	}
+
+	/* Mean without the clock in the loop */
+	gps_geofence_build();
+	t0 = host_ns();
+	for(uint32_t r = 0; r < rounds; r++)
+	{
+		for(uint32_t i = 0; i < track->count; i++)
+		{
+			gps_geofence_eval(track->fix[i].lat_e7, track->fix[i].lon_e7, bench_cb);
+		}
+	}
+	total = host_ns() - t0;
+
+	qsort(ns, track->count, sizeof(uint32_t), bench_cmp);
+	printf("%-10s %6lu %5u %6u %6lu %6lu %3u %6.1f %6lu %6lu\n",
+			track->name,
+			(unsigned long)track->count,
+			GPS_GEOFENCE_GRID_DIM,
+			bench_fence_count,
+			(unsigned long)events,
+			(unsigned long)ref_events,
+			max_inside,
+			(double)total / ((double)rounds * track->count),
+			(unsigned long)ns[(track->count * 99U) / 100U],
+			(unsigned long)ns[track->count - 1]);
+	free(ns);
+}
+
+/*
+ * Benchmark entry - START
+ */
+int main(int argc, char ** argv)
+{
+	uint32_t rounds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_ROUNDS;
+	int first = 2;
+	int last = argc;
+
+	if(rounds == 0)
+	{
+		fprintf(stderr, "usage: gps_geofence_bench [rounds] [track | nmea log ...]\n");
+		return 1;
+	}
+
+	printf("Geofence per fix, %ux%u grid, best of %lu rounds for p99/max\n",
+			GPS_GEOFENCE_GRID_DIM, GPS_GEOFENCE_GRID_DIM, (unsigned long)rounds);
+	printf("%-10s %6s %5s %6s %6s %6s %3s %6s %6s %6s\n",
+			"track", "fixes", "grid", "fences", "events", "ref", "in", "ns", "p99", "max");
+	if(argc <= 2)
+	{
+		first = 0;
+		last = host_track_script_count;
+	}
+	for(int a = first; a < last; a++)
+	{
+		st_host_track track;
+		const char * spec = (argc <= 2) ? host_track_scripts[a].name : argv[a];
+
+		if(MZ_OK != host_track_open(&track, spec))
+		{
+			fprintf(stderr, "%s: no track\n", spec);
+			return 1;
+		}
+		for(uint8_t c = 0; c < (sizeof(bench_counts) / sizeof(bench_counts[0])); c++)
+		{
+			bench_run(&track, bench_counts[c], rounds);
+		}
+		host_track_free(&track);
+	}
+	return 0;
+}
+/* Benchmark entry - END */
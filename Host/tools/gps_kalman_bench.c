@@ -0,0 +1,248 @@
+/*
+ * gps_kalman_bench.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Kalman filter harness. The fixes of a track are the truth. Receiver
+ *  noise is added to every fix and the noisy fix goes through
+ *  gps_kalman_update() as in gps_fix_commit(). The result is the RMS and
+ *  the largest distance from the truth, for the raw and for the filtered
+ *  position, and the time per update.
+ *
+ *  Two noise models, both with a 1 sigma of GPS_KALMAN_UERE_CM x HDOP per
+ *  axis: white noise, which is what the filter assumes, and a first order
+ *  Gauss-Markov process with a correlation time of BENCH_GM_TAU_S, which
+ *  is closer to a real receiver at rest. The speed and course of the fix
+ *  get white noise of BENCH_VEL_CMS per axis in both models, the Doppler
+ *  velocity of a receiver is not correlated with its position error.
+ *
+ *  gps_kalman_bench [rounds] [track | nmea log ...]
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "host_track.h"
+#include "MZ_gps_kalman.h"
+#include "math.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define BENCH_ROUNDS				(20)						///< Passes over a track for the timing
+#define BENCH_GM_TAU_S				(30.0)						///< Correlation time of the Gauss-Markov noise
+#define BENCH_VEL_CMS				(10.0)						///< Receiver velocity noise per axis, 1 sigma
+/* Define some common use MACRO - END */
+
+/**
+ * @enum en_bench_noise
+ * @brief Noise added to the truth
+ */
+typedef enum
+{
+	BENCH_NOISE_WHITE = 0,										/*!< Independent per fix */
+	BENCH_NOISE_GM,												/*!< First order Gauss-Markov */
+	BENCH_NOISE_COUNT,
+}en_bench_noise;
+
+static const char * const bench_noise_name[BENCH_NOISE_COUNT] = { "white", "gm30s" };
+
+/* Global Variables - START */
+static uint64_t bench_seed;
+/* Global Variables - END */
+
+/** @fn static double bench_gauss(void)
+ * @brief Repeatable standard normal sample
+ */
+static double bench_gauss(void)
+{
+	double u1;
+	double u2;
+
+	bench_seed = (bench_seed * 6364136223846793005ULL) + 1442695040888963407ULL;
+	u1 = ((bench_seed >> 11) + 1.0) / 9007199254740993.0;
+	bench_seed = (bench_seed * 6364136223846793005ULL) + 1442695040888963407ULL;
+	u2 = (bench_seed >> 11) / 9007199254740992.0;
+	return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+/** @fn static uint64_t bench_cycles(void)
+ * @brief Time stamp counter where the host has one. The builtin, because
+ * the intrinsic headers clash with the CMSIS __I / __O macros.
+ */
+static uint64_t bench_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __builtin_ia32_rdtsc();
+#else
+	return 0;
+#endif
+}
+
+/** @fn static void bench_noisy_vel(st_gps_fix * fix)
+ * @brief Speed and course with velocity noise, as $GPRMC carries them
+ */
+static void bench_noisy_vel(st_gps_fix * fix)
+{
+	double c = fix->course_cdeg * M_PI / 18000.0;
+	double ve = (fix->speed_cms * sin(c)) + (BENCH_VEL_CMS * bench_gauss());
+	double vn = (fix->speed_cms * cos(c)) + (BENCH_VEL_CMS * bench_gauss());
+	long cdeg = lrint(atan2(ve, vn) * 18000.0 / M_PI);
+
+	fix->speed_cms = (uint16_t)lrint(hypot(ve, vn));
+	fix->course_cdeg = (uint16_t)((cdeg < 0) ? (cdeg + 36000) : cdeg);
+}
+
+/** @fn static void bench_noisy(const st_host_track * track, en_bench_noise noise, st_gps_fix * out)
+ * @brief Copy of a track with receiver noise
+ */
+static void bench_noisy(const st_host_track * track, en_bench_noise noise, st_gps_fix * out)
+{
+	double ne = 0;
+	double nn = 0;
+
+	bench_seed = 1 + noise;
+	for(uint32_t i = 0; i < track->count; i++)
+	{
+		double sigma = (double)GPS_KALMAN_UERE_CM * track->fix[i].hdop_x100 / 100.0;
+
+		if(noise == BENCH_NOISE_WHITE)
+		{
+			ne = sigma * bench_gauss();
+			nn = sigma * bench_gauss();
+		}
+		else
+		{
+			double dt = (i == 0) ? 1e9 : (track->fix[i].tick - track->fix[i - 1].tick) / 1000.0;
+			double a = exp(-dt / BENCH_GM_TAU_S);
+			double q = sigma * sqrt(1.0 - (a * a));
+
+			ne = (a * ne) + (q * bench_gauss());
+			nn = (a * nn) + (q * bench_gauss());
+		}
+		out[i] = track->fix[i];
+		gps_fix_offset_apply(track->fix[i].lat_e7, track->fix[i].lon_e7, (int32_t)lrint(ne), (int32_t)lrint(nn),
+							 &out[i].lat_e7, &out[i].lon_e7);
+		bench_noisy_vel(&out[i]);
+	}
+}
+
+/** @fn static double bench_dist_cm(const st_gps_fix * a, const st_gps_fix * b)
+ * @brief Distance of two fixes
+ */
+static double bench_dist_cm(const st_gps_fix * a, const st_gps_fix * b)
+{
+	int32_t e;
+	int32_t n;
+
+	gps_fix_offset_cm(a->lat_e7, a->lon_e7, b->lat_e7, b->lon_e7, &e, &n);
+	return hypot(e, n);
+}
+
+/** @fn static void bench_run(const st_host_track * track, en_bench_noise noise, uint32_t rounds)
+ * @brief Filter a noisy copy of a track
+ */
+static void bench_run(const st_host_track * track, en_bench_noise noise, uint32_t rounds)
+{
+	st_gps_fix * in = malloc(track->count * sizeof(st_gps_fix));
+	st_gps_kalman kf;
+	double raw2 = 0;
+	double kf2 = 0;
+	double raw_max = 0;
+	double kf_max = 0;
+	uint64_t ns;
+	uint64_t cycles;
+
+	if(in == NULL)
+	{
+		exit(1);
+	}
+	bench_noisy(track, noise, in);
+
+	gps_kalman_init(&kf);
+	for(uint32_t i = 0; i < track->count; i++)
+	{
+		st_gps_fix f = in[i];
+		double raw = bench_dist_cm(&track->fix[i], &in[i]);
+		double est;
+
+		gps_kalman_update(&kf, &f);
+		est = bench_dist_cm(&track->fix[i], &f);
+		raw2 += raw * raw;
+		kf2 += est * est;
+		raw_max = (raw > raw_max) ? raw : raw_max;
+		kf_max = (est > kf_max) ? est : kf_max;
+	}
+
+	/* Time per update, the filter runs on copies so every round is the same */
+	ns = host_ns();
+	cycles = bench_cycles();
+	for(uint32_t r = 0; r < rounds; r++)
+	{
+		st_gps_kalman t;
+
+		gps_kalman_init(&t);
+		for(uint32_t i = 0; i < track->count; i++)
+		{
+			st_gps_fix f = in[i];
+
+			gps_kalman_update(&t, &f);
+		}
+	}
+	cycles = bench_cycles() - cycles;
+	ns = host_ns() - ns;
+
+	printf("%-10s %-6s %6lu %7.2f %7.2f %7.2f %7.2f %6lu %6.1f %6.0f\n",
+			track->name,
+			bench_noise_name[noise],
+			(unsigned long)track->count,
+			sqrt(raw2 / track->count) / 100.0,
+			sqrt(kf2 / track->count) / 100.0,
+			raw_max / 100.0,
+			kf_max / 100.0,
+			(unsigned long)kf.resets,
+			(double)ns / ((double)rounds * track->count),
+			(double)cycles / ((double)rounds * track->count));
+	free(in);
+}
+
+/*
+ * Benchmark entry - START
+ */
+int main(int argc, char ** argv)
+{
+	uint32_t rounds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_ROUNDS;
+	int count = (argc > 2) ? (argc - 2) : host_track_script_count;
+
+	if(rounds == 0)
+	{
+		fprintf(stderr, "usage: gps_kalman_bench [rounds] [track | nmea log ...]\n");
+		return 1;
+	}
+
+	printf("Kalman filter, UERE %u cm, velocity %u cm/s, accel %u cm/s^2, gate %u cm; distances in m, tsc in host cycles\n",
+			GPS_KALMAN_UERE_CM, GPS_KALMAN_VEL_CMS, GPS_KALMAN_ACCEL_CMS2, GPS_KALMAN_GATE_CM);
+	printf("%-10s %-6s %6s %7s %7s %7s %7s %6s %6s %6s\n",
+			"track", "noise", "fixes", "raw_rms", "kf_rms", "raw_max", "kf_max", "resets", "ns", "tsc");
+	for(int a = 0; a < count; a++)
+	{
+		st_host_track track;
+		const char * spec = (argc > 2) ? argv[a + 2] : host_track_scripts[a].name;
+
+		if(MZ_OK != host_track_open(&track, spec))
+		{
+			fprintf(stderr, "%s: no track\n", spec);
+			return 1;
+		}
+		for(uint8_t n = 0; n < BENCH_NOISE_COUNT; n++)
+		{
+			bench_run(&track, (en_bench_noise)n, rounds);
+		}
+		host_track_free(&track);
+	}
+	return 0;
+}
+/* Benchmark entry - END */
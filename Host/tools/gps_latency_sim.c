@@ -0,0 +1,202 @@
+/*
+ * gps_latency_sim.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  End to end latency report (MZ_gps_latency.h) of a 1 Hz receiver and a
+ *  report every SIM_REPORT_S, in simulated time. Each generated epoch
+ *  goes byte by byte into the LPUART1 ring at 9600 baud, stamped with its
+ *  first byte as the ring interrupt does. The thread pass stands in for
+ *  gps_app_thread(): the complete bursts are parsed, a new epoch is
+ *  stamped valid and committed, and when a report is due the snapshot of
+ *  gps_payload_fix() is built and uploaded through the backend against
+ *  the modem emulator. The publish command stamps the submit stage in
+ *  gps_at_cmd(), the modem OK of the upload acknowledges the epoch. A
+ *  burst that completes while the upload blocks waits in the ring.
+ *
+ *  The target time of parsing and committing is not modelled, those
+ *  stages show the scheduling only. Prints gps_latency_dump().
+ *
+ *  Built on gps_host_qos0, the BG96 backend in its default QoS 0 mode.
+ *
+ *  gps_latency_sim [backend] [epochs]
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_gps_backend.h"
+#include "MZ_gps_latency.h"
+#include "MZ_gps_lpuart.h"
+#include "MZ_gps_nmea.h"
+#include "MZ_gps_nmea_gen.h"
+#include "MZ_gps_payload.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define SIM_EPOCHS					(3600)						///< Default number of epochs, 1 h
+#define SIM_EPOCH_SIZE				(2048)						///< Largest generated epoch
+#define SIM_CHUNK_SIZE				(255)						///< rx1_char of the GPS thread
+#define SIM_BAUD					(9600)						///< NMEA line rate
+#define SIM_BITS					(10)						///< Start, 8 data, stop
+#define SIM_IDLE_MS					(2)							///< Idle line detection after the last byte
+#define SIM_REPORT_S				(10)						///< Seconds between reports
+/* Define some common use MACRO - END */
+
+/* Global Variables - START */
+static char sim_epoch[SIM_EPOCH_SIZE];
+static char sim_payload[GPS_PAYLOAD_FIX_SIZE];
+static char sim_topic[] = GPS_PAYLOAD_TOPIC;
+static st_gps_fix sim_fix;
+static st_gps_nmea_stats sim_nmea;
+static uint32_t sim_last_commit = 0xFFFFFFFF;
+static uint32_t sim_reports;
+static uint32_t sim_acked;
+/* Global Variables - END */
+
+/** @fn static int sim_out(const char * s)
+ * @brief Dump output to stdout
+ */
+static int sim_out(const char * s)
+{
+	return fputs(s, stdout);
+}
+
+/** @fn static uint32_t sim_burst_ms(uint16_t n)
+ * @brief Time from the first byte of a burst to its idle line
+ */
+static uint32_t sim_burst_ms(uint16_t n)
+{
+	return (((uint32_t)n * SIM_BITS * 1000) / SIM_BAUD) + SIM_IDLE_MS;
+}
+
+/** @fn static void sim_receive(uint32_t first, uint16_t n)
+ * @brief One burst into the ring, as the LPUART1 interrupt takes it
+ */
+static void sim_receive(uint32_t first, uint16_t n)
+{
+	gps_latency_rx(first);
+	for(uint16_t i = 0; i < n; i++)
+	{
+		gps_lpuart_rx_byte((uint8_t)sim_epoch[i]);
+	}
+	(void)gps_lpuart_rx_idle();
+}
+
+/** @fn static void sim_thread_pass(uint32_t second)
+ * @brief Parse, commit and report as gps_app_thread() does
+ */
+static void sim_thread_pass(uint32_t second)
+{
+	char chunk[SIM_CHUNK_SIZE];
+	st_gps_backend_msg msg;
+	uint16_t len;
+
+	while((len = gps_lpuart_read(chunk, sizeof(chunk))) != 0)
+	{
+		gps_nmea_parse_buffer(chunk, len, &sim_fix, &sim_nmea);
+	}
+	if((sim_fix.valid != GPS_FIX_VALID) || (sim_fix.utc_time == sim_last_commit))
+	{
+		return;
+	}
+	sim_fix.tick = HAL_GetTick();
+	sim_last_commit = sim_fix.utc_time;
+	gps_latency_mark(GPS_LAT_VALID, sim_fix.tick);
+	gps_latency_mark(GPS_LAT_COMMIT, HAL_GetTick());
+
+	if((second % SIM_REPORT_S) != 0)
+	{
+		return;
+	}
+	gps_payload_fix(&sim_fix, &sim_fix, sim_payload);
+	gps_latency_mark(GPS_LAT_PAYLOAD, HAL_GetTick());
+	msg.topic = sim_topic;
+	msg.payload = sim_payload;
+	msg.fixes = &sim_fix;
+	msg.n_fixes = 1;
+	sim_reports++;
+	if(MZ_OK == gps_backend_upload(&msg, 1, HAL_GetTick()))
+	{
+		sim_acked++;
+		gps_latency_ack(HAL_GetTick());
+	}
+}
+
+/*
+ * Simulation entry - START
+ */
+int main(int argc, char ** argv)
+{
+	st_gps_nmea_gen_cfg cfg =
+	{
+		.lat_e7 = 356812360, .lon_e7 = 1397671250, .utc_time = 120000, .utc_date = 191026,
+		.speed_cms = 1200, .course_cdeg = 9000, .turn_cdeg_s = 50, .hdop_x100 = 95,
+		.rate_hz = 1, .sentences = GPS_NMEA_GEN_ALL,
+	};
+	const char * name = (argc > 1) ? argv[1] : "bg96";
+	uint32_t epochs = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : SIM_EPOCHS;
+	st_gps_nmea_gen gen;
+	uint8_t id;
+	uint32_t next = 0;
+	uint32_t e = 0;
+	uint16_t n;
+
+	for(id = 0; id < GPS_BACKENDS; id++)
+	{
+		if((gps_backend_get(id) != NULL) && (0 == strcmp(gps_backend_get(id)->name, name)))
+		{
+			break;
+		}
+	}
+	if((id == GPS_BACKENDS) || (epochs == 0))
+	{
+		fprintf(stderr, "usage: gps_latency_sim [bg96|sim7080|udp|sink] [epochs]\n");
+		return 1;
+	}
+	host_tick_set(0);
+	host_cli_file(NULL);
+	if(gps_backend_select(id) != MZ_OK)
+	{
+		fprintf(stderr, "backend %s not built\n", name);
+		return 1;
+	}
+	gps_nmea_gen_init(&gen, &cfg);
+	n = gps_nmea_gen_epoch(&gen, sim_epoch, sizeof(sim_epoch));
+	while(e < epochs)
+	{
+		uint8_t got = 0;
+
+		/* Every burst complete by now, waiting for the next one otherwise */
+		while(e < epochs)
+		{
+			uint32_t end = next + sim_burst_ms(n);
+
+			if((int32_t)(HAL_GetTick() - end) < 0)
+			{
+				if(got)
+				{
+					break;
+				}
+				host_tick_set(end);
+			}
+			sim_receive(next, n);
+			got = 1;
+			e++;
+			next += 1000;
+			n = gps_nmea_gen_epoch(&gen, sim_epoch, sizeof(sim_epoch));
+		}
+		sim_thread_pass(e);
+	}
+
+	printf("%s: %lu epochs, %u B per burst, %lu ms on the line, report every %u s: %lu reports, %lu acknowledged\n",
+			name, (unsigned long)epochs, n, (unsigned long)sim_burst_ms(n), SIM_REPORT_S,
+			(unsigned long)sim_reports, (unsigned long)sim_acked);
+	gps_latency_dump(sim_out);
+	return 0;
+}
+/* Simulation entry - END */
@@ -0,0 +1,274 @@
+/*
+ * gps_log_bench.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Deferred CLI logging harness (MZ_gps_log.h). The CLI UART is modelled
+ *  as BENCH_UART_BAUD 8N1, an output function that takes the line time:
+ *
+ *  - caller : gps_log_bench(), the time a thread spends on one line
+ *    written with the blocking UART model and with gps_log().
+ *  - burst : N lines logged at once, drained every GPS_LOG_DRAIN_MS of
+ *    simulated time as gps_log_thread() does. Prints the lines dropped,
+ *    the time until the ring is empty and the longest drain pass, the
+ *    time the drain thread is blocked in the UART.
+ *  - threads : producer threads logging numbered lines with gps_log()
+ *    and gps_log_printf() while a drain thread writes them out, each
+ *    producer yields after BENCH_YIELD_EVERY lines. Every line must come
+ *    out once and in the order of its producer, the lines missing must be
+ *    the drops the logger counted.
+ *
+ *  gps_log_bench [producers]
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_gps_log.h"
+#include "MZ_gps_prof.h"
+#include "pthread.h"
+#include "sched.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define BENCH_UART_BAUD				(115200)					///< CLI UART model
+#define BENCH_UART_BITS				(10)						///< Start, 8 data, stop
+#define BENCH_PRODUCERS				(4)							///< Default producer threads
+#define BENCH_PRODUCERS_MAX			(16)						///< Most producer threads
+#define BENCH_LINES					(200000)					///< Lines per producer
+#define BENCH_YIELD_EVERY			(8)							///< Producer lines between yields
+#define BENCH_LINE					"gps: lat 35.6812360 lon 139.7671250 hdop 0.95\r\n"	///< Typical line
+/* Define some common use MACRO - END */
+
+static const uint16_t bench_bursts[] = { 16, GPS_LOG_SLOTS, 2 * GPS_LOG_SLOTS };
+
+/* Global Variables - START */
+static uint64_t bench_uart_us;
+static uint32_t bench_next[BENCH_PRODUCERS_MAX];
+static uint32_t bench_gaps;
+static uint32_t bench_order;
+static uint32_t bench_lines_out;
+static volatile int bench_stop;
+/* Global Variables - END */
+
+/** @fn static uint64_t bench_line_us(const char * s)
+ * @brief Time of a string on the UART model
+ */
+static uint64_t bench_line_us(const char * s)
+{
+	return ((uint64_t)strlen(s) * BENCH_UART_BITS * 1000000ULL) / BENCH_UART_BAUD;
+}
+
+/** @fn static int bench_uart_wall(const char * s)
+ * @brief Blocking UART, spins for the line time
+ */
+static int bench_uart_wall(const char * s)
+{
+	uint64_t end = host_ns() + (bench_line_us(s) * 1000ULL);
+
+	while(host_ns() < end)
+	{
+	}
+	return 1;
+}
+
+/** @fn static int bench_uart_sim(const char * s)
+ * @brief Blocking UART, the line time in simulated microseconds
+ */
+static int bench_uart_sim(const char * s)
+{
+	bench_uart_us += bench_line_us(s);
+	return 1;
+}
+
+/** @fn static void bench_caller(void)
+ * @brief Caller side cost of one line
+ */
+static void bench_caller(void)
+{
+	uint32_t direct;
+	uint32_t queued;
+
+	gps_log_init();
+	gps_log_bench(bench_uart_wall, &direct, &queued);
+	printf("caller: %u B line, UART %lu %s, gps_log %lu %s\n", (unsigned)strlen(BENCH_LINE),
+			(unsigned long)direct, GPS_PROF_UNIT, (unsigned long)queued, GPS_PROF_UNIT);
+	printf("        UART sustains %lu lines/s of this length\n",
+			(unsigned long)(1000000ULL / bench_line_us(BENCH_LINE)));
+}
+
+/** @fn static void bench_burst(uint16_t lines)
+ * @brief Lines logged at once, drained as by gps_log_thread()
+ */
+static void bench_burst(uint16_t lines)
+{
+	st_gps_log_stats s;
+	uint64_t now_us = 0;
+	uint64_t pass_max = 0;
+	uint32_t passes = 0;
+
+	gps_log_init();
+	for(uint16_t i = 0; i < lines; i++)
+	{
+		(void)gps_log(BENCH_LINE);
+	}
+	for(;;)
+	{
+		uint64_t start = bench_uart_us;
+		uint16_t n = gps_log_drain(bench_uart_sim, GPS_LOG_SLOTS);
+		uint64_t pass = bench_uart_us - start;
+
+		pass_max = (pass > pass_max) ? pass : pass_max;
+		now_us += pass;
+		if(n == 0)
+		{
+			break;
+		}
+		passes++;
+		now_us += GPS_LOG_DRAIN_MS * 1000ULL;
+	}
+	gps_log_get_stats(&s);
+	printf("burst %3u: dropped %3lu, drained %3lu in %lu passes, empty after %.1f ms, longest pass %.1f ms\n",
+			lines, (unsigned long)s.dropped, (unsigned long)s.drained, (unsigned long)passes,
+			now_us / 1000.0, pass_max / 1000.0);
+}
+
+/** @fn static int bench_check_out(const char * s)
+ * @brief Drain output of the threads run, checks the numbering
+ */
+static int bench_check_out(const char * s)
+{
+	unsigned p;
+	unsigned long n;
+
+	if(sscanf(s, "p%u n%lu", &p, &n) != 2)
+	{
+		/* "log: N records dropped" */
+		return 1;
+	}
+	bench_lines_out++;
+	if((p >= BENCH_PRODUCERS_MAX) || (n < bench_next[p]))
+	{
+		bench_order++;
+		return 1;
+	}
+	bench_gaps += (uint32_t)(n - bench_next[p]);
+	bench_next[p] = (uint32_t)n + 1;
+	return 1;
+}
+
+/** @fn static void * bench_producer(void * arg)
+ * @brief Numbered lines, every other one formatted in the slot
+ */
+static void * bench_producer(void * arg)
+{
+	unsigned p = (unsigned)(uintptr_t)arg;
+	char line[GPS_LOG_LINE_SIZE];
+
+	for(uint32_t n = 0; n < BENCH_LINES; n++)
+	{
+		if(n & 1)
+		{
+			(void)gps_log_printf("p%u n%lu\r\n", p, (unsigned long)n);
+		}
+		else
+		{
+			snprintf(line, sizeof(line), "p%u n%lu\r\n", p, (unsigned long)n);
+			(void)gps_log(line);
+		}
+		if((n % BENCH_YIELD_EVERY) == (BENCH_YIELD_EVERY - 1))
+		{
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+/** @fn static void * bench_drain(void * arg)
+ * @brief Drain thread, until the producers are done and the ring is empty
+ */
+static void * bench_drain(void * arg)
+{
+	for(;;)
+	{
+		int stop = bench_stop;
+
+		if((gps_log_drain(bench_check_out, GPS_LOG_SLOTS) == 0) && stop)
+		{
+			break;
+		}
+		sched_yield();
+	}
+	return NULL;
+}
+
+/** @fn static int bench_threads(unsigned producers)
+ * @brief Producers and a drain thread at once
+ */
+static int bench_threads(unsigned producers)
+{
+	pthread_t prod[BENCH_PRODUCERS_MAX];
+	pthread_t drain;
+	st_gps_log_stats s;
+	uint64_t t0;
+	uint64_t total = (uint64_t)producers * BENCH_LINES;
+	int ok;
+
+	gps_log_init();
+	memset(bench_next, 0, sizeof(bench_next));
+	bench_stop = 0;
+	t0 = host_ns();
+	pthread_create(&drain, NULL, bench_drain, NULL);
+	for(unsigned p = 0; p < producers; p++)
+	{
+		pthread_create(&prod[p], NULL, bench_producer, (void *)(uintptr_t)p);
+	}
+	for(unsigned p = 0; p < producers; p++)
+	{
+		pthread_join(prod[p], NULL);
+	}
+	bench_stop = 1;
+	pthread_join(drain, NULL);
+	t0 = host_ns() - t0;
+
+	/* Lines lost at the end of a producer are gaps too */
+	for(unsigned p = 0; p < producers; p++)
+	{
+		bench_gaps += BENCH_LINES - bench_next[p];
+	}
+	gps_log_get_stats(&s);
+	ok = (bench_order == 0) && (bench_gaps == s.dropped) && (bench_lines_out == s.logged) &&
+			((s.logged + s.dropped) == total);
+	printf("threads: %u x %lu lines, logged %lu, dropped %lu, written %lu, missing %lu, out of order %lu, %.0f ns/line, %s\n",
+			producers, (unsigned long)BENCH_LINES, (unsigned long)s.logged, (unsigned long)s.dropped,
+			(unsigned long)bench_lines_out, (unsigned long)bench_gaps, (unsigned long)bench_order,
+			(double)t0 / total, ok ? "consistent" : "INCONSISTENT");
+	return ok;
+}
+
+/*
+ * Benchmark entry - START
+ */
+int main(int argc, char ** argv)
+{
+	unsigned producers = (argc > 1) ? (unsigned)strtoul(argv[1], NULL, 0) : BENCH_PRODUCERS;
+
+	if((producers == 0) || (producers > BENCH_PRODUCERS_MAX))
+	{
+		fprintf(stderr, "usage: gps_log_bench [producers 1..%u]\n", BENCH_PRODUCERS_MAX);
+		return 1;
+	}
+	printf("Deferred log, %u slots of %u B, drain every %u ms, UART %u baud\n",
+			GPS_LOG_SLOTS, GPS_LOG_LINE_SIZE, GPS_LOG_DRAIN_MS, BENCH_UART_BAUD);
+	bench_caller();
+	for(uint8_t b = 0; b < (sizeof(bench_bursts) / sizeof(bench_bursts[0])); b++)
+	{
+		bench_burst(bench_bursts[b]);
+	}
+	return bench_threads(producers) ? 0 : 1;
+}
+/* Benchmark entry - END */
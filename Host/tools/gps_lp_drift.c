@@ -0,0 +1,107 @@
+/*
+ * gps_lp_drift.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Drift harness of the STOP2 tick conversion (MZ_gps_lowpower.h). Runs
+ *  sleeps through gps_lp_clock_enter() and gps_lp_clock_ticks() the way
+ *  gps_lp_suppress_ticks_and_sleep() does, against an exact clock, and
+ *  prints the difference between the true time and the RTOS tick count.
+ *
+ *  Each round runs for a random number of SysTick counts (80 MHz, up to
+ *  DRIFT_RUN_TICKS ticks), then sleeps GPS_LP_MIN_IDLE_MS to
+ *  GPS_LP_MAX_IDLE_MS ticks. Most sleeps end on the LPTIM compare, read
+ *  0 or 1 LSE count late, the others end early on an interrupt. Time is
+ *  kept in units of 1/(LSE_HZ x TICK_HZ x DRIFT_SYSTICK_UNIT) s, a whole
+ *  number of units for a SysTick count and for an LSE count.
+ *
+ *  gps_lp_drift [sleeps]
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_gps_lowpower.h"
+#include "stdio.h"
+#include "stdlib.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define DRIFT_SLEEPS				(1000000)					///< Default number of sleeps
+#define DRIFT_CORE_HZ				(80000000UL)				///< SysTick clock
+#define DRIFT_PERIOD				(DRIFT_CORE_HZ / GPS_LP_TICK_HZ)	///< SysTick counts per tick
+#define DRIFT_RUN_TICKS				(20)						///< Longest run between sleeps
+#define DRIFT_EARLY_ONE_IN			(4)							///< One sleep in 4 ends early
+#define DRIFT_SYSTICK_UNIT			(4096ULL)					///< Units per SysTick count
+#define DRIFT_LSE_UNIT				(10000000ULL)				///< Units per LSE count
+#define DRIFT_TICK_UNIT				(DRIFT_LSE_UNIT * GPS_LP_LSE_HZ / GPS_LP_TICK_HZ)	///< Units per tick
+/* Define some common use MACRO - END */
+
+/* Global Variables - START */
+static uint32_t drift_seed = 1;
+/* Global Variables - END */
+
+/** @fn static uint32_t drift_rand(uint32_t n)
+ * @brief Repeatable pseudo random number below n
+ */
+static uint32_t drift_rand(uint32_t n)
+{
+	drift_seed = (drift_seed * 1103515245U) + 12345U;
+	return (drift_seed >> 8) % n;
+}
+
+/*
+ * Drift entry - START
+ */
+int main(int argc, char ** argv)
+{
+	st_gps_lp_clock clock = {0};
+	uint32_t sleeps = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : DRIFT_SLEEPS;
+	uint64_t units = 0;
+	uint64_t ticks = 0;
+	uint32_t early = 0;
+	int64_t err = 0;
+	int64_t worst = 0;
+
+	if(sleeps == 0)
+	{
+		fprintf(stderr, "usage: gps_lp_drift [sleeps]\n");
+		return 1;
+	}
+	for(uint32_t i = 0; i < sleeps; i++)
+	{
+		uint32_t run = drift_rand(DRIFT_PERIOD * DRIFT_RUN_TICKS);
+		uint32_t idle = GPS_LP_MIN_IDLE_MS + drift_rand(GPS_LP_MAX_IDLE_MS - GPS_LP_MIN_IDLE_MS);
+		uint32_t counts;
+
+		/* Awake, SysTick counts the whole ticks */
+		ticks += run / DRIFT_PERIOD;
+		units += (uint64_t)run * DRIFT_SYSTICK_UNIT;
+
+		/* Asleep, LPTIM1 counts */
+		counts = gps_lp_clock_enter(&clock, run % DRIFT_PERIOD, DRIFT_PERIOD, idle);
+		if(drift_rand(DRIFT_EARLY_ONE_IN) != 0)
+		{
+			counts += drift_rand(2);
+		}
+		else
+		{
+			counts = drift_rand(counts);
+			early++;
+		}
+		units += (uint64_t)counts * DRIFT_LSE_UNIT;
+		ticks += gps_lp_clock_ticks(&clock, counts, idle);
+
+		err = (int64_t)(units / DRIFT_TICK_UNIT) - (int64_t)ticks;
+		if(llabs(err) > worst)
+		{
+			worst = llabs(err);
+		}
+	}
+	printf("%lu sleeps (%lu early), %.1f h simulated\n", (unsigned long)sleeps, (unsigned long)early,
+			(double)units / DRIFT_TICK_UNIT / GPS_LP_TICK_HZ / 3600.0);
+	printf("tick error: final %lld, worst %lld\n", (long long)err, (long long)worst);
+	return 0;
+}
+/* Drift entry - END */
@@ -0,0 +1,136 @@
+/*
+ * gps_lpuart_sim.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  LPUART1 ring harness (MZ_gps_lpuart.h). Generated 1 Hz epochs go byte
+ *  by byte through gps_lpuart_rx_byte() as from the interrupt, the idle
+ *  line closes each burst and the chunks of gps_lpuart_read() are parsed
+ *  as by the GPS thread. Prints the bytes per epoch and the parse and
+ *  drop counters.
+ *
+ *  The second part is a power model of one epoch at 9600 baud for the
+ *  receive schemes, from the measured bytes per epoch and the target
+ *  costs below. The costs and currents are estimates, not measurements.
+ *
+ *  gps_lpuart_sim [epochs]
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_gps_lpuart.h"
+#include "MZ_gps_nmea.h"
+#include "MZ_gps_nmea_gen.h"
+#include "stdio.h"
+#include "stdlib.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define SIM_EPOCHS					(600)						///< Default number of epochs
+#define SIM_EPOCH_SIZE				(2048)						///< Largest generated epoch
+#define SIM_CHUNK_SIZE				(255)						///< rx1_char of the GPS thread
+#define SIM_BAUD					(9600.0)					///< NMEA line rate
+#define SIM_POLL_PASSES				(100)						///< osDelay(10) loop passes per second
+
+/* Target costs, core cycles at 80 MHz (estimates) */
+#define SIM_F_CPU					(80e6)
+#define SIM_C_ISR_RING				(120.0)						///< Register level byte interrupt
+#define SIM_C_ISR_HAL				(400.0)						///< MonoZ and HAL receive interrupt per byte
+#define SIM_C_STOP_EXIT				(4000.0)					///< STOP2 exit, PLL relock and tick step
+#define SIM_C_TICK					(300.0)						///< SysTick and kernel tick
+#define SIM_C_PASS					(3000.0)					///< One GPS loop pass without parsing
+#define SIM_C_PARSE_B				(50.0)						///< Parser per byte
+
+/* Currents (estimates) */
+#define SIM_I_RUN					(10.0e-3)					///< Run at 80 MHz
+#define SIM_I_SLEEP					(2.6e-3)					///< Sleep at 80 MHz
+#define SIM_I_STOP					(3.0e-6)					///< STOP2
+/* Define some common use MACRO - END */
+
+/** @fn static void sim_report(const char * name, double cycles, double sleep_s)
+ * @brief One line of the power model, the rest of the second in STOP2
+ */
+static void sim_report(const char * name, double cycles, double sleep_s)
+{
+	double run_s = cycles / SIM_F_CPU;
+	double stop_s = 1.0 - run_s - sleep_s;
+
+	printf("%-34s duty %5.2f %%  avg %7.1f uA\n", name, run_s * 100,
+			((run_s * SIM_I_RUN) + (sleep_s * SIM_I_SLEEP) + (stop_s * SIM_I_STOP)) * 1e6);
+}
+
+/*
+ * Simulation entry - START
+ */
+int main(int argc, char ** argv)
+{
+	st_gps_nmea_gen_cfg cfg =
+	{
+		.lat_e7 = 299000000, .lon_e7 = 778000000, .utc_time = 101900, .utc_date = 300322,
+		.speed_cms = 1200, .course_cdeg = 9000, .turn_cdeg_s = 50, .hdop_x100 = 95,
+		.rate_hz = 1, .sentences = GPS_NMEA_GEN_ALL,
+	};
+	static char epoch[SIM_EPOCH_SIZE];
+	char chunk[SIM_CHUNK_SIZE];
+	st_gps_nmea_gen gen;
+	st_gps_fix fix = {0};
+	st_gps_nmea_stats st = {0};
+	st_gps_lpuart_stats ls;
+	uint32_t epochs = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : SIM_EPOCHS;
+	unsigned long total = 0;
+	unsigned long sentences = 0;
+	unsigned long chunks = 0;
+	double b;
+	double burst_s;
+	double cycles;
+
+	if(epochs == 0)
+	{
+		fprintf(stderr, "usage: gps_lpuart_sim [epochs]\n");
+		return 1;
+	}
+	gps_nmea_gen_init(&gen, &cfg);
+	for(uint32_t e = 0; e < epochs; e++)
+	{
+		uint16_t n = gps_nmea_gen_epoch(&gen, epoch, sizeof(epoch));
+		uint16_t len;
+
+		for(uint16_t i = 0; i < n; i++)
+		{
+			gps_lpuart_rx_byte((uint8_t)epoch[i]);
+			if(epoch[i] == '\n')
+			{
+				sentences++;
+			}
+		}
+		total += n;
+		gps_lpuart_rx_idle();
+		while((len = gps_lpuart_read(chunk, sizeof(chunk))) != 0)
+		{
+			chunks++;
+			gps_nmea_parse_buffer(chunk, len, &fix, &st);
+		}
+	}
+	gps_lpuart_get_stats(&ls);
+	printf("%lu epochs, %lu bytes (%.0f per epoch), %lu chunks\n",
+			(unsigned long)epochs, total, (double)total / epochs, chunks);
+	printf("sentences %lu, parsed %lu, invalid %lu, dropped bytes %lu\n", sentences,
+			(unsigned long)(st.decoded + st.other), (unsigned long)st.invalid, (unsigned long)ls.dropped);
+
+	/* Power model of one 1 Hz epoch */
+	b = (double)total / epochs;
+	burst_s = b * 10 / SIM_BAUD;
+	cycles = (SIM_POLL_PASSES * (SIM_C_PASS + (SIM_CHUNK_SIZE - 1) * SIM_C_PARSE_B)) + (1000 * SIM_C_TICK) + (b * SIM_C_ISR_HAL);
+	sim_report("osDelay(10) poll, WFI idle", cycles, 1.0 - (cycles / SIM_F_CPU));
+	cycles = (SIM_POLL_PASSES * (SIM_C_PASS + (SIM_CHUNK_SIZE - 1) * SIM_C_PARSE_B)) + (SIM_POLL_PASSES * SIM_C_STOP_EXIT)
+			+ (b * (SIM_C_ISR_HAL + SIM_C_STOP_EXIT));
+	sim_report("osDelay(10) poll, STOP2 idle", cycles, 0);
+	cycles = (10 * SIM_C_PASS) + (b * (SIM_C_PARSE_B + SIM_C_ISR_RING)) + (11 * SIM_C_STOP_EXIT) + (burst_s * 1000 * SIM_C_TICK);
+	sim_report("ring, Sleep for the burst", cycles, burst_s - (cycles / SIM_F_CPU));
+	cycles = (10 * SIM_C_PASS) + (b * (SIM_C_PARSE_B + SIM_C_ISR_RING)) + ((b + 10) * SIM_C_STOP_EXIT);
+	sim_report("ring, STOP2 between bytes", cycles, 0);
+	return 0;
+}
+/* Simulation entry - END */
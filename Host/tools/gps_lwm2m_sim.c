@@ -0,0 +1,198 @@
+/*
+ * gps_lwm2m_sim.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  LwM2M location backend harness (MZ_gps_lwm2m.h). Encodes a fix as the
+ *  /6/0 TLV of gps_lwm2m_obj6() and decodes it back, sizes the CoAP
+ *  notify with gps_lwm2m_coap_size() and compares it with the MQTT path:
+ *  the JSON snapshot of gps_payload_fix() and the bytes of a report that
+ *  reconnects each time, counted from the MQTT 3.1.1 packet layout and
+ *  40 byte TCP/IP headers.
+ *
+ *  Then the observation timing: pmin / pmax from a Write-Attributes
+ *  string, notifies over 10 min with a report every 5 s, and with no
+ *  report at all.
+ *
+ *  gps_lwm2m_sim
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_gps_lwm2m.h"
+#include "MZ_gps_payload.h"
+#include "stdio.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define SIM_TOKEN_LEN				(8)							///< CoAP token of the observation
+#define SIM_OBSERVE_SEQ				(5)							///< Observe option value
+#define SIM_UDP_IP					(28)						///< IPv4 and UDP headers
+#define SIM_TCP_IP					(40)						///< IPv4 and TCP headers
+#define SIM_COAP_ACK				(4)							///< Empty CoAP ACK of a CON notify
+#define SIM_RUN_MS					(600000)					///< Observation run, 10 min
+#define SIM_REPORT_MS				(5000)						///< Report interval of the first run
+#define SIM_MQTT_ID_LEN				(7)							///< Client id, user and password length
+/* Define some common use MACRO - END */
+
+/** @fn static double sim_f64(const uint8_t * p)
+ * @brief Big endian double of a TLV value
+ */
+static double sim_f64(const uint8_t * p)
+{
+	uint64_t b = 0;
+	double d;
+
+	for(uint8_t i = 0; i < 8; i++)
+	{
+		b = (b << 8) | p[i];
+	}
+	memcpy(&d, &b, sizeof(d));
+	return d;
+}
+
+/** @fn static float sim_f32(const uint8_t * p)
+ * @brief Big endian float of a TLV value
+ */
+static float sim_f32(const uint8_t * p)
+{
+	uint32_t b = 0;
+	float f;
+
+	for(uint8_t i = 0; i < 4; i++)
+	{
+		b = (b << 8) | p[i];
+	}
+	memcpy(&f, &b, sizeof(f));
+	return f;
+}
+
+/** @fn static void sim_decode(const uint8_t * tlv, uint16_t len)
+ * @brief Print the resources of an object instance TLV
+ */
+static void sim_decode(const uint8_t * tlv, uint16_t len)
+{
+	uint16_t i = 0;
+
+	while(i < len)
+	{
+		uint8_t type = tlv[i];
+		uint8_t id = tlv[i + 1];
+		uint8_t head = 2;
+		uint8_t size = type & 0x07;
+		const uint8_t * v;
+
+		if((type & 0x18) == 0x08)
+		{
+			/* 8 bit length field */
+			size = tlv[i + 2];
+			head = 3;
+		}
+		v = &tlv[i + head];
+		if(size == 8)
+		{
+			printf("  /6/0/%u = %.7f\n", id, sim_f64(v));
+		}
+		else if(id == 5)
+		{
+			printf("  /6/0/%u = %lu\n", id, (unsigned long)(((uint32_t)v[0] << 24) | ((uint32_t)v[1] << 16) | ((uint32_t)v[2] << 8) | v[3]));
+		}
+		else
+		{
+			printf("  /6/0/%u = %.3f\n", id, sim_f32(v));
+		}
+		i += head + size;
+	}
+}
+
+/*
+ * Simulation entry - START
+ */
+int main(void)
+{
+	st_gps_fix fix = {0};
+	st_gps_lwm2m o;
+	uint8_t tlv[GPS_LWM2M_OBJ6_SIZE];
+	char json[GPS_PAYLOAD_FIX_SIZE];
+	uint16_t n;
+	uint16_t coap;
+	int json_len;
+	int topic = strlen(GPS_PAYLOAD_TOPIC) - 2;
+	int publish;
+	int connect;
+	int app;
+	int tcp;
+	uint32_t reports = 0;
+	uint32_t notifies = 0;
+
+	fix.lat_e7 = 356812360;
+	fix.lon_e7 = 1397671250;
+	fix.alt_cm = 4020;
+	fix.utc_time = 123456;
+	fix.utc_date = 191026;
+	fix.speed_cms = 1234;
+	fix.pdop_x100 = 150;
+	fix.hdop_x100 = 95;
+	fix.vdop_x100 = 120;
+	fix.valid = GPS_FIX_VALID;
+
+	/* Sizes */
+	n = gps_lwm2m_obj6(&fix, tlv, sizeof(tlv));
+	printf("TLV %u bytes, timestamp %lu\n", n, (unsigned long)gps_fix_to_unix(&fix));
+	sim_decode(tlv, n);
+	coap = gps_lwm2m_coap_size(n, SIM_TOKEN_LEN, SIM_OBSERVE_SEQ);
+	printf("CoAP notify %u bytes, %u with UDP/IP (NON), %u with its ACK (CON)\n",
+			coap, coap + SIM_UDP_IP, coap + SIM_UDP_IP + SIM_COAP_ACK + SIM_UDP_IP);
+
+	/* Without the Ctrl-Z, it does not go on the air */
+	json_len = gps_payload_fix(&fix, &fix, json) - 1;
+	/* Fixed header, topic length, topic, payload, QoS 0 */
+	publish = 2 + 2 + topic + json_len;
+	/* Fixed and variable header, client id, user, password */
+	connect = 2 + 10 + (3 * (2 + SIM_MQTT_ID_LEN));
+	/* CONNECT, CONNACK, PUBLISH, DISCONNECT */
+	app = connect + 4 + publish + 2;
+	/* Handshake and close, 4 data segments and their ACKs */
+	tcp = (3 * SIM_TCP_IP) + (4 * SIM_TCP_IP) + (4 * SIM_TCP_IP) + (4 * SIM_TCP_IP);
+	printf("MQTT JSON %d bytes, PUBLISH %d bytes, report with reconnect %d bytes (MQTT %d, TCP/IP %d)\n",
+			json_len, publish, app + tcp, app, tcp);
+
+	/* Observation timing */
+	gps_lwm2m_reset(&o, 10, 60);
+	gps_lwm2m_report(&o);
+	printf("report while not observed: due %u, unobserved %lu\n", gps_lwm2m_due(&o, 0), (unsigned long)o.stats.unobserved);
+	gps_lwm2m_observe(&o, 1, 1000);
+	gps_lwm2m_attributes(&o, "pmin=15&gt=5;pmax=120");
+	printf("attributes: pmin %lu s, pmax %lu s\n", (unsigned long)o.pmin_s, (unsigned long)o.pmax_s);
+	for(uint32_t ms = 1000; ms <= (1000 + SIM_RUN_MS); ms += 1000)
+	{
+		if((ms % SIM_REPORT_MS) == 0)
+		{
+			gps_lwm2m_report(&o);
+			reports++;
+		}
+		if(gps_lwm2m_due(&o, ms))
+		{
+			gps_lwm2m_sent(&o, ms, n);
+			notifies++;
+		}
+	}
+	printf("10 min, a report every 5 s: %lu reports, %lu notifies\n", (unsigned long)reports, (unsigned long)notifies);
+
+	gps_lwm2m_observe(&o, 1, 0);
+	notifies = 0;
+	for(uint32_t ms = 0; ms <= SIM_RUN_MS; ms += 1000)
+	{
+		if(gps_lwm2m_due(&o, ms))
+		{
+			gps_lwm2m_sent(&o, ms, n);
+			notifies++;
+		}
+	}
+	printf("10 min, no report: %lu notifies\n", (unsigned long)notifies);
+	return 0;
+}
+/* Simulation entry - END */
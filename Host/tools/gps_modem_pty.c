@@ -0,0 +1,302 @@
+/*
+ * gps_modem_pty.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  BG96 / SIM7080 emulator on a pseudo terminal. The modem emulation of
+ *  MZ_gps_at.c (GPS_MODEM_EMU_ENABLE) answers the commands a program
+ *  writes to the printed /dev/pts/N, so the publish path of another
+ *  program, or a person with a terminal, can be measured against the same
+ *  modem model the firmware uses on the bench.
+ *
+ *  Commands end with CR or LF, echo is off (ATE0). AT+QMTPUB is answered
+ *  with the "> " prompt and takes its payload up to Ctrl-Z, AT+SMPUB takes
+ *  as many bytes as it names. Answers are OK / ERROR. URCs, e.g. the
+ *  +QMTPUB PUBACK of a QoS 1 publish or +QIURC "recv", come on their own
+ *  lines when they are due. Payloads reach the broker stand-in, which
+ *  prints them on stdout.
+ *
+ *  The emulator runs on the simulated clock of host_stub.c. The clock
+ *  follows the wall clock, and the latency a command took on it is waited
+ *  in wall time before the answer, so a client sees the configured
+ *  GPS_MODEM_EMU_* timing. Latency, failures, URC injection and loss are
+ *  the GPS_MODEM_EMU_* values of the build (config/gps_host_config.h).
+ *
+ *  gps_modem_pty [-n commands] [-q]
+ *    -n  leave after that many commands, 0 = until SIGINT
+ *    -q  no broker output
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_gps_at.h"
+#include "fcntl.h"
+#include "poll.h"
+#include "signal.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "termios.h"
+#include "time.h"
+#include "unistd.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define PTY_LINE_SIZE				(2048)						///< Longest command or payload
+#define PTY_POLL_MS					(10)						///< URC resolution while idle
+#define PTY_PAYLOAD_END				(26)						///< Ctrl-Z ends an AT+QMTPUB payload
+#define PTY_CLOSE_MS				(200)						///< Time for the client to read the last answer
+/* Define some common use MACRO - END */
+
+/* Global Variables - START */
+static int pty_fd = -1;
+static volatile sig_atomic_t pty_stop = 0;
+static uint8_t pty_quiet = 0;
+static uint64_t pty_start_ns;
+/* Global Variables - END */
+
+/** @fn static void pty_write(const char * s)
+ * @brief Bytes to the client
+ */
+static void pty_write(const char * s)
+{
+	size_t len = strlen(s);
+
+	while(len != 0)
+	{
+		ssize_t n = write(pty_fd, s, len);
+
+		if(n <= 0)
+		{
+			return;
+		}
+		s += n;
+		len -= (size_t)n;
+	}
+}
+
+/** @fn static void pty_sync(void)
+ * @brief Let the simulated clock catch up with the wall clock, the URCs
+ * due on the way go out
+ */
+static void pty_sync(void)
+{
+	uint32_t wall_ms = (uint32_t)((host_ns() - pty_start_ns) / 1000000ULL);
+
+	if((int32_t)(wall_ms - HAL_GetTick()) > 0)
+	{
+		host_tick_advance(wall_ms - HAL_GetTick());
+	}
+	gps_at_emu_poll();
+}
+
+/** @fn static void pty_wait(uint32_t ms)
+ * @brief Wait in wall time what a command took on the simulated clock
+ */
+static void pty_wait(uint32_t ms)
+{
+	struct timespec ts = { (time_t)(ms / 1000U), (long)(ms % 1000U) * 1000000L };
+
+	while((0 != nanosleep(&ts, &ts)) && !pty_stop)
+	{
+	}
+}
+
+/** @fn static void pty_signal(int sig)
+ * @brief SIGINT / SIGTERM, leave after the current command
+ */
+static void pty_signal(int sig)
+{
+	(void)sig;
+	pty_stop = 1;
+}
+
+/** @fn static uint32_t pty_smpub_len(const char * cmd)
+ * @brief Payload length of AT+SMPUB="topic",<len>,<qos>,<retain>
+ */
+static uint32_t pty_smpub_len(const char * cmd)
+{
+	const char * p = strchr(cmd, '=');
+
+	if(p == NULL)
+	{
+		return 0;
+	}
+	p++;
+	if(*p == '"')
+	{
+		p = strchr(p + 1, '"');
+	}
+	p = (p != NULL) ? strchr(p, ',') : NULL;
+	return (p != NULL) ? (uint32_t)strtoul(p + 1, NULL, 10) : 0;
+}
+
+/** @fn static mz_error_t pty_cmd(char * cmd)
+ * @brief One command or payload through gps_at_cmd(), answered after the
+ * emulated latency
+ */
+static mz_error_t pty_cmd(char * cmd)
+{
+	uint32_t start = HAL_GetTick();
+	mz_error_t status = gps_at_cmd(cmd, 0, 0);
+
+	pty_wait(HAL_GetTick() - start);
+	return status;
+}
+
+/*
+ * Broker stand-in. - START
+ */
+void gps_at_emu_broker(const char * topic, const char * payload)
+{
+	if(!pty_quiet)
+	{
+		printf("%10lu %s %s\n", (unsigned long)HAL_GetTick(), topic, payload);
+		fflush(stdout);
+	}
+}
+/* Broker stand-in. - END */
+
+/*
+ * Injected URC. - START
+ */
+void gps_at_emu_urc(const char * urc)
+{
+	pty_write("\r\n");
+	pty_write(urc);
+	pty_write("\r\n");
+}
+/* Injected URC. - END */
+
+/*
+ * Emulator entry - START
+ */
+int main(int argc, char ** argv)
+{
+	static char line[PTY_LINE_SIZE + 2];
+	struct termios tio;
+	st_gps_at_stats st;
+	uint32_t max_cmds = 0;
+	uint32_t len = 0;
+	uint32_t payload = 0;									/* Bytes an AT+SMPUB payload still needs */
+	uint8_t prompt = 0;										/* Collecting a payload */
+	int slave;
+	int opt;
+
+	while(-1 != (opt = getopt(argc, argv, "n:q")))
+	{
+		switch(opt)
+		{
+			case 'n': max_cmds = (uint32_t)strtoul(optarg, NULL, 0); break;
+			case 'q': pty_quiet = 1; break;
+			default:
+				fprintf(stderr, "usage: gps_modem_pty [-n commands] [-q]\n");
+				return 1;
+		}
+	}
+
+	pty_fd = posix_openpt(O_RDWR | O_NOCTTY);
+	if((pty_fd < 0) || (0 != grantpt(pty_fd)) || (0 != unlockpt(pty_fd)))
+	{
+		perror("posix_openpt");
+		return 1;
+	}
+
+	/* Raw line discipline, held open so the master reads nothing but the client */
+	slave = open(ptsname(pty_fd), O_RDWR | O_NOCTTY);
+	if((slave < 0) || (0 != tcgetattr(slave, &tio)))
+	{
+		perror(ptsname(pty_fd));
+		return 1;
+	}
+	cfmakeraw(&tio);
+	tcsetattr(slave, TCSANOW, &tio);
+
+	signal(SIGINT, pty_signal);
+	signal(SIGTERM, pty_signal);
+	fprintf(stderr, "modem on %s, command latency %u ms, payload %u ms\n",
+			ptsname(pty_fd), GPS_MODEM_EMU_LATENCY_MS, GPS_MODEM_EMU_PUB_LATENCY_MS);
+
+	pty_start_ns = host_ns();
+	host_tick_set(0);
+	while(!pty_stop)
+	{
+		struct pollfd pfd = { pty_fd, POLLIN, 0 };
+		char c;
+
+		pty_sync();
+		if((poll(&pfd, 1, PTY_POLL_MS) <= 0) || (1 != read(pty_fd, &c, 1)))
+		{
+			continue;
+		}
+		pty_sync();
+
+		if(!prompt)
+		{
+			mz_error_t status;
+
+			if((c != '\r') && (c != '\n'))
+			{
+				if(len < PTY_LINE_SIZE)
+				{
+					line[len++] = c;
+				}
+				continue;
+			}
+			if(len == 0)
+			{
+				continue;
+			}
+			/* gps_at_cmd() takes the command with its line end */
+			line[len++] = '\r';
+			line[len++] = '\n';
+			line[len] = '\0';
+			len = 0;
+			status = pty_cmd(line);
+			if((MZ_OK == status) && ((0 == strncmp(line, "AT+QMTPUB", 9)) || (0 == strncmp(line, "AT+SMPUB", 8))))
+			{
+				payload = (0 == strncmp(line, "AT+SMPUB", 8)) ? pty_smpub_len(line) : 0;
+				prompt = 1;
+				pty_write("\r\n> ");
+				continue;
+			}
+			pty_write((MZ_OK == status) ? "\r\nOK\r\n" : "\r\nERROR\r\n");
+		}
+		else
+		{
+			if(len < PTY_LINE_SIZE)
+			{
+				line[len++] = c;
+			}
+			/* Ctrl-Z, or the length AT+SMPUB named */
+			if((payload != 0) ? (len < payload) : (c != PTY_PAYLOAD_END))
+			{
+				continue;
+			}
+			line[len] = '\0';
+			len = 0;
+			prompt = 0;
+			pty_write((MZ_OK == pty_cmd(line)) ? "\r\nOK\r\n" : "\r\nERROR\r\n");
+		}
+
+		gps_at_get_stats(&st);
+		if((max_cmds != 0) && (st.cmds >= max_cmds))
+		{
+			break;
+		}
+	}
+
+	gps_at_get_stats(&st);
+	fprintf(stderr, "%lu commands, %lu failed, %lu publishes, %lu payload bytes, mean %lu ms, max %lu ms\n",
+			(unsigned long)st.cmds, (unsigned long)st.fails, (unsigned long)st.publishes,
+			(unsigned long)st.publish_bytes, (unsigned long)((st.cmds != 0) ? (st.total_ms / st.cmds) : 0),
+			(unsigned long)st.max_ms);
+	/* Closing the master drops what the client has not read yet */
+	pty_wait(PTY_CLOSE_MS);
+	close(slave);
+	close(pty_fd);
+	return 0;
+}
+/* Emulator entry - END */
@@ -0,0 +1,174 @@
+/*
+ * gps_qos_sim.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  MQTT QoS 1 window harness (MZ_gps_qos.h, BG96 backend). Numbered
+ *  messages are offered to gps_backend_upload() faster than the link can
+ *  take them, for SIM_RUN_MS of simulated time. The modem emulator
+ *  answers the AT commands, hands the PUBLISH to the broker stand-in
+ *  (overridden here to count the messages) and sends the +QMTPUB PUBACK
+ *  GPS_MODEM_EMU_PUBACK_MS later from gps_at_emu_poll(). The thread loop
+ *  is stood in by gps_at_emu_poll() and gps_backend_poll/flush every
+ *  SIM_STEP_MS. Loss is set with gps_at_emu_loss(), one PUBLISH or
+ *  PUBACK in N at random.
+ *
+ *  Prints per loss the offered, accepted and delivered messages per
+ *  minute. The window is GPS_MQTT_QOS1_WINDOW of the library, the same
+ *  source is built on one library variant per window:
+ *  gps_qos_sim_w1, gps_qos_sim_w2, gps_qos_sim (4), gps_qos_sim_w8.
+ *
+ *  gps_qos_sim [period ms]
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_gps_at.h"
+#include "MZ_gps_backend.h"
+#include "MZ_gps_qos.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define SIM_PERIOD_MS				(250)						///< Default offer period, 240 per minute
+#define SIM_RUN_MS					(600000)					///< Length of a run, 10 min
+#define SIM_DRAIN_MS				(120000)					///< Offers stopped before the next run
+#define SIM_STEP_MS					(10)						///< Thread loop period
+#define SIM_MSGS_MAX				(65536)						///< Messages numbered over all runs
+#define SIM_PAYLOAD_SIZE			(32)						///< Numbered payload
+/* Define some common use MACRO - END */
+
+/* Loss of the runs, every Nth packet, 0 = none */
+static const uint16_t sim_loss[] = { 0, 10, 5 };
+
+/* Global Variables - START */
+static uint8_t sim_seen[SIM_MSGS_MAX];
+static uint32_t sim_delivered;
+static uint32_t sim_dups;
+/* Global Variables - END */
+
+/*
+ * Broker stand-in, counts the numbered messages. - START
+ */
+void gps_at_emu_broker(const char * topic, const char * payload)
+{
+	const char * num = strchr(payload, ':');
+	uint32_t n = (num != NULL) ? (uint32_t)strtoul(num + 1, NULL, 10) : 0;
+
+	if(n >= SIM_MSGS_MAX)
+	{
+		return;
+	}
+	if(sim_seen[n])
+	{
+		sim_dups++;
+	}
+	else
+	{
+		sim_seen[n] = 1;
+		sim_delivered++;
+	}
+}
+/* Broker stand-in, counts the numbered messages. - END */
+
+/** @fn static void sim_step(void)
+ * @brief One thread loop pass
+ */
+static void sim_step(void)
+{
+	host_tick_advance(SIM_STEP_MS);
+	gps_at_emu_poll();
+	if(gps_backend_poll(HAL_GetTick()))
+	{
+		gps_backend_flush(HAL_GetTick());
+	}
+}
+
+/** @fn static void sim_run(uint32_t period, uint16_t loss)
+ * @brief One run, counters taken as differences
+ */
+static void sim_run(uint32_t period, uint16_t loss)
+{
+	static uint32_t number = 0;
+	char topic[] = "\"v1/devices/me/telemetry\"";
+	char payload[SIM_PAYLOAD_SIZE];
+	st_gps_backend_msg msg = { topic, payload, NULL, 0 };
+	st_gps_qos_stats q0;
+	st_gps_qos_stats q1;
+	uint8_t in_flight;
+	uint32_t offered = 0;
+	uint32_t accepted = 0;
+	uint32_t delivered;
+	uint32_t dups;
+	uint32_t start;
+	uint32_t next;
+	double minutes = SIM_RUN_MS / 60000.0;
+
+	gps_at_emu_loss(loss);
+	gps_backend_qos_stats(&q0, &in_flight);
+	delivered = sim_delivered;
+	dups = sim_dups;
+	start = HAL_GetTick();
+	next = start;
+	while((HAL_GetTick() - start) < SIM_RUN_MS)
+	{
+		if((int32_t)(HAL_GetTick() - next) >= 0)
+		{
+			next += period;
+			snprintf(payload, sizeof(payload), "{\"n\":%lu}%c", (unsigned long)++number, 26);
+			offered++;
+			if(gps_backend_upload(&msg, 1, HAL_GetTick()) == MZ_OK)
+			{
+				accepted++;
+			}
+		}
+		sim_step();
+	}
+	delivered = sim_delivered - delivered;
+	dups = sim_dups - dups;
+	gps_backend_qos_stats(&q1, &in_flight);
+
+	printf("W=%u loss 1/%-2u: offered %.1f/min, accepted %.1f/min, delivered %.1f/min (%.1f %% of accepted), dup %lu\n",
+			GPS_MQTT_QOS1_WINDOW, loss, offered / minutes, accepted / minutes, delivered / minutes,
+			(accepted != 0) ? (100.0 * delivered / accepted) : 0.0, (unsigned long)dups);
+	printf("    sends %lu, retries %lu, acked %lu, lost %lu, full %lu, in flight %u, rtt %lu ms\n",
+			(unsigned long)(q1.sends - q0.sends), (unsigned long)(q1.retries - q0.retries),
+			(unsigned long)(q1.acked - q0.acked), (unsigned long)(q1.lost - q0.lost),
+			(unsigned long)(q1.full - q0.full), in_flight, (unsigned long)q1.rtt_last_ms);
+
+	/* Empty the window before the next run */
+	for(uint32_t t = 0; t < SIM_DRAIN_MS; t += SIM_STEP_MS)
+	{
+		sim_step();
+	}
+}
+
+/*
+ * Simulation entry - START
+ */
+int main(int argc, char ** argv)
+{
+	uint32_t period = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : SIM_PERIOD_MS;
+
+	if(period == 0)
+	{
+		fprintf(stderr, "usage: %s [period ms]\n", argv[0]);
+		return 1;
+	}
+	host_tick_set(0);
+	host_cli_file(NULL);
+	if(gps_backend_select(GPS_BACKEND_BG96) != MZ_OK)
+	{
+		return 1;
+	}
+	for(uint8_t l = 0; l < (sizeof(sim_loss) / sizeof(sim_loss[0])); l++)
+	{
+		sim_run(period, sim_loss[l]);
+	}
+	return 0;
+}
+/* Simulation entry - END */
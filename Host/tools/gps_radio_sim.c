@@ -0,0 +1,179 @@
+/*
+ * gps_radio_sim.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Modem power save harness (MZ_gps_radio.h). For each upload interval
+ *  the timers are planned as gps_radio_init() does and requested from the
+ *  modem emulator of MZ_gps_at.c, which follows AT+CPSMS: it drops into
+ *  PSM after T3324 without commands and answers again
+ *  GPS_MODEM_EMU_PSM_WAKE_MS after a wake pulse. A day of MQTT uploads,
+ *  each bracketed by gps_radio_begin() / gps_radio_end(), is run on the
+ *  simulated clock.
+ *
+ *  Prints the timers, the uploads and wake ups, the share of time in each
+ *  modem state and the average modem current from the per state currents
+ *  below (an LTE-M class module, estimates), against staying idle
+ *  between uploads. Then the GPRS timer and eDRX encodings.
+ *
+ *  gps_radio_sim [hours]
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_gps_radio.h"
+#include "MZ_gps_at.h"
+#include "stdio.h"
+#include "stdlib.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define SIM_HOURS					(24)						///< Default run
+#define SIM_START_MS				(1000)						///< Tick of the timer requests
+#define SIM_AT_TIMEOUT_MS			(15000)						///< Answer timeout of the upload commands
+#define SIM_LATE_MS					(GPS_MODEM_EMU_PSM_WAKE_MS + 3000)	///< Upload longer than a wake up and its commands
+#define SIM_CMD_SIZE				(64)						///< Timer request command
+/* Define some common use MACRO - END */
+
+/* Upload intervals of the run */
+static const uint32_t sim_flush_ms[] = { 30000, 120000, 600000 };
+
+/* Average modem current per state, uA (estimates) */
+static const double sim_state_ua[GPS_RADIO_STATES] = { 120000.0, 1500.0, 10.0, 40000.0 };
+
+/** @fn static mz_error_t sim_upload(st_gps_radio * r)
+ * @brief One QoS 0 MQTT publish, as gps_publish_payload() sends it
+ */
+static mz_error_t sim_upload(st_gps_radio * r)
+{
+	char payload[] = "{\"lat\":1}\x1a";
+	mz_error_t st = gps_radio_begin(r);
+
+	if(st == MZ_OK)
+	{
+		st = gps_at_cmd("AT+QMTDISC=0\r\n", SIM_AT_TIMEOUT_MS, SIM_AT_TIMEOUT_MS);
+		st |= gps_at_cmd("AT+QMTOPEN=0,\"x\",1883\r\n", SIM_AT_TIMEOUT_MS, SIM_AT_TIMEOUT_MS);
+		st |= gps_at_cmd("AT+QMTCONN=0,\"a\",\"b\",\"c\"\r\n", SIM_AT_TIMEOUT_MS, SIM_AT_TIMEOUT_MS);
+		st |= gps_at_cmd("AT+QMTPUB=0,0,0,0,\"t\"\r\n", SIM_AT_TIMEOUT_MS, 0);
+		st |= gps_at_cmd(payload, SIM_AT_TIMEOUT_MS, SIM_AT_TIMEOUT_MS);
+	}
+	gps_radio_end(r);
+	return st;
+}
+
+/** @fn static void sim_run(uint32_t flush_ms, uint32_t hours)
+ * @brief A run of uploads every flush_ms
+ */
+static void sim_run(uint32_t flush_ms, uint32_t hours)
+{
+	static st_gps_radio r;
+	st_gps_radio_stats s;
+	char cmd[SIM_CMD_SIZE];
+	double charge = 0;
+	double total = 0;
+	uint32_t fails = 0;
+	uint32_t late = 0;
+	uint32_t next;
+	uint32_t end;
+
+	host_tick_set(SIM_START_MS);
+	gps_radio_plan(&r, flush_ms, GPS_RADIO_ACTIVE_MS, HAL_GetTick());
+	/* The request gps_radio_init() sends */
+	if(r.psm)
+	{
+		snprintf(cmd, sizeof(cmd), "AT+CPSMS=1,,,\"%s\",\"%s\"\r\n", r.t3412, r.t3324);
+	}
+	else
+	{
+		snprintf(cmd, sizeof(cmd), "AT+CPSMS=0\r\n");
+	}
+	gps_at_cmd(cmd, 1000, 1000);
+
+	next = SIM_START_MS + flush_ms;
+	end = SIM_START_MS + (hours * 3600000UL);
+	while(next < end)
+	{
+		host_tick_advance(next - HAL_GetTick());
+		if(sim_upload(&r) != MZ_OK)
+		{
+			fails++;
+		}
+		if((HAL_GetTick() - next) > SIM_LATE_MS)
+		{
+			late++;
+		}
+		next += flush_ms;
+	}
+	gps_radio_get_stats(&r, HAL_GetTick(), &s);
+	for(uint8_t i = 0; i < GPS_RADIO_STATES; i++)
+	{
+		charge += s.ms[i] * sim_state_ua[i];
+		total += s.ms[i];
+	}
+	printf("interval %lu ms: psm %u, T3412 %s (%lu s), T3324 %s (%lu ms), eDRX %s (%lu ms)\n",
+			(unsigned long)flush_ms, r.psm, r.t3412, (unsigned long)r.tau_s, r.t3324, (unsigned long)r.active_ms,
+			r.edrx, (unsigned long)r.edrx_ms);
+	printf("  uploads %lu, failed %lu, late %lu, wakes %lu (last %lu ms, max %lu ms), wake fails %lu\n",
+			(unsigned long)s.uploads, (unsigned long)fails, (unsigned long)late, (unsigned long)s.wakes,
+			(unsigned long)s.wake_last_ms, (unsigned long)s.wake_max_ms, (unsigned long)s.wake_fails);
+	printf("  connected %.1f %%, idle %.1f %%, psm %.1f %%, waking %.1f %%\n",
+			100.0 * s.ms[GPS_RADIO_CONNECTED] / total, 100.0 * s.ms[GPS_RADIO_IDLE] / total,
+			100.0 * s.ms[GPS_RADIO_PSM] / total, 100.0 * s.ms[GPS_RADIO_WAKING] / total);
+	printf("  average %.0f uA, idle between uploads %.0f uA\n", charge / total,
+			((s.ms[GPS_RADIO_CONNECTED] * sim_state_ua[GPS_RADIO_CONNECTED])
+			+ ((total - s.ms[GPS_RADIO_CONNECTED]) * sim_state_ua[GPS_RADIO_IDLE])) / total);
+}
+
+/** @fn static void sim_codes(void)
+ * @brief Timer encodings of AT+CPSMS / AT+CEDRXS
+ */
+static void sim_codes(void)
+{
+	static const uint32_t t3[] = { 31, 360, 1800, 3600, 86400, 40000000 };
+	static const uint32_t t2[] = { 0, 20, 62, 3000, 20000 };
+	static const uint32_t edrx[] = { 5000, 5120, 30000, 120000, 20000000 };
+	char bits[GPS_RADIO_T3_SIZE];
+
+	for(uint8_t i = 0; i < (sizeof(t3) / sizeof(t3[0])); i++)
+	{
+		uint32_t v = gps_radio_t3_encode(t3[i], 1, bits);
+
+		printf("T3412 %lu s -> %lu s %s\n", (unsigned long)t3[i], (unsigned long)v, bits);
+	}
+	for(uint8_t i = 0; i < (sizeof(t2) / sizeof(t2[0])); i++)
+	{
+		uint32_t v = gps_radio_t3_encode(t2[i], 0, bits);
+
+		printf("T3324 %lu s -> %lu s %s\n", (unsigned long)t2[i], (unsigned long)v, bits);
+	}
+	for(uint8_t i = 0; i < (sizeof(edrx) / sizeof(edrx[0])); i++)
+	{
+		uint32_t v = gps_radio_edrx_encode(edrx[i], bits);
+
+		printf("eDRX %lu ms -> %lu ms %s\n", (unsigned long)edrx[i], (unsigned long)v, bits);
+	}
+}
+
+/*
+ * Simulation entry - START
+ */
+int main(int argc, char ** argv)
+{
+	uint32_t hours = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : SIM_HOURS;
+
+	if(hours == 0)
+	{
+		fprintf(stderr, "usage: gps_radio_sim [hours]\n");
+		return 1;
+	}
+	host_cli_file(NULL);
+	for(uint8_t f = 0; f < (sizeof(sim_flush_ms) / sizeof(sim_flush_ms[0])); f++)
+	{
+		sim_run(sim_flush_ms[f], hours);
+	}
+	sim_codes();
+	return 0;
+}
+/* Simulation entry - END */
@@ -0,0 +1,234 @@
+/*
+ * gps_report_replay.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Reporting policy replay. Every fix of a track goes through
+ *  gps_report_policy_check() as in gps_fix_commit(), and the same track
+ *  is reported on a fixed interval for comparison: every 120 s like the
+ *  send timer of the firmware without the policy, and at the interval
+ *  that gives the policy's publish count. The path a server draws from
+ *  the published points (straight lines between them, the last point
+ *  held) is compared with every fix of the track.
+ *
+ *  gps_report_replay [track | nmea log ...]
+ */
+
+/* Include Header Files - START */
+
+#include "host_track.h"
+#include "MZ_gps_report_policy.h"
+#include "math.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define REPLAY_FIXED_MS				(120000)					///< GPS_SENSOR_DATA_SEND_TIME of MZ_GPSSensor.c
+/* Define some common use MACRO - END */
+
+/**
+ * @struct st_replay_result
+ * @brief Publishes and path error of one reporting scheme
+ */
+typedef struct
+{
+	uint32_t		publishes;									/*!< Published fixes */
+	double			mean_m;										/*!< Mean path error */
+	double			p95_m;										/*!< 95th percentile path error */
+	double			max_m;										/*!< Largest path error */
+	uint32_t		reasons[GPS_REPORT_SILENCE + 1];			/*!< Publishes per en_gps_report_reason */
+}st_replay_result;
+
+/** @fn static int replay_cmp(const void * a, const void * b)
+ * @brief qsort order of the errors
+ */
+static int replay_cmp(const void * a, const void * b)
+{
+	double x = *(const double *)a;
+	double y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+/** @fn static void replay_error(const st_host_track * track, const uint8_t * pub, st_replay_result * res)
+ * @brief Path error of the fixes flagged in pub
+ */
+static void replay_error(const st_host_track * track, const uint8_t * pub, st_replay_result * res)
+{
+	double * err = malloc(track->count * sizeof(double));
+	double sum = 0;
+	uint32_t a = 0;
+
+	if(err == NULL)
+	{
+		exit(1);
+	}
+	res->publishes = 0;
+	for(uint32_t i = 0; i < track->count; i++)
+	{
+		res->publishes += pub[i];
+	}
+
+	/* Fixes between the published a and b lie on the line a..b */
+	while(a < track->count)
+	{
+		const st_gps_fix * fa = &track->fix[a];
+		uint32_t b = a + 1;
+		int32_t be = 0;
+		int32_t bn = 0;
+		uint32_t span = 0;
+
+		while((b < track->count) && !pub[b])
+		{
+			b++;
+		}
+		if(b < track->count)
+		{
+			gps_fix_offset_cm(fa->lat_e7, fa->lon_e7, track->fix[b].lat_e7, track->fix[b].lon_e7, &be, &bn);
+			span = track->fix[b].tick - fa->tick;
+		}
+		for(uint32_t i = a; (i < b) && (i < track->count); i++)
+		{
+			double k = (span != 0) ? (double)(track->fix[i].tick - fa->tick) / span : 0.0;
+			int32_t e;
+			int32_t n;
+
+			gps_fix_offset_cm(fa->lat_e7, fa->lon_e7, track->fix[i].lat_e7, track->fix[i].lon_e7, &e, &n);
+			err[i] = hypot(e - (k * be), n - (k * bn)) / 100.0;
+			sum += err[i];
+		}
+		a = b;
+	}
+
+	qsort(err, track->count, sizeof(double), replay_cmp);
+	res->mean_m = sum / track->count;
+	res->p95_m = err[(track->count * 95U) / 100U];
+	res->max_m = err[track->count - 1];
+	free(err);
+}
+
+/** @fn static void replay_fixed(const st_host_track * track, uint32_t interval_ms, uint8_t * pub, st_replay_result * res)
+ * @brief Report on a fixed interval
+ */
+static void replay_fixed(const st_host_track * track, uint32_t interval_ms, uint8_t * pub, st_replay_result * res)
+{
+	uint32_t last = track->fix[0].tick;
+
+	memset(res, 0, sizeof(*res));
+	memset(pub, 0, track->count);
+	pub[0] = 1;
+	for(uint32_t i = 1; i < track->count; i++)
+	{
+		if((track->fix[i].tick - last) >= interval_ms)
+		{
+			pub[i] = 1;
+			last = track->fix[i].tick;
+		}
+	}
+	replay_error(track, pub, res);
+}
+
+/** @fn static void replay_policy(const st_host_track * track, uint8_t * pub, st_replay_result * res)
+ * @brief Report through the policy with the GPS_REPORT_* thresholds
+ */
+static void replay_policy(const st_host_track * track, uint8_t * pub, st_replay_result * res)
+{
+	memset(res, 0, sizeof(*res));
+	gps_report_policy_init(NULL);
+	for(uint32_t i = 0; i < track->count; i++)
+	{
+		en_gps_report_reason r = gps_report_policy_check(&track->fix[i]);
+
+		pub[i] = (r != GPS_REPORT_NONE);
+		res->reasons[r]++;
+	}
+	replay_error(track, pub, res);
+}
+
+/** @fn static void replay_print(const st_host_track * track, const char * mode, const st_replay_result * res)
+ * @brief One result line
+ */
+static void replay_print(const st_host_track * track, const char * mode, const st_replay_result * res)
+{
+	double hours = (track->fix[track->count - 1].tick - track->fix[0].tick + 1000U) / 3600000.0;
+
+	printf("%-10s %-12s %7.1f %7.1f %7.1f %7.1f",
+			track->name, mode, res->publishes / hours, res->mean_m, res->p95_m, res->max_m);
+	/* Only the policy fills the reasons */
+	if(res->reasons[GPS_REPORT_NONE] != 0)
+	{
+		printf("   %lu/%lu/%lu/%lu/%lu",
+				(unsigned long)res->reasons[GPS_REPORT_FIRST],
+				(unsigned long)res->reasons[GPS_REPORT_DISTANCE],
+				(unsigned long)res->reasons[GPS_REPORT_HEADING],
+				(unsigned long)res->reasons[GPS_REPORT_SPEED],
+				(unsigned long)res->reasons[GPS_REPORT_SILENCE]);
+	}
+	printf("\n");
+}
+
+/** @fn static void replay_track(const st_host_track * track)
+ * @brief Policy against the two fixed intervals
+ */
+static void replay_track(const st_host_track * track)
+{
+	uint8_t * pub = malloc(track->count);
+	st_replay_result res;
+	uint32_t same_ms;
+	char mode[16];
+
+	if(pub == NULL)
+	{
+		exit(1);
+	}
+	replay_fixed(track, REPLAY_FIXED_MS, pub, &res);
+	snprintf(mode, sizeof(mode), "fixed %lus", (unsigned long)(REPLAY_FIXED_MS / 1000));
+	replay_print(track, mode, &res);
+
+	replay_policy(track, pub, &res);
+	replay_print(track, "policy", &res);
+
+	/* Fixed interval with the same budget */
+	same_ms = (track->fix[track->count - 1].tick - track->fix[0].tick + 1000U) / res.publishes;
+	replay_fixed(track, same_ms, pub, &res);
+	snprintf(mode, sizeof(mode), "fixed %lus", (unsigned long)((same_ms + 500U) / 1000U));
+	replay_print(track, mode, &res);
+	free(pub);
+}
+
+/*
+ * Replay entry - START
+ */
+int main(int argc, char ** argv)
+{
+	int count = (argc > 1) ? (argc - 1) : host_track_script_count;
+
+	printf("Report policy: min %lu s, silence %lu s, %lu m, %lu.%02lu deg above %lu cm/s, %lu cm/s\n",
+			(unsigned long)(GPS_REPORT_MIN_INTERVAL_MS / 1000),
+			(unsigned long)(GPS_REPORT_MAX_SILENCE_MS / 1000),
+			(unsigned long)GPS_REPORT_DISTANCE_M,
+			(unsigned long)(GPS_REPORT_HEADING_CDEG / 100),
+			(unsigned long)(GPS_REPORT_HEADING_CDEG % 100),
+			(unsigned long)GPS_REPORT_HEADING_MIN_CMS,
+			(unsigned long)GPS_REPORT_SPEED_DELTA_CMS);
+	printf("%-10s %-12s %7s %7s %7s %7s   %s\n",
+			"track", "mode", "pub/h", "mean_m", "p95_m", "max_m", "first/dist/head/speed/silence");
+	for(int a = 0; a < count; a++)
+	{
+		st_host_track track;
+		const char * spec = (argc > 1) ? argv[a + 1] : host_track_scripts[a].name;
+
+		if(MZ_OK != host_track_open(&track, spec))
+		{
+			fprintf(stderr, "%s: no track\n", spec);
+			return 1;
+		}
+		replay_track(&track);
+		host_track_free(&track);
+	}
+	return 0;
+}
+/* Replay entry - END */
@@ -0,0 +1,342 @@
+/*
+ * gps_rtos_sim.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  The GPS firmware on the FreeRTOS POSIX port (Host/rtos). gps_app_init()
+ *  of MZ_GPSSensor.c creates its threads and timers through the MonoZ and
+ *  CMSIS-RTOS2 wrappers as on the target, and the kernel schedules them,
+ *  its timer task and the idle task on the tick. The modem is the
+ *  emulator of MZ_gps_at.c, a command blocks the GPS thread in osDelay()
+ *  for its latency and the lower priority threads run meanwhile.
+ *
+ *  The receiver is simulated on LPUART1 : an epoch starts every second and
+ *  goes out at 9600 baud from the tick interrupt, the bytes due in each
+ *  tick are fed to the armed MZ_UART_Receive_IT() of the GPS thread, whose
+ *  callback runs in the tick as the LPUART1 interrupt does. Bytes that
+ *  arrive while no receive is armed are lost, and so is the end of an
+ *  epoch longer than a second on the line. The epochs come from an NMEA
+ *  file, e.g. written by gps_tracegen, one from each RMC to the next and
+ *  looped, or else from the synthetic receiver.
+ *
+ *  gps_rtos_replay is the same tool on the firmware with
+ *  GPS_REPLAY_ENABLE : the GPS thread takes the epochs from
+ *  gps_replay_poll() instead, gps_replay_source() below hands it the file.
+ *
+ *  A monitor task of high priority ends the run after the simulated time
+ *  and takes the run time of every task. Printed then : the run, LPUART1
+ *  counters, per task CPU share and ready to running latency, the depth
+ *  of the timer command queue (host_rtos.h), the AT path and backend
+ *  counters and gps_latency_dump(). Times of the task and queue tables
+ *  are host microseconds : the shares between the tasks and the
+ *  scheduling order are those of the firmware, the amounts are not the
+ *  Cortex-M4 ones. -x runs the kernel tick that many times faster than
+ *  real time, the run is too fast for the host when the simulated time
+ *  falls behind speed x wall time.
+ *
+ *  gps_rtos_sim [-t seconds] [-x speed] [-q] [nmea file]
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "host_rtos.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cmsis_os2.h"
+#include "MZ_GPSSensor.h"
+#include "MZ_uart.h"
+#include "MZ_gps_at.h"
+#include "MZ_gps_backend.h"
+#include "MZ_gps_latency.h"
+#include "MZ_gps_nmea_gen.h"
+#include "MZ_gps_replay.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "sys/resource.h"
+#include "unistd.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define SIM_SECONDS					(600)						///< Default simulated time, 5 reports
+#define SIM_SPEED					(20)						///< Default tick speed up
+#define SIM_GEN_EPOCHS				(600)						///< Epochs of the synthetic receiver, looped
+#define SIM_EPOCH_SIZE				(2048)						///< Largest generated epoch
+#define SIM_EPOCH_MS				(1000)						///< One epoch per second
+#define SIM_BAUD					(9600)						///< NMEA line rate
+#define SIM_BITS					(10)						///< Start, 8 data, stop
+#define SIM_MONITOR_STACK			(1024)						///< Monitor task stack, bytes
+/* Define some common use MACRO - END */
+
+/* Global Variables - START */
+static char * sim_trace;										/* NMEA text, NUL terminated */
+static uint32_t * sim_epoch_off;								/* Start of every epoch, one more for the end */
+static uint32_t sim_epochs;
+static uint32_t sim_seconds = SIM_SECONDS;
+#if(GPS_REPLAY_ENABLE != MZ_ENABLE)
+static uint32_t sim_line_epoch = 0xFFFFFFFF;					/* Epoch on the line */
+static uint32_t sim_line_sent;									/* Its bytes fed so far */
+static uint32_t sim_line_bytes;									/* Bytes fed */
+static uint32_t sim_line_cut;									/* Bytes cut by the next epoch */
+static uint32_t sim_rx_buffers;									/* Receive callbacks */
+static _uart_api sim_rx_cb;										/* Callback of the GPS thread */
+#endif
+/* Global Variables - END */
+
+/** @fn static int sim_out(const char * s)
+ * @brief Report output to stdout
+ */
+static int sim_out(const char * s)
+{
+	return fputs(s, stdout);
+}
+
+/** @fn static void sim_usage(void)
+ * @brief Usage and exit
+ */
+static void sim_usage(void)
+{
+	fprintf(stderr, "usage: gps_rtos_sim [-t seconds] [-x speed] [-q] [nmea file]\n");
+	exit(1);
+}
+
+/** @fn static void sim_load(const char * path)
+ * @brief NMEA file into sim_trace
+ */
+static void sim_load(const char * path)
+{
+	FILE * f = fopen(path, "rb");
+	long size;
+
+	if((f == NULL) || (fseek(f, 0, SEEK_END) != 0) || ((size = ftell(f)) <= 0))
+	{
+		fprintf(stderr, "%s: cannot read\n", path);
+		exit(1);
+	}
+	rewind(f);
+	sim_trace = malloc((size_t)size + 1);
+	if((sim_trace == NULL) || (fread(sim_trace, 1, (size_t)size, f) != (size_t)size))
+	{
+		fprintf(stderr, "%s: cannot read\n", path);
+		exit(1);
+	}
+	sim_trace[size] = '\0';
+	fclose(f);
+}
+
+/** @fn static void sim_generate(void)
+ * @brief SIM_GEN_EPOCHS of the synthetic receiver into sim_trace
+ */
+static void sim_generate(void)
+{
+	st_gps_nmea_gen_cfg cfg =
+	{
+		.lat_e7 = 356812360, .lon_e7 = 1397671250, .utc_time = 120000, .utc_date = 191026,
+		.speed_cms = 1200, .course_cdeg = 9000, .turn_cdeg_s = 50, .hdop_x100 = 95,
+		.rate_hz = 1, .sentences = GPS_NMEA_GEN_ALL,
+	};
+	st_gps_nmea_gen gen;
+	size_t len = 0;
+
+	sim_trace = malloc(((size_t)SIM_GEN_EPOCHS * SIM_EPOCH_SIZE) + 1);
+	if(sim_trace == NULL)
+	{
+		exit(1);
+	}
+	gps_nmea_gen_init(&gen, &cfg);
+	for(uint32_t e = 0; e < SIM_GEN_EPOCHS; e++)
+	{
+		len += gps_nmea_gen_epoch(&gen, &sim_trace[len], SIM_EPOCH_SIZE);
+	}
+	sim_trace[len] = '\0';
+}
+
+/** @fn static void sim_split(void)
+ * @brief Epoch offsets, every $G?RMC line starts one
+ */
+static void sim_split(void)
+{
+	size_t len = strlen(sim_trace);
+	uint32_t n = 0;
+
+	sim_epoch_off = malloc((len + 2) * sizeof(uint32_t));
+	if(sim_epoch_off == NULL)
+	{
+		exit(1);
+	}
+	for(size_t i = 0; (i + 6) <= len; i++)
+	{
+		if(((i == 0) || (sim_trace[i - 1] == '\n')) && (0 == strncmp(&sim_trace[i], "$G", 2)) &&
+		   (0 == strncmp(&sim_trace[i + 3], "RMC", 3)))
+		{
+			sim_epoch_off[n++] = (uint32_t)i;
+		}
+	}
+	if(n == 0)
+	{
+		/* No RMC, the whole file is one epoch */
+		sim_epoch_off[n++] = 0;
+	}
+	sim_epoch_off[n] = (uint32_t)len;
+	sim_epochs = n;
+}
+
+#if(GPS_REPLAY_ENABLE == MZ_ENABLE)
+/*
+ * Trace of the replay, the loaded or generated one. - START
+ */
+const char * gps_replay_source(void)
+{
+	return &sim_trace[sim_epoch_off[0]];
+}
+/* Trace of the replay, the loaded or generated one. - END */
+#else
+/** @fn static void sim_rx_intr(void * arg)
+ * @brief LPUART1 receive complete, counted before the GPS thread callback
+ */
+static void sim_rx_intr(void * arg)
+{
+	sim_rx_buffers++;
+	sim_rx_cb(arg);
+}
+#endif
+
+/*
+ * LPUART1 line, from the tick interrupt. - START
+ */
+void vApplicationTickHook(void)
+{
+#if(GPS_REPLAY_ENABLE != MZ_ENABLE)
+	TickType_t now = xTaskGetTickCountFromISR();
+	uint32_t e = now / SIM_EPOCH_MS;
+	uint32_t start = sim_epoch_off[e % sim_epochs];
+	uint32_t len = sim_epoch_off[(e % sim_epochs) + 1] - start;
+	uint32_t due = (((now % SIM_EPOCH_MS) + 1) * SIM_BAUD) / (SIM_BITS * 1000);
+
+	if(e != sim_line_epoch)
+	{
+		if(sim_line_epoch != 0xFFFFFFFF)
+		{
+			uint32_t prev = sim_line_epoch % sim_epochs;
+
+			sim_line_cut += (sim_epoch_off[prev + 1] - sim_epoch_off[prev]) - sim_line_sent;
+		}
+		sim_line_epoch = e;
+		sim_line_sent = 0;
+	}
+	if(due > len)
+	{
+		due = len;
+	}
+	if(due > sim_line_sent)
+	{
+		/* The receive callback runs from here, in interrupt context */
+		host_uart_feed(_LPUART1, (const uint8_t *)&sim_trace[start + sim_line_sent], (uint16_t)(due - sim_line_sent));
+		sim_line_bytes += due - sim_line_sent;
+		sim_line_sent = due;
+	}
+#endif
+}
+/* LPUART1 line, from the tick interrupt. - END */
+
+/** @fn static void sim_monitor(void * arg)
+ * @brief End of the run, above every application task
+ */
+static void sim_monitor(void * arg)
+{
+	(void)arg;
+
+	vTaskDelay(pdMS_TO_TICKS(sim_seconds * 1000));
+	host_rtos_snapshot();
+	vTaskEndScheduler();
+}
+
+/*
+ * Simulation entry - START
+ */
+int main(int argc, char ** argv)
+{
+	osThreadAttr_t attr;
+	st_gps_at_stats at;
+	st_gps_backend_stats bs;
+	struct rusage ru;
+	uint32_t speed = SIM_SPEED;
+	uint64_t wall;
+	int opt;
+
+	while(-1 != (opt = getopt(argc, argv, "t:x:q")))
+	{
+		switch(opt)
+		{
+			case 't': sim_seconds = (uint32_t)strtoul(optarg, NULL, 0); break;
+			case 'x': speed = (uint32_t)strtoul(optarg, NULL, 0); break;
+			case 'q': host_cli_file(NULL); break;
+			default: sim_usage();
+		}
+	}
+	if((optind < (argc - 1)) || (sim_seconds == 0) || (sim_seconds > 3600000) || (speed == 0) || (speed > 1000))
+	{
+		sim_usage();
+	}
+	if(optind == (argc - 1))
+	{
+		sim_load(argv[optind]);
+	}
+	else
+	{
+		sim_generate();
+	}
+	sim_split();
+
+	vPortSetTickPeriod(1000 / speed);
+	(void)osKernelInitialize();
+	if(MZ_OK != gps_app_init())
+	{
+		fprintf(stderr, "gps_app_init failed\n");
+		return 1;
+	}
+#if(GPS_REPLAY_ENABLE != MZ_ENABLE)
+	sim_rx_cb = MZ_UART_reference(_LPUART1)->rx_intr_api;
+	(void)MZ_UART_register_intr_cb_rx(_LPUART1, sim_rx_intr);
+#endif
+	memset(&attr, 0, sizeof(attr));
+	attr.name = "sim monitor";
+	attr.priority = osPriorityHigh;
+	attr.stack_size = SIM_MONITOR_STACK;
+	if(NULL == osThreadNew(sim_monitor, NULL, &attr))
+	{
+		fprintf(stderr, "monitor task not created\n");
+		return 1;
+	}
+
+	wall = host_ns();
+	(void)osKernelStart();
+	wall = host_ns() - wall;
+	getrusage(RUSAGE_SELF, &ru);
+
+	/* Tasks stay where the scheduler ended, stdout is the main thread's now */
+	printf("\n%lu s simulated at x%lu in %.2f s wall, %.2f s user %.2f s sys, %lu epochs in the trace\n",
+			(unsigned long)sim_seconds, (unsigned long)speed, wall / 1e9,
+			ru.ru_utime.tv_sec + (ru.ru_utime.tv_usec / 1e6), ru.ru_stime.tv_sec + (ru.ru_stime.tv_usec / 1e6),
+			(unsigned long)sim_epochs);
+#if(GPS_REPLAY_ENABLE != MZ_ENABLE)
+	printf("lpuart1: %lu bytes on the line, %lu receive buffers, %lu bytes lost without a receive armed, %lu cut by the next epoch\n",
+			(unsigned long)sim_line_bytes, (unsigned long)sim_rx_buffers,
+			(unsigned long)host_uart_overrun(_LPUART1), (unsigned long)sim_line_cut);
+#endif
+	host_rtos_report(sim_out);
+	gps_at_get_stats(&at);
+	printf("at: %lu cmds, %lu fails, %lu publishes %lu B, latency avg %lu max %lu ms\n",
+			(unsigned long)at.cmds, (unsigned long)at.fails, (unsigned long)at.publishes,
+			(unsigned long)at.publish_bytes, (unsigned long)((at.cmds != 0) ? (at.total_ms / at.cmds) : 0),
+			(unsigned long)at.max_ms);
+	gps_backend_get_stats(gps_backend_current(), &bs);
+	printf("backend %s: uploads %lu, fails %lu, msgs %lu, payload %lu B\n",
+			gps_backend_get(gps_backend_current())->name, (unsigned long)bs.uploads, (unsigned long)bs.fails,
+			(unsigned long)bs.msgs, (unsigned long)bs.payload_bytes);
+	gps_latency_dump(sim_out);
+	return 0;
+}
+/* Simulation entry - END */
@@ -0,0 +1,150 @@
+/*
+ * gps_rxpm_sim.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Receiver power management harness (MZ_gps_rxpm.h), on/off mode. The
+ *  NMEA generator emulates the NEO-6M: it takes the RXM-PMREQ frames of
+ *  gps_rxpm_poll(), sleeps in backup, wakes by itself and restarts hot,
+ *  warm or cold from the age of its ephemeris. Its epochs are parsed and
+ *  the valid fixes go through the report policy as in gps_fix_commit().
+ *
+ *  A stationary receiver is run from a cold boot in 100 ms steps. A report
+ *  later than one epoch after its deadline is late, a deadline that
+ *  passes without a fix is a miss of gps_rxpm. "outage" blanks the sky
+ *  for OUTAGE_MS after OUTAGE_AT_MS.
+ *
+ *  gps_rxpm_sim [sky | outage] [hours]
+ *  gps_rxpm_noeph [sky | outage] [hours]	no ephemeris refresh
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_gps_rxpm.h"
+#include "MZ_gps_nmea.h"
+#include "MZ_gps_nmea_gen.h"
+#include "MZ_gps_report_policy.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define SIM_HOURS					(24)						///< Default run
+#define SIM_STEP_MS					(100)						///< Poll period of gps_rxpm
+#define SIM_EPOCH_MS				(1000)						///< Receiver rate
+#define SIM_EPOCH_SIZE				(1024)						///< Largest generated epoch
+#define SIM_OUTAGE_AT_MS			(5 * 3600000UL)				///< Start of the outage
+#define SIM_OUTAGE_MS				(20 * 60000UL)				///< Length of the outage
+/* Define some common use MACRO - END */
+
+/*
+ * Simulation entry - START
+ */
+int main(int argc, char ** argv)
+{
+	st_gps_nmea_gen_cfg cfg =
+	{
+		.lat_e7 = 298653100, .lon_e7 = 778731228, .utc_time = 0, .utc_date = 300322,
+		.speed_cms = 0, .hdop_x100 = 95, .rate_hz = 1,
+		.sentences = GPS_NMEA_GEN_RMC | GPS_NMEA_GEN_GGA | GPS_NMEA_GEN_GSA,
+	};
+	static st_gps_nmea_gen gen;
+	static st_gps_rxpm pm;
+	static char epoch[SIM_EPOCH_SIZE];
+	uint8_t frame[GPS_RXPM_FRAME_SIZE];
+	st_gps_fix fix = {0};
+	uint8_t outage = ((argc > 1) && (0 == strcmp(argv[1], "outage")));
+	uint32_t hours = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : SIM_HOURS;
+	uint32_t outage_at = outage ? SIM_OUTAGE_AT_MS : 0xFFFFFFFFUL;
+	uint32_t last_utc = 0xFFFFFFFFUL;
+	uint32_t deadline = 0;
+	uint32_t reports = 0;
+	uint32_t late = 0;
+	uint32_t worst = 0;
+	uint32_t on_s = 0;
+	uint32_t starts[3] = {0};
+	uint8_t was_on = 1;
+
+	if((hours == 0) || ((argc > 1) && !outage && (0 != strcmp(argv[1], "sky"))))
+	{
+		fprintf(stderr, "usage: %s [sky | outage] [hours]\n", argv[0]);
+		return 1;
+	}
+	gps_nmea_gen_init(&gen, &cfg);
+	/* Cold boot */
+	gen.has_eph = 0;
+	gen.powered = 0;
+	gen.wake_cs = 0;
+	gps_report_policy_init(NULL);
+	gps_rxpm_init(&pm, 0);
+
+	for(uint32_t now = 0; now < (hours * 3600000UL); now += SIM_STEP_MS)
+	{
+		uint16_t len = gps_rxpm_poll(&pm, now, frame, sizeof(frame));
+		uint16_t n;
+
+		if(len != 0)
+		{
+			gps_nmea_gen_ubx_input(&gen, frame, len);
+		}
+		if(now == outage_at)
+		{
+			gps_nmea_gen_sky(&gen, 0);
+		}
+		if(now == (outage_at + SIM_OUTAGE_MS))
+		{
+			gps_nmea_gen_sky(&gen, 1);
+		}
+		if((now % SIM_EPOCH_MS) != 0)
+		{
+			continue;
+		}
+
+		n = gps_nmea_gen_epoch(&gen, epoch, sizeof(epoch));
+		if(gen.powered)
+		{
+			on_s++;
+			if(!was_on)
+			{
+				starts[gen.start]++;
+			}
+		}
+		was_on = gen.powered;
+		gps_nmea_parse_buffer(epoch, n, &fix, NULL);
+		if((n != 0) && (fix.valid == GPS_FIX_VALID) && (fix.utc_time != last_utc))
+		{
+			last_utc = fix.utc_time;
+			fix.tick = now;
+			gps_rxpm_fix(&pm, now);
+			if(GPS_REPORT_NONE != gps_report_policy_check(&fix))
+			{
+				if((reports != 0) && (now > deadline))
+				{
+					if((now - deadline) > SIM_EPOCH_MS)
+					{
+						late++;
+					}
+					if((now - deadline) > worst)
+					{
+						worst = now - deadline;
+					}
+				}
+				reports++;
+				deadline = now + GPS_RXPM_PERIOD_MS;
+				gps_rxpm_reported(&pm, now);
+			}
+		}
+	}
+	printf("%s, %lu h, ephemeris refresh %s\n", outage ? "outage 20 min" : "open sky", (unsigned long)hours,
+			(GPS_RXPM_EPH_REFRESH_MS == 0xFFFFFFFFUL) ? "off" : "on");
+	printf("reports %lu, late %lu, worst %lu ms, misses %lu\n", (unsigned long)reports, (unsigned long)late,
+			(unsigned long)worst, (unsigned long)pm.stats.misses);
+	printf("receiver on %.1f %%, offs %lu, starts hot/warm/cold %lu/%lu/%lu\n", 100.0 * on_s / (hours * 3600.0),
+			(unsigned long)pm.stats.offs, (unsigned long)starts[0], (unsigned long)starts[1], (unsigned long)starts[2]);
+	printf("lead %lu ms, ttff max %lu ms\n", (unsigned long)pm.lead_ms, (unsigned long)pm.stats.ttff_max);
+	return 0;
+}
+/* Simulation entry - END */
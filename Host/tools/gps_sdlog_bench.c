@@ -0,0 +1,253 @@
+/*
+ * gps_sdlog_bench.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  SD ring logger throughput benchmark on a file-backed card
+ *  (Host/stub/host_sd.c). Generated epochs go through
+ *  gps_sdlog_write_nmea() / gps_sdlog_write_fix() at the receiver rate and
+ *  gps_sdlog_poll() runs every 10 ms like the GPS thread loop, against
+ *  card timings from a fast card to one with long write spikes. After each
+ *  run the logger is initialized again on the same image, the recovered
+ *  head is checked and the ring is read back record by record.
+ *
+ *  gps_sdlog_bench [image] [seconds]
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_gps_sdlog.h"
+#include "MZ_gps_nmea_gen.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define BENCH_SECONDS				(600)						///< Simulated time per scenario
+#define BENCH_POLL_MS				(10)						///< GPS thread loop period
+#define BENCH_EPOCH_SIZE			(1024)						///< Largest epoch
+#define BENCH_CARD_BLOCKS			(GPS_SDLOG_START_BLOCK + GPS_SDLOG_RING_BLOCKS)
+/* Define some common use MACRO - END */
+
+extern SD_HandleTypeDef hsd1;
+
+/**
+ * @struct st_bench_case
+ * @brief Receiver output and card timing of one run
+ */
+typedef struct
+{
+	const char *		name;									/*!< Printed name */
+	uint8_t				rate_hz;								/*!< Epochs per second */
+	uint8_t				glonass;								/*!< $GN talker and $GLGSV */
+	uint32_t			kbytes_s;								/*!< Card write rate */
+	uint32_t			busy_ms;								/*!< Card cost per write */
+	uint32_t			spike_ms;								/*!< Slow write */
+	uint32_t			spike_every;							/*!< Every Nth write is slow */
+}st_bench_case;
+
+static const st_bench_case bench_cases[] =
+{
+	{ "1Hz, fast card",				1,	0,	2000,	2,	0,		0 },
+	{ "10Hz, fast card",			10,	0,	2000,	2,	0,		0 },
+	{ "10Hz gnss, slow card",		10,	1,	50,		100,	0,		0 },
+	{ "10Hz, 250ms spikes /8",		10,	0,	2000,	2,	250,	8 },
+	{ "10Hz gnss, 1s spikes /4",	10,	1,	2000,	2,	1000,	4 },
+};
+
+/**
+ * @struct st_bench_readback
+ * @brief Records found in the ring after the run
+ */
+typedef struct
+{
+	uint32_t		blocks;										/*!< Valid data blocks */
+	uint32_t		nmea_bytes;									/*!< Raw NMEA bytes */
+	uint32_t		fixes;										/*!< Fix records */
+	uint32_t		bad;										/*!< Blocks with a wrong header or record */
+}st_bench_readback;
+
+/** @fn static void bench_readback(uint32_t first_seq, uint32_t next_seq, st_bench_readback * rb)
+ * @brief Read the blocks of a sequence range back from the image
+ */
+static void bench_readback(uint32_t first_seq, uint32_t next_seq, st_bench_readback * rb)
+{
+	static uint8_t blk[GPS_SDLOG_BLOCK_SIZE];
+	const st_gps_sdlog_block_hdr * hdr = (const st_gps_sdlog_block_hdr *)blk;
+
+	memset(rb, 0, sizeof(*rb));
+	for(uint32_t seq = first_seq; seq != next_seq; seq++)
+	{
+		uint32_t addr = GPS_SDLOG_START_BLOCK + (seq % GPS_SDLOG_RING_BLOCKS);
+		uint32_t off = sizeof(st_gps_sdlog_block_hdr);
+
+		if((HAL_OK != HAL_SD_ReadBlocks(&hsd1, blk, addr, 1, 0)) ||
+		   (GPS_SDLOG_BLOCK_MAGIC != hdr->magic) || (seq != hdr->seq) ||
+		   (hdr->used > GPS_SDLOG_BLOCK_SIZE))
+		{
+			rb->bad++;
+			continue;
+		}
+		rb->blocks++;
+		while((off + 2) <= hdr->used)
+		{
+			uint8_t type = blk[off];
+			uint8_t len = blk[off + 1];
+
+			if((off + 2 + len) > hdr->used)
+			{
+				rb->bad++;
+				break;
+			}
+			if(GPS_SDLOG_REC_NMEA == type)
+			{
+				rb->nmea_bytes += len;
+			}
+			else if((GPS_SDLOG_REC_FIX == type) && (len == sizeof(st_gps_fix)))
+			{
+				rb->fixes++;
+			}
+			off += 2U + len;
+		}
+	}
+}
+
+/** @fn static void bench_case(const st_bench_case * bc, const char * image, uint32_t seconds)
+ * @brief Run one scenario on a fresh image
+ */
+static void bench_case(const st_bench_case * bc, const char * image, uint32_t seconds)
+{
+	st_gps_nmea_gen_cfg cfg =
+	{
+		.lat_e7 = 298653100,
+		.lon_e7 = 778731228,
+		.utc_time = 101902,
+		.utc_date = 300322,
+		.speed_cms = 1400,
+		.course_cdeg = 4500,
+		.turn_cdeg_s = 150,
+		.hdop_x100 = 120,
+		.rate_hz = bc->rate_hz,
+		.sentences = GPS_NMEA_GEN_ALL,
+		.glonass = bc->glonass,
+		.hot_s = 1,
+		.warm_s = 1,
+		.cold_s = 1,
+	};
+	static st_gps_nmea_gen gen;
+	static char epoch[BENCH_EPOCH_SIZE];
+	const uint32_t epoch_ms = 1000U / bc->rate_hz;
+	st_gps_sdlog_stats st;
+	st_gps_sdlog_stats st_boot;
+	st_host_sd_stats card;
+	st_bench_readback rb;
+	uint64_t offered = 0;
+	uint32_t fixes = 0;
+	uint64_t ns = 0;
+	uint32_t next_epoch = 0;
+	uint32_t start_seq;
+	int64_t missing;
+
+	remove(image);
+	if((MZ_OK != host_sd_open(image, BENCH_CARD_BLOCKS)) || (MZ_OK != gps_sdlog_init()))
+	{
+		fprintf(stderr, "%s: cannot open %s\n", bc->name, image);
+		exit(1);
+	}
+	host_sd_timing(bc->kbytes_s, bc->busy_ms, bc->spike_ms, bc->spike_every);
+	gps_nmea_gen_init(&gen, &cfg);
+	gps_sdlog_get_stats(&st);
+	start_seq = st.next_seq;
+
+	for(uint32_t t = 0; t < (seconds * 1000U); t += BENCH_POLL_MS)
+	{
+		uint64_t t0;
+
+		if(t >= next_epoch)
+		{
+			uint16_t len = gps_nmea_gen_epoch(&gen, epoch, sizeof(epoch));
+
+			t0 = host_ns();
+			gps_sdlog_write_nmea(epoch, len);
+			gps_sdlog_write_fix(&gen.fix);
+			ns += host_ns() - t0;
+			offered += len;
+			fixes++;
+			next_epoch += epoch_ms;
+		}
+		t0 = host_ns();
+		gps_sdlog_poll();
+		ns += host_ns() - t0;
+		host_tick_advance(BENCH_POLL_MS);
+	}
+
+	/* Let the aged buffer flush and the card finish */
+	for(uint32_t t = 0; t < (GPS_SDLOG_FLUSH_MS + 5000U); t += BENCH_POLL_MS)
+	{
+		gps_sdlog_poll();
+		host_tick_advance(BENCH_POLL_MS);
+	}
+	gps_sdlog_get_stats(&st);
+	host_sd_get_stats(&card);
+
+	/* Boot again on the same card and read the ring back */
+	if(MZ_OK != gps_sdlog_init())
+	{
+		fprintf(stderr, "%s: init after the run failed\n", bc->name);
+		exit(1);
+	}
+	gps_sdlog_get_stats(&st_boot);
+	bench_readback(start_seq, st_boot.next_seq, &rb);
+
+	/* Every byte taken is on the card, the others were counted as dropped */
+	missing = (int64_t)(offered + ((uint64_t)fixes * sizeof(st_gps_fix))) - st.dropped_bytes -
+			  rb.nmea_bytes - ((uint64_t)rb.fixes * sizeof(st_gps_fix));
+
+	printf("%-24s %6lu %6lu %6lu %8lu %5.1f %5lu %6.1f %4s %8lu %5lu %7ld %3lu\n",
+			bc->name,
+			(unsigned long)(offered / seconds),
+			(unsigned long)st.bursts,
+			(unsigned long)st.blocks_written,
+			(unsigned long)st.dropped_bytes,
+			100.0 * card.busy_ms / (seconds * 1000.0 + GPS_SDLOG_FLUSH_MS + 5000.0),
+			(unsigned long)card.max_busy_ms,
+			(double)ns / (double)offered,
+			(st_boot.next_seq == st.next_seq) ? "ok" : "LOST",
+			(unsigned long)rb.nmea_bytes,
+			(unsigned long)rb.fixes,
+			(long)missing,
+			(unsigned long)rb.bad);
+
+	host_sd_close();
+}
+
+/*
+ * Benchmark entry - START
+ */
+int main(int argc, char ** argv)
+{
+	const char * image = (argc > 1) ? argv[1] : "gps_sdlog.img";
+	uint32_t seconds = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : BENCH_SECONDS;
+
+	if(seconds == 0)
+	{
+		fprintf(stderr, "usage: gps_sdlog_bench [image] [seconds]\n");
+		return 1;
+	}
+
+	printf("SD ring logger, %lu s per run, %u blocks per burst, poll every %u ms\n",
+			(unsigned long)seconds, GPS_SDLOG_BLOCKS_PER_BUF, BENCH_POLL_MS);
+	printf("%-24s %6s %6s %6s %8s %5s %5s %6s %4s %8s %5s %7s %3s\n",
+			"case", "B/s", "bursts", "blocks", "dropped", "busy%", "maxms", "ns/B",
+			"head", "nmea_rd", "fixes", "missing", "bad");
+	for(uint32_t i = 0; i < (sizeof(bench_cases) / sizeof(bench_cases[0])); i++)
+	{
+		bench_case(&bench_cases[i], image, seconds);
+	}
+	remove(image);
+	return 0;
+}
+/* Benchmark entry - END */
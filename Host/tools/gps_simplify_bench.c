@@ -0,0 +1,208 @@
+/*
+ * gps_simplify_bench.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Track simplifier benchmark. Every fix of a track is pushed through
+ *  gps_simplify_push() as in gps_fix_commit(), at several tolerances, and
+ *  the track is flushed at its end. The result is the compression ratio,
+ *  the largest distance of a dropped fix from the kept polyline (which
+ *  must stay within the tolerance) and the time per pushed point as mean
+ *  and maximum.
+ *
+ *  gps_simplify_bench [rounds] [track | nmea log ...]
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "host_track.h"
+#include "MZ_gps_track_simplify.h"
+#include "math.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define BENCH_ROUNDS				(20)						///< Passes over a track for the timing
+/* Define some common use MACRO - END */
+
+static const uint32_t bench_tol_cm[] = { 250, 500, GPS_SIMPLIFY_TOLERANCE_CM, 2500 };
+
+/* Global Variables - START */
+static uint32_t * bench_kept;									/* Ticks of the emitted fixes */
+static uint32_t bench_kept_count;
+/* Global Variables - END */
+
+/** @fn static void bench_emit(const st_gps_fix * fix)
+ * @brief Record an emitted fix
+ */
+static void bench_emit(const st_gps_fix * fix)
+{
+	bench_kept[bench_kept_count++] = fix->tick;
+}
+
+/** @fn static void bench_nop(const st_gps_fix * fix)
+ * @brief Emit callback of the timed runs
+ */
+static void bench_nop(const st_gps_fix * fix)
+{
+}
+
+/** @fn static double bench_seg_dist(const st_gps_fix * a, const st_gps_fix * b, const st_gps_fix * p)
+ * @brief Distance in cm of p from the segment a..b
+ */
+static double bench_seg_dist(const st_gps_fix * a, const st_gps_fix * b, const st_gps_fix * p)
+{
+	int32_t be, bn, pe, pn;
+	double len2;
+	double k;
+
+	gps_fix_offset_cm(a->lat_e7, a->lon_e7, b->lat_e7, b->lon_e7, &be, &bn);
+	gps_fix_offset_cm(a->lat_e7, a->lon_e7, p->lat_e7, p->lon_e7, &pe, &pn);
+	len2 = ((double)be * be) + ((double)bn * bn);
+	k = (len2 > 0) ? ((((double)pe * be) + ((double)pn * bn)) / len2) : 0.0;
+	k = (k < 0) ? 0 : ((k > 1) ? 1 : k);
+	return hypot(pe - (k * be), pn - (k * bn));
+}
+
+/** @fn static void bench_run(const st_host_track * track, uint32_t tol_cm, uint32_t rounds)
+ * @brief Simplify a track at one tolerance
+ */
+static void bench_run(const st_host_track * track, uint32_t tol_cm, uint32_t rounds)
+{
+	static st_gps_simplify ctx;
+	uint32_t max_ns = UINT32_MAX;
+	double max_cm = 0;
+	uint64_t total;
+	uint64_t t0;
+	uint32_t k = 0;
+
+	/* Kept points and the error of the dropped ones */
+	bench_kept_count = 0;
+	gps_simplify_init(&ctx, tol_cm, bench_emit);
+	for(uint32_t i = 0; i < track->count; i++)
+	{
+		gps_simplify_push(&ctx, &track->fix[i]);
+	}
+	gps_simplify_flush(&ctx);
+
+	for(uint32_t i = 0; (i < track->count) && ((k + 1) < bench_kept_count); i++)
+	{
+		const st_gps_fix * a;
+		const st_gps_fix * b;
+		double d;
+
+		if(track->fix[i].tick == bench_kept[k + 1])
+		{
+			k++;
+			continue;
+		}
+		/* Fix i lies between the kept k and k + 1 */
+		a = &track->fix[i];
+		while(a->tick != bench_kept[k])
+		{
+			a--;
+		}
+		b = &track->fix[i];
+		while(b->tick != bench_kept[k + 1])
+		{
+			b++;
+		}
+		d = bench_seg_dist(a, b, &track->fix[i]);
+		if(d > max_cm)
+		{
+			max_cm = d;
+		}
+	}
+
+	/* Time per point, the slowest push is the best of all rounds */
+	for(uint32_t r = 0; r < rounds; r++)
+	{
+		uint32_t round_max = 0;
+
+		gps_simplify_init(&ctx, tol_cm, bench_nop);
+		for(uint32_t i = 0; i < track->count; i++)
+		{
+			uint32_t dt;
+
+			t0 = host_ns();
+			gps_simplify_push(&ctx, &track->fix[i]);
+			dt = (uint32_t)(host_ns() - t0);
+			if(dt > round_max)
+			{
+				round_max = dt;
+			}
+		}
+		if(round_max < max_ns)
+		{
+			max_ns = round_max;
+		}
+	}
+	t0 = host_ns();
+	for(uint32_t r = 0; r < rounds; r++)
+	{
+		gps_simplify_init(&ctx, tol_cm, bench_nop);
+		for(uint32_t i = 0; i < track->count; i++)
+		{
+			gps_simplify_push(&ctx, &track->fix[i]);
+		}
+	}
+	total = host_ns() - t0;
+
+	printf("%-10s %6lu %6lu %6lu %6.1f %7.1f %6.1f %6lu\n",
+			track->name,
+			(unsigned long)tol_cm,
+			(unsigned long)track->count,
+			(unsigned long)bench_kept_count,
+			(double)track->count / bench_kept_count,
+			max_cm,
+			(double)total / ((double)rounds * track->count),
+			(unsigned long)max_ns);
+}
+
+/*
+ * Benchmark entry - START
+ */
+int main(int argc, char ** argv)
+{
+	uint32_t rounds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_ROUNDS;
+	int count = (argc > 2) ? (argc - 2) : host_track_script_count;
+
+	if(rounds == 0)
+	{
+		fprintf(stderr, "usage: gps_simplify_bench [rounds] [track | nmea log ...]\n");
+		return 1;
+	}
+
+	printf("Track simplifier, window %u, segments up to %lu m\n",
+			GPS_SIMPLIFY_WINDOW, (unsigned long)(GPS_SIMPLIFY_MAX_SEG_CM / 100));
+	printf("%-10s %6s %6s %6s %6s %7s %6s %6s\n",
+			"track", "tol_cm", "in", "kept", "ratio", "err_cm", "ns", "max");
+	for(int a = 0; a < count; a++)
+	{
+		st_host_track track;
+		const char * spec = (argc > 2) ? argv[a + 2] : host_track_scripts[a].name;
+
+		if(MZ_OK != host_track_open(&track, spec))
+		{
+			fprintf(stderr, "%s: no track\n", spec);
+			return 1;
+		}
+		bench_kept = malloc(track.count * sizeof(uint32_t));
+		if(bench_kept == NULL)
+		{
+			return 1;
+		}
+		for(uint8_t t = 0; t < (sizeof(bench_tol_cm) / sizeof(bench_tol_cm[0])); t++)
+		{
+			bench_run(&track, bench_tol_cm[t], rounds);
+		}
+		free(bench_kept);
+		host_track_free(&track);
+	}
+	return 0;
+}
+/* Benchmark entry - END */
@@ -0,0 +1,132 @@
+/*
+ * gps_time_sim.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  RTC discipline harness (MZ_gps_time.h). An RTC with a crystal error of
+ *  a few ppm plus a slow random wander runs for SIM_DAYS days against
+ *  true time. While the GPS is on, the first SIM_GPS_ON_S of each day, it
+ *  is compared every GPS_TIME_SAMPLE_MS through gps_time_sample() and the
+ *  step, shift and calibration actions are applied as gps_time_commit()
+ *  does. The RTC is read in 1/SIM_FRAC_HZ s, as from RTC_SSR.
+ *
+ *  Prints the RTC offset every 6 h and the largest offset after the
+ *  first day, free running and disciplined, for each crystal error.
+ *
+ *  gps_time_sim [ppm ...]
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_gps_time.h"
+#include "math.h"
+#include "stdio.h"
+#include "stdlib.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define SIM_DAYS					(3)							///< Length of a run
+#define SIM_DAY_S					(86400)
+#define SIM_GPS_ON_S				(6 * 3600)					///< GPS on at the start of each day
+#define SIM_PRINT_S					(6 * 3600)					///< Offset line period
+#define SIM_FRAC_HZ					(256)						///< PREDIV_S + 1
+#define SIM_WANDER_PPM				(0.5)						///< Bound of the random wander
+#define SIM_WANDER_STEP_PPM			(2e-6)						///< Largest wander step per second
+#define SIM_EPOCH_MS				(1700000000000ULL)			///< GPS time at the start
+/* Define some common use MACRO - END */
+
+/* Crystal errors of the default run, ppm */
+static const double sim_ppm[] = { 20.0, -35.0 };
+
+/* Global Variables - START */
+static uint32_t sim_seed;
+/* Global Variables - END */
+
+/** @fn static double sim_rand(void)
+ * @brief Repeatable pseudo random number in [-1, 1]
+ */
+static double sim_rand(void)
+{
+	sim_seed = (sim_seed * 1103515245U) + 12345U;
+	return (double)((int32_t)((sim_seed >> 8) % 2001) - 1000) / 1000.0;
+}
+
+/** @fn static void sim_run(double ppm, uint8_t discipline)
+ * @brief SIM_DAYS days of one RTC
+ */
+static void sim_run(double ppm, uint8_t discipline)
+{
+	st_gps_time t;
+	st_gps_time_action act;
+	double off = 0;												/* RTC minus true time, s */
+	double cal_ppb = 0;
+	double wander = 0;
+	double worst = 0;
+
+	printf("%+.0f ppm, %s\n", ppm, discipline ? "disciplined" : "free running");
+	sim_seed = 1;
+	gps_time_reset(&t, 0, 0, SIM_FRAC_HZ);
+	for(uint32_t s = 0; s < (SIM_DAYS * SIM_DAY_S); s++)
+	{
+		wander += sim_rand() * SIM_WANDER_STEP_PPM;
+		wander = fmin(fmax(wander, -SIM_WANDER_PPM), SIM_WANDER_PPM);
+		off += ((ppm + wander) * 1e-6) + (cal_ppb * 1e-9);
+
+		if(discipline && ((s % SIM_DAY_S) < SIM_GPS_ON_S) && (((uint64_t)s * 1000) % GPS_TIME_SAMPLE_MS) == 0)
+		{
+			uint64_t gps_ms = SIM_EPOCH_MS + ((uint64_t)s * 1000);
+			uint64_t rtc_ms = gps_ms + (int64_t)floor(off * SIM_FRAC_HZ) * 1000 / SIM_FRAC_HZ;
+
+			gps_time_sample(&t, gps_ms, rtc_ms, &act);
+			if(act.step)
+			{
+				off = 0;
+				gps_time_sample(&t, gps_ms, gps_ms, &act);
+			}
+			if(act.cal)
+			{
+				cal_ppb = gps_time_cal_ppb(act.cal_units);
+			}
+			if(act.shift_frac != 0)
+			{
+				off -= (double)act.shift_frac / SIM_FRAC_HZ;
+			}
+		}
+		if((s >= SIM_DAY_S) && (fabs(off) > worst))
+		{
+			worst = fabs(off);
+		}
+		if((s % SIM_PRINT_S) == 0)
+		{
+			printf("  %3lu h: offset %9.3f ms, calibration %6.0f ppb, fitted drift %6ld ppb\n",
+					(unsigned long)(s / 3600), off * 1000, cal_ppb, (long)t.stats.drift_ppb);
+		}
+	}
+	printf("  largest offset after day 1: %.3f ms, steps %lu, shifts %lu, calibrations %lu\n", worst * 1000,
+			(unsigned long)t.stats.steps, (unsigned long)t.stats.shifts, (unsigned long)t.stats.cals);
+}
+
+/*
+ * Simulation entry - START
+ */
+int main(int argc, char ** argv)
+{
+	if(argc > 1)
+	{
+		for(int i = 1; i < argc; i++)
+		{
+			sim_run(atof(argv[i]), 0);
+			sim_run(atof(argv[i]), 1);
+		}
+		return 0;
+	}
+	for(uint8_t i = 0; i < (sizeof(sim_ppm) / sizeof(sim_ppm[0])); i++)
+	{
+		sim_run(sim_ppm[i], 0);
+		sim_run(sim_ppm[i], 1);
+	}
+	return 0;
+}
+/* Simulation entry - END */
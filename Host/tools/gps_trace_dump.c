@@ -0,0 +1,185 @@
+/*
+ * gps_trace_dump.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Post-mortem trace decoder. Prints a raw image of gps_trace_buf, as
+ *  dumped with the debugger (MZ_gps_trace.h), through gps_trace_decode():
+ *  records oldest first with their HAL tick and the cycles since the
+ *  previous record.
+ *
+ *  -w writes an image of a simulated run instead, two boots with epochs
+ *  over a few minutes of HAL tick, to try the decoder on.
+ *  -b measures the cost of a record: every gps_trace_event() is
+ *  bracketed by the GPS_PROF_TRACE probe the firmware puts around the
+ *  commit event, the prof dump gives its distribution, the bulk loop the
+ *  mean without the probe.
+ *
+ *  gps_trace_dump <image> [last]
+ *  gps_trace_dump -w <image>
+ *  gps_trace_dump -b [events]
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_gps_trace.h"
+#include "MZ_gps_prof.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define DUMP_BENCH_EVENTS			(1000000)					///< Records of the -b run
+#define DUMP_RUN_EPOCHS				(180)						///< Epochs of the -w run, one per second
+/* Define some common use MACRO - END */
+
+extern st_gps_trace_buf gps_trace_buf;
+
+/** @fn static int dump_out(const char * s)
+ * @brief Decoder output to stdout
+ */
+static int dump_out(const char * s)
+{
+	return fputs(s, stdout);
+}
+
+/** @fn static uint64_t dump_cycles(void)
+ * @brief Time stamp counter where the host has one. The builtin, because
+ * the intrinsic headers clash with the CMSIS __I / __O macros.
+ */
+static uint64_t dump_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __builtin_ia32_rdtsc();
+#else
+	return 0;
+#endif
+}
+
+/** @fn static int dump_read(const char * path, uint32_t last)
+ * @brief Decode an image
+ */
+static int dump_read(const char * path, uint32_t last)
+{
+	static st_gps_trace_buf image;
+	FILE * f = fopen(path, "rb");
+	size_t n;
+
+	if(f == NULL)
+	{
+		fprintf(stderr, "%s: cannot read\n", path);
+		return 1;
+	}
+	n = fread(&image, 1, sizeof(image), f);
+	fclose(f);
+	if(n != sizeof(image))
+	{
+		/* The ring size is GPS_TRACE_RECORDS of the firmware */
+		fprintf(stderr, "%s: %lu bytes, a ring of %u records is %lu\n",
+				path, (unsigned long)n, GPS_TRACE_RECORDS, (unsigned long)sizeof(image));
+		return 1;
+	}
+	gps_trace_decode(&image, last, dump_out);
+	return 0;
+}
+
+/** @fn static int dump_write(const char * path)
+ * @brief Image of a simulated run : a boot, epochs, a failed AT command,
+ * an Error_Handler and the boot after it
+ */
+static int dump_write(const char * path)
+{
+	FILE * f = fopen(path, "wb");
+
+	if(f == NULL)
+	{
+		fprintf(stderr, "%s: cannot write\n", path);
+		return 1;
+	}
+	memset(&gps_trace_buf, 0, sizeof(gps_trace_buf));
+	host_tick_set(0);
+	gps_trace_init();
+	for(uint32_t e = 0; e < DUMP_RUN_EPOCHS; e++)
+	{
+		host_tick_advance(1000);
+		gps_trace_event(GPS_TRACE_UART_RX, 0);
+		gps_trace_event(GPS_TRACE_COMMIT, 101902 + ((e / 60) * 100) + (e % 60));
+		if((e % 60) == 59)
+		{
+			gps_trace_event(GPS_TRACE_PUBLISH, 212);
+			host_tick_advance(150);
+			gps_trace_event(GPS_TRACE_AT_FAIL, 0x000001);
+			gps_trace_event(GPS_TRACE_PUBLISH_DONE, 0x000001);
+		}
+	}
+	gps_trace_event(GPS_TRACE_ERROR, 0x08012345);
+
+	/* The ring survives the reset */
+	host_tick_set(0);
+	gps_trace_init();
+	fwrite(&gps_trace_buf, 1, sizeof(gps_trace_buf), f);
+	fclose(f);
+	fprintf(stderr, "%s: %lu records, %lu bytes\n", path, (unsigned long)gps_trace_buf.head, (unsigned long)sizeof(gps_trace_buf));
+	return 0;
+}
+
+/** @fn static int dump_bench(uint32_t events)
+ * @brief Cost of gps_trace_event() under GPS_PROF
+ */
+static int dump_bench(uint32_t events)
+{
+	uint64_t ns;
+	uint64_t cycles;
+
+	gps_trace_init();
+	gps_prof_init();
+	for(uint32_t i = 0; i < events; i++)
+	{
+		GPS_PROF_BEGIN(GPS_PROF_TRACE);
+		gps_trace_event(GPS_TRACE_COMMIT, i);
+		GPS_PROF_END(GPS_PROF_TRACE);
+	}
+	printf("gps_trace_event under GPS_PROF_TRACE, probe included:\n");
+	gps_prof_dump(dump_out);
+
+	ns = host_ns();
+	cycles = dump_cycles();
+	for(uint32_t i = 0; i < events; i++)
+	{
+		gps_trace_event(GPS_TRACE_COMMIT, i);
+	}
+	cycles = dump_cycles() - cycles;
+	ns = host_ns() - ns;
+	printf("bulk: %lu records, %.1f ns, %.0f tsc per record\n",
+			(unsigned long)events, (double)ns / events, (double)cycles / events);
+	return 0;
+}
+
+/*
+ * Decoder entry - START
+ */
+int main(int argc, char ** argv)
+{
+	if((argc >= 2) && (0 == strcmp(argv[1], "-b")))
+	{
+		uint32_t events = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : DUMP_BENCH_EVENTS;
+
+		return (events != 0) ? dump_bench(events) : 1;
+	}
+	if((argc == 3) && (0 == strcmp(argv[1], "-w")))
+	{
+		return dump_write(argv[2]);
+	}
+	if((argc == 2) || ((argc == 3) && (argv[1][0] != '-')))
+	{
+		return dump_read(argv[1], (argc == 3) ? (uint32_t)strtoul(argv[2], NULL, 0) : 0);
+	}
+	fprintf(stderr, "usage: gps_trace_dump <image> [last]\n"
+					"       gps_trace_dump -w <image>\n"
+					"       gps_trace_dump -b [events]\n");
+	return 1;
+}
+/* Decoder entry - END */
@@ -0,0 +1,246 @@
+/*
+ * gps_tracegen.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Receiver trace generator. Drives MZ_gps_nmea_gen.c through one of the
+ *  scripted tracks of host_track.c and writes what LPUART1 would receive.
+ *
+ *    <out>       NMEA byte stream
+ *    <out>.rx    length of every receive buffer, one per line: one per
+ *                epoch, or -s pieces per epoch for sentences cut between
+ *                buffers (GPS_REPLAY_SPLIT is -s 2)
+ *    -u <file>   UBX NAV-POSLLH frame of every epoch
+ *
+ *  gps_bench reads the stream back in those buffers. -p neo6m starts at
+ *  the epoch quoted in the gps_app_thread comment, at rest with its HDOP,
+ *  satellites and DOPs, so the file has the line shapes of that comment.
+ *
+ *  gps_tracegen [-t track] [-n seconds] [-r hz] [-m rmc,vtg,gga,gsa,gsv,gll]
+ *               [-g] [-c every] [-d every] [-s pieces] [-u ubx] [-p neo6m] <out>
+ */
+
+/* Include Header Files - START */
+
+#include "host_track.h"
+#include "MZ_gps_nmea_gen.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "unistd.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define GEN_EPOCH_SIZE				(1024)						///< Largest epoch, $GN with GLGSV fits
+#define GEN_UBX_SIZE				(64)						///< NAV-POSLLH frame
+#define GEN_MAX_PIECES				(8)							///< Receive buffers per epoch
+/* Define some common use MACRO - END */
+
+/**
+ * @struct st_gen_sentence
+ * @brief Name of a sentence mask bit
+ */
+typedef struct
+{
+	const char *	name;										/*!< -m name */
+	uint8_t			bit;										/*!< GPS_NMEA_GEN_* */
+}st_gen_sentence;
+
+static const st_gen_sentence gen_sentences[] =
+{
+	{ "rmc",	GPS_NMEA_GEN_RMC },
+	{ "vtg",	GPS_NMEA_GEN_VTG },
+	{ "gga",	GPS_NMEA_GEN_GGA },
+	{ "gsa",	GPS_NMEA_GEN_GSA },
+	{ "gsv",	GPS_NMEA_GEN_GSV },
+	{ "gll",	GPS_NMEA_GEN_GLL },
+	{ "all",	GPS_NMEA_GEN_ALL },
+};
+
+/** @fn static void gen_usage(void)
+ * @brief Print the options and leave
+ */
+static void gen_usage(void)
+{
+	fprintf(stderr, "usage: gps_tracegen [-t track] [-n seconds] [-r hz] [-m rmc,vtg,gga,gsa,gsv,gll]\n"
+					"                    [-g] [-c every] [-d every] [-s pieces] [-u ubx] [-p neo6m] <out>\n"
+					"tracks:");
+	for(uint8_t i = 0; i < host_track_script_count; i++)
+	{
+		fprintf(stderr, " %s", host_track_scripts[i].name);
+	}
+	fprintf(stderr, "\n");
+	exit(1);
+}
+
+/** @fn static uint8_t gen_mask(char * list)
+ * @brief Sentence mask of a comma separated list
+ */
+static uint8_t gen_mask(char * list)
+{
+	uint8_t mask = 0;
+
+	for(char * tok = strtok(list, ","); tok != NULL; tok = strtok(NULL, ","))
+	{
+		uint8_t i;
+
+		for(i = 0; i < (sizeof(gen_sentences) / sizeof(gen_sentences[0])); i++)
+		{
+			if(0 == strcmp(tok, gen_sentences[i].name))
+			{
+				mask |= gen_sentences[i].bit;
+				break;
+			}
+		}
+		if(i == (sizeof(gen_sentences) / sizeof(gen_sentences[0])))
+		{
+			gen_usage();
+		}
+	}
+	return mask;
+}
+
+/*
+ * Generator entry - START
+ */
+int main(int argc, char ** argv)
+{
+	st_gps_nmea_gen_cfg cfg =
+	{
+		.lat_e7 = 298653100,
+		.lon_e7 = 778731228,
+		.utc_time = 101902,
+		.utc_date = 300322,
+		.course_cdeg = 4500,
+		.hdop_x100 = 120,
+		.rate_hz = 1,
+		.sentences = GPS_NMEA_GEN_ALL,
+		.hot_s = 1,
+	};
+	static st_gps_nmea_gen gen;
+	static char epoch[GEN_EPOCH_SIZE];
+	const st_host_track_script * script = NULL;
+	const char * track = "urban";
+	const char * ubx_path = NULL;
+	uint32_t seconds = 0;
+	uint32_t pieces = 1;
+	uint8_t neo6m = 0;
+	uint32_t epochs = 0;
+	uint64_t bytes = 0;
+	char rx_path[256];
+	FILE * out;
+	FILE * rx;
+	FILE * ubx = NULL;
+	int opt;
+
+	while(-1 != (opt = getopt(argc, argv, "t:n:r:m:gc:d:s:u:p:")))
+	{
+		switch(opt)
+		{
+			case 't': track = optarg; break;
+			case 'n': seconds = (uint32_t)strtoul(optarg, NULL, 0); break;
+			case 'r': cfg.rate_hz = (uint8_t)strtoul(optarg, NULL, 0); break;
+			case 'm': cfg.sentences = gen_mask(optarg); break;
+			case 'g': cfg.glonass = 1; break;
+			case 'c': cfg.corrupt_every = (uint16_t)strtoul(optarg, NULL, 0); break;
+			case 'd': cfg.drop_every = (uint16_t)strtoul(optarg, NULL, 0); break;
+			case 's': pieces = (uint32_t)strtoul(optarg, NULL, 0); break;
+			case 'u': ubx_path = optarg; break;
+			case 'p': neo6m = (0 == strcmp(optarg, "neo6m")) ? 1 : 2; break;
+			default: gen_usage();
+		}
+	}
+	for(uint8_t i = 0; i < host_track_script_count; i++)
+	{
+		if(0 == strcmp(track, host_track_scripts[i].name))
+		{
+			script = &host_track_scripts[i];
+		}
+	}
+	if((optind != (argc - 1)) || (script == NULL) || (cfg.rate_hz == 0) || (cfg.rate_hz > 10) ||
+	   (cfg.sentences == 0) || (pieces == 0) || (pieces > GEN_MAX_PIECES) || (neo6m > 1))
+	{
+		gen_usage();
+	}
+	if(neo6m)
+	{
+		/* $GPGGA,101902.00,...,1,05,3.95,248.4,M,-36.3,M,,  $GPGSA,...,4.73,3.95,2.60 */
+		cfg.hdop_x100 = 395;
+		script = &host_track_scripts[0];
+	}
+
+	snprintf(rx_path, sizeof(rx_path), "%s.rx", argv[optind]);
+	out = fopen(argv[optind], "wb");
+	rx = fopen(rx_path, "w");
+	if(ubx_path != NULL)
+	{
+		ubx = fopen(ubx_path, "wb");
+	}
+	if((out == NULL) || (rx == NULL) || ((ubx_path != NULL) && (ubx == NULL)))
+	{
+		fprintf(stderr, "cannot write %s\n", argv[optind]);
+		return 1;
+	}
+
+	gps_nmea_gen_init(&gen, &cfg);
+	if(neo6m)
+	{
+		gen.fix.sats = 5;
+		gen.fix.pdop_x100 = 473;
+		gen.fix.vdop_x100 = 260;
+	}
+	for(uint8_t r = 0; r < script->repeat; r++)
+	{
+		for(uint8_t l = 0; l < script->leg_count; l++)
+		{
+			const st_host_track_leg * leg = &script->legs[l];
+
+			gen.cfg.speed_cms = neo6m ? 2 : leg->speed_cms;
+			gen.cfg.turn_cdeg_s = leg->turn_cdeg_s;
+			gen.fix.speed_cms = gen.cfg.speed_cms;
+			for(uint32_t e = 0; e < (leg->seconds * cfg.rate_hz); e++)
+			{
+				uint16_t len;
+				uint16_t at = 0;
+
+				if((seconds != 0) && (epochs >= (seconds * cfg.rate_hz)))
+				{
+					goto done;
+				}
+				if(ubx != NULL)
+				{
+					uint8_t frame[GEN_UBX_SIZE];
+
+					fwrite(frame, 1, gps_nmea_gen_ubx_posllh(&gen, frame, sizeof(frame)), ubx);
+				}
+				len = gps_nmea_gen_epoch(&gen, epoch, sizeof(epoch));
+				fwrite(epoch, 1, len, out);
+
+				/* Even cuts, the last piece takes the rest */
+				for(uint32_t p = 1; p <= pieces; p++)
+				{
+					uint16_t end = (p == pieces) ? len : (uint16_t)((len * p) / pieces);
+
+					fprintf(rx, "%u\n", end - at);
+					at = end;
+				}
+				bytes += len;
+				epochs++;
+			}
+		}
+	}
+
+done:
+	fclose(out);
+	fclose(rx);
+	if(ubx != NULL)
+	{
+		fclose(ubx);
+	}
+	fprintf(stderr, "%s: %lu epochs at %u Hz, %lu bytes, %lu sentences, %lu receive buffers\n",
+			argv[optind], (unsigned long)epochs, cfg.rate_hz, (unsigned long)bytes,
+			(unsigned long)gen.sentence_count, (unsigned long)(epochs * pieces));
+	return 0;
+}
+/* Generator entry - END */
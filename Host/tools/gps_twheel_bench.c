@@ -0,0 +1,307 @@
+/*
+ * gps_twheel_bench.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Timer wheel harness.
+ *
+ *  - check : random starts, restarts and stops of periodic and one shot
+ *    timers, every expiry compared with the tick it is due.
+ *  - wrap : a 1 s periodic timer over the HAL tick wrap, the wheel driven
+ *    by a GPS_TW_TICK_MS MonoZ timer as in MZ_GPSSensor.c, once with the
+ *    elapsed time (the firmware) and once with HAL_GetTick() /
+ *    GPS_TW_TICK_MS.
+ *  - cost : gps_tw_bench() with several timer counts against
+ *    mz_tm_start / mz_tm_stop and the expiry of MonoZ timers. The MonoZ
+ *    library is closed and does not run on the host, the mz_tm row
+ *    times host_timer.c, its model as a sorted FreeRTOS timer list
+ *    without the command queue to the timer task. It is not a measurement
+ *    of the library. The library has MZ_MAX_TIMER_COUNT timers.
+ *
+ *  gps_twheel_bench [rounds]
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_gps_twheel.h"
+#include "MZ_gps_prof.h"
+#include "MZ_timer.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define BENCH_ROUNDS				(2000)						///< Repetitions of the cost runs
+#define BENCH_CHECK_TIMERS			(500)						///< Timers of the check
+#define BENCH_CHECK_TICKS			(2000000)					///< Wheel ticks of the check
+#define BENCH_WRAP_BEFORE_MS		(60000)						///< Start of the wrap run before the HAL tick wraps
+#define BENCH_WRAP_RUN_MS			(180000)					///< Length of the wrap run
+#define BENCH_MAX_TIMERS			(1024)						///< Largest wheel of the cost run
+/* Define some common use MACRO - END */
+
+/**
+ * @struct st_bench_drive
+ * @brief Wheel driven by one MonoZ timer
+ */
+typedef struct
+{
+	st_gps_twheel		wheel;									/*!< Wheel */
+	st_gps_tw_timer		timer;									/*!< 1 s periodic timer */
+	uint32_t			last_ms;								/*!< HAL tick the wheel is moved up to */
+	uint32_t			fired;									/*!< Expiries */
+	uint32_t			after_wrap;								/*!< Expiries after the HAL tick wrapped */
+}st_bench_drive;
+
+static const uint16_t bench_counts[] = { MZ_MAX_TIMER_COUNT, 64, 256, BENCH_MAX_TIMERS };
+
+/* Global Variables - START */
+static st_gps_twheel bench_wheel;
+static st_gps_tw_timer bench_timer[BENCH_CHECK_TIMERS];
+static uint32_t bench_due[BENCH_CHECK_TIMERS];
+static uint32_t bench_cur;
+static uint32_t bench_fired;
+static uint32_t bench_bad;
+static uint32_t bench_seed = 1;
+static st_bench_drive bench_elapsed;
+static st_bench_drive bench_divided;
+static uint32_t bench_mz_fired;
+/* Global Variables - END */
+
+/** @fn static uint32_t bench_rand(uint32_t n)
+ * @brief Repeatable pseudo random number below n
+ */
+static uint32_t bench_rand(uint32_t n)
+{
+	bench_seed = (bench_seed * 1103515245U) + 12345U;
+	return (bench_seed >> 8) % n;
+}
+
+/** @fn static void bench_check_cb(void * arg)
+ * @brief Expiry of a checked timer, sometimes restarted from its callback
+ */
+static void bench_check_cb(void * arg)
+{
+	uint32_t i = (uint32_t)(uintptr_t)arg;
+
+	bench_fired++;
+	bench_bad += (bench_due[i] != bench_cur);
+	if(bench_timer[i].period != 0)
+	{
+		bench_due[i] += bench_timer[i].period;
+	}
+	if(bench_rand(4) == 0)
+	{
+		uint32_t k = 1 + bench_rand(300000);
+
+		gps_tw_start(&bench_wheel, &bench_timer[i], k, 0);
+		bench_due[i] = bench_cur + k;
+	}
+}
+
+/** @fn static void bench_check(void)
+ * @brief Expiries against the ticks they are due
+ */
+static void bench_check(void)
+{
+	bench_cur = 12345;
+	gps_tw_init(&bench_wheel, bench_cur);
+	for(uint32_t i = 0; i < BENCH_CHECK_TIMERS; i++)
+	{
+		uint32_t k = 1 + bench_rand(400000);
+		uint32_t p = ((i % 3) == 0) ? (1 + bench_rand(1000)) : 0;
+
+		gps_tw_timer_init(&bench_timer[i], bench_check_cb, (void *)(uintptr_t)i);
+		gps_tw_start(&bench_wheel, &bench_timer[i], k, p);
+		bench_due[i] = bench_cur + k;
+	}
+	for(uint32_t step = 0; step < BENCH_CHECK_TICKS; step++)
+	{
+		/* A start after advance(cur) with k ticks expires at cur + k */
+		if((step % 7) == 0)
+		{
+			uint32_t i = bench_rand(BENCH_CHECK_TIMERS);
+
+			if(bench_rand(2) != 0)
+			{
+				gps_tw_stop(&bench_wheel, &bench_timer[i]);
+			}
+			else
+			{
+				uint32_t k = 1 + bench_rand(70000);
+
+				gps_tw_start(&bench_wheel, &bench_timer[i], k, bench_timer[i].period);
+				bench_due[i] = bench_cur + k;
+			}
+		}
+		bench_cur++;
+		gps_tw_advance(&bench_wheel, bench_cur);
+	}
+	printf("check: %u timers, %lu ticks, %lu expiries, %lu off their tick, %lu running\n",
+			BENCH_CHECK_TIMERS, (unsigned long)BENCH_CHECK_TICKS, (unsigned long)bench_fired,
+			(unsigned long)bench_bad, (unsigned long)bench_wheel.active);
+}
+
+/** @fn static void bench_drive_cb(void * arg)
+ * @brief Expiry of the 1 s timer of a driven wheel
+ */
+static void bench_drive_cb(void * arg)
+{
+	st_bench_drive * d = (st_bench_drive *)arg;
+
+	d->fired++;
+	d->after_wrap += (HAL_GetTick() < BENCH_WRAP_RUN_MS);
+}
+
+/** @fn static void bench_elapsed_cb(TimerHandle_t xTimer)
+ * @brief Wheel moved by the elapsed time, gps_twheel_timer_cb
+ */
+static void bench_elapsed_cb(TimerHandle_t xTimer)
+{
+	uint32_t ticks = (HAL_GetTick() - bench_elapsed.last_ms) / GPS_TW_TICK_MS;
+
+	bench_elapsed.last_ms += ticks * GPS_TW_TICK_MS;
+	gps_tw_advance(&bench_elapsed.wheel, bench_elapsed.wheel.now + ticks - 1);
+}
+
+/** @fn static void bench_divided_cb(TimerHandle_t xTimer)
+ * @brief Wheel moved to HAL_GetTick() / GPS_TW_TICK_MS
+ */
+static void bench_divided_cb(TimerHandle_t xTimer)
+{
+	gps_tw_advance(&bench_divided.wheel, HAL_GetTick() / GPS_TW_TICK_MS);
+}
+
+/** @fn static void bench_wrap(void)
+ * @brief Both drives over the HAL tick wrap
+ */
+static void bench_wrap(void)
+{
+	size_t id_elapsed;
+	size_t id_divided;
+
+	host_tick_set(0xFFFFFFFFUL - BENCH_WRAP_BEFORE_MS + 1);
+	memset(&bench_elapsed, 0, sizeof(bench_elapsed));
+	memset(&bench_divided, 0, sizeof(bench_divided));
+	bench_elapsed.last_ms = HAL_GetTick();
+	gps_tw_init(&bench_elapsed.wheel, 0);
+	gps_tw_init(&bench_divided.wheel, HAL_GetTick() / GPS_TW_TICK_MS);
+	gps_tw_timer_init(&bench_elapsed.timer, bench_drive_cb, &bench_elapsed);
+	gps_tw_timer_init(&bench_divided.timer, bench_drive_cb, &bench_divided);
+	gps_tw_start(&bench_elapsed.wheel, &bench_elapsed.timer, 1000 / GPS_TW_TICK_MS, 1000 / GPS_TW_TICK_MS);
+	gps_tw_start(&bench_divided.wheel, &bench_divided.timer, 1000 / GPS_TW_TICK_MS, 1000 / GPS_TW_TICK_MS);
+
+	id_elapsed = mz_tm_create_recursive("elapsed", GPS_TW_TICK_MS, bench_elapsed_cb);
+	id_divided = mz_tm_create_recursive("divided", GPS_TW_TICK_MS, bench_divided_cb);
+	(void)mz_tm_start(id_elapsed);
+	(void)mz_tm_start(id_divided);
+	host_tick_advance(BENCH_WRAP_RUN_MS);
+	(void)mz_tm_delete(id_elapsed);
+	(void)mz_tm_delete(id_divided);
+
+	printf("wrap: 1 s timer over %lu s, the HAL tick wraps after %lu s\n",
+			(unsigned long)(BENCH_WRAP_RUN_MS / 1000), (unsigned long)(BENCH_WRAP_BEFORE_MS / 1000));
+	printf("  elapsed time             %4lu expiries, %4lu after the wrap\n",
+			(unsigned long)bench_elapsed.fired, (unsigned long)bench_elapsed.after_wrap);
+	printf("  HAL_GetTick() / %3u      %4lu expiries, %4lu after the wrap\n", GPS_TW_TICK_MS,
+			(unsigned long)bench_divided.fired, (unsigned long)bench_divided.after_wrap);
+}
+
+/** @fn static void bench_mz_cb(TimerHandle_t xTimer)
+ * @brief Expiry of a MonoZ timer of the cost run
+ */
+static void bench_mz_cb(TimerHandle_t xTimer)
+{
+	bench_mz_fired++;
+}
+
+/** @fn static void bench_cost(uint32_t rounds)
+ * @brief Start, stop and expiry of the wheel and of MonoZ timers
+ */
+static void bench_cost(uint32_t rounds)
+{
+	static st_gps_tw_timer timers[BENCH_MAX_TIMERS];
+	size_t id[MZ_MAX_TIMER_COUNT];
+	uint64_t start = 0;
+	uint64_t stop = 0;
+	uint64_t expire = 0;
+	uint64_t t0;
+
+	printf("cost in ns, mean of %lu rounds\n", (unsigned long)rounds);
+	printf("%-8s %6s %7s %7s %7s\n", "timers", "count", "start", "stop", "expire");
+	for(uint8_t c = 0; c < (sizeof(bench_counts) / sizeof(bench_counts[0])); c++)
+	{
+		st_gps_tw_bench res;
+
+		start = stop = expire = 0;
+		for(uint32_t r = 0; r < rounds; r++)
+		{
+			gps_tw_bench(timers, bench_counts[c], &res);
+			start += res.start;
+			stop += res.stop;
+			expire += res.expire;
+		}
+		printf("%-8s %6u %7.1f %7.1f %7.1f\n", "twheel", bench_counts[c],
+				(double)start / rounds, (double)stop / rounds, (double)expire / rounds);
+	}
+
+	/* Every MonoZ timer the library has, one shot with spread periods */
+	for(uint8_t i = 0; i < MZ_MAX_TIMER_COUNT; i++)
+	{
+		id[i] = mz_tm_create_one("bench", 1 + ((i * 7919UL) % 1000), bench_mz_cb);
+	}
+	start = stop = expire = 0;
+	host_tick_set(0);
+	for(uint32_t r = 0; r < rounds; r++)
+	{
+		t0 = host_ns();
+		for(uint8_t i = 0; i < MZ_MAX_TIMER_COUNT; i++)
+		{
+			(void)mz_tm_start(id[i]);
+		}
+		start += host_ns() - t0;
+		t0 = host_ns();
+		for(uint8_t i = 0; i < MZ_MAX_TIMER_COUNT; i += 2)
+		{
+			(void)mz_tm_stop(id[i]);
+		}
+		stop += host_ns() - t0;
+
+		/* Expiry includes the empty ticks on the way, as for the wheel */
+		bench_mz_fired = 0;
+		t0 = host_ns();
+		host_tick_advance(1000);
+		expire += (bench_mz_fired != 0) ? ((host_ns() - t0) / bench_mz_fired) : 0;
+	}
+	for(uint8_t i = 0; i < MZ_MAX_TIMER_COUNT; i++)
+	{
+		(void)mz_tm_delete(id[i]);
+	}
+	printf("%-8s %6u %7.1f %7.1f %7.1f  (host_timer.c model)\n", "mz_tm", MZ_MAX_TIMER_COUNT,
+			(double)start / ((double)rounds * MZ_MAX_TIMER_COUNT),
+			(double)stop / ((double)rounds * ((MZ_MAX_TIMER_COUNT + 1) / 2)),
+			(double)expire / rounds);
+}
+
+/*
+ * Benchmark entry - START
+ */
+int main(int argc, char ** argv)
+{
+	uint32_t rounds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_ROUNDS;
+
+	if(rounds == 0)
+	{
+		fprintf(stderr, "usage: gps_twheel_bench [rounds]\n");
+		return 1;
+	}
+	gps_prof_init();
+	printf("Timer wheel, %u levels of %u slots, tick %u ms\n", GPS_TW_LEVELS, GPS_TW_SLOTS, GPS_TW_TICK_MS);
+	bench_check();
+	bench_wrap();
+	bench_cost(rounds);
+	return 0;
+}
+/* Benchmark entry - END */
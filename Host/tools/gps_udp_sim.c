@@ -0,0 +1,140 @@
+/*
+ * gps_udp_sim.c
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  UDP uplink harness (MZ_gps_udp.h, GPS_BACKEND_UDP). Reports of 1 or 16
+ *  fixes go through gps_backend_upload() to the modem emulator, whose
+ *  AT+QISENDEX hands the datagram to the server stand-in gps_udp_serve()
+ *  and returns its ACK as the +QIURC "recv" URC. The thread loop is
+ *  stood in by gps_backend_poll() / gps_backend_flush() every second,
+ *  which runs the retransmits. Loss is set with gps_at_emu_loss(), one
+ *  datagram in N either way at random.
+ *
+ *  Prints per fix the uplink and downlink bytes with IP / UDP headers,
+ *  the datagrams and the round trips, and whether every frame was
+ *  acknowledged.
+ *
+ *  gps_udp_sim [reports]
+ */
+
+/* Include Header Files - START */
+
+#include "host_stub.h"
+#include "MZ_gps_at.h"
+#include "MZ_gps_backend.h"
+#include "MZ_gps_udp.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define SIM_REPORTS					(360)						///< Default reports per run
+#define SIM_REPORT_S				(10)						///< Seconds between reports
+#define SIM_DRAIN_S					(120)						///< Loop passes after the last report
+/* Define some common use MACRO - END */
+
+/* Points per report and loss of the runs */
+static const uint16_t sim_points[] = { 1, GPS_UDP_POINTS_MAX };
+static const uint16_t sim_loss[] = { 0, 10, 5, 3 };
+
+/* Global Variables - START */
+static st_gps_fix sim_fixes[GPS_UDP_POINTS_MAX];
+static uint32_t sim_fix_count;
+/* Global Variables - END */
+
+/** @fn static void sim_loop(uint32_t seconds)
+ * @brief Thread loop passes, one per second
+ */
+static void sim_loop(uint32_t seconds)
+{
+	for(uint32_t s = 0; s < seconds; s++)
+	{
+		host_tick_advance(1000);
+		if(gps_backend_poll(HAL_GetTick()))
+		{
+			gps_backend_flush(HAL_GetTick());
+		}
+	}
+}
+
+/** @fn static void sim_run(uint16_t points, uint16_t loss, uint32_t reports)
+ * @brief One run, counters taken as differences
+ */
+static void sim_run(uint16_t points, uint16_t loss, uint32_t reports)
+{
+	char topic[] = "\"t\"";
+	char payload[] = "{}\x1a";
+	st_gps_backend_msg msg = { topic, payload, sim_fixes, points };
+	st_gps_udp_stats s0;
+	st_gps_udp_stats s1;
+	st_gps_at_stats a0;
+	st_gps_at_stats a1;
+	double fixes = (double)reports * points;
+
+	gps_at_emu_loss(loss);
+	gps_backend_udp_stats(&s0);
+	gps_at_get_stats(&a0);
+	for(uint32_t r = 0; r < reports; r++)
+	{
+		for(uint16_t i = 0; i < points; i++)
+		{
+			st_gps_fix * f = &sim_fixes[i];
+			uint32_t t = sim_fix_count++;
+
+			memset(f, 0, sizeof(*f));
+			f->utc_date = 191026;
+			f->utc_time = ((t / 3600 % 24) * 10000) + ((t / 60 % 60) * 100) + (t % 60);
+			f->lat_e7 = 356812360 + (t * 37);
+			f->lon_e7 = 1397671250 - (t * 11);
+			f->hdop_x100 = 95;
+			f->speed_cms = 1234;
+			f->valid = GPS_FIX_VALID;
+		}
+		gps_backend_upload(&msg, 1, HAL_GetTick());
+		sim_loop(SIM_REPORT_S);
+	}
+	sim_loop(SIM_DRAIN_S);
+	gps_backend_udp_stats(&s1);
+	gps_at_get_stats(&a1);
+
+	printf("%2u points/report, loss 1/%-2u: frames %lu acked %lu lost %lu overflow %lu, retries %lu\n",
+			points, loss, (unsigned long)(s1.frames - s0.frames), (unsigned long)(s1.acked - s0.acked),
+			(unsigned long)(s1.lost - s0.lost), (unsigned long)(s1.overflow - s0.overflow),
+			(unsigned long)(s1.retries - s0.retries));
+	printf("    per fix: up %.1f B, down %.1f B, datagrams %.2f, round trips %.3f, AT commands %.2f\n",
+			(s1.air_bytes - s0.air_bytes) / fixes, (s1.ack_bytes - s0.ack_bytes) / fixes,
+			(s1.sends - s0.sends) / fixes, (s1.acked - s0.acked) / fixes, (a1.cmds - a0.cmds) / fixes);
+}
+
+/*
+ * Simulation entry - START
+ */
+int main(int argc, char ** argv)
+{
+	uint32_t reports = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : SIM_REPORTS;
+
+	if(reports == 0)
+	{
+		fprintf(stderr, "usage: gps_udp_sim [reports]\n");
+		return 1;
+	}
+	host_tick_set(0);
+	host_cli_file(NULL);
+	if(gps_backend_select(GPS_BACKEND_UDP) != MZ_OK)
+	{
+		fprintf(stderr, "GPS_BACKEND_UDP not built\n");
+		return 1;
+	}
+	for(uint8_t p = 0; p < (sizeof(sim_points) / sizeof(sim_points[0])); p++)
+	{
+		for(uint8_t l = 0; l < (sizeof(sim_loss) / sizeof(sim_loss[0])); l++)
+		{
+			sim_run(sim_points[p], sim_loss[l], reports);
+		}
+	}
+	return 0;
+}
+/* Simulation entry - END */
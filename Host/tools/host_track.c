@@ -0,0 +1,230 @@
+/*
+ * host_track.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "host_track.h"
+#include "MZ_gps_nmea.h"
+#include "MZ_gps_nmea_gen.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define TRACK_EPOCH_SIZE			(1024)						///< Largest generated epoch
+#define TRACK_LINE_SIZE				(128)						///< Longest NMEA line read from a log
+#define TRACK_GROW					(4096)						///< Fixes added per reallocation
+/* Define some common use MACRO - END */
+
+/* Built in tracks - START */
+static const st_host_track_leg track_static[] =
+{
+	{ 3600,	0,		0 },
+};
+
+/* Pedestrian, 90 degree corners and short waits */
+static const st_host_track_leg track_walk[] =
+{
+	{ 120,	140,	0 },
+	{ 20,	140,	450 },
+	{ 300,	140,	0 },
+	{ 30,	0,		0 },
+	{ 60,	140,	-300 },
+	{ 180,	140,	20 },
+	{ 20,	140,	-450 },
+};
+
+/* City driving, junctions, traffic lights and a U-turn, about 5 min per lap */
+static const st_host_track_leg track_urban[] =
+{
+	{ 45,	1100,	0 },
+	{ 10,	500,	900 },
+	{ 25,	0,		0 },
+	{ 60,	1300,	0 },
+	{ 8,	600,	-1125 },
+	{ 90,	1400,	30 },
+	{ 15,	0,		0 },
+	{ 30,	900,	0 },
+	{ 12,	500,	1500 },
+};
+
+/* Motorway with long bends and a ramp */
+static const st_host_track_leg track_highway[] =
+{
+	{ 600,	3000,	0 },
+	{ 120,	2800,	50 },
+	{ 600,	3100,	0 },
+	{ 120,	2800,	-50 },
+	{ 30,	1500,	600 },
+	{ 330,	2500,	0 },
+};
+
+const st_host_track_script host_track_scripts[] =
+{
+	{ "static",		track_static,	1,	1 },
+	{ "walk",		track_walk,		7,	5 },
+	{ "urban",		track_urban,	9,	12 },
+	{ "highway",	track_highway,	6,	2 },
+};
+const uint8_t host_track_script_count = sizeof(host_track_scripts) / sizeof(host_track_scripts[0]);
+/* Built in tracks - END */
+
+/** @fn static mz_error_t track_add(st_host_track * track, const st_gps_fix * fix)
+ * @brief Append one fix
+ */
+static mz_error_t track_add(st_host_track * track, const st_gps_fix * fix)
+{
+	if(track->count == track->size)
+	{
+		st_gps_fix * f = realloc(track->fix, (track->size + TRACK_GROW) * sizeof(st_gps_fix));
+
+		if(f == NULL)
+		{
+			return MZ_FAIL;
+		}
+		track->fix = f;
+		track->size += TRACK_GROW;
+	}
+	track->fix[track->count++] = *fix;
+	return MZ_OK;
+}
+
+/** @fn static mz_error_t track_script(st_host_track * track, const st_host_track_script * s)
+ * @brief Drive the generator through the legs at 1 Hz
+ */
+static mz_error_t track_script(st_host_track * track, const st_host_track_script * s)
+{
+	st_gps_nmea_gen_cfg cfg =
+	{
+		.lat_e7 = 298653100,
+		.lon_e7 = 778731228,
+		.utc_time = 101902,
+		.utc_date = 300322,
+		.course_cdeg = 4500,
+		.hdop_x100 = 120,
+		.rate_hz = 1,
+		.sentences = GPS_NMEA_GEN_ALL,
+		.hot_s = 1,
+	};
+	static st_gps_nmea_gen gen;
+	static char epoch[TRACK_EPOCH_SIZE];
+	st_gps_fix fix;
+	uint32_t ms = 0;
+
+	memset(&fix, 0, sizeof(fix));
+	gps_nmea_gen_init(&gen, &cfg);
+	for(uint8_t r = 0; r < s->repeat; r++)
+	{
+		for(uint8_t l = 0; l < s->leg_count; l++)
+		{
+			/* The generator reads speed and turn rate on every epoch */
+			gen.cfg.speed_cms = s->legs[l].speed_cms;
+			gen.cfg.turn_cdeg_s = s->legs[l].turn_cdeg_s;
+			gen.fix.speed_cms = s->legs[l].speed_cms;
+			for(uint32_t t = 0; t < s->legs[l].seconds; t++)
+			{
+				uint16_t len = gps_nmea_gen_epoch(&gen, epoch, sizeof(epoch));
+
+				gps_nmea_parse_buffer(epoch, len, &fix, NULL);
+				fix.tick = ms;
+				ms += 1000;
+				if((fix.valid == GPS_FIX_VALID) && (MZ_OK != track_add(track, &fix)))
+				{
+					return MZ_FAIL;
+				}
+			}
+		}
+	}
+	return MZ_OK;
+}
+
+/** @fn static mz_error_t track_log(st_host_track * track, FILE * f)
+ * @brief Read an NMEA log, an epoch ends where the next $xxRMC starts
+ */
+static mz_error_t track_log(st_host_track * track, FILE * f)
+{
+	char line[TRACK_LINE_SIZE];
+	st_gps_fix fix;
+	uint8_t pending = 0;
+	uint64_t first_ms = 0;
+
+	memset(&fix, 0, sizeof(fix));
+	for(;;)
+	{
+		uint8_t end = (NULL == fgets(line, sizeof(line), f));
+		char * s = end ? NULL : strchr(line, '$');
+		uint16_t len = (s != NULL) ? (uint16_t)strcspn(s, "\r\n") : 0;
+
+		if(end || ((len > 6) && (0 == memcmp(&s[3], "RMC", 3))))
+		{
+			if(pending && (fix.valid == GPS_FIX_VALID))
+			{
+				uint64_t ms = ((uint64_t)gps_fix_to_unix(&fix) * 1000U) + fix.utc_ms;
+
+				if(track->count == 0)
+				{
+					first_ms = ms;
+				}
+				fix.tick = (uint32_t)(ms - first_ms);
+				if(MZ_OK != track_add(track, &fix))
+				{
+					return MZ_FAIL;
+				}
+			}
+			pending = 0;
+		}
+		if(end)
+		{
+			break;
+		}
+		if((s != NULL) && (GPS_NMEA_INVALID != gps_nmea_parse_sentence(s, len, &fix)))
+		{
+			pending = 1;
+		}
+	}
+	return (track->count != 0) ? MZ_OK : MZ_FAIL;
+}
+
+/*
+ * Build a track. - START
+ */
+mz_error_t host_track_open(st_host_track * track, const char * spec)
+{
+	FILE * f;
+	mz_error_t ret;
+
+	memset(track, 0, sizeof(*track));
+	track->name = spec;
+	for(uint8_t i = 0; i < host_track_script_count; i++)
+	{
+		if(0 == strcmp(spec, host_track_scripts[i].name))
+		{
+			return track_script(track, &host_track_scripts[i]);
+		}
+	}
+
+	f = fopen(spec, "r");
+	if(f == NULL)
+	{
+		return MZ_FAIL;
+	}
+	ret = track_log(track, f);
+	fclose(f);
+	return ret;
+}
+/* Build a track. - END */
+
+/*
+ * Release the fixes of a track. - START
+ */
+void host_track_free(st_host_track * track)
+{
+	free(track->fix);
+	memset(track, 0, sizeof(*track));
+}
+/* Release the fixes of a track. - END */
@@ -0,0 +1,72 @@
+/*
+ * host_track.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Tracks for the host tools: one committed fix per epoch, either read
+ *  from an NMEA log or driven out of the NMEA generator by a script of
+ *  speed / turn legs. Both go through the firmware parser.
+ */
+
+#ifndef HOST_TRACK_H_
+#define HOST_TRACK_H_
+
+/* Include Header Files - START */
+
+#include "MZ_gps_fix.h"
+#include "MZ_error_handler.h"
+
+/* Include Header Files - END */
+
+/**
+ * @struct st_host_track_leg
+ * @brief One leg of a scripted track
+ */
+typedef struct
+{
+	uint32_t		seconds;									/*!< Leg length */
+	uint16_t		speed_cms;									/*!< Speed during the leg */
+	int16_t			turn_cdeg_s;								/*!< Course change per second */
+}st_host_track_leg;
+
+/**
+ * @struct st_host_track_script
+ * @brief Named scripted track
+ */
+typedef struct
+{
+	const char *				name;							/*!< Name given on the command line */
+	const st_host_track_leg *	legs;							/*!< Legs, driven in order */
+	uint8_t						leg_count;						/*!< Number of legs */
+	uint8_t						repeat;							/*!< Times the legs are driven */
+}st_host_track_script;
+
+/**
+ * @struct st_host_track
+ * @brief Committed fixes of one track
+ */
+typedef struct
+{
+	const char *	name;										/*!< Script name or file path */
+	st_gps_fix *	fix;										/*!< Valid fixes, tick in ms from the first */
+	uint32_t		count;										/*!< Number of fixes */
+	uint32_t		size;										/*!< Allocated fixes */
+}st_host_track;
+
+extern const st_host_track_script host_track_scripts[];		///< Built in tracks
+extern const uint8_t host_track_script_count;
+
+/** @fn mz_error_t host_track_open(st_host_track * track, const char * spec)
+ * @brief Build a track.
+ * @param track filled, release with host_track_free()
+ * @param spec name of a built in script or path of an NMEA log
+ * @return MZ_OK, MZ_FAIL when the log cannot be read or has no fix
+ */
+mz_error_t host_track_open(st_host_track * track, const char * spec);
+
+/** @fn void host_track_free(st_host_track * track)
+ * @brief Release the fixes of a track.
+ */
+void host_track_free(st_host_track * track);
+
+#endif /* HOST_TRACK_H_ */
@@ -19,6 +19,31 @@
 #include "MZ_uart.h"
 #include "MZ_main.h"
 #include "main.h"
+#include "MZ_gps_app_config.h"
+#include "MZ_gps_fix.h"
+#include "MZ_gps_nmea.h"
+#include "MZ_gps_sdlog.h"
+#include "MZ_gps_geofence.h"
+#include "MZ_gps_report_policy.h"
+#include "MZ_gps_track_simplify.h"
+#include "MZ_gps_kalman.h"
+#include "MZ_gps_replay.h"
+#include "MZ_gps_at.h"
+#include "MZ_gps_prof.h"
+#include "MZ_gps_latency.h"
+#include "MZ_gps_trace.h"
+#include "MZ_gps_log.h"
+#include "MZ_gps_twheel.h"
+#include "MZ_gps_health.h"
+#include "MZ_gps_lowpower.h"
+#include "MZ_gps_lpuart.h"
+#include "MZ_gps_rxpm.h"
+#include "MZ_gps_radio.h"
+#include "MZ_gps_time.h"
+#include "MZ_gps_aid.h"
+#include "MZ_gps_lwm2m.h"
+#include "MZ_gps_backend.h"
+#include "MZ_gps_payload.h"
 
 #include "stdlib.h"
 #include "stdio.h"
@@ -36,6 +61,7 @@
 #define TIMER_ID_CLEAR							(0)						///< Clear the timer id
 #define GPS_SENSOR_DATA_SEND_TIME				(pdMS_TO_TICKS(120000))	//< Timer is set for 120 seconds
 #define GPS_SENSOR_READ_TIME					(TIME_90SEC)			///< Set 90 seconds timer for read sensor data */
+#define GPS_RXPM_TX_TIMEOUT_MS					(100)					///< UBX frame to the receiver, 64 bytes at 9600
 /* Define some common use MACRO - END */
 
 /* Thread related MACRO and variables - START */
@@ -44,44 +70,39 @@
 static mz_thread_t 					gps_thread_id = NULL;						/* Thread id handler */
 static StaticTask_t 				gps_cb_mem;									/* Thread control block */
 static StackType_t 					gps_stack[GPS_APP_STACK_SIZE];				/* Thread stack */
+#if(GPS_LOG_ENABLE == MZ_ENABLE)
+#define GPS_LOG_STACK_SIZE			(512)										/* Stack size for the log drain thread */
+static mz_thread_t 					gps_log_thread_id = NULL;					/* Thread id handler */
+static StaticTask_t 				gps_log_cb_mem;								/* Thread control block */
+static StackType_t 					gps_log_stack[GPS_LOG_STACK_SIZE];			/* Thread stack */
+#endif
 
 /* Thread related MACRO and variables - END */
 
 /* Timer related MACRO and variables - START */
 static char gps_read_timer_expire_flag = GPS_READ_TIMER_EXPIRE_CLEAR;			/* Flag is created and cleared for sensor data read */
+#if(GPS_TWHEEL_ENABLE == MZ_ENABLE)
+static st_gps_twheel gps_wheel;													/* Application timers, one MonoZ timer drives it */
+static uint32_t gps_wheel_ms = 0;												/* HAL tick the wheel has been moved up to */
+#if(GPS_REPORT_POLICY_ENABLE != MZ_ENABLE)
+static st_gps_tw_timer gps_sensor_data_tw;										/* gps_sensor data send timer */
+#endif
+#elif(GPS_REPORT_POLICY_ENABLE != MZ_ENABLE)
 static size_t gps_sensor_data_timer_id = TIMER_ID_CLEAR;					    /*!< gps_sensor timer id - Initialize it to 0 */
+#endif
 /* Timer related MACRO and variables - END */
 
 /* GPS_SENSORS MACRO - START */
 
-#define LAT_DATA_SIZE				20
-#define LON_DATA_SIZE				20
-#define PDOP_DATA_SIZE				8
-#define HDOP_DATA_SIZE				8
-#define VDOP_DATA_SIZE				8
-
-#define PAYLOAD_STRING_SIZE			200
+#define PAYLOAD_STRING_SIZE			(GPS_PAYLOAD_FIX_SIZE)
 
 #define RX_BUF_SIZE					255
-#define RESP_BUF_SIZE				80
-
-#define LAT_BUFF_SIZE				11
-#define LON_BUFF_SIZE				12
-#define LAT_BUFF1_SIZE				10
-#define LON_BUFF1_SIZE				10
-#define LAT_BUFF2_SIZE				2
-#define LON_BUFF2_SIZE				3
-#define PDOP_BUFF_SIZE				5
-#define HDOP_BUFF_SIZE				5
-#define VDOP_BUFF_SIZE				5
-
-#define SPLIT_STRING_SIZE1			10
-#define SPLIT_STRING_SIZE1_2		80
-
-#define SPLIT_STRING_SIZE2			21
-#define SPLIT_STRING_SIZE2_2		12
 
-#define MINUTE_DEVIDER				60
+#if((GPS_LPUART_RING_ENABLE == MZ_ENABLE) && (GPS_REPLAY_ENABLE != MZ_ENABLE))
+#define GPS_RX_RING					(MZ_ENABLE)					///< Receive through the stop mode ring
+#else
+#define GPS_RX_RING					(MZ_DISABLE)
+#endif
 
 /* GPS_SENSORS MACRO - END */
 
@@ -89,11 +110,44 @@ static size_t gps_sensor_data_timer_id = TIMER_ID_CLEAR;					    /*!< gps_sensor
 
 static volatile long int final_gps_value = INIT_0;						/* Store final gps value after calculation from raw value and decimal place */
 
-static char  final_lat_data[LAT_DATA_SIZE] = {0};				/* Store final gps value after calculation from raw value and decimal place */
-static char  final_lon_data[LON_DATA_SIZE] = {0};				/* Store final gps value after calculation from raw value and decimal place */
-static char  final_pdop_data[PDOP_DATA_SIZE] = {0};			/* Store final gps value after calculation from raw value and decimal place */
-static char  final_hdop_data[HDOP_DATA_SIZE] = {0};			/* Store final gps value after calculation from raw value and decimal place */
-static char  final_vdop_data[VDOP_DATA_SIZE] = {0};			/* Store final gps value after calculation from raw value and decimal place */
+
+static st_gps_fix gps_fix = {0};								/* Fix being assembled from the current sentences */
+static uint32_t gps_last_commit_time = 0xFFFFFFFF;				/* UTC time of the last committed fix */
+static st_gps_nmea_stats gps_nmea_stats = {0};					/* Parser counters */
+#if(GPS_PROF_ENABLE == MZ_ENABLE)
+static uint32_t gps_prof_dump_tick = 0;							/* Tick of the last probe dump */
+#endif
+#if(GPS_LATENCY_ENABLE == MZ_ENABLE)
+static uint32_t gps_latency_dump_tick = 0;						/* Tick of the last latency dump */
+#endif
+#if((GPS_RX_RING == MZ_ENABLE) && (GPS_LOG_ENABLE == MZ_ENABLE))
+static uint32_t gps_duty_tick = 0;								/* Tick of the last duty cycle line */
+#endif
+#if(GPS_RXPM_ENABLE == MZ_ENABLE)
+static st_gps_rxpm gps_rxpm;									/* Receiver power save state */
+static uint8_t gps_rxpm_frame[GPS_RXPM_FRAME_SIZE];				/* UBX frame to the receiver */
+#endif
+#if(GPS_AID_ENABLE == MZ_ENABLE)
+static uint8_t gps_aid_frame[GPS_AID_FRAME_SIZE];				/* Aiding frame to the receiver */
+#endif
+#if(GPS_RADIO_ENABLE == MZ_ENABLE)
+static st_gps_radio gps_radio;									/* Modem power save scheduler */
+#if(GPS_LOG_ENABLE == MZ_ENABLE)
+static uint32_t gps_radio_dump_tick = 0;						/* Tick of the last radio state line */
+#endif
+#endif
+#if(GPS_HEALTH_ENABLE == MZ_ENABLE)
+static uint32_t gps_health_tick = 0;							/* Tick of the last health payload */
+static st_gps_health gps_health;								/* Last health sample */
+static char health_payload[GPS_HEALTH_PAYLOAD_SIZE] = "";		/* Health payload buffer */
+static st_gps_backend_msg health_msg;
+#endif
+#if(GPS_KALMAN_ENABLE == MZ_ENABLE)
+static st_gps_kalman gps_kalman;								/* Position / velocity filter */
+static st_gps_fix gps_fix_smooth = {0};							/* Last committed fix after smoothing */
+#endif
+static st_gps_fix gps_fix_last = {0};							/* Last valid fix, the location reported */
+static uint32_t gps_backend_dump_tick = 0;						/* Tick of the last backend counters line */
 
 /* GPS sensor related MACRO and variables - END */
 
@@ -102,17 +156,70 @@ static volatile char gps_uart_recv_complete_flag = UART_RECEIVE_COMPLETE_CLEAR;
 /* GPS UART related variables - END */
 
 /* MQTT related MACRO and variables - START */
+#if(GPS_TRACK_BATCH_ENABLE != MZ_ENABLE)
 static char payload_string[PAYLOAD_STRING_SIZE] = "";					/* payload string buffer to pass the final payload information to MonoZ_Lib */
-static st_mqtt_message pmsg;
+#endif
+static st_gps_backend_msg pmsg;
 /* MQTT related MACRO and variables - END */
 
+/* Geofence related MACRO and variables - START */
+#define GEOFENCE_PAYLOAD_SIZE		(GPS_PAYLOAD_FENCE_SIZE)
+#if(GPS_GEOFENCE_ENABLE == MZ_ENABLE)
+/**
+ * @struct st_geofence_ev
+ * @brief Geofence transition waiting for the publisher
+ */
+typedef struct
+{
+	uint16_t				id;									/*!< Fence id */
+	en_gps_geofence_event	ev;									/*!< Enter / exit */
+}st_geofence_ev;
+
+static st_geofence_ev geofence_ev_queue[GPS_GEOFENCE_EVENT_QUEUE];	/* Events raised by the last fixes */
+static uint8_t geofence_ev_count = 0;							/* Number of queued events */
+static char geofence_payload[GEOFENCE_PAYLOAD_SIZE] = "";		/* Payload buffer for one event */
+static st_gps_backend_msg geofence_msg;
+#endif
+/* Geofence related MACRO and variables - END */
+
+/* Track batch related MACRO and variables - START */
+#if(GPS_TRACK_BATCH_ENABLE == MZ_ENABLE)
+#define BATCH_PAYLOAD_SIZE			(GPS_PAYLOAD_BATCH_SIZE(GPS_BATCH_MAX_POINTS + 1))
+
+static st_gps_simplify gps_simplify;							/* Streaming simplifier state */
+static st_gps_fix gps_batch[GPS_BATCH_MAX_POINTS + 1];			/* Kept points, +1 for the flush point */
+static uint16_t gps_batch_count = 0;							/* Number of points in gps_batch */
+static char batch_payload[BATCH_PAYLOAD_SIZE] = "";				/* Payload buffer for one batch */
+#endif
+/* Track batch related MACRO and variables - END */
+
 /* static function prototypes - START */
 
 static mz_error_t gps_uart_init(void);
 static void gps_sensor_read_timer_cb(TimerHandle_t xTimer);
-static void create_mqtt_payload(st_mqtt_message * pmsg , char * buff);
-static void send_payload_to_server(st_mqtt_message * pmsg);
+#if(GPS_TWHEEL_ENABLE == MZ_ENABLE)
+static void gps_twheel_timer_cb(TimerHandle_t xTimer);
+#endif
+#if(GPS_TRACK_BATCH_ENABLE != MZ_ENABLE)
+static void create_mqtt_payload(st_gps_backend_msg * pmsg , char * buff);
+#endif
+static mz_error_t send_payload_to_server(st_gps_backend_msg * pmsg);
+static void gps_fix_commit(st_gps_fix * fix);
+#if(GPS_GEOFENCE_ENABLE == MZ_ENABLE)
+static void gps_geofence_event_cb(uint16_t id, en_gps_geofence_event ev);
+static void gps_geofence_publish(void);
+#endif
+#if(GPS_TRACK_BATCH_ENABLE == MZ_ENABLE)
+static void gps_batch_emit_cb(const st_gps_fix * fix);
+static void create_batch_payload(st_gps_backend_msg * pmsg , char * buff);
+#endif
+#if(GPS_RX_RING == MZ_ENABLE)
+static void gps_rx_burst(void);
+#endif
 static void gps_app_thread(void * arg);
+#if(GPS_LOG_ENABLE == MZ_ENABLE)
+static void gps_log_thread(void * arg);
+#endif
 
 /* static function prototypes - END */
 
@@ -120,20 +227,7 @@ static void gps_app_thread(void * arg);
 int8_t dataTxReady = INIT_0;  	//data transmit ready flag
 int8_t timerCBFlag = INIT_0;  	//timer callback flag
 
-char __lat[LAT_BUFF_SIZE] = {0};
-char __long[LON_BUFF_SIZE] = {0};
-char __PDOP[PDOP_BUFF_SIZE] = {0};
-char __HDOP[HDOP_BUFF_SIZE] = {0};
-char __VDOP[VDOP_BUFF_SIZE] = {0};
-
-float __fLat = FLOAT_0;
-float __fLon = FLOAT_0;
-
 char rx1_char[RX_BUF_SIZE] = {0};
-char respbuf[RESP_BUF_SIZE] = {0};
-
-char splitStrings[SPLIT_STRING_SIZE1][SPLIT_STRING_SIZE1_2];
-char splitStrings2[SPLIT_STRING_SIZE2][SPLIT_STRING_SIZE2_2];
 /* GPS sensor variable and buffers END*/
 
 /* GPS UART configuration related MACRO - START */
@@ -150,15 +244,14 @@ char splitStrings2[SPLIT_STRING_SIZE2][SPLIT_STRING_SIZE2_2];
 #define MZ_GPS_UART_INSTANCE				(_LPUART1)					///< Defimes the UART instance
 /* GPS UART configuration related MACRO - END */
 
-#define MZ_MQTT_PUB_TOPIC 		"\"v1/devices/me/telemetry\""
+#define MZ_MQTT_PUB_TOPIC 		GPS_PAYLOAD_TOPIC
+#if(GPS_MQTT_QOS1_ENABLE == MZ_ENABLE)
+#define MZ_MQTT_PUB_QOS			MQTT_QOS1
+#else
 #define MZ_MQTT_PUB_QOS			MQTT_QOS0
+#endif
 #define MZ_MQTT_SUB_TOPIC		"\"v1/devices/me/attributes\""
 #define MZ_MQTT_SUB_QOS			MQTT_QOS2
-#define MZ_MZTT_KEY1			"latitude"
-#define MZ_MZTT_KEY2			"longitude"
-#define MZ_MZTT_KEY3			"PDOP"
-#define MZ_MZTT_KEY4			"HDOP"
-#define MZ_MZTT_KEY5			"VDOP"
 
 /* GPS UART configuration structure - START */
 /*
@@ -196,12 +289,36 @@ MZ_UART_INIT_ST gps_lpuart1_instance =
 static void gps_lpuart1_rx_intr(void * arg)
 {
 	(void)arg;
+	GPS_PROF_BEGIN(GPS_PROF_UART_ISR);
 
 	/* Set gps sensor uart receive complete flag */
 	gps_uart_recv_complete_flag = UART_RECEIVE_COMPLETE_SET;
+	GPS_TRACE(GPS_TRACE_UART_RX, 0);
+#if(GPS_LATENCY_ENABLE == MZ_ENABLE)
+	gps_latency_rx(HAL_GetTick());
+#endif
+
+	GPS_PROF_END(GPS_PROF_UART_ISR);
 }
 /*GPS UART related callback - END */
 
+#if(GPS_REPORT_POLICY_ENABLE != MZ_ENABLE)
+#if(GPS_TWHEEL_ENABLE == MZ_ENABLE)
+/** @fn static void gps_sensor_data_tw_cb(void * arg)
+ * @brief gps sensor data send timer callback - START
+ * Called from the timer wheel when the one shot data send timer expires.
+ * @param arg void
+ */
+static void gps_sensor_data_tw_cb(void * arg)
+{
+	(void)arg;
+	dataTxReady = FLAG_SET;
+
+	/* Print when the application is ready for data transmission */
+	GPS_LOG_OUT("Ready for data Transmission\r\n");
+}
+/* gps sensor data send timer callback - END */
+#else
 /** @fn static void gps_sensor_data_timer_cb(TimerHandle_t xTimer)
  * @brief gps_sensor_data_timer_cb timer callback - START
  * This Timer callback will be called after the loadcell_data timer is
@@ -215,17 +332,18 @@ static void gps_sensor_data_timer_cb(TimerHandle_t xTimer)
 	if(MZ_OK != mz_tm_stop(gps_sensor_data_timer_id))
 	{
 		/* print of error starting on CLI */
-		mz_puts("gps sensor data timer stopping failed\r\n");
+		GPS_LOG_OUT("gps sensor data timer stopping failed\r\n");
 	}
     else {} // Default waiting case.
 
-	HAL_Delay(DELAY_100MS);
 	dataTxReady = FLAG_SET;
 
 	/* Print when the application is ready for data transmission */
-	mz_puts("Ready for data Transmission\r\n");
+	GPS_LOG_OUT("Ready for data Transmission\r\n");
 }
 /* Sensor transmission timer callback - END */
+#endif //(GPS_TWHEEL_ENABLE == MZ_ENABLE)
+#endif //(GPS_REPORT_POLICY_ENABLE != MZ_ENABLE)
 
 /** @fn static mz_error_t gps_uart_init(void)
  *  @brief GPS UART related initialization - START
@@ -241,14 +359,38 @@ static mz_error_t gps_uart_init(void)
 	 * When receive is completed on the lpuart interface,
 	 * the callback API gps_lpuart1_rx_intr() will be processed.
 	 */
-	return MZ_UART_register_intr_cb_rx(	MZ_GPS_UART_INSTANCE,
-										gps_lpuart1_rx_intr);
+	mz_error_t _ret = MZ_UART_register_intr_cb_rx(	MZ_GPS_UART_INSTANCE,
+													gps_lpuart1_rx_intr);
 
 	/*
 	 * Based on the Application requirement register a transmit callback using
 	 * MZ_UART_register_intr_cb_tx() API. Please refer MZ_uart.h for more
 	 * details.
 	 */
+
+#if(GPS_LP_ENABLE == MZ_ENABLE)
+	if(MZ_OK == _ret)
+	{
+		/* LPUART1 runs on the LSE, a start bit wakes the MCU from STOP2 */
+		UART_WakeUpTypeDef wake = {0};
+		UART_HandleTypeDef * huart = &MZ_UART_reference(MZ_GPS_UART_INSTANCE)->_handler;
+
+		wake.WakeUpEvent = UART_WAKEUP_ON_STARTBIT;
+		HAL_UARTEx_StopModeWakeUpSourceConfig(huart, wake);
+		__HAL_UART_ENABLE_IT(huart, UART_IT_WUF);
+		HAL_UARTEx_EnableStopMode(huart);
+	}
+#endif
+
+#if(GPS_RX_RING == MZ_ENABLE)
+	if(MZ_OK == _ret)
+	{
+		/* Bytes to the stop mode ring, no HAL receive is started */
+		_ret = gps_lpuart_init();
+	}
+#endif
+
+	return _ret;
 }
 /* GPS uart related initialization - END */
 
@@ -265,54 +407,305 @@ static void gps_sensor_read_timer_cb(TimerHandle_t xTimer)
 }
 /* gps sensor reading timer callback - END */
 
+#if(GPS_TWHEEL_ENABLE == MZ_ENABLE)
+/** @fn static void gps_twheel_timer_cb(TimerHandle_t xTimer)
+ * @brief Timer wheel drive callback - START
+ * Periodic MonoZ timer of GPS_TW_TICK_MS. The wheel follows the system
+ * tick, a late callback runs every tick it missed. The wheel tick is
+ * moved by the elapsed time : HAL_GetTick() / GPS_TW_TICK_MS falls back
+ * to 0 when the HAL tick wraps after 49.7 days, and the wheel would wait
+ * for it to catch up.
+ * @param xTimer TimerHandle_t
+ */
+static void gps_twheel_timer_cb(TimerHandle_t xTimer)
+{
+	uint32_t ticks = (HAL_GetTick() - gps_wheel_ms) / GPS_TW_TICK_MS;
+
+	gps_wheel_ms += ticks * GPS_TW_TICK_MS;
+	gps_tw_advance(&gps_wheel, gps_wheel.now + ticks - 1);
+}
+/* Timer wheel drive callback - END */
+#endif
+
+#if(GPS_TRACK_BATCH_ENABLE != MZ_ENABLE)
 /** @fn static void create_mqtt_payload(void)
  * @brief MQTT Create payload API - START
- * This API will be used to create the payload string/buffer from gps final
- * value received after processing of raw value.
+ * This API will be used to create the payload string/buffer from the last
+ * position and the dilutions of the current epoch (MZ_gps_payload.c).
  */
-static void create_mqtt_payload(st_mqtt_message * pmsg , char * buff)
+static void create_mqtt_payload(st_gps_backend_msg * pmsg , char * buff)
 {
-	sprintf(buff,"{\"%s\":%s,\"%s\":%s,\"%s\":%s,\"%s\":%s,\"%s\":%s}%c",MZ_MZTT_KEY1,final_lat_data,MZ_MZTT_KEY2,final_lon_data,MZ_MZTT_KEY3,final_pdop_data,MZ_MZTT_KEY4,final_hdop_data,MZ_MZTT_KEY5,final_vdop_data,26);
+#if(GPS_KALMAN_ENABLE == MZ_ENABLE)
+	gps_payload_fix(&gps_fix_smooth, &gps_fix, buff);
+#else
+	gps_payload_fix(&gps_fix, &gps_fix, buff);
+#endif
 
 	pmsg->topic = MZ_MQTT_PUB_TOPIC;
-	pmsg->qos = MZ_MQTT_PUB_QOS;
-	pmsg->retain = MQTT_RETAIN_OFF;
-	pmsg->message = buff;
+	pmsg->payload = buff;
+	pmsg->fixes = &gps_fix_last;
+	pmsg->n_fixes = (gps_fix_last.valid == GPS_FIX_VALID) ? 1 : 0;
 }
 /* MQTT Create payload API - END */
+#else
+/** @fn static void create_batch_payload(st_gps_backend_msg * pmsg , char * buff)
+ * @brief MQTT Create batch payload API - START
+ * Flush the simplifier and build one telemetry array with a timestamp per
+ * kept point. The batch is emptied.
+ */
+static void create_batch_payload(st_gps_backend_msg * pmsg , char * buff)
+{
+	uint16_t count;
+
+	/* The newest point always closes the batch */
+	gps_simplify_flush(&gps_simplify);
+
+	gps_payload_batch(gps_batch, gps_batch_count, buff);
+	count = gps_batch_count;
+	gps_batch_count = 0;
+
+	/* The points stay in gps_batch until the next one is kept */
+	pmsg->topic = MZ_MQTT_PUB_TOPIC;
+	pmsg->payload = buff;
+	pmsg->fixes = gps_batch;
+	pmsg->n_fixes = count;
+}
+/* MQTT Create batch payload API - END */
+
+/** @fn static void gps_batch_emit_cb(const st_gps_fix * fix)
+ * @brief Simplifier output callback - START
+ * Append the kept point and request a publish when the batch is full.
+ * @param fix kept point
+ */
+static void gps_batch_emit_cb(const st_gps_fix * fix)
+{
+	if(gps_batch_count >= (GPS_BATCH_MAX_POINTS + 1))
+	{
+		GPS_LOG_OUT("track batch full\r\n");
+		return;
+	}
+
+	gps_batch[gps_batch_count++] = *fix;
+	if(gps_batch_count >= GPS_BATCH_MAX_POINTS)
+	{
+		dataTxReady = FLAG_SET;
+	}
+}
+/* Simplifier output callback - END */
+#endif
 
-/** @fn static void send_payload_to_server(void)
+/** @fn static mz_error_t send_payload_to_server(st_gps_backend_msg * pmsg)
  * @brief MQTT send payload API - START
- * This API will be used to send the payload string/buffer to MonoZ_Lib.
+ * This API will be used to send the payload string/buffer to MonoZ_Lib
+ * through the selected telemetry backend (gps_backend_select).
  * It will also print if the sending of payload to MonoZ_Lib was successful or
  * any error occurred
+ * @param pmsg message to publish
+ * @return MZ_OK when the modem accepted the payload
  */
-static void send_payload_to_server(st_mqtt_message * pmsg)
+static mz_error_t send_payload_to_server(st_gps_backend_msg * pmsg)
 {
-	//mz_error_t status = mz_mqtt_pub(pmsg);
+	GPS_TRACE(GPS_TRACE_PUBLISH, strlen(pmsg->payload));
 
-	mz_error_t status = MZ_init_cmd_direct("AT+QMTDISC=0\r\n",AT_TIME_15SEC, AT_TIME_15SEC);
-	status |= MZ_init_cmd_direct("AT+QMTOPEN=0,\"cloud.monoz.io\",1883\r\n",AT_TIME_15SEC, AT_TIME_15SEC);
-	status |= MZ_init_cmd_direct("AT+QMTCONN=0,\"GPSTest\",\"GPSTest\",\"GPSTest\"\r\n",AT_TIME_15SEC, AT_TIME_15SEC);
-	status |= MZ_init_cmd_direct("AT+QMTPUB=0,0,0,0,\"v1/devices/me/telemetry\"\r\n",AT_TIME_15SEC, 0);
-	status |= MZ_init_cmd_direct(payload_string,AT_TIME_15SEC, AT_TIME_15SEC);
+#if(GPS_RADIO_ENABLE == MZ_ENABLE)
+	/* Out of PSM only for the upload */
+	mz_error_t status = gps_radio_begin(&gps_radio);
+	if(MZ_OK == status)
+	{
+		status = gps_backend_upload(pmsg, 1, HAL_GetTick());
+	}
+	gps_radio_end(&gps_radio);
+#else
+	mz_error_t status = gps_backend_upload(pmsg, 1, HAL_GetTick());
+#endif
+	GPS_TRACE(GPS_TRACE_PUBLISH_DONE, status);
 
 
 	/* Check the status of the request */
 	if(MZ_OK == status)
 	{
 		/* print success on CLI */
-		mz_puts("Data send to MonoZ_Lib\r\n");
+		GPS_LOG_OUT("Data send to MonoZ_Lib\r\n");
 	}
 	else
 	{
 		/* print of error string on CLI */
-		mz_puts("Data send to MonoZ_Lib FAILED\r\n");
+		GPS_LOG_OUT("Data send to MonoZ_Lib FAILED\r\n");
 		//mz_puts(mz_error_to_str(status));
 	}
+	return status;
 }
 /* MQTT send payload API - END */
 
+/** @fn static void gps_fix_commit(st_gps_fix * fix)
+ * @brief Commit one GPS epoch - START
+ * Called once per new valid epoch after all sentences of the received buffer
+ * are processed. All consumers of a fix are called from here.
+ * @param fix assembled fix
+ */
+static void gps_fix_commit(st_gps_fix * fix)
+{
+	GPS_PROF_BEGIN(GPS_PROF_COMMIT);
+
+	fix->tick = HAL_GetTick();
+	gps_last_commit_time = fix->utc_time;
+#if(GPS_TRACE_ENABLE == MZ_ENABLE)
+	/* Cost of a trace record, "trace" in the prof dump */
+	GPS_PROF_BEGIN(GPS_PROF_TRACE);
+	GPS_TRACE(GPS_TRACE_COMMIT, fix->utc_time);
+	GPS_PROF_END(GPS_PROF_TRACE);
+#endif
+#if(GPS_LATENCY_ENABLE == MZ_ENABLE)
+	gps_latency_mark(GPS_LAT_VALID, fix->tick);
+#endif
+
+#if(GPS_SDLOG_ENABLE == MZ_ENABLE)
+	gps_sdlog_write_fix(fix);
+#endif
+
+#if(GPS_KALMAN_ENABLE == MZ_ENABLE)
+	/* The log keeps the raw position, everything below uses the estimate */
+	gps_fix_smooth = *fix;
+	gps_kalman_update(&gps_kalman, &gps_fix_smooth);
+	fix = &gps_fix_smooth;
+#endif
+
+#if(GPS_GEOFENCE_ENABLE == MZ_ENABLE)
+	gps_geofence_eval(fix->lat_e7, fix->lon_e7, gps_geofence_event_cb);
+#endif
+
+#if(GPS_TRACK_BATCH_ENABLE == MZ_ENABLE)
+	gps_simplify_push(&gps_simplify, fix);
+#endif
+
+#if(GPS_RXPM_ENABLE == MZ_ENABLE)
+	if(fix->valid == GPS_FIX_VALID)
+	{
+		gps_rxpm_fix(&gps_rxpm, fix->tick);
+	}
+#endif
+
+#if(GPS_TIME_ENABLE == MZ_ENABLE)
+	/* The RTC follows GPS time, sub-second from the start of the burst */
+#if(GPS_RX_RING == MZ_ENABLE)
+	gps_time_fix(fix, gps_lpuart_burst_tick());
+#else
+	gps_time_fix(fix, fix->tick);
+#endif
+#endif
+
+#if(GPS_AID_ENABLE == MZ_ENABLE)
+	if(fix->valid == GPS_FIX_VALID)
+	{
+		gps_aid_fix(fix);
+	}
+#endif
+
+	if(fix->valid == GPS_FIX_VALID)
+	{
+		gps_fix_last = *fix;
+	}
+
+#if(GPS_REPORT_POLICY_ENABLE == MZ_ENABLE)
+	/* Movement based reporting replaces the fixed send timer */
+	if(GPS_REPORT_NONE != gps_report_policy_check(fix))
+	{
+		dataTxReady = FLAG_SET;
+	}
+#endif
+
+#if(GPS_LATENCY_ENABLE == MZ_ENABLE)
+	gps_latency_mark(GPS_LAT_COMMIT, HAL_GetTick());
+#endif
+	GPS_PROF_END(GPS_PROF_COMMIT);
+}
+/* Commit one GPS epoch - END */
+
+#if(GPS_GEOFENCE_ENABLE == MZ_ENABLE)
+/** @fn static void gps_geofence_event_cb(uint16_t id, en_gps_geofence_event ev)
+ * @brief Geofence event callback - START
+ * Queue the transition, it is published from the thread loop.
+ * @param id fence id
+ * @param ev enter / exit
+ */
+static void gps_geofence_event_cb(uint16_t id, en_gps_geofence_event ev)
+{
+	if(geofence_ev_count >= GPS_GEOFENCE_EVENT_QUEUE)
+	{
+		GPS_LOG_OUT("geofence event queue full\r\n");
+		return;
+	}
+
+	geofence_ev_queue[geofence_ev_count].id = id;
+	geofence_ev_queue[geofence_ev_count].ev = ev;
+	geofence_ev_count++;
+}
+/* Geofence event callback - END */
+
+/** @fn static void gps_geofence_publish(void)
+ * @brief Publish queued geofence events - START
+ */
+static void gps_geofence_publish(void)
+{
+	for(uint8_t i = 0; i < geofence_ev_count; i++)
+	{
+		gps_payload_geofence(geofence_ev_queue[i].id, (geofence_ev_queue[i].ev == GPS_GEOFENCE_ENTER), geofence_payload);
+
+		geofence_msg.topic = MZ_MQTT_PUB_TOPIC;
+		geofence_msg.payload = geofence_payload;
+		geofence_msg.fixes = NULL;
+		geofence_msg.n_fixes = 0;
+
+		send_payload_to_server(&geofence_msg);
+	}
+	geofence_ev_count = 0;
+}
+/* Publish queued geofence events - END */
+#endif
+
+#if(GPS_LOG_ENABLE == MZ_ENABLE)
+/** @fn static void gps_log_thread(void * arg)
+ * @brief CLI log drain thread - START
+ * Writes the records queued by GPS_LOG_OUT on the CLI UART. It runs below
+ * every other application thread, the UART time is spent here only.
+ * @param arg void
+ */
+static void gps_log_thread(void * arg)
+{
+	(void)arg;
+
+	while(1)
+	{
+		(void)gps_log_drain(gps_log_cli, GPS_LOG_SLOTS);
+		osDelay(GPS_LOG_DRAIN_MS);
+	}
+}
+/* CLI log drain thread - END */
+#endif
+
+#if(GPS_RX_RING == MZ_ENABLE)
+/** @fn static void gps_rx_burst(void)
+ * @brief Parse a complete receiver burst - START
+ * The burst is taken from the stop mode ring in line aligned chunks of
+ * rx1_char, the epoch is committed once all of it is decoded.
+ */
+static void gps_rx_burst(void)
+{
+	uint16_t len;
+
+	while(0 != (len = gps_lpuart_read(rx1_char, sizeof(rx1_char))))
+	{
+#if(GPS_SDLOG_ENABLE == MZ_ENABLE)
+		gps_sdlog_write_nmea(rx1_char, len);
+#endif
+		GPS_PROF_BEGIN(GPS_PROF_PARSE);
+		gps_nmea_parse_buffer(rx1_char, len, &gps_fix, &gps_nmea_stats);
+		GPS_PROF_END(GPS_PROF_PARSE);
+	}
+}
+/* Parse a complete receiver burst - END */
+#endif
+
 /** @fn static void gps_app_thread(void * arg)
  * @brief GPS main Application thread.  START
  * 1. It creates all the timer
@@ -326,16 +719,6 @@ static void gps_app_thread(void * arg)
 {
 	(void)arg;
 
-	char latbuf1[LAT_BUFF1_SIZE] = {0};
-	char lonbuf1[LON_BUFF1_SIZE] = {0};
-	char latbuf2[LAT_BUFF2_SIZE] = {0};
-	char lonbuf2[LON_BUFF2_SIZE] = {0};
-
-	int32_t wrdInLine = INIT_0;
-	int32_t noLineCnt = INIT_0;
-	int32_t wrdInLine2 = INIT_0;
-	int32_t noLineCnt2 = INIT_0;
-
 	/*
 	 * create the gps sensor reading timer.
 	 * As per requirement, We are creating a recursive timer using
@@ -350,8 +733,31 @@ static void gps_app_thread(void * arg)
 											GPS_SENSOR_READ_TIME,
 											gps_sensor_read_timer_cb))
 	{
-		mz_puts("GPS sensor reading timer started\r\n");
+		GPS_LOG_OUT("GPS sensor reading timer started\r\n");
+	}
+
+#if(GPS_TWHEEL_ENABLE == MZ_ENABLE)
+	/* One MonoZ timer for every application timer on the wheel */
+	if(MZ_OK != mz_tm_create_start_recursive("gps timer wheel",
+											pdMS_TO_TICKS(GPS_TW_TICK_MS),
+											gps_twheel_timer_cb))
+	{
+		GPS_LOG_OUT("gps timer wheel start failed\r\n");
 	}
+#endif
+
+#if(GPS_RXPM_ENABLE == MZ_ENABLE)
+	/* The receiver is on and searching after reset */
+	gps_rxpm_init(&gps_rxpm, HAL_GetTick());
+#endif
+
+#if(GPS_RADIO_ENABLE == MZ_ENABLE)
+	/* PSM / eDRX timers for the upload interval */
+	if(MZ_OK != gps_radio_init(&gps_radio))
+	{
+		GPS_LOG_OUT("modem power save request failed\r\n");
+	}
+#endif
 
 	/*
 	 * This is the infinite loop for this thread - the thread will execute this
@@ -364,143 +770,85 @@ static void gps_app_thread(void * arg)
 		 * not status - Check if the flag is set
 		 */
 
+#if(GPS_REPLAY_ENABLE == MZ_ENABLE)
+		/* Take the next recorded epoch instead of the receiver */
+		if(0 != gps_replay_poll(rx1_char, sizeof(rx1_char), HAL_GetTick()))
+		{
+			gps_uart_recv_complete_flag = UART_RECEIVE_COMPLETE_SET;
+#if(GPS_LATENCY_ENABLE == MZ_ENABLE)
+			gps_latency_rx(HAL_GetTick());
+#endif
+		}
+#elif(GPS_RX_RING == MZ_ENABLE)
+		/* Sleep until a receiver burst is complete, then parse all of it */
+		if(gps_lpuart_wait(GPS_LPUART_WAIT_MS))
+		{
+			gps_rx_burst();
+		}
+#if(GPS_LOG_ENABLE == MZ_ENABLE)
+		if((HAL_GetTick() - gps_duty_tick) >= GPS_LPUART_DUTY_MS)
+		{
+			st_gps_lpuart_stats rx;
+
+			gps_duty_tick = HAL_GetTick();
+			gps_lpuart_get_stats(&rx);
+			gps_log_printf("lpuart: duty %lu permille, bursts %lu, bytes %lu, wakes %lu, lost %lu\r\n",
+							(unsigned long)gps_lpuart_duty(), (unsigned long)rx.bursts, (unsigned long)rx.bytes,
+							(unsigned long)rx.wakes, (unsigned long)(rx.dropped + rx.overruns));
+		}
+#endif
+#else
 		/* Read GPS uart data in a buffer*/
 		(void)MZ_UART_Receive_IT(MZ_GPS_UART_INSTANCE, (uint8_t *)&rx1_char, sizeof(rx1_char));
+#endif
 
-		wrdInLine = 0;
-		noLineCnt = 0;
-	    for(int16_t recCmptData = 0; recCmptData <= (strlen(rx1_char)); recCmptData++)
-	    {
-			/*  10:19:02  $GPRMC,101902.00,A,2951.91860,N,07752.38737,E,0.032,,300322,,,A*7C
-				10:19:02  $GPVTG,,T,,M,0.032,N,0.060,K,A*24
-				10:19:02  $GPGGA,101902.00,2951.91860,N,07752.38737,E,1,05,3.95,248.4,M,-36.3,M,,*7A
-				10:19:02  $GPGSA,A,3,06,02,19,24,17,,,,,,,,4.73,3.95,2.60*05
-				10:19:02  $GPGSV,3,1,09,02,62,243,34,03,00,033,,06,65,030,32,11,64,227,32*76
-				10:19:02  $GPGSV,3,2,09,17,27,062,23,19,41,045,29,20,25,174,20,24,34,262,32*73
-				10:19:02  $GPGSV,3,3,09,28,42,121,19*46
-				10:19:02  $GPGLL,2951.91860,N,07752.38737,E,101902.00,A,A*64
-			*/
-
-	    	/* Split all new lines from received buffer */
-	        if(rx1_char[recCmptData] == '\n')
-	        {
-	            splitStrings[noLineCnt][wrdInLine] = '\0';
-	            noLineCnt++;
-	            wrdInLine = 0;
-	        }
-	        else
-	        {
-	            splitStrings[noLineCnt][wrdInLine] = rx1_char[recCmptData];
-	            wrdInLine++;
-	        }
-		}
-	    for(int16_t dataInLine = 0; dataInLine <= noLineCnt; dataInLine++)
+#if(GPS_RX_RING != MZ_ENABLE)
+
+		/* Log the raw buffer once when a new receive is complete */
+		if(gps_uart_recv_complete_flag == UART_RECEIVE_COMPLETE_SET)
 		{
-			wrdInLine2 = 0;
-			noLineCnt2 = 0;
-			strcpy(respbuf, splitStrings[dataInLine]);
+			gps_uart_recv_complete_flag = UART_RECEIVE_COMPLETE_CLEAR;
+#if(GPS_SDLOG_ENABLE == MZ_ENABLE)
+			gps_sdlog_write_nmea(rx1_char, strnlen(rx1_char, sizeof(rx1_char)));
+#endif
+		}
 
-			for(int16_t dataInLine2 = 0; dataInLine2 <= (strlen(respbuf)); dataInLine2++)
-			{
-				/* split all contents from line */
-				if((respbuf[dataInLine2] == ',') || (respbuf[dataInLine2] == '*'))
-				{
-					splitStrings2[noLineCnt2][wrdInLine2] = '\0';
-					noLineCnt2++;
-					wrdInLine2 = 0;
-				}
-				else
-				{
-					splitStrings2[noLineCnt2][wrdInLine2] = respbuf[dataInLine2];
-					wrdInLine2++;
-				}
-			}
-		    for(int32_t ii = 0; ii <= noLineCnt2; ii++)
-			{
-				memset(latbuf1, 0, LAT_BUFF1_SIZE);
-				memset(latbuf2, 0, LAT_BUFF2_SIZE);
-				memset(lonbuf1, 0, LON_BUFF1_SIZE);
-				memset(lonbuf2, 0, LON_BUFF2_SIZE);
-				HAL_Delay(100);
-
-	    		/* Data moved to the corresponding variable according to the GPS format */
-				if((strcmp("$GPRMC",splitStrings2[ii])) == 0)
-				{
-					/*  $GPRMC, 123519, A, 4807.038, N, 01131.000, E,022.4, 084.4, 230394, 003.1, W*6A
-						 $				Every NMEA sentence starts with $ character.
-						GPRMC			Global Positioning Recommended Minimum Coordinates
-						123519			Current time in UTC – 12:35:19
-						A				Status A=active or V=Void.
-						4807.038,N		Latitude 48 deg 07.038′ N
-						01131.000,E		Longitude 11 deg 31.000′ E
-						022.4			Speed over the ground in knots
-						084.4			Track angle in degrees True
-						220318			Current Date – 22rd of March 2018
-						003.1,W			Magnetic Variation
-						*6A				The checksum data, always begins with *
-					 */
-
-		    		for(int16_t i = 0; i <= 1; i++){
-		    			latbuf2[i] = splitStrings2[3][i];}
-
-		    		for(int16_t i = 0; i <= 2; i++){
-		    			lonbuf2[i] = splitStrings2[5][i];}
-
-		    		for(int16_t i = 2; i <= strlen(splitStrings2[3]); i++){
-		    			latbuf1[i - 2] = splitStrings2[3][i];}
-
-		    		for(int16_t i = 3; i <= strlen(splitStrings2[5]); i++){
-		    			lonbuf1[i - 3] = splitStrings2[5][i];}
-
-		    		__fLat = (strtod(latbuf2, NULL)) + (strtod(latbuf1, NULL) / MINUTE_DEVIDER);
-		    		__fLon = (strtod(lonbuf2, NULL)) + (strtod(lonbuf1, NULL) / MINUTE_DEVIDER);
-
-		    		sprintf (__lat, "%4.8f", __fLat);
-		    		sprintf (__long, "%4.8f", __fLon);
-				}
-		    	else if((strcmp("$GPGSA",splitStrings2[ii])) == 0)
-				{
-		    		/*  $GPGSA,A,3,06,02,19,24,17,,,,,,,,4.73,3.95,2.60*05
-
-						Parameter	Value	Unit			Description
-						Op. Mode	A						M=Manual, A=Automatic 2D/3D
-						Nav. Mode	3						1=No, 2=2D, 3=3D
-						SVID		9(=G9)					Satellite ID
-						SVID		8(=G8)					Satellite ID
-						SVID		7(=G7)					Satellite ID
-						SVID		4(=G4)					Satellite ID
-						SVID		27(=G27)				Satellite ID
-						SVID		30(=G30)				Satellite ID
-						SVID								Satellite ID
-						SVID								Satellite ID
-						SVID								Satellite ID
-						SVID								Satellite ID
-						SVID								Satellite ID
-						SVID								Satellite ID
-						SVs Used	6						Number of SVs used for Navigation
-						PDOP		4.73					Positional Dilution of Precision
-						HDOP		3.95					Horizontal Dilution of Precision
-						VDOP		2.60					Vertical Dilution of Precision
-						GNSS System ID
-					*/
-
-					strcpy(__PDOP, splitStrings2[15]);
-					strcpy(__HDOP, splitStrings2[16]);
-					strcpy(__VDOP, splitStrings2[17]);
-				}
-			}
-			HAL_Delay(10);
+		/*  10:19:02  $GPRMC,101902.00,A,2951.91860,N,07752.38737,E,0.032,,300322,,,A*7C
+			10:19:02  $GPVTG,,T,,M,0.032,N,0.060,K,A*24
+			10:19:02  $GPGGA,101902.00,2951.91860,N,07752.38737,E,1,05,3.95,248.4,M,-36.3,M,,*7A
+			10:19:02  $GPGSA,A,3,06,02,19,24,17,,,,,,,,4.73,3.95,2.60*05
+			10:19:02  $GPGSV,3,1,09,02,62,243,34,03,00,033,,06,65,030,32,11,64,227,32*76
+			10:19:02  $GPGSV,3,2,09,17,27,062,23,19,41,045,29,20,25,174,20,24,34,262,32*73
+			10:19:02  $GPGSV,3,3,09,28,42,121,19*46
+			10:19:02  $GPGLL,2951.91860,N,07752.38737,E,101902.00,A,A*64
+
+			$GPRMC : time, status, latitude, longitude, speed, course and date
+			$GPGGA : satellites in use and altitude
+			$GPGSA : PDOP, HDOP and VDOP (fields 15, 16 and 17)
+			The sentences are decoded in MZ_gps_nmea.c.
+		*/
+		{
+			GPS_PROF_BEGIN(GPS_PROF_PARSE);
+			gps_nmea_parse_buffer(rx1_char, (uint16_t)strnlen(rx1_char, sizeof(rx1_char)), &gps_fix, &gps_nmea_stats);
+			GPS_PROF_END(GPS_PROF_PARSE);
 		}
-	    //Move the data to create the payload
-		strcpy(final_lat_data, __lat);
-		strcpy(final_lon_data, __long);
-		strcpy(final_pdop_data, __PDOP);
-		strcpy(final_hdop_data, __HDOP);
-		strcpy(final_vdop_data, __VDOP);
+#endif //(GPS_RX_RING != MZ_ENABLE)
+
+	    /* Commit the epoch once, the same buffer is parsed on every pass */
+	    if((gps_fix.valid == GPS_FIX_VALID) && (gps_fix.utc_time != gps_last_commit_time))
+	    {
+	    	gps_fix_commit(&gps_fix);
+	    }
 
+#if(GPS_REPORT_POLICY_ENABLE != MZ_ENABLE)
 		if(timerCBFlag == FLAG_CLEAR)
 		{
 			timerCBFlag = FLAG_SET;
+#if(GPS_TWHEEL_ENABLE == MZ_ENABLE)
+			/* Starting the gps sensor data one time timer */
+			gps_tw_start(&gps_wheel, &gps_sensor_data_tw,
+						(GPS_SENSOR_DATA_SEND_TIME * portTICK_PERIOD_MS) / GPS_TW_TICK_MS, 0);
+#else
 			/* Stopping the gps sensor data one time timer */
 			if(gps_sensor_data_timer_id)
 			{
@@ -508,7 +856,7 @@ static void gps_app_thread(void * arg)
 				if(MZ_OK != mz_tm_start(gps_sensor_data_timer_id))
 				{
 					/* print of error string on CLI */
-					mz_puts("gps sensor data timer creation failed\r\n");
+					GPS_LOG_OUT("gps sensor data timer creation failed\r\n");
 				}
 				else {} // Default waiting case.
 			}
@@ -523,29 +871,226 @@ static void gps_app_thread(void * arg)
 				if(MZ_OK != mz_tm_start(gps_sensor_data_timer_id))
 				{
 					/* print of error string on CLI */
-					mz_puts("gps sensor data timer creation failed\r\n");
+					GPS_LOG_OUT("gps sensor data timer creation failed\r\n");
 				}
 				else {} // Default waiting case.
 			}
+#endif //(GPS_TWHEEL_ENABLE == MZ_ENABLE)
 		}
 		else {} // Default waiting case.
+#endif
 
 		/* Send data to MQTT server */
 		if(dataTxReady == FLAG_SET)
 		{
+			GPS_PROF_BEGIN(GPS_PROF_PAYLOAD);
+#if(GPS_TRACK_BATCH_ENABLE == MZ_ENABLE)
+			/* Publish the simplified track since the last send */
+			create_batch_payload(&pmsg, batch_payload);
+#else
 			/* Create the payload from the received data */
 			create_mqtt_payload(&pmsg, payload_string);
+#endif
+			GPS_PROF_END(GPS_PROF_PAYLOAD);
+#if(GPS_LATENCY_ENABLE == MZ_ENABLE)
+			/* GPS_LAT_SUBMIT is stamped when the publish command goes out */
+			gps_latency_mark(GPS_LAT_PAYLOAD, HAL_GetTick());
+#endif
 
 			/* send the payload to mqtt server */
+			GPS_PROF_BEGIN(GPS_PROF_PUBLISH);
+#if(GPS_LATENCY_ENABLE == MZ_ENABLE)
+			if(MZ_OK == send_payload_to_server(&pmsg))
+			{
+				/* Modem OK of the payload ends the epoch */
+				gps_latency_ack(HAL_GetTick());
+			}
+#else
 			send_payload_to_server(&pmsg);
+#endif
+			GPS_PROF_END(GPS_PROF_PUBLISH);
+#if(GPS_RXPM_ENABLE == MZ_ENABLE)
+			/* The receiver may sleep until shortly before the next report */
+			gps_rxpm_reported(&gps_rxpm, HAL_GetTick());
+#endif
 
 			dataTxReady = FLAG_CLEAR;
 			timerCBFlag = FLAG_CLEAR;
 		}
 		else {} // Default waiting case.
 
-		/* Put a delay to avoid blocking on this thread */
-		HAL_Delay(10);
+#if(GPS_MODEM_EMU_ENABLE == MZ_ENABLE)
+		/* Emulated URCs, e.g. QoS 1 PUBACKs */
+		gps_at_emu_poll();
+#endif
+
+		/* Backends that hold reports back, e.g. LwM2M until pmin, or
+		 * retransmit, e.g. QoS 1 without PUBACK */
+		if(gps_backend_poll(HAL_GetTick()))
+		{
+			GPS_PROF_BEGIN(GPS_PROF_PUBLISH);
+#if(GPS_RADIO_ENABLE == MZ_ENABLE)
+			mz_error_t status = gps_radio_begin(&gps_radio);
+			if(MZ_OK == status)
+			{
+				status = gps_backend_flush(HAL_GetTick());
+			}
+			gps_radio_end(&gps_radio);
+#else
+			mz_error_t status = gps_backend_flush(HAL_GetTick());
+#endif
+			GPS_PROF_END(GPS_PROF_PUBLISH);
+			GPS_LOG_OUT((MZ_OK == status) ? "Data flushed to MonoZ_Lib\r\n" : "Data flush to MonoZ_Lib FAILED\r\n");
+		}
+
+#if(GPS_GEOFENCE_ENABLE == MZ_ENABLE)
+		/* Send geofence transitions as soon as they happen */
+		gps_geofence_publish();
+#endif
+
+#if(GPS_SDLOG_ENABLE == MZ_ENABLE)
+		/* Start pending SD card transfers */
+		gps_sdlog_poll();
+#endif
+
+#if(GPS_RXPM_ENABLE == MZ_ENABLE)
+		/* Receiver power save frames */
+		{
+			uint16_t len = gps_rxpm_poll(&gps_rxpm, HAL_GetTick(), gps_rxpm_frame, sizeof(gps_rxpm_frame));
+
+			if((len != 0) && (MZ_OK != MZ_UART_Transmit(MZ_GPS_UART_INSTANCE, gps_rxpm_frame, len, GPS_RXPM_TX_TIMEOUT_MS)))
+			{
+				GPS_LOG_OUT("gps receiver power frame failed\r\n");
+			}
+		}
+#endif
+
+#if(GPS_AID_ENABLE == MZ_ENABLE)
+		/* Aiding after boot, benchmark restarts */
+		{
+			uint16_t len = gps_aid_poll(HAL_GetTick(), gps_aid_frame, sizeof(gps_aid_frame));
+
+			if((len != 0) && (MZ_OK != MZ_UART_Transmit(MZ_GPS_UART_INSTANCE, gps_aid_frame, len, GPS_AID_TX_TIMEOUT_MS)))
+			{
+				GPS_LOG_OUT("gps receiver aiding frame failed\r\n");
+			}
+		}
+#endif
+
+#if(GPS_PROF_ENABLE == MZ_ENABLE)
+		/* Probe tables on the CLI */
+		if((HAL_GetTick() - gps_prof_dump_tick) >= GPS_PROF_DUMP_MS)
+		{
+			gps_prof_dump_tick = HAL_GetTick();
+			gps_prof_dump(GPS_LOG_OUT);
+		}
+#endif
+
+#if(GPS_HEALTH_ENABLE == MZ_ENABLE)
+		/* Task, stack and heap usage since the last health payload */
+#if(GPS_RADIO_ENABLE == MZ_ENABLE)
+		/* Not worth a wake up of its own, sent while the modem is still awake */
+		if(((HAL_GetTick() - gps_health_tick) >= GPS_HEALTH_PERIOD_MS) && gps_radio_awake(&gps_radio, HAL_GetTick()))
+#else
+		if((HAL_GetTick() - gps_health_tick) >= GPS_HEALTH_PERIOD_MS)
+#endif
+		{
+			int len;
+
+			gps_health_tick = HAL_GetTick();
+			gps_health_sample(&gps_health);
+			len = gps_health_payload(&gps_health, health_payload, sizeof(health_payload) - 1);
+			health_payload[len++] = 26;
+			health_payload[len] = '\0';
+
+			health_msg.topic = MZ_MQTT_PUB_TOPIC;
+			health_msg.payload = health_payload;
+			health_msg.fixes = NULL;
+			health_msg.n_fixes = 0;
+			send_payload_to_server(&health_msg);
+		}
+#endif
+
+#if((GPS_RADIO_ENABLE == MZ_ENABLE) && (GPS_LOG_ENABLE == MZ_ENABLE))
+		/* Time in each modem state */
+		if((HAL_GetTick() - gps_radio_dump_tick) >= GPS_RADIO_DUMP_MS)
+		{
+			st_gps_radio_stats radio;
+
+			gps_radio_dump_tick = HAL_GetTick();
+			gps_radio_get_stats(&gps_radio, HAL_GetTick(), &radio);
+			gps_log_printf("radio: conn %lu idle %lu psm %lu wake %lu s, uploads %lu, wakes %lu (last %lu max %lu ms), fails %lu\r\n",
+							(unsigned long)(radio.ms[GPS_RADIO_CONNECTED] / 1000), (unsigned long)(radio.ms[GPS_RADIO_IDLE] / 1000),
+							(unsigned long)(radio.ms[GPS_RADIO_PSM] / 1000), (unsigned long)(radio.ms[GPS_RADIO_WAKING] / 1000),
+							(unsigned long)radio.uploads, (unsigned long)radio.wakes, (unsigned long)radio.wake_last_ms,
+							(unsigned long)radio.wake_max_ms, (unsigned long)radio.wake_fails);
+		}
+#endif
+
+		/* Telemetry backend counters on the CLI */
+		if((HAL_GetTick() - gps_backend_dump_tick) >= GPS_BACKEND_DUMP_MS)
+		{
+			st_gps_backend_stats bs;
+
+			gps_backend_dump_tick = HAL_GetTick();
+			gps_backend_get_stats(gps_backend_current(), &bs);
+			gps_log_printf("backend %s: uploads %lu, fails %lu, msgs %lu, payload %lu B, at %lu cmds %lu B\r\n",
+							gps_backend_get(gps_backend_current())->name, (unsigned long)bs.uploads, (unsigned long)bs.fails,
+							(unsigned long)bs.msgs, (unsigned long)bs.payload_bytes, (unsigned long)bs.at_cmds,
+							(unsigned long)bs.at_bytes);
+#if(MZ_LWM2M_ENABLE == MZ_ENABLE)
+			if(GPS_BACKEND_LWM2M == gps_backend_current())
+			{
+				st_gps_lwm2m_stats lw;
+
+				gps_lwm2m_get_stats(&lw);
+				gps_log_printf("lwm2m: reports %lu, notifies %lu, unobserved %lu, fails %lu, acks %lu, tlv %lu B, coap %lu B\r\n",
+								(unsigned long)lw.reports, (unsigned long)lw.notifies, (unsigned long)lw.unobserved,
+								(unsigned long)lw.fails, (unsigned long)lw.acks, (unsigned long)lw.payload_bytes,
+								(unsigned long)lw.coap_bytes);
+			}
+#endif
+#if(GPS_UDP_ENABLE == MZ_ENABLE)
+			if(GPS_BACKEND_UDP == gps_backend_current())
+			{
+				st_gps_udp_stats us;
+
+				gps_backend_udp_stats(&us);
+				gps_log_printf("udp: frames %lu, points %lu, sends %lu, retries %lu, acked %lu, lost %lu, overflow %lu, air %lu B, acks %lu B, rtt %lu max %lu ms\r\n",
+								(unsigned long)us.frames, (unsigned long)us.points, (unsigned long)us.sends,
+								(unsigned long)us.retries, (unsigned long)us.acked, (unsigned long)us.lost,
+								(unsigned long)us.overflow, (unsigned long)us.air_bytes, (unsigned long)us.ack_bytes,
+								(unsigned long)us.rtt_last_ms, (unsigned long)us.rtt_max_ms);
+			}
+#endif
+#if(GPS_MQTT_QOS1_ENABLE == MZ_ENABLE)
+			if(GPS_BACKEND_BG96 == gps_backend_current())
+			{
+				st_gps_qos_stats qs;
+				uint8_t in_flight;
+
+				gps_backend_qos_stats(&qs, &in_flight);
+				gps_log_printf("qos1: queued %lu, full %lu, sends %lu, retries %lu, acked %lu, failed %lu, lost %lu, in flight %u, rtt %lu max %lu ms\r\n",
+								(unsigned long)qs.queued, (unsigned long)qs.full, (unsigned long)qs.sends,
+								(unsigned long)qs.retries, (unsigned long)qs.acked, (unsigned long)qs.failed,
+								(unsigned long)qs.lost, in_flight, (unsigned long)qs.rtt_last_ms, (unsigned long)qs.rtt_max_ms);
+			}
+#endif
+		}
+
+#if(GPS_LATENCY_ENABLE == MZ_ENABLE)
+		/* Latency histograms on the CLI */
+		if((HAL_GetTick() - gps_latency_dump_tick) >= GPS_LATENCY_DUMP_MS)
+		{
+			gps_latency_dump_tick = HAL_GetTick();
+			gps_latency_dump(GPS_LOG_OUT);
+		}
+#endif
+
+#if(GPS_RX_RING != MZ_ENABLE)
+		/* Put a delay to avoid blocking on this thread, and let idle run */
+		osDelay(10);
+#endif
 
 	}//End of while(1) - Do not place any code after this.
 
@@ -563,10 +1108,98 @@ mz_error_t gps_app_init(void)
 {
 	mz_error_t _ret = MZ_OK;
 
+#if(GPS_TRACE_ENABLE == MZ_ENABLE)
+	/* Records of the previous run first, before they are overwritten */
+	gps_trace_init();
+	gps_trace_decode(gps_trace_get(), GPS_TRACE_BOOT_DUMP, gps_log_cli);
+#endif
+
+#if(GPS_PROF_ENABLE == MZ_ENABLE)
+	gps_prof_init();
+#endif
+
+#if(GPS_LOG_ENABLE == MZ_ENABLE)
+	gps_log_init();
+#if(GPS_PROF_ENABLE == MZ_ENABLE)
+	{
+		/* Caller side cost of a CLI line, synchronous and deferred */
+		uint32_t direct_cost;
+		uint32_t log_cost;
+
+		gps_log_bench(gps_log_cli, &direct_cost, &log_cost);
+		gps_log_printf("log bench: mz_puts %lu, gps_log %lu %s per line\r\n",
+						(unsigned long)direct_cost, (unsigned long)log_cost, GPS_PROF_UNIT);
+	}
+#endif
+#endif
+
+#if(GPS_LP_ENABLE == MZ_ENABLE)
+	gps_lp_init();
+#endif
+
+#if(GPS_TIME_ENABLE == MZ_ENABLE)
+	/* An RTC set from GPS before the reset timestamps right away */
+	gps_time_init();
+#endif
+
+#if(GPS_AID_ENABLE == MZ_ENABLE)
+	/* Last fix from before the reset, sent once the thread runs */
+	gps_aid_init();
+#endif
+
+#if(MZ_LWM2M_ENABLE == MZ_ENABLE)
+	/* Nothing is notified until the server observes the location */
+	gps_lwm2m_init();
+#endif
+
 	/* Initialize gps uart related functions */
 	_ret = gps_uart_init();
 	if(MZ_OK != _ret) goto clean;
 
+#if(GPS_SDLOG_ENABLE == MZ_ENABLE)
+	/* SD card logging is optional, run without it when no card is present */
+	if(MZ_OK != gps_sdlog_init())
+	{
+		mz_puts("SD card logger not available\r\n");
+	}
+#endif
+
+#if(GPS_REPORT_POLICY_ENABLE == MZ_ENABLE)
+	/* Default deadbands from MZ_gps_app_config.h */
+	gps_report_policy_init(NULL);
+#endif
+
+#if(GPS_KALMAN_ENABLE == MZ_ENABLE)
+	gps_kalman_init(&gps_kalman);
+#endif
+
+#if(GPS_TWHEEL_ENABLE == MZ_ENABLE)
+	gps_wheel_ms = HAL_GetTick();
+	gps_tw_init(&gps_wheel, 0);
+#if(GPS_REPORT_POLICY_ENABLE != MZ_ENABLE)
+	gps_tw_timer_init(&gps_sensor_data_tw, gps_sensor_data_tw_cb, NULL);
+#endif
+#endif
+
+#if(GPS_REPLAY_ENABLE == MZ_ENABLE)
+	mz_puts("GPS input replayed from the recorded trace\r\n");
+	gps_replay_init();
+#endif
+
+#if(GPS_TRACK_BATCH_ENABLE == MZ_ENABLE)
+	gps_simplify_init(&gps_simplify, GPS_SIMPLIFY_TOLERANCE_CM, gps_batch_emit_cb);
+#endif
+
+#if(GPS_GEOFENCE_ENABLE == MZ_ENABLE)
+	/* Load the fence table and build the grid index */
+	gps_geofence_reset();
+	gps_geofence_load();
+	if(MZ_OK != gps_geofence_build())
+	{
+		mz_puts("geofence index build failed\r\n");
+	}
+#endif
+
 	/* Create the gps application thread */
 	if(!mz_thread_create(	&gps_thread_id,
 							"gps Scheduler",
@@ -581,6 +1214,22 @@ mz_error_t gps_app_init(void)
 		_ret = MZ_THREAD_CREATE_FAIL;
 	}
 
+#if(GPS_LOG_ENABLE == MZ_ENABLE)
+	/* Create the CLI log drain thread */
+	if(!mz_thread_create(	&gps_log_thread_id,
+							"gps Log",
+							gps_log_thread,
+							NULL,
+							osPriorityLow,
+							gps_log_stack,
+							GPS_LOG_STACK_SIZE,
+							&gps_log_cb_mem,
+							sizeof(gps_log_cb_mem)))
+	{
+		_ret = MZ_THREAD_CREATE_FAIL;
+	}
+#endif
+
 	clean :
 	return _ret;
 }
@@ -11,7 +11,7 @@
 #include "MZ_tool_gen.h"
 
 #if(MZ_LWM2M_ENABLE == 1)
-#include "MZ_lwm2m_example1.h"
+#include "MZ_gps_lwm2m.h"
 #endif
 
 /* NOTE : This function can be modified, when the callback is needed,
@@ -96,7 +96,7 @@ __attribute__((weak)) void mz_device_info_default_callback(void * evnt)
 __attribute__((weak)) void mz_pro_default_callback(void * evnt)
 {
 #if(MZ_LWM2M_ENABLE == MZ_ENABLE)
-	lwm2m_event_process(evnt);
+	gps_lwm2m_event(evnt);
 #endif
 #if(MZ_MQTT_ENABLE == MZ_ENABLE)
 	//mqtt_event_process(evnt);
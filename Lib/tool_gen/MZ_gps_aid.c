@@ -0,0 +1,429 @@
+/*
+ * MZ_gps_aid.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_aid.h"
+#include "MZ_gps_ubx.h"
+#include "stddef.h"
+#include "string.h"
+#if((GPS_AID_ENABLE == MZ_ENABLE) && defined(__arm__))
+#include "stdio.h"
+#include "main.h"
+#include "MZ_common.h"
+#include "MZ_gps_log.h"
+#include "MZ_gps_time.h"
+#if(GPS_AID_FLASH_ENABLE == MZ_ENABLE)
+#include "MZ_flash.h"
+#endif
+#endif
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define AID_INI_LEN					(48)						///< AID-INI payload
+#define AID_INI_POS					(0x01UL)					///< AID-INI flags, position valid
+#define AID_INI_TIME				(0x02UL)					///< Time valid
+#define AID_INI_LLA					(0x20UL)					///< Position is lat / lon / alt
+#define AID_RST_LEN					(4)							///< CFG-RST payload
+#define AID_RST_GNSS				(0x02)						///< CFG-RST resetMode, controlled software reset, GNSS only
+#define AID_GPS_EPOCH_S				(315964800UL)				///< 1980-01-06 in unix time
+#define AID_WEEK_S					(604800UL)
+#define AID_UERE_CM					(500)						///< Range error, position accuracy is HDOP times this
+#define AID_TRACK_GAP_S				(3)							///< Longer gaps between fixes end continuous tracking
+#define AID_CRC_LEN					(offsetof(st_gps_aid_ckpt, crc))
+/* Define some common use MACRO - END */
+
+/** @fn static uint32_t aid_crc(const uint8_t * p, uint32_t len)
+ * @brief CRC-32 (IEEE), bitwise, the checkpoint is small
+ */
+static uint32_t aid_crc(const uint8_t * p, uint32_t len)
+{
+	uint32_t crc = 0xFFFFFFFFUL;
+
+	while(len--)
+	{
+		crc ^= *p++;
+		for(uint8_t b = 0; b < 8; b++)
+		{
+			crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320UL : 0);
+		}
+	}
+	return ~crc;
+}
+
+/*
+ * Take a valid fix into the checkpoint. - START
+ */
+void gps_aid_update(st_gps_aid_ckpt * c, const st_gps_fix * fix)
+{
+	uint32_t now = gps_fix_to_unix(fix);
+	uint32_t acc = (uint32_t)fix->hdop_x100 * AID_UERE_CM / 100;
+
+	if(now == 0)
+	{
+		return;
+	}
+
+	if(!gps_aid_valid(c))
+	{
+		memset(c, 0, sizeof(*c));
+		c->magic = GPS_AID_MAGIC;
+	}
+
+	/* The ephemeris is refreshed by continuous tracking, as in the receiver */
+	if((c->track_s == 0) || (now < c->fix_s) || ((now - c->fix_s) > AID_TRACK_GAP_S))
+	{
+		c->track_s = now;
+	}
+	if((now - c->track_s) >= GPS_AID_EPH_TRACK_S)
+	{
+		c->eph_s = now;
+	}
+
+	c->lat_e7 = fix->lat_e7;
+	c->lon_e7 = fix->lon_e7;
+	c->alt_cm = fix->alt_cm;
+	c->acc_cm = (acc < GPS_AID_POS_ACC_CM) ? GPS_AID_POS_ACC_CM : acc;
+	c->fix_s = now;
+	c->seq++;
+	c->crc = aid_crc((const uint8_t *)c, AID_CRC_LEN);
+}
+/* Take a valid fix into the checkpoint. - END */
+
+/*
+ * Check a checkpoint. - START
+ */
+uint8_t gps_aid_valid(const st_gps_aid_ckpt * c)
+{
+	return (c->magic == GPS_AID_MAGIC) && (c->crc == aid_crc((const uint8_t *)c, AID_CRC_LEN));
+}
+/* Check a checkpoint. - END */
+
+/*
+ * UBX AID-INI. - START
+ */
+uint16_t gps_aid_ini(const st_gps_aid_ckpt * c, uint32_t now_s, uint16_t now_ms, uint32_t tacc_ms, uint8_t * out, uint16_t size)
+{
+	uint8_t payload[AID_INI_LEN];
+	uint32_t flags = 0;
+
+	memset(payload, 0, sizeof(payload));
+
+	if((c != NULL) && gps_aid_valid(c))
+	{
+		uint64_t acc = GPS_AID_POS_ACC_MAX_CM;
+
+		/* The device may have moved since, by up to GPS_AID_POS_GROW_CMS */
+		if((now_s != 0) && (now_s >= c->fix_s))
+		{
+			acc = c->acc_cm + ((uint64_t)(now_s - c->fix_s) * GPS_AID_POS_GROW_CMS);
+		}
+		if(acc <= GPS_AID_POS_ACC_MAX_CM)
+		{
+			gps_ubx_put_u32(&payload[0], (uint32_t)c->lat_e7);
+			gps_ubx_put_u32(&payload[4], (uint32_t)c->lon_e7);
+			gps_ubx_put_u32(&payload[8], (uint32_t)c->alt_cm);
+			gps_ubx_put_u32(&payload[12], (uint32_t)acc);
+			flags |= AID_INI_POS | AID_INI_LLA;
+		}
+	}
+
+	if(now_s > AID_GPS_EPOCH_S)
+	{
+		/* GPS time runs ahead of UTC by the leap seconds */
+		uint32_t gps_s = now_s - AID_GPS_EPOCH_S + GPS_AID_LEAP_S;
+
+		gps_ubx_put_u16(&payload[18], (uint16_t)(gps_s / AID_WEEK_S));
+		gps_ubx_put_u32(&payload[20], ((gps_s % AID_WEEK_S) * 1000UL) + now_ms);
+		gps_ubx_put_u32(&payload[28], tacc_ms);
+		flags |= AID_INI_TIME;
+	}
+
+	if(flags == 0)
+	{
+		return 0;
+	}
+	gps_ubx_put_u32(&payload[44], flags);
+	return gps_ubx_frame(GPS_UBX_CLASS_AID, GPS_UBX_AID_INI, payload, AID_INI_LEN, out, size);
+}
+/* UBX AID-INI. - END */
+
+/*
+ * UBX CFG-RST. - START
+ */
+uint16_t gps_aid_rst(uint16_t bbr, uint8_t * out, uint16_t size)
+{
+	uint8_t payload[AID_RST_LEN];
+
+	gps_ubx_put_u16(&payload[0], bbr);
+	payload[2] = AID_RST_GNSS;
+	payload[3] = 0;
+	return gps_ubx_frame(GPS_UBX_CLASS_CFG, GPS_UBX_CFG_RST, payload, AID_RST_LEN, out, size);
+}
+/* UBX CFG-RST. - END */
+
+/*
+ * Count one boot to first fix time. - START
+ */
+void gps_aid_ttff_add(st_gps_aid_ttff * t, uint32_t ms)
+{
+	t->n++;
+	t->last_ms = ms;
+	t->sum_ms += ms;
+	if((t->n == 1) || (ms < t->min_ms))
+	{
+		t->min_ms = ms;
+	}
+	if(ms > t->max_ms)
+	{
+		t->max_ms = ms;
+	}
+}
+/* Count one boot to first fix time. - END */
+
+#if((GPS_AID_ENABLE == MZ_ENABLE) && defined(__arm__))
+
+/* Define some common use MACRO - START */
+#define AID_NV_MAGIC				(0x41494E56UL)				///< "AINV", noinit block is valid
+#define AID_LINE_SIZE				(96)						///< One CLI line
+#define AID_FLASH_PAGE				(2048)						///< STM32L4A6 page, dual bank
+#define AID_FLASH_SLOTS				(AID_FLASH_PAGE / sizeof(st_gps_aid_ckpt))
+/* Define some common use MACRO - END */
+
+/**
+ * @struct st_gps_aid_nv
+ * @brief Kept over resets
+ */
+typedef struct
+{
+	uint32_t			magic;									/*!< AID_NV_MAGIC */
+	uint32_t			boots;									/*!< Resets seen */
+	st_gps_aid_ckpt		ckpt;									/*!< Last good fix */
+	st_gps_aid_ttff		ttff[2];								/*!< Unaided, aided */
+}st_gps_aid_nv;
+
+/* Aiding related variables - START */
+static st_gps_aid_nv aid_nv MZ_VAR_NOINIT;						/* Survives resets, not power loss */
+static st_gps_aid_ckpt aid_boot;								/* Checkpoint found at boot */
+static uint8_t aid_step = 0;									/* 0 reset, 1 aiding, 2 done */
+static uint8_t aid_aided = 0;									/* AID-INI was sent this boot */
+static uint8_t aid_fixed = 0;									/* First fix of this boot seen */
+static uint32_t aid_step_tick = 0;								/* Tick of the receiver reset */
+static uint32_t aid_fix_tick = 0;								/* Tick of the first fix */
+#if(GPS_AID_FLASH_ENABLE == MZ_ENABLE)
+static st_mz_flash aid_flash;									/* Reserved page */
+static uint8_t aid_flash_ok = 0;								/* Page driver ready */
+static uint8_t aid_flash_stored = 0;							/* Written this boot */
+static uint32_t aid_flash_slot = 0;								/* Next erased slot */
+static uint32_t aid_flash_tick = 0;								/* Tick of the last write */
+#endif
+/* Aiding related variables - END */
+
+#if(GPS_AID_FLASH_ENABLE == MZ_ENABLE)
+/** @fn static void aid_flash_load(st_gps_aid_ckpt * best)
+ * @brief Newest valid slot of the page, and the first erased one
+ */
+static void aid_flash_load(st_gps_aid_ckpt * best)
+{
+	const st_gps_aid_ckpt * slot = (const st_gps_aid_ckpt *)GPS_AID_FLASH_ADDR;
+
+	aid_flash_ok = (MZ_OK == mz_f_init(&aid_flash, GPS_AID_FLASH_ADDR, 1));
+	aid_flash_slot = AID_FLASH_SLOTS;
+	for(uint32_t i = 0; i < AID_FLASH_SLOTS; i++)
+	{
+		if(slot[i].magic == 0xFFFFFFFFUL)
+		{
+			/* Slots are written in order, the rest is erased */
+			aid_flash_slot = i;
+			break;
+		}
+		if(gps_aid_valid(&slot[i]) && (!gps_aid_valid(best) || (slot[i].seq > best->seq)))
+		{
+			*best = slot[i];
+		}
+	}
+}
+
+/** @fn static void aid_flash_store(const st_gps_aid_ckpt * c)
+ * @brief Write the next slot, erase the page when it is full
+ */
+static void aid_flash_store(const st_gps_aid_ckpt * c)
+{
+	if(!aid_flash_ok)
+	{
+		return;
+	}
+	if(aid_flash_slot >= AID_FLASH_SLOTS)
+	{
+		if(MZ_OK != mz_f_erase_ctx_relative_page_no(&aid_flash, 0))
+		{
+			return;
+		}
+		aid_flash_slot = 0;
+	}
+	/* A failed write leaves the slot unusable, the next write takes the next one */
+	(void)mz_f_store(&aid_flash, GPS_AID_FLASH_ADDR + (aid_flash_slot * sizeof(*c)), c, sizeof(*c));
+	aid_flash_slot++;
+	aid_flash_stored = 1;
+	aid_flash_tick = HAL_GetTick();
+}
+#endif
+
+/** @fn static uint16_t aid_ini_frame(uint8_t * out, uint16_t size)
+ * @brief AID-INI from the boot checkpoint and the RTC
+ */
+static uint16_t aid_ini_frame(uint8_t * out, uint16_t size)
+{
+	char line[AID_LINE_SIZE];
+	uint32_t now_s = 0;
+	uint16_t now_ms = 0;
+	uint16_t len;
+
+#if(GPS_AID_TTFF_BENCH == MZ_ENABLE)
+	/* Every other boot unaided, for the comparison */
+	if((aid_nv.boots & 1) == 0)
+	{
+		GPS_LOG_OUT("aid: benchmark boot without aiding\r\n");
+		return 0;
+	}
+#endif
+#if(GPS_TIME_ENABLE == MZ_ENABLE)
+	(void)gps_time_now(&now_s, &now_ms);
+#endif
+
+	len = gps_aid_ini(&aid_boot, now_s, now_ms, GPS_AID_TIME_ACC_MS, out, size);
+	aid_aided = (len != 0);
+	if(!gps_aid_valid(&aid_boot))
+	{
+		sprintf(line, "aid: no checkpoint, %s\r\n", (len != 0) ? "time only" : "nothing to send");
+	}
+	else if((now_s != 0) && (now_s >= aid_boot.fix_s))
+	{
+		sprintf(line, "aid: checkpoint %lu, fix age %lu s, ephemeris age %ld s\r\n",
+				(unsigned long)aid_boot.seq, (unsigned long)(now_s - aid_boot.fix_s),
+				(aid_boot.eph_s != 0) ? (long)(now_s - aid_boot.eph_s) : -1L);
+	}
+	else
+	{
+		sprintf(line, "aid: checkpoint %lu, no time, position only\r\n", (unsigned long)aid_boot.seq);
+	}
+	GPS_LOG_OUT(line);
+	return len;
+}
+
+/*
+ * Pick the newest checkpoint. - START
+ */
+void gps_aid_init(void)
+{
+	if(aid_nv.magic != AID_NV_MAGIC)
+	{
+		/* Power on, only the flash copy is left */
+		memset(&aid_nv, 0, sizeof(aid_nv));
+		aid_nv.magic = AID_NV_MAGIC;
+	}
+	else
+	{
+		aid_nv.boots++;
+	}
+
+	memset(&aid_boot, 0, sizeof(aid_boot));
+	if(gps_aid_valid(&aid_nv.ckpt))
+	{
+		aid_boot = aid_nv.ckpt;
+	}
+#if(GPS_AID_FLASH_ENABLE == MZ_ENABLE)
+	aid_flash_load(&aid_boot);
+#endif
+	/* Sequence and ephemeris stamp go on from the newest one */
+	aid_nv.ckpt = aid_boot;
+
+	aid_step = 0;
+	aid_aided = 0;
+	aid_fixed = 0;
+}
+/* Pick the newest checkpoint. - END */
+
+/*
+ * Aiding after boot. - START
+ */
+uint16_t gps_aid_poll(uint32_t now_ms, uint8_t * out, uint16_t size)
+{
+	if(aid_step == 0)
+	{
+		aid_step = 1;
+		aid_step_tick = now_ms;
+#if(GPS_AID_TTFF_BENCH == MZ_ENABLE)
+		/* Start the receiver from the state under test */
+		return gps_aid_rst(GPS_AID_BENCH_BBR, out, size);
+#endif
+	}
+
+	if(aid_step == 1)
+	{
+		if((now_ms - aid_step_tick) < GPS_AID_DELAY_MS)
+		{
+			return 0;
+		}
+		aid_step = 2;
+		if(aid_fixed)
+		{
+			/* MCU reset only, the receiver kept its fix */
+			return 0;
+		}
+		return aid_ini_frame(out, size);
+	}
+
+#if(GPS_AID_TTFF_BENCH == MZ_ENABLE)
+	if(aid_fixed && ((now_ms - aid_fix_tick) >= GPS_AID_BENCH_HOLD_MS))
+	{
+		/* Next benchmark run */
+		NVIC_SystemReset();
+	}
+#endif
+	return 0;
+}
+/* Aiding after boot. - END */
+
+/*
+ * A valid fix was committed. - START
+ */
+void gps_aid_fix(const st_gps_fix * fix)
+{
+	char line[AID_LINE_SIZE];
+
+#if(GPS_AID_TTFF_BENCH == MZ_ENABLE)
+	/* Fixes from before the receiver reset do not count */
+	if(!aid_fixed && (aid_step == 2))
+#else
+	if(!aid_fixed)
+#endif
+	{
+		st_gps_aid_ttff * t = &aid_nv.ttff[aid_aided];
+
+		aid_fixed = 1;
+		aid_fix_tick = fix->tick;
+		/* The HAL tick starts at boot */
+		gps_aid_ttff_add(t, fix->tick);
+		sprintf(line, "ttff: %lu ms %s, boot %lu, n %lu avg %lu min %lu max %lu ms\r\n",
+				(unsigned long)fix->tick, aid_aided ? "aided" : "unaided", (unsigned long)aid_nv.boots,
+				(unsigned long)t->n, (unsigned long)(t->sum_ms / t->n), (unsigned long)t->min_ms, (unsigned long)t->max_ms);
+		GPS_LOG_OUT(line);
+	}
+
+	gps_aid_update(&aid_nv.ckpt, fix);
+
+#if(GPS_AID_FLASH_ENABLE == MZ_ENABLE)
+	if(!aid_flash_stored || ((HAL_GetTick() - aid_flash_tick) >= GPS_AID_FLASH_MS))
+	{
+		aid_flash_store(&aid_nv.ckpt);
+	}
+#endif
+}
+/* A valid fix was committed. - END */
+
+#endif //((GPS_AID_ENABLE == MZ_ENABLE) && defined(__arm__))
@@ -0,0 +1,136 @@
+/*
+ * MZ_gps_aid.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Receiver aiding at boot.
+ *
+ *  Every valid fix updates a checkpoint (position, UTC of the fix and the
+ *  time the ephemeris was last refreshed by continuous tracking) kept in
+ *  .mz_RamBlock_noinit, so it is there after any reset. A copy goes to a
+ *  flash page reserved in STM32L4A6ZGTX_FLASH.ld every GPS_AID_FLASH_MS
+ *  for power loss, one 40 byte slot per write, the page is erased when
+ *  it is full. At boot the newest valid checkpoint is sent to the
+ *  receiver as UBX AID-INI : position with an accuracy that grows with
+ *  its age, and GPS time from the RTC (gps_time_now) when it carries GPS
+ *  time. Frames go to the receiver through gps_aid_poll().
+ *  The time from boot to the first valid fix is kept across restarts,
+ *  aided and unaided apart. In the TTFF benchmark mode
+ *  (GPS_AID_TTFF_BENCH) each boot resets the receiver with CFG-RST
+ *  (GPS_AID_BENCH_BBR, cold by default), aids every other boot only, and
+ *  restarts the MCU GPS_AID_BENCH_HOLD_MS after the first fix.
+ *  The frame builders and the checkpoint update have no HAL dependency.
+ */
+
+#ifndef MZ_GPS_AID_H_
+#define MZ_GPS_AID_H_
+
+#include "stdint.h"
+#include "MZ_gps_app_config.h"
+#include "MZ_gps_fix.h"
+
+#define GPS_AID_MAGIC				(0x41494431UL)				///< "AID1", checkpoint content is valid
+#define GPS_AID_FRAME_SIZE			(56)						///< Largest frame from gps_aid_poll (AID-INI)
+#define GPS_AID_BBR_HOT				(0x0000)					///< CFG-RST navBbrMask, keep everything
+#define GPS_AID_BBR_WARM			(0x0001)					///< Clear the ephemeris
+#define GPS_AID_BBR_COLD			(0xFFFF)					///< Clear everything
+
+/**
+ * @struct st_gps_aid_ckpt
+ * @brief Last good fix, the flash slot layout
+ */
+typedef struct
+{
+	uint32_t		magic;										/*!< GPS_AID_MAGIC */
+	uint32_t		seq;										/*!< Checkpoints written, the newest wins */
+	int32_t			lat_e7;										/*!< Latitude */
+	int32_t			lon_e7;										/*!< Longitude */
+	int32_t			alt_cm;										/*!< Altitude */
+	uint32_t		acc_cm;										/*!< Position accuracy of the fix */
+	uint32_t		fix_s;										/*!< UTC of the fix, seconds since 1970 */
+	uint32_t		track_s;									/*!< Continuous tracking since, 0 = not tracking */
+	uint32_t		eph_s;										/*!< Last ephemeris refresh, 0 = none */
+	uint32_t		crc;										/*!< CRC-32 of the fields above */
+}st_gps_aid_ckpt;
+
+/**
+ * @struct st_gps_aid_ttff
+ * @brief Boot to first valid fix
+ */
+typedef struct
+{
+	uint32_t		n;											/*!< Boots with a fix */
+	uint32_t		last_ms;									/*!< Last TTFF */
+	uint32_t		min_ms;										/*!< Shortest TTFF */
+	uint32_t		max_ms;										/*!< Longest TTFF */
+	uint32_t		sum_ms;										/*!< For the average */
+}st_gps_aid_ttff;
+
+/** @fn void gps_aid_update(st_gps_aid_ckpt * c, const st_gps_fix * fix)
+ * @brief Take a valid fix into the checkpoint and seal it.
+ * @param c checkpoint
+ * @param fix valid fix with UTC date and time
+ */
+void gps_aid_update(st_gps_aid_ckpt * c, const st_gps_fix * fix);
+
+/** @fn uint8_t gps_aid_valid(const st_gps_aid_ckpt * c)
+ * @brief Check magic and CRC of a checkpoint.
+ * @param c checkpoint
+ * @return 1 when valid
+ */
+uint8_t gps_aid_valid(const st_gps_aid_ckpt * c);
+
+/** @fn uint16_t gps_aid_ini(const st_gps_aid_ckpt * c, uint32_t now_s, uint16_t now_ms, uint32_t tacc_ms, uint8_t * out, uint16_t size)
+ * @brief UBX AID-INI from a checkpoint and the current time.
+ * @param c checkpoint, NULL or invalid for time only
+ * @param now_s UTC seconds since 1970, 0 when not known
+ * @param now_ms milliseconds of now_s
+ * @param tacc_ms accuracy of now
+ * @param out output
+ * @param size size of out, GPS_AID_FRAME_SIZE
+ * @return frame length, 0 when there is nothing to aid with
+ */
+uint16_t gps_aid_ini(const st_gps_aid_ckpt * c, uint32_t now_s, uint16_t now_ms, uint32_t tacc_ms, uint8_t * out, uint16_t size);
+
+/** @fn uint16_t gps_aid_rst(uint16_t bbr, uint8_t * out, uint16_t size)
+ * @brief UBX CFG-RST, GNSS only software reset.
+ * @param bbr navBbrMask, GPS_AID_BBR_*
+ * @param out output
+ * @param size size of out
+ * @return frame length
+ */
+uint16_t gps_aid_rst(uint16_t bbr, uint8_t * out, uint16_t size);
+
+/** @fn void gps_aid_ttff_add(st_gps_aid_ttff * t, uint32_t ms)
+ * @brief Count one boot to first fix time.
+ * @param t statistics
+ * @param ms TTFF
+ */
+void gps_aid_ttff_add(st_gps_aid_ttff * t, uint32_t ms);
+
+#if(GPS_AID_ENABLE == MZ_ENABLE)
+
+/** @fn void gps_aid_init(void)
+ * @brief Pick the newest checkpoint after a reset, call after gps_time_init().
+ */
+void gps_aid_init(void);
+
+/** @fn uint16_t gps_aid_poll(uint32_t now_ms, uint8_t * out, uint16_t size)
+ * @brief Aiding after boot and the benchmark restarts, call it at least
+ * every second.
+ * @param now_ms current tick
+ * @param out UBX frame to send to the receiver
+ * @param size size of out, GPS_AID_FRAME_SIZE
+ * @return frame length, 0 when nothing is to be sent
+ */
+uint16_t gps_aid_poll(uint32_t now_ms, uint8_t * out, uint16_t size);
+
+/** @fn void gps_aid_fix(const st_gps_fix * fix)
+ * @brief A valid fix was committed.
+ * @param fix fix
+ */
+void gps_aid_fix(const st_gps_fix * fix);
+
+#endif //(GPS_AID_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_AID_H_ */
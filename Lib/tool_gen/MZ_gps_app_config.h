@@ -0,0 +1,234 @@
+/*
+ * MZ_gps_app_config.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Build time feature switches and tuning values of the GPS application.
+ *  Every optional module of the GPS pipeline is enabled/disabled here with
+ *  MZ_ENABLE / MZ_DISABLE, the same way MZ_BoardCfg.h does for the library.
+ */
+
+#ifndef MZ_GPS_APP_CONFIG_H_
+#define MZ_GPS_APP_CONFIG_H_
+
+#include "MZ_BoardCfg.h"
+
+/* SD card ring logger - START */
+#define GPS_SDLOG_ENABLE				(MZ_DISABLE)			///< Log raw NMEA and committed fixes to the SD card
+#define GPS_SDLOG_BLOCKS_PER_BUF		(4)						///< Blocks in one half of the double buffer (one DMA burst)
+#define GPS_SDLOG_SUPER_BLOCK			(2048)					///< First of the two ping-pong superblocks
+#define GPS_SDLOG_START_BLOCK			(GPS_SDLOG_SUPER_BLOCK + 2)	///< First block of the log ring
+#define GPS_SDLOG_RING_BLOCKS			(262144UL)				///< Ring length in blocks (128 MiB)
+#define GPS_SDLOG_SUPER_EVERY			(16)					///< Update the superblock after this many bursts
+#define GPS_SDLOG_FLUSH_MS				(5000)					///< Flush a partially filled buffer after this time
+/* SD card ring logger - END */
+
+/* Geofence engine - START */
+#define GPS_GEOFENCE_ENABLE				(MZ_DISABLE)			///< Evaluate fences on every committed fix
+#define GPS_GEOFENCE_MAX_FENCES			(256)					///< Maximum number of fences
+#define GPS_GEOFENCE_MAX_VERTICES		(2048)					///< Vertex pool shared by all polygons
+#define GPS_GEOFENCE_GRID_DIM			(16)					///< Grid index is GRID_DIM x GRID_DIM cells
+#define GPS_GEOFENCE_MAX_CELL_ITEMS		(2048)					///< Total fence references over all cells
+#define GPS_GEOFENCE_MAX_INSIDE			(16)					///< Fences that can be inside at the same time
+#define GPS_GEOFENCE_EVENT_QUEUE		(8)						///< Events waiting for the publisher
+/* Geofence engine - END */
+
+/* Adaptive reporting policy - START */
+#define GPS_REPORT_POLICY_ENABLE		(MZ_DISABLE)			///< Publish on movement instead of a fixed period
+#define GPS_REPORT_MIN_INTERVAL_MS		(5000)					///< Never publish faster than this
+#define GPS_REPORT_MAX_SILENCE_MS		(120000)				///< Always publish after this much silence
+#define GPS_REPORT_DISTANCE_M			(100)					///< Publish after moving this far
+#define GPS_REPORT_HEADING_CDEG			(3000)					///< Publish after turning this much (1/100 degree)
+#define GPS_REPORT_HEADING_MIN_CMS		(250)					///< Heading is ignored below this speed
+#define GPS_REPORT_SPEED_DELTA_CMS		(500)					///< Publish after a speed change of this much
+/* Adaptive reporting policy - END */
+
+/* Track batching and simplification - START */
+#define GPS_TRACK_BATCH_ENABLE			(MZ_DISABLE)			///< Publish a simplified track batch instead of one snapshot
+#define GPS_BATCH_MAX_POINTS			(16)					///< Points per published batch
+#define GPS_SIMPLIFY_TOLERANCE_CM		(1000)					///< Maximum cross-track error of dropped points
+#define GPS_SIMPLIFY_WINDOW				(32)					///< Points held while a segment is open
+#define GPS_SIMPLIFY_MAX_SEG_CM			(500000L)				///< Segments are closed beyond this length
+/* Track batching and simplification - END */
+
+/* Position smoothing - START */
+#define GPS_KALMAN_ENABLE				(MZ_DISABLE)			///< Smooth committed fixes before they are used
+#define GPS_KALMAN_ACCEL_CMS2			(30)					///< Process noise, 1 sigma acceleration in cm/s^2
+#define GPS_KALMAN_UERE_CM				(300)					///< Position 1 sigma per unit of HDOP
+#define GPS_KALMAN_VEL_CMS				(10)					///< Receiver velocity 1 sigma per axis, 0 = position only
+#define GPS_KALMAN_GATE_CM				(10000)					///< Innovation above this restarts the filter
+#define GPS_KALMAN_RESET_MS				(10000)					///< Gap between fixes that restarts the filter
+#define GPS_KALMAN_ORIGIN_CM			(200000L)				///< Local frame is moved when the estimate is this far
+/* Position smoothing - END */
+
+/* NMEA replay - START */
+#define GPS_REPLAY_ENABLE				(MZ_DISABLE)			///< Feed the GPS thread from a recorded trace instead of LPUART1
+#define GPS_REPLAY_PERIOD_MS			(1000)					///< Time between two replayed epochs
+#define GPS_REPLAY_SYNTH				(MZ_DISABLE)			///< Generate epochs (MZ_gps_nmea_gen.c) instead of the trace
+#define GPS_REPLAY_RATE_HZ				(1)						///< Generated epochs per second, 1..10
+#define GPS_REPLAY_GLONASS				(MZ_DISABLE)			///< Generate $GN sentences and a $GLGSV block
+#define GPS_REPLAY_CORRUPT_EVERY		(0)						///< Every Nth generated sentence has a bad checksum, 0 = off
+#define GPS_REPLAY_DROP_EVERY			(0)						///< Every Nth generated sentence loses a byte, 0 = off
+#define GPS_REPLAY_SPLIT				(MZ_DISABLE)			///< Deliver every epoch in two receive buffers
+/* NMEA replay - END */
+
+/* Modem emulation - START */
+#define GPS_MODEM_EMU_ENABLE			(MZ_DISABLE)			///< Answer publish path AT commands locally, no modem traffic
+#define GPS_MODEM_EMU_LATENCY_MS		(150)					///< Emulated response time of a command
+#define GPS_MODEM_EMU_PUB_LATENCY_MS	(400)					///< Emulated time to send a payload
+#define GPS_MODEM_EMU_FAIL_EVERY		(0)						///< Every Nth command fails, 0 = off
+#define GPS_MODEM_EMU_URC_EVERY			(0)						///< Every Nth command drops the session with a URC, 0 = off
+#define GPS_MODEM_EMU_PSM_WAKE_MS		(2500)					///< Time from the wake up pulse to the first answer out of PSM
+#define GPS_MODEM_EMU_LOSS_EVERY		(0)						///< One emulated datagram or QoS 1 packet in N, either way, is lost at random, 0 = off
+#define GPS_MODEM_EMU_PUBACK_MS			(1200)					///< Emulated round trip from a QoS 1 PUBLISH to its +QMTPUB URC
+/* Modem emulation - END */
+
+/* Hot path profiling - START */
+#define GPS_PROF_ENABLE					(MZ_DISABLE)			///< Cycle count probes in the GPS hot paths
+#define GPS_PROF_HIST_BINS				(24)					///< log2 histogram bins per probe
+#define GPS_PROF_DUMP_MS				(60000)					///< Period of the probe dump on the CLI
+/* Hot path profiling - END */
+
+/* End to end latency - START */
+#define GPS_LATENCY_ENABLE				(MZ_DISABLE)			///< Per stage latency histograms from receive to modem OK
+#define GPS_LATENCY_HIST_BINS			(18)					///< log2 ms bins, the last one collects everything above
+#define GPS_LATENCY_DUMP_MS				(60000)					///< Period of the histogram dump on the CLI
+/* End to end latency - END */
+
+/* Post-mortem trace - START */
+#define GPS_TRACE_ENABLE				(MZ_DISABLE)			///< Event ring in .mz_RamBlock_noinit, kept over resets
+#define GPS_TRACE_RECORDS				(256)					///< Ring size in 12 byte records, power of two
+#define GPS_TRACE_BOOT_DUMP				(32)					///< Newest records printed on the CLI at start up, 0 = all
+/* Post-mortem trace - END */
+
+/* Deferred CLI logging - START */
+#define GPS_LOG_ENABLE					(MZ_DISABLE)			///< Queue CLI output, a low priority thread writes it
+#define GPS_LOG_SLOTS					(64)					///< Queued records, power of two
+#define GPS_LOG_LINE_SIZE				(80)					///< Longest record, longer text is cut
+#define GPS_LOG_DRAIN_MS				(20)					///< Drain thread period
+/* Deferred CLI logging - END */
+
+/* Timer wheel - START */
+#define GPS_TWHEEL_ENABLE				(MZ_DISABLE)			///< Application timers on one MonoZ timer (MZ_MAX_TIMER_COUNT)
+#define GPS_TW_TICK_MS					(100)					///< Wheel resolution
+#define GPS_TW_LEVELS					(4)						///< 64 slots per level, 4 levels = 64^4 ticks
+/* Timer wheel - END */
+
+/* Health telemetry - START */
+#define GPS_HEALTH_ENABLE				(MZ_DISABLE)			///< Publish per task CPU / stack and heap usage
+#define GPS_HEALTH_PERIOD_MS			(600000)				///< Health payload period
+#define GPS_HEALTH_MAX_TASKS			(12)					///< Tasks in one sample, more tasks give an empty sample
+#define GPS_HEALTH_PAYLOAD_SIZE			(640)					///< Health payload buffer
+#define GPS_HEALTH_RT_SHIFT				(6)						///< Run time counter = cycles / 2^6, wraps after 57 min at 80 MHz
+/* Health telemetry - END */
+
+/* Low power idle - START */
+#define GPS_LP_ENABLE					(MZ_DISABLE)			///< Tickless idle in STOP2, LPTIM1 keeps the time
+#define GPS_LP_MIN_IDLE_MS				(5)						///< Shorter idle periods only use WFI
+#define GPS_LP_MAX_IDLE_MS				(1900)					///< Longest STOP2 period, 16 bit LPTIM1 at 32768 Hz
+/* Low power idle - END */
+
+/* Stop mode receive - START */
+#define GPS_LPUART_RING_ENABLE			(MZ_DISABLE)			///< LPUART1 bytes to a ring from its interrupt, thread wakes per burst (replay takes precedence)
+#define GPS_LPUART_RING_SIZE			(1024)					///< Receive ring, power of two, one 1 Hz epoch fits
+#define GPS_LPUART_WAIT_MS				(100)					///< Longest wait for a burst, the thread loop period otherwise
+#define GPS_LPUART_DUTY_MS				(10000)					///< Period of the duty cycle line on the CLI, below 53 s
+/* Stop mode receive - END */
+
+/* Receiver power save - START */
+#define GPS_RXPM_ENABLE					(MZ_DISABLE)			///< Receiver out of continuous tracking between reports
+#define GPS_RXPM_CYCLIC					(MZ_DISABLE)			///< CFG-PM2 cyclic tracking, else backup (RXM-PMREQ) until each report
+#define GPS_RXPM_PERIOD_MS				(GPS_REPORT_MAX_SILENCE_MS)	///< Report deadline after each report
+#define GPS_RXPM_CYCLIC_UPDATE_MS		(10000)					///< Fix period in cyclic tracking, divides the report period
+#define GPS_RXPM_LEAD_INIT_MS			(5000)					///< Wake up lead before the first TTFF is measured
+#define GPS_RXPM_LEAD_MIN_MS			(2000)					///< Shortest wake up lead
+#define GPS_RXPM_MIN_OFF_MS				(10000)					///< Shorter backup periods are not worth it
+#define GPS_RXPM_EPH_REFRESH_MS			(1800000)				///< Stay on for an ephemeris refresh this often
+#define GPS_RXPM_EPH_ON_MS				(40000)					///< Continuous tracking that refreshes the ephemeris
+/* Receiver power save - END */
+
+/* Modem power save - START */
+#define GPS_RADIO_ENABLE				(MZ_DISABLE)			///< PSM / eDRX matched to the upload interval, wake the modem per upload
+#define GPS_RADIO_FLUSH_MS				(GPS_REPORT_MAX_SILENCE_MS)	///< Upload interval the timers are matched to
+#define GPS_RADIO_ACTIVE_MS				(20000)					///< T3324, reachable this long after an upload
+#define GPS_RADIO_TAU_FLUSHES			(3)						///< T3412 covers this many upload intervals
+#define GPS_RADIO_PSM_MIN_MS			(60000)					///< Shorter upload intervals use eDRX only
+#define GPS_RADIO_WAKE_PULSE_MS			(100)					///< MODEM_WAKEUP pulse out of PSM
+#define GPS_RADIO_WAKE_TIMEOUT_MS		(10000)					///< Longest wait for the first answer after the pulse
+#define GPS_RADIO_DUMP_MS				(600000)				///< Period of the radio state line on the CLI
+/* Modem power save - END */
+
+/* RTC discipline - START */
+#define GPS_TIME_ENABLE					(MZ_DISABLE)			///< Set and calibrate the RTC from GPS time, timestamp payloads from it
+#define GPS_TIME_SAMPLE_MS				(60000)					///< Interval of the RTC / GPS comparisons
+#define GPS_TIME_CAL_WINDOW_S			(3600)					///< Drift fit window, the calibration is updated at its end
+#define GPS_TIME_STEP_MS				(1000)					///< Error at which the calendar is set again
+#define GPS_TIME_SHIFT_MS				(8)						///< Phase error shifted out of the RTC
+#define GPS_TIME_OUT_DELAY_MS			(0)						///< Receiver delay from the UTC epoch to the first byte of $GPRMC
+/* RTC discipline - END */
+
+/* Receiver aiding - START */
+#define GPS_AID_ENABLE					(MZ_DISABLE)			///< Checkpoint the last fix, AID-INI to the receiver at boot
+#define GPS_AID_FLASH_ENABLE			(MZ_ENABLE)				///< Also keep the checkpoint in flash, survives power loss
+#define GPS_AID_FLASH_ADDR				(0x080F3800UL)			///< Page reserved as GPS_FLASH in STM32L4A6ZGTX_FLASH.ld
+#define GPS_AID_FLASH_MS				(3600000)				///< Shortest interval of the flash writes after the first one
+#define GPS_AID_POS_ACC_CM				(5000)					///< Best position accuracy claimed for a checkpoint
+#define GPS_AID_POS_GROW_CMS			(300)					///< Accuracy lost per second of checkpoint age, the device may move
+#define GPS_AID_POS_ACC_MAX_CM			(30000000UL)			///< Older positions are not sent
+#define GPS_AID_TIME_ACC_MS				(1000)					///< Accuracy claimed for the RTC time
+#define GPS_AID_LEAP_S					(18)					///< GPS minus UTC
+#define GPS_AID_EPH_TRACK_S				(36)					///< Continuous tracking that refreshes the ephemeris
+#define GPS_AID_DELAY_MS				(1000)					///< From boot or receiver reset to AID-INI
+#define GPS_AID_TX_TIMEOUT_MS			(100)					///< UART timeout of one frame
+#define GPS_AID_TTFF_BENCH				(MZ_DISABLE)			///< Restart over and over, aid every other boot, log the TTFF
+#define GPS_AID_BENCH_BBR				(GPS_AID_BBR_COLD)		///< Receiver state of each benchmark start, CFG-RST navBbrMask
+#define GPS_AID_BENCH_HOLD_MS			(60000)					///< Tracking after the first fix before the next restart
+/* Receiver aiding - END */
+
+/* Telemetry backend - START */
+#define GPS_BACKEND_BG96				(0)						///< JSON over MQTT, BG96 AT+QMT*
+#define GPS_BACKEND_LWM2M				(1)						///< LwM2M Object 6 notifications, needs MZ_LWM2M_ENABLE
+#define GPS_BACKEND_SIM7080				(2)						///< JSON over MQTT, SIM7080 AT+SM*
+#define GPS_BACKEND_SINK				(3)						///< Local sink, CLI by default (gps_backend_sink_write)
+#define GPS_BACKEND_UDP					(4)						///< Binary fix frames over UDP, host simulation only
+#define GPS_BACKENDS					(5)						///< Number of backends
+#define GPS_REPORT_BACKEND				(GPS_BACKEND_BG96)		///< Backend after boot, gps_backend_select() changes it
+#define GPS_BACKEND_HOST				"cloud.monoz.io"		///< MQTT broker
+#define GPS_BACKEND_PORT				(1883)					///< MQTT broker port
+#define GPS_BACKEND_CLIENT_ID			"GPSTest"				///< MQTT client identifier
+#define GPS_BACKEND_USER				"GPSTest"				///< MQTT user name
+#define GPS_BACKEND_PASS				"GPSTest"				///< MQTT password
+#define GPS_BACKEND_DUMP_MS				(600000)				///< Period of the backend statistics line on the CLI
+#define GPS_LWM2M_PMIN_S				(0)						///< Minimum notification period until the server writes pmin
+#define GPS_LWM2M_PMAX_S				(0)						///< Maximum notification period until the server writes pmax, 0 = none
+#define GPS_LWM2M_TOKEN_LEN				(8)						///< CoAP token length counted in the byte statistics
+/* Telemetry backend - END */
+
+/* UDP uplink - START */
+/* GPS_BACKEND_UDP takes its ACKs from the +QIURC "recv" URC, which the
+ * MonoZ library does not pass to the application. It is no firmware
+ * option: GPS_UDP_ENABLE is only set by the host build, against the modem
+ * emulator (Host/config/gps_host_config.h). */
+#define GPS_UDP_HOST					"cloud.monoz.io"		///< Fix collector
+#define GPS_UDP_PORT					(5000)					///< Fix collector port
+#define GPS_UDP_DEVICE_ID				(0x00000001UL)			///< Sender id in every frame
+#define GPS_UDP_WINDOW					(4)						///< Frames in flight
+#define GPS_UDP_POINTS_MAX				(16)					///< Points per frame
+#define GPS_UDP_RTO_MS					(4000)					///< First retransmit timeout, doubled per retry
+#define GPS_UDP_TRIES					(4)						///< Sends of a frame before it is dropped
+/* UDP uplink - END */
+
+/* MQTT QoS 1 - START */
+/* The QoS 1 window frees a message on its +QMTPUB URC, which the MonoZ
+ * library does not pass to the application. It is no firmware option:
+ * GPS_MQTT_QOS1_ENABLE is only set by the host build, against the modem
+ * emulator (Host/config/gps_host_config.h). The firmware publishes with
+ * QoS 0. */
+#define GPS_MQTT_QOS1_WINDOW			(4)						///< Messages in flight
+#define GPS_MQTT_QOS1_TOPIC_SIZE		(48)					///< Longest kept topic with quotes
+#define GPS_MQTT_QOS1_PAYLOAD_SIZE		(200)					///< Longest kept payload with Ctrl-Z, longer ones go out with QoS 0
+#define GPS_MQTT_QOS1_RTO_MS			(5000)					///< First retransmit timeout, doubled per retry
+#define GPS_MQTT_QOS1_TRIES				(4)						///< Sends of a message before it is dropped
+/* MQTT QoS 1 - END */
+
+#endif /* MZ_GPS_APP_CONFIG_H_ */
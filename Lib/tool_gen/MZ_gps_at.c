@@ -0,0 +1,471 @@
+/*
+ * MZ_gps_at.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_at.h"
+#include "MZ_gps_trace.h"
+#include "MZ_gps_log.h"
+#include "MZ_gps_lowpower.h"
+#include "MZ_gps_radio.h"
+#include "MZ_gps_backend.h"
+#include "MZ_gps_udp.h"
+#include "MZ_gps_latency.h"
+#include "MZ_Modem_public.h"
+#include "MZ_print.h"
+#include "MZ_sys_cmsis_os2.h"
+#include "main.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define AT_PAYLOAD_END				(26)						///< Ctrl-Z ends a publish payload
+#define AT_TOPIC_SIZE				(64)						///< Largest emulated topic
+#define AT_URC_SIZE					(48)						///< Emulated "recv" URC with an ACK
+#define AT_PUBACKS					(GPS_MQTT_QOS1_WINDOW * 2)	///< Emulated PUBACKs on the way
+#define AT_LOSS_SEED				(1)							///< Loss draws restart here on gps_at_emu_loss()
+/* Define some common use MACRO - END */
+
+/* AT path related variables - START */
+static st_gps_at_stats at_stats = {0};							/* Command counters */
+static uint8_t at_publish_prompt = 0;							/* Next command is a payload */
+#if(GPS_MODEM_EMU_ENABLE == MZ_ENABLE)
+static uint8_t at_emu_connected = 0;							/* Emulated MQTT / TCP session is up */
+static char at_emu_topic[AT_TOPIC_SIZE] = "";					/* Topic of the pending publish */
+static uint8_t at_emu_psm = 0;									/* PSM requested with AT+CPSMS */
+static uint32_t at_emu_active_ms = 0;							/* Requested T3324 */
+static uint32_t at_emu_idle_tick = 0;							/* End of the last command */
+static uint8_t at_emu_asleep = 0;								/* Emulated modem is in PSM */
+static uint8_t at_emu_waking = 0;								/* Wake up pulse seen */
+static uint32_t at_emu_wake_tick = 0;							/* Time of the wake up pulse */
+#if((GPS_UDP_ENABLE == MZ_ENABLE) || (GPS_MQTT_QOS1_ENABLE == MZ_ENABLE))
+static uint32_t at_emu_loss_seed = AT_LOSS_SEED;				/* Pseudo random loss draws */
+static uint16_t at_emu_loss_every = GPS_MODEM_EMU_LOSS_EVERY;	/* One packet in N is lost, 0 = none */
+#endif
+#if(GPS_MQTT_QOS1_ENABLE == MZ_ENABLE)
+static uint16_t at_emu_pub_id = 0;								/* Packet id of the pending publish, 0 for QoS 0 */
+static uint16_t at_emu_puback_id[AT_PUBACKS];					/* PUBACKs on the way */
+static uint32_t at_emu_puback_tick[AT_PUBACKS];					/* Tick each PUBACK arrives */
+static uint8_t at_emu_pubacks = 0;								/* Number of PUBACKs on the way */
+#endif
+#endif
+/* AT path related variables - END */
+
+/** @fn static uint8_t at_is(const char * cmd, const char * prefix)
+ * @brief Command starts with prefix
+ */
+static uint8_t at_is(const char * cmd, const char * prefix)
+{
+	return (0 == strncmp(cmd, prefix, strlen(prefix)));
+}
+
+#if(GPS_MODEM_EMU_ENABLE == MZ_ENABLE)
+/** @fn static void at_emu_topic_from(const char * cmd)
+ * @brief Keep the first quoted argument of a publish command as topic
+ */
+static void at_emu_topic_from(const char * cmd)
+{
+	const char * start = strchr(cmd, '"');
+	const char * end = (start != NULL) ? strchr(start + 1, '"') : NULL;
+	size_t len;
+
+	at_emu_topic[0] = '\0';
+	if(end != NULL)
+	{
+		len = (size_t)(end - start - 1);
+		if(len >= AT_TOPIC_SIZE)
+		{
+			len = AT_TOPIC_SIZE - 1;
+		}
+		memcpy(at_emu_topic, start + 1, len);
+		at_emu_topic[len] = '\0';
+	}
+}
+
+/** @fn static void at_emu_psm_from(const char * cmd)
+ * @brief Keep the PSM request of AT+CPSMS, T3324 is the last quoted field
+ */
+static void at_emu_psm_from(const char * cmd)
+{
+	const char * end = strrchr(cmd, '"');
+	uint32_t sec;
+
+	at_emu_psm = 0;
+	if((cmd[9] == '1') && (end != NULL) && ((end - cmd) >= 18))
+	{
+		sec = gps_radio_t3_decode(end - 8, 0);
+		if(sec != 0xFFFFFFFFUL)
+		{
+			at_emu_psm = 1;
+			at_emu_active_ms = sec * 1000;
+		}
+	}
+}
+
+/** @fn static void at_emu_drop(void)
+ * @brief The emulated session is gone, with the PUBACKs on the way
+ */
+static void at_emu_drop(void)
+{
+	at_emu_connected = 0;
+#if(GPS_MQTT_QOS1_ENABLE == MZ_ENABLE)
+	at_emu_pubacks = 0;
+#endif
+}
+
+#if((GPS_UDP_ENABLE == MZ_ENABLE) || (GPS_MQTT_QOS1_ENABLE == MZ_ENABLE))
+/** @fn static uint8_t at_emu_lost(void)
+ * @brief The next datagram or QoS 1 packet is lost. A draw per packet: a
+ * count shared by both directions locks onto the exchange pattern and
+ * loses only one direction or only retries.
+ */
+static uint8_t at_emu_lost(void)
+{
+	at_emu_loss_seed = (at_emu_loss_seed * 1103515245U) + 12345U;
+	return (at_emu_loss_every != 0) && (((at_emu_loss_seed >> 8) % at_emu_loss_every) == 0);
+}
+#endif
+
+#if(GPS_MQTT_QOS1_ENABLE == MZ_ENABLE)
+/** @fn static void at_emu_pub_from(const char * cmd)
+ * @brief Packet id of AT+QMTPUB=0,<msgid>,<qos>,..., 0 for QoS 0
+ */
+static void at_emu_pub_from(const char * cmd)
+{
+	static const char pub[] = "AT+QMTPUB=0,";
+	char * p;
+	uint16_t id;
+
+	at_emu_pub_id = 0;
+	if(!at_is(cmd, pub))
+	{
+		return;
+	}
+	id = (uint16_t)strtoul(&cmd[sizeof(pub) - 1], &p, 10);
+	if((p[0] == ',') && (p[1] == '1'))
+	{
+		at_emu_pub_id = id;
+	}
+}
+
+/** @fn static void at_emu_puback(void)
+ * @brief The broker got a QoS 1 PUBLISH, its PUBACK arrives
+ * GPS_MODEM_EMU_PUBACK_MS later unless lost
+ */
+static void at_emu_puback(void)
+{
+	if(at_emu_lost() || (at_emu_pubacks >= AT_PUBACKS))
+	{
+		return;
+	}
+	at_emu_puback_id[at_emu_pubacks] = at_emu_pub_id;
+	at_emu_puback_tick[at_emu_pubacks] = HAL_GetTick() + GPS_MODEM_EMU_PUBACK_MS;
+	at_emu_pubacks++;
+}
+#endif
+
+#if(GPS_UDP_ENABLE == MZ_ENABLE)
+
+/** @fn static void at_emu_datagram(const char * cmd)
+ * @brief AT+QISENDEX to the server stand-in, its ACK comes back as the
+ * "recv" URC, data on the same line
+ */
+static void at_emu_datagram(const char * cmd)
+{
+	const char * hex = strchr(cmd, '"');
+	uint8_t frame[GPS_UDP_FRAME_SIZE];
+	uint8_t ack[GPS_UDP_ACK_SIZE];
+	char urc[AT_URC_SIZE];
+	uint16_t len;
+	int n;
+
+	if((hex == NULL) || at_emu_lost())
+	{
+		return;
+	}
+	len = gps_udp_unhex(hex + 1, frame, sizeof(frame));
+	len = gps_udp_serve(frame, len, ack, sizeof(ack));
+	if((len == 0) || at_emu_lost())
+	{
+		return;
+	}
+	n = sprintf(urc, "+QIURC: \"recv\",0,%u,\"", len);
+	n += gps_udp_hex(ack, len, &urc[n]);
+	sprintf(&urc[n], "\"");
+	gps_at_emu_urc(urc);
+}
+#endif
+
+/** @fn static mz_error_t at_emu_answer(char * cmd)
+ * @brief Emulated BG96 / SIM7080 answer to one command
+ */
+static mz_error_t at_emu_answer(char * cmd)
+{
+	/* Injected faults, counted over all commands */
+	if((GPS_MODEM_EMU_URC_EVERY != 0) && ((at_stats.cmds % GPS_MODEM_EMU_URC_EVERY) == 0) && at_emu_connected)
+	{
+		at_emu_drop();
+		gps_at_emu_urc(at_is(cmd, "AT+SM") ? "+SMSTATE: 0" : "+QMTSTAT: 0,1");
+	}
+	if((GPS_MODEM_EMU_FAIL_EVERY != 0) && ((at_stats.cmds % GPS_MODEM_EMU_FAIL_EVERY) == 0))
+	{
+		osDelay(GPS_MODEM_EMU_LATENCY_MS);
+		at_publish_prompt = 0;
+		return MZ_FAIL;
+	}
+
+	if(at_publish_prompt)
+	{
+		char * end = strchr(cmd, AT_PAYLOAD_END);
+		char saved = 0;
+
+		at_publish_prompt = 0;
+		osDelay(GPS_MODEM_EMU_PUB_LATENCY_MS);
+		if(!at_emu_connected)
+		{
+			return MZ_FAIL;
+		}
+#if(GPS_MQTT_QOS1_ENABLE == MZ_ENABLE)
+		/* A QoS 1 PUBLISH may not reach the broker */
+		if((at_emu_pub_id != 0) && at_emu_lost())
+		{
+			return MZ_OK;
+		}
+#endif
+		if(end != NULL)
+		{
+			saved = *end;
+			*end = '\0';
+		}
+		gps_at_emu_broker(at_emu_topic, cmd);
+		if(end != NULL)
+		{
+			*end = saved;
+		}
+#if(GPS_MQTT_QOS1_ENABLE == MZ_ENABLE)
+		if(at_emu_pub_id != 0)
+		{
+			at_emu_puback();
+		}
+#endif
+		return MZ_OK;
+	}
+
+	osDelay(GPS_MODEM_EMU_LATENCY_MS);
+	if(at_is(cmd, "AT+QMTDISC") || at_is(cmd, "AT+SMDISC"))
+	{
+		at_emu_drop();
+	}
+	else if(at_is(cmd, "AT+QMTCONN") || at_is(cmd, "AT+SMCONN"))
+	{
+		at_emu_connected = 1;
+	}
+	else if(at_is(cmd, "AT+QMTPUB") || at_is(cmd, "AT+SMPUB"))
+	{
+		at_emu_topic_from(cmd);
+#if(GPS_MQTT_QOS1_ENABLE == MZ_ENABLE)
+		at_emu_pub_from(cmd);
+#endif
+	}
+	else if(at_is(cmd, "AT+CPSMS="))
+	{
+		at_emu_psm_from(cmd);
+	}
+#if(GPS_UDP_ENABLE == MZ_ENABLE)
+	else if(at_is(cmd, "AT+QISENDEX="))
+	{
+		at_emu_datagram(cmd);
+	}
+#endif
+	return MZ_OK;
+}
+
+/** @fn static void at_emu_psm_check(void)
+ * @brief Enter PSM after T3324 without commands, the session is dropped
+ */
+static void at_emu_psm_check(void)
+{
+	if(at_emu_psm && !at_emu_asleep && ((HAL_GetTick() - at_emu_idle_tick) >= at_emu_active_ms))
+	{
+		at_emu_asleep = 1;
+		at_emu_drop();
+	}
+}
+
+/** @fn static mz_error_t at_emu_cmd(char * cmd)
+ * @brief Emulated modem with PSM : asleep it does not answer until
+ * GPS_MODEM_EMU_PSM_WAKE_MS after a wake up pulse
+ */
+static mz_error_t at_emu_cmd(char * cmd)
+{
+	mz_error_t status;
+
+	/* URCs that came while the application did something else */
+	gps_at_emu_poll();
+	at_emu_psm_check();
+	if(at_emu_asleep)
+	{
+		if(!at_emu_waking || ((HAL_GetTick() - at_emu_wake_tick) < GPS_MODEM_EMU_PSM_WAKE_MS))
+		{
+			/* No answer, the command times out */
+			osDelay(GPS_MODEM_EMU_LATENCY_MS);
+			at_publish_prompt = 0;
+			return MZ_FAIL;
+		}
+		at_emu_asleep = 0;
+		at_emu_waking = 0;
+	}
+
+	status = at_emu_answer(cmd);
+	at_emu_idle_tick = HAL_GetTick();
+	return status;
+}
+
+/*
+ * Emulated wake up pulse. - START
+ */
+void gps_at_emu_wake(void)
+{
+	at_emu_psm_check();
+	if(at_emu_asleep && !at_emu_waking)
+	{
+		at_emu_waking = 1;
+		at_emu_wake_tick = HAL_GetTick();
+	}
+}
+/* Emulated wake up pulse. - END */
+
+#if((GPS_UDP_ENABLE == MZ_ENABLE) || (GPS_MQTT_QOS1_ENABLE == MZ_ENABLE))
+/*
+ * Emulated packet loss. - START
+ */
+void gps_at_emu_loss(uint16_t every)
+{
+	at_emu_loss_every = every;
+	at_emu_loss_seed = AT_LOSS_SEED;
+}
+/* Emulated packet loss. - END */
+#endif
+
+/*
+ * URCs that are due. - START
+ */
+void gps_at_emu_poll(void)
+{
+#if(GPS_MQTT_QOS1_ENABLE == MZ_ENABLE)
+	char urc[AT_URC_SIZE];
+	uint8_t i = 0;
+
+	while(i < at_emu_pubacks)
+	{
+		if((int32_t)(HAL_GetTick() - at_emu_puback_tick[i]) < 0)
+		{
+			i++;
+			continue;
+		}
+		sprintf(urc, "+QMTPUB: 0,%u,0", at_emu_puback_id[i]);
+		at_emu_pubacks--;
+		at_emu_puback_id[i] = at_emu_puback_id[at_emu_pubacks];
+		at_emu_puback_tick[i] = at_emu_puback_tick[at_emu_pubacks];
+		gps_at_emu_urc(urc);
+	}
+#endif
+}
+/* URCs that are due. - END */
+
+/*
+ * Broker stand-in. - START
+ * NOTE : This function can be modified, the gps_at_emu_broker can be
+ *        implemented in the user file also.
+ */
+__attribute__((weak)) void gps_at_emu_broker(const char * topic, const char * payload)
+{
+	(void)topic;
+	(void)payload;
+}
+/* Broker stand-in. - END */
+
+/*
+ * Injected URC. - START
+ * NOTE : This function can be modified, the gps_at_emu_urc can be
+ *        implemented in the user file also.
+ */
+__attribute__((weak)) void gps_at_emu_urc(const char * urc)
+{
+	GPS_LOG_OUT(urc);
+	GPS_LOG_OUT("\r\n");
+	gps_backend_urc(urc);
+}
+/* Injected URC. - END */
+#endif //(GPS_MODEM_EMU_ENABLE == MZ_ENABLE)
+
+/*
+ * Send one AT command. - START
+ */
+mz_error_t gps_at_cmd(char * cmd, int32_t to, int32_t twn)
+{
+	uint32_t start = HAL_GetTick();
+	uint8_t payload = at_publish_prompt;
+	mz_error_t status;
+
+	at_stats.cmds++;
+#if(GPS_LATENCY_ENABLE == MZ_ENABLE)
+	/* The report leaves the application with its publish command */
+	if(at_is(cmd, "AT+QMTPUB") || at_is(cmd, "AT+SMPUB") || at_is(cmd, "AT+QISENDEX"))
+	{
+		gps_latency_mark(GPS_LAT_SUBMIT, start);
+	}
+#endif
+
+	/* The modem UART1 can not wake the MCU from STOP2 */
+	GPS_LP_STOP_LOCK();
+#if(GPS_MODEM_EMU_ENABLE == MZ_ENABLE)
+	(void)to;
+	(void)twn;
+	status = at_emu_cmd(cmd);
+#else
+	at_publish_prompt = 0;
+	status = MZ_init_cmd_direct(cmd, to, twn);
+#endif
+	GPS_LP_STOP_UNLOCK();
+
+	/* The command after a publish command carries the payload */
+	if(at_is(cmd, "AT+QMTPUB") || at_is(cmd, "AT+SMPUB"))
+	{
+		at_publish_prompt = (MZ_OK == status);
+	}
+	if(payload && (MZ_OK == status))
+	{
+		at_stats.publishes++;
+		at_stats.publish_bytes += strlen(cmd);
+	}
+
+	at_stats.last_ms = HAL_GetTick() - start;
+	at_stats.total_ms += at_stats.last_ms;
+	if(at_stats.last_ms > at_stats.max_ms)
+	{
+		at_stats.max_ms = at_stats.last_ms;
+	}
+	if(MZ_OK != status)
+	{
+		at_stats.fails++;
+		GPS_TRACE(GPS_TRACE_AT_FAIL, status);
+	}
+	return status;
+}
+/* Send one AT command. - END */
+
+/*
+ * Copy the AT command path counters. - START
+ */
+void gps_at_get_stats(st_gps_at_stats * stats)
+{
+	*stats = at_stats;
+}
+/* Copy the AT command path counters. - END */
@@ -0,0 +1,103 @@
+/*
+ * MZ_gps_at.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  AT command path of the GPS application.
+ *
+ *  Every command of the publish path goes through gps_at_cmd(), which
+ *  measures the command latency and keeps per command statistics. With
+ *  GPS_MODEM_EMU_ENABLE the modem is emulated instead : QMT* (BG96) and
+ *  SM* / CNACT (SIM7080) commands are answered after a configurable
+ *  latency, failures and a connection lost URC can be injected every Nth
+ *  command, and published payloads are handed to a broker stand-in. With
+ *  GPS_UDP_ENABLE (host builds), AT+QISENDEX datagrams go to the UDP
+ *  server stand-in (gps_udp_serve), its ACK comes back as a "recv" URC,
+ *  one datagram in GPS_MODEM_EMU_LOSS_EVERY either way is lost, drawn at
+ *  random from a fixed seed. With GPS_MQTT_QOS1_ENABLE (host builds) a
+ *  QoS 1 AT+QMTPUB gets its +QMTPUB PUBACK URC GPS_MODEM_EMU_PUBACK_MS
+ *  later from gps_at_emu_poll(), the same loss applies to the PUBLISH and
+ *  to the PUBACK. The emulated modem follows AT+CPSMS : it enters PSM
+ *  after the requested active time and answers GPS_MODEM_EMU_PSM_WAKE_MS
+ *  after a wake up pulse (gps_at_emu_wake). The whole publish path can then be measured
+ *  on a board without a modem or network, with repeatable timing. The
+ *  latency is an osDelay(), the lower priority tasks run meanwhile. On a
+ *  PC, Host/tools/gps_modem_pty serves the same emulator on a pty.
+ */
+
+#ifndef MZ_GPS_AT_H_
+#define MZ_GPS_AT_H_
+
+#include "stdint.h"
+#include "MZ_error_handler.h"
+#include "MZ_gps_app_config.h"
+
+/**
+ * @struct st_gps_at_stats
+ * @brief AT command path counters
+ */
+typedef struct
+{
+	uint32_t		cmds;										/*!< Commands sent */
+	uint32_t		fails;										/*!< Commands that did not return MZ_OK */
+	uint32_t		publishes;									/*!< Payloads sent after a publish command */
+	uint32_t		publish_bytes;								/*!< Payload bytes */
+	uint32_t		last_ms;									/*!< Latency of the last command */
+	uint32_t		max_ms;										/*!< Worst command latency */
+	uint32_t		total_ms;									/*!< Sum of command latencies */
+}st_gps_at_stats;
+
+/** @fn mz_error_t gps_at_cmd(char * cmd, int32_t to, int32_t twn)
+ * @brief Send one AT command (or a payload after a publish prompt).
+ * Same arguments as MZ_init_cmd_direct.
+ * @param cmd command with line end, or payload ended by Ctrl-Z
+ * @param to response timeout
+ * @param twn wait time
+ * @return MZ_OK/MZ_FAIL
+ */
+mz_error_t gps_at_cmd(char * cmd, int32_t to, int32_t twn);
+
+/** @fn void gps_at_get_stats(st_gps_at_stats * stats)
+ * @brief Copy the AT command path counters.
+ * @param stats output
+ */
+void gps_at_get_stats(st_gps_at_stats * stats);
+
+#if(GPS_MODEM_EMU_ENABLE == MZ_ENABLE)
+/** @fn void gps_at_emu_broker(const char * topic, const char * payload)
+ * @brief Broker stand-in, called for every emulated publish. Weak, the
+ * default does nothing.
+ * @param topic publish topic
+ * @param payload payload without Ctrl-Z
+ */
+void gps_at_emu_broker(const char * topic, const char * payload);
+
+/** @fn void gps_at_emu_urc(const char * urc)
+ * @brief Called for every injected URC. Weak, the default prints it and
+ * hands it to the telemetry backend (gps_backend_urc).
+ * @param urc URC line without line end
+ */
+void gps_at_emu_urc(const char * urc);
+
+/** @fn void gps_at_emu_wake(void)
+ * @brief Wake up pulse to the emulated modem, stands in for MODEM_WAKEUP.
+ */
+void gps_at_emu_wake(void);
+
+#if((GPS_UDP_ENABLE == MZ_ENABLE) || (GPS_MQTT_QOS1_ENABLE == MZ_ENABLE))
+/** @fn void gps_at_emu_loss(uint16_t every)
+ * @brief Change the emulated loss, GPS_MODEM_EMU_LOSS_EVERY at boot. The
+ * draws restart from their seed, runs are repeatable.
+ * @param every one datagram or QoS 1 packet in every is lost, 0 = none
+ */
+void gps_at_emu_loss(uint16_t every);
+#endif
+
+/** @fn void gps_at_emu_poll(void)
+ * @brief Emit the emulated URCs that are due, e.g. QoS 1 PUBACKs. Called
+ * from the thread loop and before every emulated command.
+ */
+void gps_at_emu_poll(void);
+#endif //(GPS_MODEM_EMU_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_AT_H_ */
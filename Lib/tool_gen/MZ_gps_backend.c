@@ -0,0 +1,634 @@
+/*
+ * MZ_gps_backend.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_backend.h"
+#include "MZ_gps_at.h"
+#include "MZ_gps_log.h"
+#include "MZ_gps_latency.h"
+#include "MZ_gps_lwm2m.h"
+#include "MZ_gps_qos.h"
+#include "MZ_gps_udp.h"
+#include "MZ_print.h"
+#include "MZ_timer.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#if((GPS_UDP_ENABLE == MZ_ENABLE) || (GPS_MQTT_QOS1_ENABLE == MZ_ENABLE) || (GPS_LATENCY_ENABLE == MZ_ENABLE))
+#include "main.h"
+#endif
+
+/* Include Header Files - END */
+
+#if((GPS_REPORT_BACKEND == GPS_BACKEND_LWM2M) && (MZ_LWM2M_ENABLE != MZ_ENABLE))
+#error "GPS_BACKEND_LWM2M needs MZ_LWM2M_ENABLE in MZ_BoardCfg.h"
+#endif
+#if((GPS_REPORT_BACKEND == GPS_BACKEND_UDP) && (GPS_UDP_ENABLE != MZ_ENABLE))
+#error "GPS_BACKEND_UDP is only built by the host simulation"
+#endif
+
+/* Define some common use MACRO - START */
+#define BACKEND_PAYLOAD_END			(26)						///< Ctrl-Z ends a payload
+#define BACKEND_CMD_SIZE			(96)						///< Longest AT command
+/* Define some common use MACRO - END */
+
+/* Backend related variables - START */
+static uint8_t backend_id = GPS_REPORT_BACKEND;					/* Selected backend */
+static st_gps_backend_stats backend_stats[GPS_BACKENDS];		/* Counters per backend */
+static char backend_cmd[BACKEND_CMD_SIZE];						/* AT command being sent */
+/* Backend related variables - END */
+
+/** @fn static mz_error_t backend_at(char * cmd, int32_t to, int32_t twn)
+ * @brief One AT command of the selected backend, counted
+ */
+static mz_error_t backend_at(char * cmd, int32_t to, int32_t twn)
+{
+	backend_stats[backend_id].at_cmds++;
+	backend_stats[backend_id].at_bytes += strlen(cmd);
+	return gps_at_cmd(cmd, to, twn);
+}
+
+/** @fn static char * backend_payload_end(char * payload)
+ * @brief Ctrl-Z at the end of a payload, NULL when there is none
+ */
+static char * backend_payload_end(char * payload)
+{
+	size_t len = strlen(payload);
+
+	return ((len != 0) && (payload[len - 1] == BACKEND_PAYLOAD_END)) ? &payload[len - 1] : NULL;
+}
+
+/** @fn static mz_error_t backend_flush_none(uint32_t now_ms)
+ * @brief Nothing is held back
+ */
+static mz_error_t backend_flush_none(uint32_t now_ms)
+{
+	(void)now_ms;
+	return MZ_OK;
+}
+
+/** @fn static uint8_t backend_poll_none(uint32_t now_ms)
+ * @brief Nothing is sent outside an upload
+ */
+static uint8_t backend_poll_none(uint32_t now_ms)
+{
+	(void)now_ms;
+	return 0;
+}
+
+/*
+ * BG96, MQTT with AT+QMT*. - START
+ */
+#if(GPS_MQTT_QOS1_ENABLE == MZ_ENABLE)
+static st_gps_qos bg96_qos;										/* QoS 1 messages in flight */
+static uint8_t bg96_session = 0;								/* Session kept for the PUBACKs */
+
+/** @fn static void bg96_session_lost(void)
+ * @brief Connect again before the next publish, the messages in flight go
+ * out again on the new session
+ */
+static void bg96_session_lost(void)
+{
+	bg96_session = 0;
+	gps_qos_session_lost(&bg96_qos);
+}
+#endif
+
+/** @fn static mz_error_t bg96_publish_qos0(const st_gps_backend_msg * msg)
+ * @brief One message with QoS 0
+ */
+static mz_error_t bg96_publish_qos0(const st_gps_backend_msg * msg)
+{
+	mz_error_t status;
+
+	/* The payload follows the prompt, ended by its Ctrl-Z */
+	snprintf(backend_cmd, sizeof(backend_cmd), "AT+QMTPUB=0,0,0,0,%s\r\n", msg->topic);
+	status = backend_at(backend_cmd, AT_TIME_15SEC, 0);
+	status |= backend_at(msg->payload, AT_TIME_15SEC, AT_TIME_15SEC);
+	return status;
+}
+
+static mz_error_t bg96_connect(void)
+{
+	mz_error_t status;
+
+#if(GPS_MQTT_QOS1_ENABLE == MZ_ENABLE)
+	/* The PUBACKs of the messages in flight come on the open session */
+	if(bg96_session)
+	{
+		return MZ_OK;
+	}
+#endif
+	/* A session left open by a failed upload is closed first */
+	sprintf(backend_cmd, "AT+QMTDISC=0\r\n");
+	status = backend_at(backend_cmd, AT_TIME_15SEC, AT_TIME_15SEC);
+#if(GPS_MQTT_QOS1_ENABLE == MZ_ENABLE)
+	/* The window retransmits, the modem only reports a missing PUBACK */
+	sprintf(backend_cmd, "AT+QMTCFG=\"timeout\",0,%u,0,0\r\n", (unsigned int)(GPS_MQTT_QOS1_RTO_MS / 1000));
+	status |= backend_at(backend_cmd, AT_TIME_1SEC, AT_TIME_1SEC);
+#endif
+	sprintf(backend_cmd, "AT+QMTOPEN=0,\"%s\",%u\r\n", GPS_BACKEND_HOST, GPS_BACKEND_PORT);
+	status |= backend_at(backend_cmd, AT_TIME_15SEC, AT_TIME_15SEC);
+	sprintf(backend_cmd, "AT+QMTCONN=0,\"%s\",\"%s\",\"%s\"\r\n", GPS_BACKEND_CLIENT_ID, GPS_BACKEND_USER, GPS_BACKEND_PASS);
+	status |= backend_at(backend_cmd, AT_TIME_15SEC, AT_TIME_15SEC);
+#if(GPS_MQTT_QOS1_ENABLE == MZ_ENABLE)
+	bg96_session = (MZ_OK == status);
+#endif
+	return status;
+}
+
+static mz_error_t bg96_publish_batch(const st_gps_backend_msg * msgs, uint16_t n)
+{
+	mz_error_t status = MZ_OK;
+
+	for(uint16_t i = 0; i < n; i++)
+	{
+#if(GPS_MQTT_QOS1_ENABLE == MZ_ENABLE)
+		/* Into the window, flush() sends it */
+		if(gps_qos_fits(msgs[i].topic, msgs[i].payload))
+		{
+			if(!gps_qos_queue(&bg96_qos, msgs[i].topic, msgs[i].payload))
+			{
+				status = MZ_FAIL;
+			}
+			continue;
+		}
+#endif
+		status |= bg96_publish_qos0(&msgs[i]);
+	}
+	return status;
+}
+
+#if(GPS_MQTT_QOS1_ENABLE == MZ_ENABLE)
+static mz_error_t bg96_flush(uint32_t now_ms)
+{
+	st_gps_qos_slot * s;
+	mz_error_t status;
+
+	if(!gps_qos_due(&bg96_qos, now_ms))
+	{
+		return MZ_OK;
+	}
+	status = bg96_connect();
+	while((MZ_OK == status) && (NULL != (s = gps_qos_next(&bg96_qos, now_ms))))
+	{
+		snprintf(backend_cmd, sizeof(backend_cmd), "AT+QMTPUB=0,%u,1,0,%s\r\n", s->id, s->topic);
+		status = backend_at(backend_cmd, AT_TIME_15SEC, 0);
+		if(MZ_OK == status)
+		{
+			/* Only the modem's OK is waited for, the PUBACK comes as URC */
+			status = backend_at(s->payload, AT_TIME_15SEC, 0);
+		}
+		if(MZ_OK != status)
+		{
+			gps_qos_unsent(&bg96_qos, s);
+		}
+	}
+	if(MZ_OK != status)
+	{
+		bg96_session_lost();
+	}
+	return status;
+}
+
+static uint8_t bg96_poll(uint32_t now_ms)
+{
+	return gps_qos_due(&bg96_qos, now_ms);
+}
+
+static void bg96_urc(const char * line)
+{
+	static const char pub[] = "+QMTPUB: 0,";
+	static const char stat[] = "+QMTSTAT: 0,";
+	char * p;
+
+	if(0 == strncmp(line, pub, sizeof(pub) - 1))
+	{
+		/* +QMTPUB: 0,<msgid>,<result>[,<value>] */
+		uint16_t id = (uint16_t)strtoul(&line[sizeof(pub) - 1], &p, 10);
+
+		if(*p == ',')
+		{
+			gps_qos_result(&bg96_qos, id, (uint8_t)strtoul(p + 1, NULL, 10), HAL_GetTick());
+		}
+	}
+	else if(0 == strncmp(line, stat, sizeof(stat) - 1))
+	{
+		bg96_session_lost();
+	}
+}
+#endif
+
+static const st_gps_backend backend_bg96 =
+{
+#if(GPS_MQTT_QOS1_ENABLE == MZ_ENABLE)
+	"bg96", bg96_connect, bg96_publish_batch, bg96_flush, bg96_poll, bg96_urc
+#else
+	"bg96", bg96_connect, bg96_publish_batch, backend_flush_none, backend_poll_none, NULL
+#endif
+};
+
+#if(GPS_MQTT_QOS1_ENABLE == MZ_ENABLE)
+/*
+ * Copy the QoS 1 counters. - START
+ */
+void gps_backend_qos_stats(st_gps_qos_stats * stats, uint8_t * in_flight)
+{
+	*stats = bg96_qos.stats;
+	*in_flight = gps_qos_in_flight(&bg96_qos);
+}
+/* Copy the QoS 1 counters. - END */
+#endif
+/* BG96, MQTT with AT+QMT*. - END */
+
+/*
+ * SIM7080, MQTT with AT+SM*. - START
+ */
+static mz_error_t sim7080_connect(void)
+{
+	mz_error_t status;
+
+	sprintf(backend_cmd, "AT+SMDISC\r\n");
+	status = backend_at(backend_cmd, AT_TIME_15SEC, AT_TIME_15SEC);
+	sprintf(backend_cmd, "AT+SMCONF=\"URL\",\"%s\",%u\r\n", GPS_BACKEND_HOST, GPS_BACKEND_PORT);
+	status |= backend_at(backend_cmd, AT_TIME_1SEC, AT_TIME_1SEC);
+	sprintf(backend_cmd, "AT+SMCONF=\"CLIENTID\",\"%s\"\r\n", GPS_BACKEND_CLIENT_ID);
+	status |= backend_at(backend_cmd, AT_TIME_1SEC, AT_TIME_1SEC);
+	sprintf(backend_cmd, "AT+SMCONF=\"USERNAME\",\"%s\"\r\n", GPS_BACKEND_USER);
+	status |= backend_at(backend_cmd, AT_TIME_1SEC, AT_TIME_1SEC);
+	sprintf(backend_cmd, "AT+SMCONF=\"PASSWORD\",\"%s\"\r\n", GPS_BACKEND_PASS);
+	status |= backend_at(backend_cmd, AT_TIME_1SEC, AT_TIME_1SEC);
+	sprintf(backend_cmd, "AT+SMCONN\r\n");
+	status |= backend_at(backend_cmd, AT_TIME_15SEC, AT_TIME_15SEC);
+	return status;
+}
+
+static mz_error_t sim7080_publish_batch(const st_gps_backend_msg * msgs, uint16_t n)
+{
+	mz_error_t status = MZ_OK;
+
+	for(uint16_t i = 0; i < n; i++)
+	{
+		/* SMPUB takes a length instead of the Ctrl-Z */
+		char * end = backend_payload_end(msgs[i].payload);
+
+		if(end != NULL)
+		{
+			*end = '\0';
+		}
+		snprintf(backend_cmd, sizeof(backend_cmd), "AT+SMPUB=%s,%u,0,0\r\n", msgs[i].topic, (unsigned)strlen(msgs[i].payload));
+		status |= backend_at(backend_cmd, AT_TIME_15SEC, 0);
+		status |= backend_at(msgs[i].payload, AT_TIME_15SEC, AT_TIME_15SEC);
+		if(end != NULL)
+		{
+			*end = BACKEND_PAYLOAD_END;
+		}
+	}
+	return status;
+}
+
+static const st_gps_backend backend_sim7080 =
+{
+	"sim7080", sim7080_connect, sim7080_publish_batch, backend_flush_none, backend_poll_none, NULL
+};
+/* SIM7080, MQTT with AT+SM*. - END */
+
+#if(MZ_LWM2M_ENABLE == MZ_ENABLE)
+/*
+ * LwM2M, Object 6 notifications. - START
+ */
+static mz_error_t lwm2m_connect(void)
+{
+	/* Registration is kept by the MonoZ client */
+	return MZ_OK;
+}
+
+static mz_error_t lwm2m_publish_batch(const st_gps_backend_msg * msgs, uint16_t n)
+{
+	const st_gps_fix * fix = NULL;
+
+	/* Only the newest location is reported */
+	for(uint16_t i = 0; i < n; i++)
+	{
+		if(msgs[i].n_fixes != 0)
+		{
+			fix = &msgs[i].fixes[msgs[i].n_fixes - 1];
+		}
+	}
+	if(fix != NULL)
+	{
+		gps_lwm2m_set(fix);
+	}
+	return MZ_OK;
+}
+
+static mz_error_t lwm2m_flush(uint32_t now_ms)
+{
+	return gps_lwm2m_pending(now_ms) ? gps_lwm2m_notify(now_ms) : MZ_OK;
+}
+
+static const st_gps_backend backend_lwm2m =
+{
+	"lwm2m", lwm2m_connect, lwm2m_publish_batch, lwm2m_flush, gps_lwm2m_pending, NULL
+};
+/* LwM2M, Object 6 notifications. - END */
+#endif //(MZ_LWM2M_ENABLE == MZ_ENABLE)
+
+#if(GPS_UDP_ENABLE == MZ_ENABLE)
+/*
+ * UDP, binary fix frames. - START
+ */
+#define UDP_CMD_SIZE				((GPS_UDP_FRAME_SIZE * 2) + 32)	///< AT+QISENDEX with the hex frame
+
+static st_gps_udp udp;											/* Frames in flight */
+static uint8_t udp_open = 0;									/* Socket opened */
+static uint16_t udp_rx_len = 0;									/* "recv" URC seen, data line follows */
+static char udp_cmd[UDP_CMD_SIZE];								/* AT+QISENDEX being sent */
+
+static mz_error_t udp_connect(void)
+{
+	mz_error_t status;
+
+	/* The zeroed window is empty, only the id is missing */
+	udp.dev_id = GPS_UDP_DEVICE_ID;
+
+	/* No handshake on the air, the socket stays until a send fails */
+	if(udp_open)
+	{
+		return MZ_OK;
+	}
+	sprintf(backend_cmd, "AT+QICLOSE=0\r\n");
+	status = backend_at(backend_cmd, AT_TIME_1SEC, AT_TIME_1SEC);
+	sprintf(backend_cmd, "AT+QICFG=\"dataformat\",1,1\r\n");
+	status |= backend_at(backend_cmd, AT_TIME_1SEC, AT_TIME_1SEC);
+	sprintf(backend_cmd, "AT+QIOPEN=1,0,\"UDP\",\"%s\",%u,0,1\r\n", GPS_UDP_HOST, GPS_UDP_PORT);
+	status |= backend_at(backend_cmd, AT_TIME_15SEC, AT_TIME_15SEC);
+	udp_open = (MZ_OK == status);
+	return status;
+}
+
+static mz_error_t udp_publish_batch(const st_gps_backend_msg * msgs, uint16_t n)
+{
+	for(uint16_t i = 0; i < n; i++)
+	{
+		if(msgs[i].n_fixes != 0)
+		{
+			gps_udp_queue(&udp, msgs[i].fixes, msgs[i].n_fixes);
+		}
+	}
+	return MZ_OK;
+}
+
+static mz_error_t udp_flush(uint32_t now_ms)
+{
+	const uint8_t * frame;
+	uint16_t len;
+	mz_error_t status = udp_connect();
+
+	while((MZ_OK == status) && (0 != (len = gps_udp_next(&udp, now_ms, &frame))))
+	{
+		int n = sprintf(udp_cmd, "AT+QISENDEX=0,\"");
+
+		n += gps_udp_hex(frame, len, &udp_cmd[n]);
+		sprintf(&udp_cmd[n], "\"\r\n");
+		status = backend_at(udp_cmd, AT_TIME_15SEC, AT_TIME_1SEC);
+	}
+	if(MZ_OK != status)
+	{
+		/* Opened again for the retry, e.g. after PSM */
+		udp_open = 0;
+	}
+	return status;
+}
+
+static uint8_t udp_poll(uint32_t now_ms)
+{
+	return gps_udp_due(&udp, now_ms);
+}
+
+static void udp_urc(const char * line)
+{
+	static const char recv[] = "+QIURC: \"recv\",0,";
+	uint8_t data[GPS_UDP_ACK_SIZE + 1];
+	const char * hex = NULL;
+
+	if(0 == strncmp(line, recv, sizeof(recv) - 1))
+	{
+		/* The data is on the next line, or after the length */
+		udp_rx_len = (uint16_t)strtoul(&line[sizeof(recv) - 1], (char **)&hex, 10);
+		if(*hex != ',')
+		{
+			return;
+		}
+		hex++;
+		if(*hex == '"')
+		{
+			hex++;
+		}
+	}
+	else if(udp_rx_len != 0)
+	{
+		hex = line;
+	}
+	else
+	{
+		return;
+	}
+
+	gps_udp_ack(&udp, data, gps_udp_unhex(hex, data, sizeof(data)), HAL_GetTick());
+	udp_rx_len = 0;
+}
+
+static const st_gps_backend backend_udp =
+{
+	"udp", udp_connect, udp_publish_batch, udp_flush, udp_poll, udp_urc
+};
+
+/*
+ * Copy the counters of the UDP uplink. - START
+ */
+void gps_backend_udp_stats(st_gps_udp_stats * stats)
+{
+	*stats = udp.stats;
+}
+/* Copy the counters of the UDP uplink. - END */
+/* UDP, binary fix frames. - END */
+#endif //(GPS_UDP_ENABLE == MZ_ENABLE)
+
+/*
+ * Sink, every message to gps_backend_sink_write. - START
+ */
+static mz_error_t sink_connect(void)
+{
+	return MZ_OK;
+}
+
+static mz_error_t sink_publish_batch(const st_gps_backend_msg * msgs, uint16_t n)
+{
+	for(uint16_t i = 0; i < n; i++)
+	{
+		char * end = backend_payload_end(msgs[i].payload);
+
+		if(end != NULL)
+		{
+			*end = '\0';
+		}
+#if(GPS_LATENCY_ENABLE == MZ_ENABLE)
+		gps_latency_mark(GPS_LAT_SUBMIT, HAL_GetTick());
+#endif
+		gps_backend_sink_write(msgs[i].topic, msgs[i].payload);
+		if(end != NULL)
+		{
+			*end = BACKEND_PAYLOAD_END;
+		}
+	}
+	return MZ_OK;
+}
+
+static const st_gps_backend backend_sink =
+{
+	"sink", sink_connect, sink_publish_batch, backend_flush_none, backend_poll_none, NULL
+};
+
+/*
+ * NOTE : This function can be modified, the gps_backend_sink_write can be
+ *        implemented in the user file also.
+ *        Written with mz_puts, not GPS_LOG_OUT: a payload is longer than
+ *        a log record and would be cut to GPS_LOG_LINE_SIZE.
+ */
+__attribute__((weak)) void gps_backend_sink_write(const char * topic, const char * payload)
+{
+	mz_puts((void *)topic);
+	mz_puts(" ");
+	mz_puts((void *)payload);
+	mz_puts("\r\n");
+}
+/* Sink, every message to gps_backend_sink_write. - END */
+
+/* Backends by GPS_BACKEND_* */
+static const st_gps_backend * const backend_table[GPS_BACKENDS] =
+{
+	[GPS_BACKEND_BG96] = &backend_bg96,
+#if(MZ_LWM2M_ENABLE == MZ_ENABLE)
+	[GPS_BACKEND_LWM2M] = &backend_lwm2m,
+#endif
+	[GPS_BACKEND_SIM7080] = &backend_sim7080,
+	[GPS_BACKEND_SINK] = &backend_sink,
+#if(GPS_UDP_ENABLE == MZ_ENABLE)
+	[GPS_BACKEND_UDP] = &backend_udp,
+#endif
+};
+
+/*
+ * Operations of a backend. - START
+ */
+const st_gps_backend * gps_backend_get(uint8_t id)
+{
+	return (id < GPS_BACKENDS) ? backend_table[id] : NULL;
+}
+/* Operations of a backend. - END */
+
+/*
+ * Use a backend from the next upload. - START
+ */
+mz_error_t gps_backend_select(uint8_t id)
+{
+	if(NULL == gps_backend_get(id))
+	{
+		return MZ_FAIL;
+	}
+	backend_id = id;
+	return MZ_OK;
+}
+/* Use a backend from the next upload. - END */
+
+/*
+ * Selected backend. - START
+ */
+uint8_t gps_backend_current(void)
+{
+	return backend_id;
+}
+/* Selected backend. - END */
+
+/*
+ * Connect, publish and flush. - START
+ */
+mz_error_t gps_backend_upload(const st_gps_backend_msg * msgs, uint16_t n, uint32_t now_ms)
+{
+	const st_gps_backend * b = backend_table[backend_id];
+	st_gps_backend_stats * s = &backend_stats[backend_id];
+	mz_error_t status;
+
+	s->uploads++;
+	s->msgs += n;
+	for(uint16_t i = 0; i < n; i++)
+	{
+		s->payload_bytes += strlen(msgs[i].payload);
+	}
+
+	status = b->connect();
+	if(MZ_OK == status)
+	{
+		status = b->publish_batch(msgs, n);
+		status |= b->flush(now_ms);
+	}
+	if(MZ_OK != status)
+	{
+		s->fails++;
+	}
+	return status;
+}
+/* Connect, publish and flush. - END */
+
+/*
+ * A flush is due. - START
+ */
+uint8_t gps_backend_poll(uint32_t now_ms)
+{
+	return backend_table[backend_id]->poll(now_ms);
+}
+/* A flush is due. - END */
+
+/*
+ * Send what was held back. - START
+ */
+mz_error_t gps_backend_flush(uint32_t now_ms)
+{
+	mz_error_t status = backend_table[backend_id]->flush(now_ms);
+
+	if(MZ_OK != status)
+	{
+		backend_stats[backend_id].fails++;
+	}
+	return status;
+}
+/* Send what was held back. - END */
+
+/*
+ * A modem URC line. - START
+ */
+void gps_backend_urc(const char * line)
+{
+	if(NULL != backend_table[backend_id]->urc)
+	{
+		backend_table[backend_id]->urc(line);
+	}
+}
+/* A modem URC line. - END */
+
+/*
+ * Copy the counters of a backend. - START
+ */
+void gps_backend_get_stats(uint8_t id, st_gps_backend_stats * stats)
+{
+	if(id < GPS_BACKENDS)
+	{
+		*stats = backend_stats[id];
+	}
+}
+/* Copy the counters of a backend. - END */
@@ -0,0 +1,167 @@
+/*
+ * MZ_gps_backend.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Telemetry backends behind one interface.
+ *
+ *  The application builds its payloads once (JSON ended by Ctrl-Z, the
+ *  reported fixes alongside) and hands them to the selected backend:
+ *  connect() opens the session, publish_batch() sends one or more
+ *  messages, flush() ends the upload and sends what was held back, and
+ *  poll() tells from the thread loop that a flush is due without a new
+ *  upload, urc() takes the modem URCs. Backends :
+ *  - BG96 : MQTT with AT+QMTOPEN / QMTCONN / QMTPUB. With
+ *    GPS_MQTT_QOS1_ENABLE the session is kept and messages are published
+ *    with QoS 1 from an in-flight window (MZ_gps_qos.h), flush() sends
+ *    them, the +QMTPUB URC acknowledges them. Host simulation only: the
+ *    MonoZ library does not pass the URC to the application, the
+ *    firmware configuration has no switch for it.
+ *  - SIM7080 : MQTT with AT+SMCONF / SMCONN / SMPUB.
+ *  - LwM2M : the newest fix as Object 6 (MZ_gps_lwm2m.h), notified from
+ *    flush() when the observation allows, other telemetry is dropped.
+ *    Only with MZ_LWM2M_ENABLE.
+ *  - UDP : the fixes as binary frames with sequence numbers, ACKs and
+ *    retransmits (MZ_gps_udp.h) over a BG96 socket, AT+QIOPEN and
+ *    AT+QISENDEX, ACKs from the +QIURC "recv" URC. Other telemetry is
+ *    dropped. Host simulation only (GPS_UDP_ENABLE of the host build):
+ *    the MonoZ library does not pass the URC to the application, the
+ *    firmware configuration has no switch for it.
+ *  - Sink : every message to gps_backend_sink_write(), whole to the CLI
+ *    with mz_puts by default (host_cli_file() in a host build).
+ *  The AT backends go through gps_at_cmd(), so with GPS_MODEM_EMU_ENABLE
+ *  they run against the emulated modem. GPS_REPORT_BACKEND is used after
+ *  boot, gps_backend_select() switches at run time.
+ */
+
+#ifndef MZ_GPS_BACKEND_H_
+#define MZ_GPS_BACKEND_H_
+
+#include "stdint.h"
+#include "MZ_error_handler.h"
+#include "MZ_gps_app_config.h"
+#include "MZ_gps_fix.h"
+#include "MZ_gps_udp.h"
+#include "MZ_gps_qos.h"
+
+/**
+ * @struct st_gps_backend_msg
+ * @brief One telemetry message
+ */
+typedef struct
+{
+	char *				topic;									/*!< Quoted topic */
+	char *				payload;								/*!< JSON ended by Ctrl-Z */
+	const st_gps_fix *	fixes;									/*!< Locations in the payload, oldest first, NULL for other telemetry */
+	uint16_t			n_fixes;								/*!< Number of fixes */
+}st_gps_backend_msg;
+
+/**
+ * @struct st_gps_backend
+ * @brief Backend operations
+ */
+typedef struct
+{
+	const char *	name;										/*!< Name on the CLI */
+	mz_error_t		(*connect)(void);							/*!< Open the session */
+	mz_error_t		(*publish_batch)(const st_gps_backend_msg * msgs, uint16_t n);	/*!< Send n messages */
+	mz_error_t		(*flush)(uint32_t now_ms);					/*!< End of an upload, send what is held back */
+	uint8_t			(*poll)(uint32_t now_ms);					/*!< A flush is due without an upload */
+	void			(*urc)(const char * line);					/*!< Modem URC line, NULL when not needed */
+}st_gps_backend;
+
+/**
+ * @struct st_gps_backend_stats
+ * @brief Counters of one backend
+ */
+typedef struct
+{
+	uint32_t		uploads;									/*!< Uploads started */
+	uint32_t		fails;										/*!< Uploads or flushes that failed */
+	uint32_t		msgs;										/*!< Messages handed over */
+	uint32_t		payload_bytes;								/*!< Payload bytes handed over */
+	uint32_t		at_bytes;									/*!< AT command and payload bytes to the modem */
+	uint32_t		at_cmds;									/*!< AT commands, payloads included */
+}st_gps_backend_stats;
+
+/** @fn const st_gps_backend * gps_backend_get(uint8_t id)
+ * @brief Operations of a backend.
+ * @param id GPS_BACKEND_*
+ * @return operations, NULL when the backend is not built
+ */
+const st_gps_backend * gps_backend_get(uint8_t id);
+
+/** @fn mz_error_t gps_backend_select(uint8_t id)
+ * @brief Use a backend from the next upload.
+ * @param id GPS_BACKEND_*
+ * @return MZ_OK, MZ_FAIL when the backend is not built
+ */
+mz_error_t gps_backend_select(uint8_t id);
+
+/** @fn uint8_t gps_backend_current(void)
+ * @brief Selected backend.
+ * @return GPS_BACKEND_*
+ */
+uint8_t gps_backend_current(void);
+
+/** @fn mz_error_t gps_backend_upload(const st_gps_backend_msg * msgs, uint16_t n, uint32_t now_ms)
+ * @brief Connect, publish and flush with the selected backend.
+ * @param msgs messages
+ * @param n number of messages
+ * @param now_ms current time
+ * @return MZ_OK when all steps succeeded
+ */
+mz_error_t gps_backend_upload(const st_gps_backend_msg * msgs, uint16_t n, uint32_t now_ms);
+
+/** @fn uint8_t gps_backend_poll(uint32_t now_ms)
+ * @brief The selected backend wants a flush, ask from the thread loop.
+ * @param now_ms current time
+ * @return 1 when gps_backend_flush() is due
+ */
+uint8_t gps_backend_poll(uint32_t now_ms);
+
+/** @fn mz_error_t gps_backend_flush(uint32_t now_ms)
+ * @brief Send what the selected backend held back.
+ * @param now_ms current time
+ * @return MZ_OK/MZ_FAIL
+ */
+mz_error_t gps_backend_flush(uint32_t now_ms);
+
+/** @fn void gps_backend_urc(const char * line)
+ * @brief A modem URC line for the selected backend.
+ * @param line URC without line end
+ */
+void gps_backend_urc(const char * line);
+
+/** @fn void gps_backend_get_stats(uint8_t id, st_gps_backend_stats * stats)
+ * @brief Copy the counters of a backend.
+ * @param id GPS_BACKEND_*
+ * @param stats output
+ */
+void gps_backend_get_stats(uint8_t id, st_gps_backend_stats * stats);
+
+#if(GPS_UDP_ENABLE == MZ_ENABLE)
+/** @fn void gps_backend_udp_stats(st_gps_udp_stats * stats)
+ * @brief Copy the counters of the UDP uplink.
+ * @param stats output
+ */
+void gps_backend_udp_stats(st_gps_udp_stats * stats);
+#endif
+
+#if(GPS_MQTT_QOS1_ENABLE == MZ_ENABLE)
+/** @fn void gps_backend_qos_stats(st_gps_qos_stats * stats, uint8_t * in_flight)
+ * @brief Copy the QoS 1 counters of the BG96 backend.
+ * @param stats output
+ * @param in_flight output, messages waiting for their PUBACK
+ */
+void gps_backend_qos_stats(st_gps_qos_stats * stats, uint8_t * in_flight);
+#endif
+
+/** @fn void gps_backend_sink_write(const char * topic, const char * payload)
+ * @brief Output of the sink backend. Weak, the default prints to the CLI.
+ * @param topic quoted topic
+ * @param payload payload without Ctrl-Z
+ */
+void gps_backend_sink_write(const char * topic, const char * payload);
+
+#endif /* MZ_GPS_BACKEND_H_ */
@@ -0,0 +1,220 @@
+/*
+ * MZ_gps_fix.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_fix.h"
+#include "stdio.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define GPS_FIX_COORD_MIN_DECIMALS		(5)						///< Minute fraction digits kept from the coordinate
+#define GPS_FIX_DEG_SCALE				(10000000L)				///< 1e-7 degree per degree
+#define GPS_FIX_KNOT_CMS_NUM			(1852L)					///< 1 knot = 1852/3600 m/s
+#define GPS_FIX_KNOT_CMS_DEN			(36000L)				///< Denominator for 1/1000 knot to cm/s
+#define GPS_FIX_E7_CM_NUM				(111319L)				///< 1e-7 degree of latitude = 1.11319 cm
+#define GPS_FIX_E7_CM_DEN				(100000L)				///< Denominator of GPS_FIX_E7_CM_NUM
+/* Define some common use MACRO - END */
+
+/* cos(deg) * 32767 for deg = 0..90 */
+static const uint16_t gps_fix_cos_table[91] =
+{
+	32767, 32762, 32747, 32722, 32687, 32642, 32587, 32523, 32448, 32364,
+	32269, 32165, 32051, 31927, 31794, 31650, 31498, 31335, 31163, 30982,
+	30791, 30591, 30381, 30162, 29934, 29697, 29451, 29196, 28932, 28659,
+	28377, 28087, 27788, 27481, 27165, 26841, 26509, 26169, 25821, 25465,
+	25101, 24730, 24351, 23964, 23571, 23170, 22762, 22347, 21925, 21497,
+	21062, 20621, 20173, 19720, 19260, 18794, 18323, 17846, 17364, 16876,
+	16384, 15886, 15383, 14876, 14364, 13848, 13328, 12803, 12275, 11743,
+	11207, 10668, 10126, 9580, 9032, 8481, 7927, 7371, 6813, 6252,
+	5690, 5126, 4560, 3993, 3425, 2856, 2286, 1715, 1144, 572,
+	0,
+};
+
+/*
+ * Convert a decimal NMEA field to an integer scaled by 10^decimals. - START
+ */
+int32_t gps_fix_parse_scaled(const char * s, uint8_t decimals)
+{
+	int32_t value = 0;
+	int8_t negative = 0;
+
+	if(*s == '-')
+	{
+		negative = 1;
+		s++;
+	}
+
+	while((*s >= '0') && (*s <= '9'))
+	{
+		value = (value * 10) + (*s - '0');
+		s++;
+	}
+
+	if(*s == '.')
+	{
+		s++;
+	}
+
+	while(decimals > 0)
+	{
+		value *= 10;
+		if((*s >= '0') && (*s <= '9'))
+		{
+			value += (*s - '0');
+			s++;
+		}
+		decimals--;
+	}
+
+	return negative ? -value : value;
+}
+/* Convert a decimal NMEA field to an integer scaled by 10^decimals. - END */
+
+/*
+ * Convert an NMEA (d)ddmm.mmmmm coordinate to 1e-7 degree. - START
+ */
+int32_t gps_fix_parse_coord(const char * s, char hemi)
+{
+	/* Whole field scaled by 1e5 : (d)ddmm mmmmm */
+	int32_t raw = gps_fix_parse_scaled(s, GPS_FIX_COORD_MIN_DECIMALS);
+
+	/* Split degrees from minutes (minutes are the two digits before '.') */
+	int32_t deg = raw / 10000000L;
+	int32_t min_e5 = raw - (deg * 10000000L);
+
+	/* minutes * 1e5 -> degree * 1e7 : * 100 / 60 */
+	int32_t value = (deg * GPS_FIX_DEG_SCALE) + ((min_e5 * 10) / 6);
+
+	return ((hemi == 'S') || (hemi == 'W')) ? -value : value;
+}
+/* Convert an NMEA (d)ddmm.mmmmm coordinate to 1e-7 degree. - END */
+
+/*
+ * Convert a speed in 1/1000 knot to cm/s. - START
+ */
+uint16_t gps_fix_knots_to_cms(int32_t knots_x1000)
+{
+	int32_t cms;
+
+	if(knots_x1000 <= 0)
+	{
+		return 0;
+	}
+
+	cms = (int32_t)(((int64_t)knots_x1000 * GPS_FIX_KNOT_CMS_NUM) / GPS_FIX_KNOT_CMS_DEN);
+
+	return (cms > 0xFFFF) ? 0xFFFF : (uint16_t)cms;
+}
+/* Convert a speed in 1/1000 knot to cm/s. - END */
+
+/*
+ * Cosine of a latitude in Q15. - START
+ */
+int32_t gps_fix_cos_q15(int32_t lat_e7)
+{
+	int32_t deg;
+	int32_t frac;
+	int32_t a;
+	int32_t b;
+
+	if(lat_e7 < 0)
+	{
+		lat_e7 = -lat_e7;
+	}
+	if(lat_e7 >= (90 * GPS_FIX_DEG_SCALE))
+	{
+		return 0;
+	}
+
+	deg = lat_e7 / GPS_FIX_DEG_SCALE;
+	frac = (lat_e7 - (deg * GPS_FIX_DEG_SCALE)) / 1000;			/* 1e-4 degree steps */
+	a = gps_fix_cos_table[deg];
+	b = gps_fix_cos_table[deg + 1];
+
+	return a - (((a - b) * frac) / 10000);
+}
+/* Cosine of a latitude in Q15. - END */
+
+/*
+ * Local east/north offset of a point from a reference point. - START
+ */
+void gps_fix_offset_cm(int32_t ref_lat_e7, int32_t ref_lon_e7, int32_t lat_e7, int32_t lon_e7, int32_t * east_cm, int32_t * north_cm)
+{
+	int64_t dlat = (int64_t)lat_e7 - ref_lat_e7;
+	int64_t dlon = (int64_t)lon_e7 - ref_lon_e7;
+
+	*north_cm = (int32_t)((dlat * GPS_FIX_E7_CM_NUM) / GPS_FIX_E7_CM_DEN);
+	*east_cm = (int32_t)((((dlon * gps_fix_cos_q15(ref_lat_e7)) >> 15) * GPS_FIX_E7_CM_NUM) / GPS_FIX_E7_CM_DEN);
+}
+/* Local east/north offset of a point from a reference point. - END */
+
+/*
+ * Point at a local east/north offset from a reference point. - START
+ */
+void gps_fix_offset_apply(int32_t ref_lat_e7, int32_t ref_lon_e7, int32_t east_cm, int32_t north_cm, int32_t * lat_e7, int32_t * lon_e7)
+{
+	int64_t cos_q15 = gps_fix_cos_q15(ref_lat_e7);
+
+	if(cos_q15 < 1)
+	{
+		cos_q15 = 1;
+	}
+
+	*lat_e7 = ref_lat_e7 + (int32_t)(((int64_t)north_cm * GPS_FIX_E7_CM_DEN) / GPS_FIX_E7_CM_NUM);
+	*lon_e7 = ref_lon_e7 + (int32_t)(((((int64_t)east_cm * GPS_FIX_E7_CM_DEN) / GPS_FIX_E7_CM_NUM) << 15) / cos_q15);
+}
+/* Point at a local east/north offset from a reference point. - END */
+
+/*
+ * Print a 1e-7 degree value as a decimal degree string. - START
+ */
+int gps_fix_format_e7(char * buff, int32_t v)
+{
+	const char * sign = "";
+	uint32_t mag = (uint32_t)v;
+
+	if(v < 0)
+	{
+		sign = "-";
+		mag = (uint32_t)(-(int64_t)v);
+	}
+	return sprintf(buff,"%s%lu.%07lu",sign,(unsigned long)(mag / GPS_FIX_DEG_SCALE),(unsigned long)(mag % GPS_FIX_DEG_SCALE));
+}
+/* Print a 1e-7 degree value as a decimal degree string. - END */
+
+/*
+ * UTC date and time of a fix as seconds since 1970-01-01. - START
+ */
+uint32_t gps_fix_to_unix(const st_gps_fix * fix)
+{
+	int32_t d = (int32_t)(fix->utc_date / 10000);
+	int32_t m = (int32_t)((fix->utc_date / 100) % 100);
+	int32_t y = (int32_t)(fix->utc_date % 100) + 2000;
+	int32_t era;
+	int32_t yoe;
+	int32_t doy;
+	int32_t days;
+
+	if((d == 0) || (m == 0))
+	{
+		return 0;
+	}
+
+	/* Days from civil date, March based year */
+	y -= (m <= 2) ? 1 : 0;
+	era = y / 400;
+	yoe = y - (era * 400);
+	doy = (((153 * (m + ((m > 2) ? -3 : 9))) + 2) / 5) + d - 1;
+	days = (era * 146097) + (yoe * 365) + (yoe / 4) - (yoe / 100) + doy - 719468;
+
+	return ((uint32_t)days * 86400UL) +
+			((fix->utc_time / 10000) * 3600UL) +
+			(((fix->utc_time / 100) % 100) * 60UL) +
+			(fix->utc_time % 100);
+}
+/* UTC date and time of a fix as seconds since 1970-01-01. - END */
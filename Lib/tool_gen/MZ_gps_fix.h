@@ -0,0 +1,110 @@
+/*
+ * MZ_gps_fix.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Integer representation of one committed GPS epoch and the helpers used
+ *  to assemble it from NMEA fields. No HAL dependency.
+ */
+
+#ifndef MZ_GPS_FIX_H_
+#define MZ_GPS_FIX_H_
+
+#include "stdint.h"
+
+#define GPS_FIX_INVALID				(0)						///< Receiver reports no valid position
+#define GPS_FIX_VALID				(1)						///< Receiver reports a valid position
+
+/**
+ * @struct st_gps_fix
+ * @brief One committed GPS epoch in fixed point
+ */
+typedef struct
+{
+	int32_t			lat_e7;										/*!< Latitude in 1e-7 degree, north positive */
+	int32_t			lon_e7;										/*!< Longitude in 1e-7 degree, east positive */
+	int32_t			alt_cm;										/*!< Altitude above MSL in cm (from $GPGGA) */
+	uint32_t		utc_time;									/*!< UTC time as hhmmss */
+	uint32_t		utc_date;									/*!< UTC date as ddmmyy */
+	uint32_t		tick;										/*!< System tick at commit */
+	uint16_t		speed_cms;									/*!< Speed over ground in cm/s */
+	uint16_t		course_cdeg;								/*!< Track angle in 1/100 degree */
+	uint16_t		pdop_x100;									/*!< PDOP * 100 */
+	uint16_t		hdop_x100;									/*!< HDOP * 100 */
+	uint16_t		vdop_x100;									/*!< VDOP * 100 */
+	uint16_t		utc_ms;										/*!< Milliseconds of utc_time */
+	uint8_t			sats;										/*!< Satellites used (from $GPGGA) */
+	uint8_t			valid;										/*!< GPS_FIX_VALID / GPS_FIX_INVALID */
+}st_gps_fix;
+
+/** @fn int32_t gps_fix_parse_scaled(const char * s, uint8_t decimals)
+ * @brief Convert a decimal NMEA field to an integer scaled by 10^decimals.
+ * Extra fraction digits are truncated, missing ones are zero filled.
+ * @param s NMEA field, may be empty
+ * @param decimals number of fraction digits to keep
+ * @return scaled value, 0 for an empty field
+ */
+int32_t gps_fix_parse_scaled(const char * s, uint8_t decimals);
+
+/** @fn int32_t gps_fix_parse_coord(const char * s, char hemi)
+ * @brief Convert an NMEA (d)ddmm.mmmmm coordinate to 1e-7 degree.
+ * @param s NMEA coordinate field
+ * @param hemi hemisphere character, 'S' and 'W' give negative values
+ * @return coordinate in 1e-7 degree
+ */
+int32_t gps_fix_parse_coord(const char * s, char hemi);
+
+/** @fn uint16_t gps_fix_knots_to_cms(int32_t knots_x1000)
+ * @brief Convert a speed in 1/1000 knot to cm/s.
+ * @param knots_x1000 speed in 1/1000 knot
+ * @return speed in cm/s, saturated to 0xFFFF
+ */
+uint16_t gps_fix_knots_to_cms(int32_t knots_x1000);
+
+/** @fn int32_t gps_fix_cos_q15(int32_t lat_e7)
+ * @brief Cosine of a latitude in Q15 (table with linear interpolation).
+ * Used to scale longitude differences to ground distance.
+ * @param lat_e7 latitude in 1e-7 degree
+ * @return cos(lat) * 32767
+ */
+int32_t gps_fix_cos_q15(int32_t lat_e7);
+
+/** @fn void gps_fix_offset_cm(int32_t ref_lat_e7, int32_t ref_lon_e7, int32_t lat_e7, int32_t lon_e7, int32_t * east_cm, int32_t * north_cm)
+ * @brief Local east/north offset of a point from a reference point
+ * (equirectangular projection, good to a few km from the reference).
+ * @param ref_lat_e7 reference latitude in 1e-7 degree
+ * @param ref_lon_e7 reference longitude in 1e-7 degree
+ * @param lat_e7 point latitude in 1e-7 degree
+ * @param lon_e7 point longitude in 1e-7 degree
+ * @param east_cm east offset in cm
+ * @param north_cm north offset in cm
+ */
+void gps_fix_offset_cm(int32_t ref_lat_e7, int32_t ref_lon_e7, int32_t lat_e7, int32_t lon_e7, int32_t * east_cm, int32_t * north_cm);
+
+/** @fn void gps_fix_offset_apply(int32_t ref_lat_e7, int32_t ref_lon_e7, int32_t east_cm, int32_t north_cm, int32_t * lat_e7, int32_t * lon_e7)
+ * @brief Inverse of gps_fix_offset_cm, point at a local east/north offset.
+ * @param ref_lat_e7 reference latitude in 1e-7 degree
+ * @param ref_lon_e7 reference longitude in 1e-7 degree
+ * @param east_cm east offset in cm
+ * @param north_cm north offset in cm
+ * @param lat_e7 point latitude in 1e-7 degree
+ * @param lon_e7 point longitude in 1e-7 degree
+ */
+void gps_fix_offset_apply(int32_t ref_lat_e7, int32_t ref_lon_e7, int32_t east_cm, int32_t north_cm, int32_t * lat_e7, int32_t * lon_e7);
+
+/** @fn int gps_fix_format_e7(char * buff, int32_t v)
+ * @brief Print a 1e-7 degree value as a decimal degree string.
+ * @param buff output, at least 13 characters
+ * @param v value in 1e-7 degree
+ * @return number of characters written
+ */
+int gps_fix_format_e7(char * buff, int32_t v);
+
+/** @fn uint32_t gps_fix_to_unix(const st_gps_fix * fix)
+ * @brief UTC date and time of a fix as seconds since 1970-01-01.
+ * @param fix fix with utc_date (ddmmyy, 20yy) and utc_time (hhmmss)
+ * @return unix time in seconds, 0 when the date is not set
+ */
+uint32_t gps_fix_to_unix(const st_gps_fix * fix);
+
+#endif /* MZ_GPS_FIX_H_ */
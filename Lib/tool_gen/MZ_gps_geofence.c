@@ -0,0 +1,407 @@
+/*
+ * MZ_gps_geofence.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_geofence.h"
+#include "MZ_gps_fix.h"
+
+#include "string.h"
+
+/* Include Header Files - END */
+
+#if(GPS_GEOFENCE_ENABLE == MZ_ENABLE)
+
+/* Define some common use MACRO - START */
+#define GF_GRID_CELLS				(GPS_GEOFENCE_GRID_DIM * GPS_GEOFENCE_GRID_DIM)	///< Number of grid cells
+#define GF_E7_PER_KM				(89832L)					///< 1e-7 degree of latitude per km (1e10 / 111319)
+#define GF_COS_MIN_Q15				(328)						///< cos(89.4 deg), limits circle bbox near the poles
+#define GF_NOT_INSIDE				(0xFF)						///< Fence is not in the inside list
+/* Define some common use MACRO - END */
+
+#if(GPS_GEOFENCE_MAX_CELL_ITEMS < GPS_GEOFENCE_MAX_FENCES)
+#error "GPS_GEOFENCE_MAX_CELL_ITEMS must hold every fence in a single cell"
+#endif
+
+/**
+ * @struct st_gf_fence
+ * @brief One fence with its bounding box
+ */
+typedef struct
+{
+	int32_t			min_lat;									/*!< Bounding box */
+	int32_t			max_lat;									/*!< Bounding box */
+	int32_t			min_lon;									/*!< Bounding box */
+	int32_t			max_lon;									/*!< Bounding box */
+	int32_t			c_lat;										/*!< Circle centre */
+	int32_t			c_lon;										/*!< Circle centre */
+	int64_t			r2;											/*!< Circle radius^2 in (1e-7 degree)^2 */
+	int32_t			cos_q15;									/*!< Circle longitude scale */
+	uint16_t		id;											/*!< User id */
+	uint16_t		first;										/*!< First vertex of a polygon */
+	uint16_t		n;											/*!< Vertex count, 0 for a circle */
+	uint8_t			inside_slot;								/*!< Index in gf_inside or GF_NOT_INSIDE */
+}st_gf_fence;
+
+/* Geofence related variables - START */
+static st_gf_fence gf_fence[GPS_GEOFENCE_MAX_FENCES];
+static st_gps_geofence_pt gf_vertex[GPS_GEOFENCE_MAX_VERTICES];
+static uint16_t gf_fence_count = 0;
+static uint16_t gf_vertex_count = 0;
+
+static uint16_t gf_cell_start[GF_GRID_CELLS + 1];				/* CSR offsets into gf_cell_items */
+static uint16_t gf_cell_items[GPS_GEOFENCE_MAX_CELL_ITEMS];	/* Fence indexes per cell */
+static int32_t gf_grid_min_lat = 0;
+static int32_t gf_grid_min_lon = 0;
+static int32_t gf_cell_h = 1;									/* Cell height in 1e-7 degree */
+static int32_t gf_cell_w = 1;									/* Cell width in 1e-7 degree */
+static uint8_t gf_grid_dim = GPS_GEOFENCE_GRID_DIM;			/* Grid in use, coarser when the items do not fit */
+static uint8_t gf_built = 0;
+
+static uint16_t gf_inside[GPS_GEOFENCE_MAX_INSIDE];			/* Fences the last fix was inside */
+static uint8_t gf_inside_count = 0;
+/* Geofence related variables - END */
+
+/** @fn static uint8_t gf_cell_range(int32_t v, int32_t min, int32_t size)
+ * @brief Grid row/column of a coordinate, clamped to the grid
+ */
+static uint8_t gf_cell_range(int32_t v, int32_t min, int32_t size)
+{
+	int32_t c = (v - min) / size;
+
+	if(c < 0)
+	{
+		return 0;
+	}
+	if(c >= gf_grid_dim)
+	{
+		return gf_grid_dim - 1;
+	}
+	return (uint8_t)c;
+}
+
+/** @fn static uint8_t gf_test(const st_gf_fence * f, int32_t lat, int32_t lon)
+ * @brief Point in fence test in integer math
+ */
+static uint8_t gf_test(const st_gf_fence * f, int32_t lat, int32_t lon)
+{
+	uint8_t inside = 0;
+
+	if((lat < f->min_lat) || (lat > f->max_lat) || (lon < f->min_lon) || (lon > f->max_lon))
+	{
+		return 0;
+	}
+
+	if(f->n == 0)
+	{
+		int64_t dlat = lat - f->c_lat;
+		int64_t dlon = ((int64_t)(lon - f->c_lon) * f->cos_q15) >> 15;
+
+		return ((dlat * dlat) + (dlon * dlon)) <= f->r2;
+	}
+
+	/* Ray casting towards +lon. The edge (i, j) crosses the ray when the
+	 * point lies between its latitudes and left of it; the left test is the
+	 * sign of the cross product so no division is needed. */
+	for(uint16_t i = 0, j = f->n - 1; i < f->n; j = i++)
+	{
+		const st_gps_geofence_pt * pi = &gf_vertex[f->first + i];
+		const st_gps_geofence_pt * pj = &gf_vertex[f->first + j];
+
+		if((pi->lat_e7 > lat) != (pj->lat_e7 > lat))
+		{
+			int64_t cross = ((int64_t)(pj->lon_e7 - pi->lon_e7) * (lat - pi->lat_e7)) -
+							((int64_t)(lon - pi->lon_e7) * (pj->lat_e7 - pi->lat_e7));
+
+			if((pj->lat_e7 > pi->lat_e7) ? (cross > 0) : (cross < 0))
+			{
+				inside ^= 1;
+			}
+		}
+	}
+
+	return inside;
+}
+
+/*
+ * Remove all fences and forget the inside state. - START
+ */
+void gps_geofence_reset(void)
+{
+	gf_fence_count = 0;
+	gf_vertex_count = 0;
+	gf_inside_count = 0;
+	gf_built = 0;
+}
+/* Remove all fences and forget the inside state. - END */
+
+/*
+ * Add a circular fence. - START
+ */
+mz_error_t gps_geofence_add_circle(uint16_t id, int32_t lat_e7, int32_t lon_e7, uint32_t radius_m)
+{
+	st_gf_fence * f;
+	int32_t r_e7;
+	int32_t r_lon_e7;
+
+	if(gf_fence_count >= GPS_GEOFENCE_MAX_FENCES)
+	{
+		return MZ_INVALID_SIZE;
+	}
+
+	r_e7 = (int32_t)(((int64_t)radius_m * GF_E7_PER_KM) / 1000);
+	if((radius_m == 0) || ((2 * r_e7) > GPS_GEOFENCE_MAX_SPAN_E7))
+	{
+		return MZ_INVALID_ARGUMENT;
+	}
+
+	f = &gf_fence[gf_fence_count];
+	f->id = id;
+	f->n = 0;
+	f->first = 0;
+	f->c_lat = lat_e7;
+	f->c_lon = lon_e7;
+	f->r2 = (int64_t)r_e7 * r_e7;
+	f->cos_q15 = gps_fix_cos_q15(lat_e7);
+	if(f->cos_q15 < GF_COS_MIN_Q15)
+	{
+		f->cos_q15 = GF_COS_MIN_Q15;
+	}
+
+	r_lon_e7 = (int32_t)(((int64_t)r_e7 << 15) / f->cos_q15);
+	f->min_lat = lat_e7 - r_e7;
+	f->max_lat = lat_e7 + r_e7;
+	f->min_lon = lon_e7 - r_lon_e7;
+	f->max_lon = lon_e7 + r_lon_e7;
+	f->inside_slot = GF_NOT_INSIDE;
+
+	gf_fence_count++;
+	gf_built = 0;
+	return MZ_OK;
+}
+/* Add a circular fence. - END */
+
+/*
+ * Add a polygon fence. - START
+ */
+mz_error_t gps_geofence_add_polygon(uint16_t id, const st_gps_geofence_pt * pts, uint16_t n)
+{
+	st_gf_fence * f;
+
+	if((pts == NULL) || (n < 3))
+	{
+		return MZ_INVALID_ARGUMENT;
+	}
+	if((gf_fence_count >= GPS_GEOFENCE_MAX_FENCES) ||
+	   ((uint32_t)(gf_vertex_count + n) > GPS_GEOFENCE_MAX_VERTICES))
+	{
+		return MZ_INVALID_SIZE;
+	}
+
+	f = &gf_fence[gf_fence_count];
+	f->min_lat = f->max_lat = pts[0].lat_e7;
+	f->min_lon = f->max_lon = pts[0].lon_e7;
+	for(uint16_t i = 1; i < n; i++)
+	{
+		if(pts[i].lat_e7 < f->min_lat) f->min_lat = pts[i].lat_e7;
+		if(pts[i].lat_e7 > f->max_lat) f->max_lat = pts[i].lat_e7;
+		if(pts[i].lon_e7 < f->min_lon) f->min_lon = pts[i].lon_e7;
+		if(pts[i].lon_e7 > f->max_lon) f->max_lon = pts[i].lon_e7;
+	}
+	if(((f->max_lat - f->min_lat) > GPS_GEOFENCE_MAX_SPAN_E7) ||
+	   ((f->max_lon - f->min_lon) > GPS_GEOFENCE_MAX_SPAN_E7))
+	{
+		return MZ_INVALID_ARGUMENT;
+	}
+
+	memcpy(&gf_vertex[gf_vertex_count], pts, n * sizeof(st_gps_geofence_pt));
+	f->id = id;
+	f->first = gf_vertex_count;
+	f->n = n;
+	f->inside_slot = GF_NOT_INSIDE;
+
+	gf_vertex_count += n;
+	gf_fence_count++;
+	gf_built = 0;
+	return MZ_OK;
+}
+/* Add a polygon fence. - END */
+
+/*
+ * Build the grid index. - START
+ */
+mz_error_t gps_geofence_build(void)
+{
+	int32_t max_lat;
+	int32_t max_lon;
+	uint32_t total;
+	uint16_t cells;
+
+	gf_built = 0;
+	gf_inside_count = 0;
+	memset(gf_cell_start, 0, sizeof(gf_cell_start));
+
+	if(gf_fence_count == 0)
+	{
+		return MZ_OK;
+	}
+
+	/* Grid covers the union of all bounding boxes */
+	gf_grid_min_lat = gf_fence[0].min_lat;
+	gf_grid_min_lon = gf_fence[0].min_lon;
+	max_lat = gf_fence[0].max_lat;
+	max_lon = gf_fence[0].max_lon;
+	for(uint16_t i = 0; i < gf_fence_count; i++)
+	{
+		gf_fence[i].inside_slot = GF_NOT_INSIDE;
+		if(gf_fence[i].min_lat < gf_grid_min_lat) gf_grid_min_lat = gf_fence[i].min_lat;
+		if(gf_fence[i].min_lon < gf_grid_min_lon) gf_grid_min_lon = gf_fence[i].min_lon;
+		if(gf_fence[i].max_lat > max_lat) max_lat = gf_fence[i].max_lat;
+		if(gf_fence[i].max_lon > max_lon) max_lon = gf_fence[i].max_lon;
+	}
+
+	/* Pass 1 : count references per cell (stored one slot ahead). A set of
+	 * fences that are large against the grid does not fit the item pool,
+	 * it is indexed on a coarser grid instead, down to a single cell. */
+	for(gf_grid_dim = GPS_GEOFENCE_GRID_DIM; ; gf_grid_dim = (gf_grid_dim + 1) / 2)
+	{
+		total = 0;
+		memset(gf_cell_start, 0, sizeof(gf_cell_start));
+		gf_cell_h = (int32_t)((((int64_t)max_lat - gf_grid_min_lat) / gf_grid_dim) + 1);
+		gf_cell_w = (int32_t)((((int64_t)max_lon - gf_grid_min_lon) / gf_grid_dim) + 1);
+		for(uint16_t i = 0; i < gf_fence_count; i++)
+		{
+			const st_gf_fence * f = &gf_fence[i];
+			uint8_t r0 = gf_cell_range(f->min_lat, gf_grid_min_lat, gf_cell_h);
+			uint8_t r1 = gf_cell_range(f->max_lat, gf_grid_min_lat, gf_cell_h);
+			uint8_t c0 = gf_cell_range(f->min_lon, gf_grid_min_lon, gf_cell_w);
+			uint8_t c1 = gf_cell_range(f->max_lon, gf_grid_min_lon, gf_cell_w);
+
+			for(uint8_t r = r0; r <= r1; r++)
+			{
+				for(uint8_t c = c0; c <= c1; c++)
+				{
+					gf_cell_start[(r * gf_grid_dim) + c + 1]++;
+					total++;
+				}
+			}
+		}
+		if((total <= GPS_GEOFENCE_MAX_CELL_ITEMS) || (gf_grid_dim == 1))
+		{
+			break;
+		}
+	}
+
+	/* Prefix sum : gf_cell_start[k + 1] is the fill cursor of cell k */
+	cells = (uint16_t)gf_grid_dim * gf_grid_dim;
+	for(uint16_t k = 1; k <= cells; k++)
+	{
+		gf_cell_start[k] += gf_cell_start[k - 1];
+	}
+	for(uint16_t k = cells; k > 0; k--)
+	{
+		gf_cell_start[k] = gf_cell_start[k - 1];
+	}
+
+	/* Pass 2 : fill, afterwards gf_cell_start[k + 1] is the end of cell k */
+	for(uint16_t i = 0; i < gf_fence_count; i++)
+	{
+		const st_gf_fence * f = &gf_fence[i];
+		uint8_t r0 = gf_cell_range(f->min_lat, gf_grid_min_lat, gf_cell_h);
+		uint8_t r1 = gf_cell_range(f->max_lat, gf_grid_min_lat, gf_cell_h);
+		uint8_t c0 = gf_cell_range(f->min_lon, gf_grid_min_lon, gf_cell_w);
+		uint8_t c1 = gf_cell_range(f->max_lon, gf_grid_min_lon, gf_cell_w);
+
+		for(uint8_t r = r0; r <= r1; r++)
+		{
+			for(uint8_t c = c0; c <= c1; c++)
+			{
+				gf_cell_items[gf_cell_start[(r * gf_grid_dim) + c + 1]++] = i;
+			}
+		}
+	}
+
+	gf_built = 1;
+	return MZ_OK;
+}
+/* Build the grid index. - END */
+
+/*
+ * Test one fix against the candidate fences and report transitions. - START
+ */
+void gps_geofence_eval(int32_t lat_e7, int32_t lon_e7, gps_geofence_cb cb)
+{
+	uint8_t k = 0;
+
+	if(!gf_built)
+	{
+		return;
+	}
+
+	/* Exits : only the fences we are inside need a check */
+	while(k < gf_inside_count)
+	{
+		st_gf_fence * f = &gf_fence[gf_inside[k]];
+
+		if(gf_test(f, lat_e7, lon_e7))
+		{
+			k++;
+			continue;
+		}
+
+		/* Swap remove from the inside list */
+		f->inside_slot = GF_NOT_INSIDE;
+		gf_inside_count--;
+		if(k != gf_inside_count)
+		{
+			gf_inside[k] = gf_inside[gf_inside_count];
+			gf_fence[gf_inside[k]].inside_slot = k;
+		}
+		if(cb) cb(f->id, GPS_GEOFENCE_EXIT);
+	}
+
+	/* Enters : candidates of the grid cell */
+	if((lat_e7 >= gf_grid_min_lat) && (lon_e7 >= gf_grid_min_lon) &&
+	   (((int64_t)lat_e7 - gf_grid_min_lat) < ((int64_t)gf_cell_h * gf_grid_dim)) &&
+	   (((int64_t)lon_e7 - gf_grid_min_lon) < ((int64_t)gf_cell_w * gf_grid_dim)))
+	{
+		uint16_t cell = (gf_cell_range(lat_e7, gf_grid_min_lat, gf_cell_h) * gf_grid_dim) +
+						gf_cell_range(lon_e7, gf_grid_min_lon, gf_cell_w);
+
+		for(uint16_t n = gf_cell_start[cell]; n < gf_cell_start[cell + 1]; n++)
+		{
+			uint16_t idx = gf_cell_items[n];
+			st_gf_fence * f = &gf_fence[idx];
+
+			if((f->inside_slot != GF_NOT_INSIDE) || (gf_inside_count >= GPS_GEOFENCE_MAX_INSIDE))
+			{
+				continue;
+			}
+			if(gf_test(f, lat_e7, lon_e7))
+			{
+				f->inside_slot = gf_inside_count;
+				gf_inside[gf_inside_count++] = idx;
+				if(cb) cb(f->id, GPS_GEOFENCE_ENTER);
+			}
+		}
+	}
+}
+/* Test one fix against the candidate fences and report transitions. - END */
+
+/*
+ * Fence table loader. - START
+ * NOTE : This function can be modified, when fences are needed,
+ *        the gps_geofence_load can be implemented in the user file also.
+ */
+__attribute__((weak)) void gps_geofence_load(void)
+{
+	/* Example :
+	 * gps_geofence_add_circle(1, 298653100, 778731228, 200);
+	 */
+}
+/* Fence table loader. - END */
+
+#endif //(GPS_GEOFENCE_ENABLE == MZ_ENABLE)
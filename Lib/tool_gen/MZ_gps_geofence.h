@@ -0,0 +1,104 @@
+/*
+ * MZ_gps_geofence.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  On-device geofence engine evaluated on every committed fix.
+ *
+ *  Fences are circles or polygons in 1e-7 degree fixed point. After all
+ *  fences are added, gps_geofence_build() places them in a uniform grid
+ *  over their common bounding box. A fix only tests the fences listed in
+ *  its grid cell (bounding box reject, then integer ray casting), so the
+ *  cost per fix is bounded by the fullest cell and not by the fence count.
+ *  Fences that are large against the grid cell are indexed on a coarser
+ *  grid so the cell lists fit their pool. Host/tools/gps_geofence_bench
+ *  measures the cost per fix over whole tracks.
+ *
+ *  Limitations: fences must not cross the antimeridian and a single fence
+ *  may span at most GPS_GEOFENCE_MAX_SPAN_E7 in latitude and longitude.
+ *  No HAL dependency.
+ */
+
+#ifndef MZ_GPS_GEOFENCE_H_
+#define MZ_GPS_GEOFENCE_H_
+
+#include "stdint.h"
+#include "MZ_error_handler.h"
+#include "MZ_gps_app_config.h"
+
+#define GPS_GEOFENCE_MAX_SPAN_E7	(100000000L)				///< 10 degree, keeps ray casting products in 64 bit
+
+/**
+ * @enum en_gps_geofence_event
+ * @brief Fence transition reported to the event callback
+ */
+typedef enum
+{
+	GPS_GEOFENCE_EXIT = 0,										/*!< Fix left the fence */
+	GPS_GEOFENCE_ENTER = 1,										/*!< Fix entered the fence */
+}en_gps_geofence_event;
+
+/**
+ * @struct st_gps_geofence_pt
+ * @brief Polygon vertex
+ */
+typedef struct
+{
+	int32_t			lat_e7;										/*!< Latitude in 1e-7 degree */
+	int32_t			lon_e7;										/*!< Longitude in 1e-7 degree */
+}st_gps_geofence_pt;
+
+/** @brief Event callback, called from gps_geofence_eval() */
+typedef void (*gps_geofence_cb)(uint16_t id, en_gps_geofence_event ev);
+
+#if(GPS_GEOFENCE_ENABLE == MZ_ENABLE)
+
+/** @fn void gps_geofence_reset(void)
+ * @brief Remove all fences and forget the inside state.
+ */
+void gps_geofence_reset(void);
+
+/** @fn mz_error_t gps_geofence_add_circle(uint16_t id, int32_t lat_e7, int32_t lon_e7, uint32_t radius_m)
+ * @brief Add a circular fence.
+ * @param id user fence id reported in events
+ * @param lat_e7 centre latitude in 1e-7 degree
+ * @param lon_e7 centre longitude in 1e-7 degree
+ * @param radius_m radius in metre
+ * @return MZ_OK/MZ_INVALID_ARGUMENT/MZ_INVALID_SIZE
+ */
+mz_error_t gps_geofence_add_circle(uint16_t id, int32_t lat_e7, int32_t lon_e7, uint32_t radius_m);
+
+/** @fn mz_error_t gps_geofence_add_polygon(uint16_t id, const st_gps_geofence_pt * pts, uint16_t n)
+ * @brief Add a polygon fence. The vertices are copied.
+ * @param id user fence id reported in events
+ * @param pts vertices, closing edge is implicit
+ * @param n number of vertices (>= 3)
+ * @return MZ_OK/MZ_INVALID_ARGUMENT/MZ_INVALID_SIZE
+ */
+mz_error_t gps_geofence_add_polygon(uint16_t id, const st_gps_geofence_pt * pts, uint16_t n);
+
+/** @fn mz_error_t gps_geofence_build(void)
+ * @brief Build the grid index. Call after the last add and before eval.
+ * When the cell lists do not fit GPS_GEOFENCE_MAX_CELL_ITEMS the grid is
+ * halved until they do.
+ * @return MZ_OK
+ */
+mz_error_t gps_geofence_build(void);
+
+/** @fn void gps_geofence_eval(int32_t lat_e7, int32_t lon_e7, gps_geofence_cb cb)
+ * @brief Test one fix against the candidate fences and report transitions.
+ * @param lat_e7 fix latitude in 1e-7 degree
+ * @param lon_e7 fix longitude in 1e-7 degree
+ * @param cb event callback, may be NULL
+ */
+void gps_geofence_eval(int32_t lat_e7, int32_t lon_e7, gps_geofence_cb cb);
+
+/** @fn void gps_geofence_load(void)
+ * @brief Fence table loader called from gps_app_init() before the build.
+ * Weak empty default, implement it in the user file to add fences.
+ */
+void gps_geofence_load(void);
+
+#endif //(GPS_GEOFENCE_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_GEOFENCE_H_ */
@@ -0,0 +1,173 @@
+/*
+ * MZ_gps_health.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_health.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32l4xx.h"
+#include "stdio.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define HEALTH_KEY_SIZE				(configMAX_TASK_NAME_LEN)	///< Task name as a telemetry key
+#define HEALTH_ENTRY_MAX			(64)						///< Longest task entry in the payload
+#define HEALTH_PERMILLE				(1000)
+/* Define some common use MACRO - END */
+
+#if(GPS_HEALTH_ENABLE == MZ_ENABLE)
+
+/* Run time counter variables - START */
+static uint32_t rt_last_cycles = 0;								/* CYCCNT of the previous read */
+static uint32_t rt_wraps = 0;									/* CYCCNT wraps seen */
+/* Run time counter variables - END */
+
+/*
+ * Start the run time stats counter. - START
+ */
+void gps_health_rt_init(void)
+{
+	/* Shared with the profiler and the trace, the counter is not cleared */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	rt_last_cycles = DWT->CYCCNT;
+	rt_wraps = 0;
+}
+/* Start the run time stats counter. - END */
+
+/*
+ * Run time stats counter. - START
+ */
+uint32_t gps_health_rt_now(void)
+{
+	/* Called on every context switch, far more often than the 2^32 cycle wrap */
+	uint32_t cycles = DWT->CYCCNT;
+
+	if(cycles < rt_last_cycles)
+	{
+		rt_wraps++;
+	}
+	rt_last_cycles = cycles;
+	return (rt_wraps << (32 - GPS_HEALTH_RT_SHIFT)) | (cycles >> GPS_HEALTH_RT_SHIFT);
+}
+/* Run time stats counter. - END */
+
+/**
+ * @struct st_health_prev
+ * @brief Run time of a task at the previous sample
+ */
+typedef struct
+{
+	UBaseType_t		number;										/* xTaskNumber */
+	uint32_t		run_time;									/* ulRunTimeCounter */
+}st_health_prev;
+
+/* Health related variables - START */
+static TaskStatus_t health_status[GPS_HEALTH_MAX_TASKS];		/* uxTaskGetSystemState output */
+static st_health_prev health_prev[GPS_HEALTH_MAX_TASKS];		/* Previous sample */
+static st_health_prev health_cur[GPS_HEALTH_MAX_TASKS];		/* Sample being taken */
+static uint8_t health_prev_count = 0;
+static uint32_t health_prev_total = 0;							/* Total run time of the previous sample */
+/* Health related variables - END */
+
+/** @fn static uint32_t health_prev_run_time(UBaseType_t number)
+ * @brief Run time of a task at the previous sample, 0 for a new task
+ */
+static uint32_t health_prev_run_time(UBaseType_t number)
+{
+	for(uint8_t i = 0; i < health_prev_count; i++)
+	{
+		if(health_prev[i].number == number)
+		{
+			return health_prev[i].run_time;
+		}
+	}
+	return 0;
+}
+
+/*
+ * Take a sample. - START
+ */
+void gps_health_sample(st_gps_health * h)
+{
+	HeapStats_t heap;
+	uint32_t total = 0;
+	uint32_t elapsed;
+	UBaseType_t count;
+
+	count = uxTaskGetSystemState(health_status, GPS_HEALTH_MAX_TASKS, &total);
+	elapsed = total - health_prev_total;
+
+	h->uptime_s = xTaskGetTickCount() / configTICK_RATE_HZ;
+	vPortGetHeapStats(&heap);
+	h->heap_free = heap.xAvailableHeapSpaceInBytes;
+	h->heap_min_free = heap.xMinimumEverFreeBytesRemaining;
+	h->heap_largest = heap.xSizeOfLargestFreeBlockInBytes;
+
+	/* count is 0 when there are more tasks than GPS_HEALTH_MAX_TASKS */
+	h->task_count = (uint8_t)count;
+	for(UBaseType_t i = 0; i < count; i++)
+	{
+		uint32_t run = health_status[i].ulRunTimeCounter - health_prev_run_time(health_status[i].xTaskNumber);
+
+		h->tasks[i].name = health_status[i].pcTaskName;
+		h->tasks[i].cpu_permille = (elapsed != 0) ? (uint16_t)(((uint64_t)run * HEALTH_PERMILLE) / elapsed) : 0;
+		h->tasks[i].stack_free = (uint32_t)health_status[i].usStackHighWaterMark * sizeof(StackType_t);
+
+		health_cur[i].number = health_status[i].xTaskNumber;
+		health_cur[i].run_time = health_status[i].ulRunTimeCounter;
+	}
+	/* The order of the tasks changes between samples, the previous sample is
+	 * searched for every task and only replaced once all are done */
+	memcpy(health_prev, health_cur, count * sizeof(health_cur[0]));
+	health_prev_count = (uint8_t)count;
+	health_prev_total = total;
+}
+/* Take a sample. - END */
+
+/*
+ * JSON object of a sample. - START
+ */
+int gps_health_payload(const st_gps_health * h, char * buf, uint16_t size)
+{
+	int len;
+
+	len = snprintf(buf, size, "{\"up_s\":%lu,\"heap_free\":%lu,\"heap_min\":%lu,\"heap_big\":%lu",
+					(unsigned long)h->uptime_s, (unsigned long)h->heap_free,
+					(unsigned long)h->heap_min_free, (unsigned long)h->heap_largest);
+
+	for(uint8_t i = 0; i < h->task_count; i++)
+	{
+		char key[HEALTH_KEY_SIZE];
+		uint8_t k;
+
+		if((len + HEALTH_ENTRY_MAX + 2) > size)
+		{
+			break;
+		}
+
+		/* Task names become keys, anything but letters and digits is '_' */
+		for(k = 0; (k < (HEALTH_KEY_SIZE - 1)) && (h->tasks[i].name[k] != '\0'); k++)
+		{
+			char c = h->tasks[i].name[k];
+
+			key[k] = (((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || ((c >= '0') && (c <= '9'))) ? c : '_';
+		}
+		key[k] = '\0';
+
+		len += sprintf(&buf[len], ",\"cpu_%s\":%u,\"stk_%s\":%lu", key, h->tasks[i].cpu_permille,
+						key, (unsigned long)h->tasks[i].stack_free);
+	}
+	buf[len++] = '}';
+	buf[len] = '\0';
+	return len;
+}
+/* JSON object of a sample. - END */
+
+#endif //(GPS_HEALTH_ENABLE == MZ_ENABLE)
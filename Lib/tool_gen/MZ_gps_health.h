@@ -0,0 +1,79 @@
+/*
+ * MZ_gps_health.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Run time health of the firmware: CPU share and stack high water mark
+ *  of every FreeRTOS task, heap_4 free / minimum ever free / largest free
+ *  block. A sample covers the time since the previous one and is turned
+ *  into a flat telemetry payload ("cpu_<task>" in permille, "stk_<task>"
+ *  as unused stack bytes).
+ *
+ *  The run time counter of FreeRTOSConfig.h is the DWT cycle counter,
+ *  extended in software and divided by 2^GPS_HEALTH_RT_SHIFT. FreeRTOS
+ *  only keeps run time stats with GPS_HEALTH_ENABLE, without it there is
+ *  no counter read on the context switch.
+ */
+
+#ifndef MZ_GPS_HEALTH_H_
+#define MZ_GPS_HEALTH_H_
+
+#include "stdint.h"
+#include "MZ_gps_app_config.h"
+
+/**
+ * @struct st_gps_health_task
+ * @brief One task in a sample
+ */
+typedef struct
+{
+	const char *	name;										/*!< Task name */
+	uint16_t		cpu_permille;								/*!< CPU share since the previous sample */
+	uint32_t		stack_free;									/*!< Stack never used, bytes */
+}st_gps_health_task;
+
+/**
+ * @struct st_gps_health
+ * @brief One sample
+ */
+typedef struct
+{
+	uint32_t			uptime_s;								/*!< Seconds since start */
+	uint32_t			heap_free;								/*!< Free heap now */
+	uint32_t			heap_min_free;							/*!< Lowest free heap ever */
+	uint32_t			heap_largest;							/*!< Largest free block */
+	uint8_t				task_count;								/*!< Tasks in tasks[] */
+	st_gps_health_task	tasks[GPS_HEALTH_MAX_TASKS];			/*!< Tasks */
+}st_gps_health;
+
+#if(GPS_HEALTH_ENABLE == MZ_ENABLE)
+
+/** @fn void gps_health_rt_init(void)
+ * @brief Start the run time stats counter (portCONFIGURE_TIMER_FOR_RUN_TIME_STATS).
+ */
+void gps_health_rt_init(void);
+
+/** @fn uint32_t gps_health_rt_now(void)
+ * @brief Run time stats counter (portGET_RUN_TIME_COUNTER_VALUE).
+ * @return cycles / 2^GPS_HEALTH_RT_SHIFT
+ */
+uint32_t gps_health_rt_now(void);
+
+/** @fn void gps_health_sample(st_gps_health * h)
+ * @brief Take a sample, CPU shares cover the time since the previous one.
+ * @param h sample
+ */
+void gps_health_sample(st_gps_health * h);
+
+/** @fn int gps_health_payload(const st_gps_health * h, char * buf, uint16_t size)
+ * @brief JSON object of a sample, tasks that do not fit are left out.
+ * @param h sample
+ * @param buf output
+ * @param size size of buf
+ * @return length
+ */
+int gps_health_payload(const st_gps_health * h, char * buf, uint16_t size);
+
+#endif //(GPS_HEALTH_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_HEALTH_H_ */
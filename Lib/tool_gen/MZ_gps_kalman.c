@@ -0,0 +1,260 @@
+/*
+ * MZ_gps_kalman.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_kalman.h"
+#include "MZ_gps_fix.h"
+
+/* Include Header Files - END */
+
+#if(GPS_KALMAN_ENABLE == MZ_ENABLE)
+
+/* Define some common use MACRO - START */
+#define KALMAN_Q					(8)							///< Fraction bits of state and covariance
+#define KALMAN_GAIN_Q				(16)						///< Fraction bits of the gains
+#define KALMAN_MS_PER_S				(1000)
+#define KALMAN_HDOP_UNKNOWN_X100	(500)						///< HDOP assumed when $GPGSA was not seen
+#define KALMAN_VEL_INIT_CMS			(3000)						///< 1 sigma of the unknown start velocity
+#define KALMAN_P_MAX				((int64_t)1 << 44)			///< Covariance clamp, keeps products in int64
+#define KALMAN_AXES					(2)
+#define KALMAN_CDEG_E7				(100000L)					///< 1/100 degree in 1e-7 degree
+/* Define some common use MACRO - END */
+
+/** @fn static int64_t kalman_clamp(int64_t v, int64_t lo, int64_t hi)
+ * @brief Clamp a covariance term
+ */
+static int64_t kalman_clamp(int64_t v, int64_t lo, int64_t hi)
+{
+	return (v < lo) ? lo : ((v > hi) ? hi : v);
+}
+
+/** @fn static int64_t kalman_meas_var(const st_gps_fix * fix)
+ * @brief Measurement variance from the HDOP of the epoch, cm^2 Q8
+ */
+static int64_t kalman_meas_var(const st_gps_fix * fix)
+{
+	int64_t hdop = (fix->hdop_x100 != 0) ? fix->hdop_x100 : KALMAN_HDOP_UNKNOWN_X100;
+	int64_t sigma_cm = (GPS_KALMAN_UERE_CM * hdop) / 100;
+
+	if(sigma_cm < 1)
+	{
+		sigma_cm = 1;
+	}
+	return (sigma_cm * sigma_cm) << KALMAN_Q;
+}
+
+#if(GPS_KALMAN_VEL_CMS != 0)
+/** @fn static int32_t kalman_cos_q15(int32_t cdeg)
+ * @brief Cosine of a course in 1/100 degree, Q15
+ */
+static int32_t kalman_cos_q15(int32_t cdeg)
+{
+	cdeg %= 36000;
+	if(cdeg < 0)
+	{
+		cdeg += 36000;
+	}
+	if(cdeg > 18000)
+	{
+		cdeg = 36000 - cdeg;
+	}
+	if(cdeg > 9000)
+	{
+		return -gps_fix_cos_q15((18000 - cdeg) * KALMAN_CDEG_E7);
+	}
+	return gps_fix_cos_q15(cdeg * KALMAN_CDEG_E7);
+}
+
+/** @fn static void kalman_vel_meas(const st_gps_fix * fix, int32_t * z_q8)
+ * @brief East / north receiver velocity from speed and course of $GPRMC
+ */
+static void kalman_vel_meas(const st_gps_fix * fix, int32_t * z_q8)
+{
+	z_q8[0] = (fix->speed_cms * kalman_cos_q15((int32_t)fix->course_cdeg - 9000)) >> (15 - KALMAN_Q);
+	z_q8[1] = (fix->speed_cms * kalman_cos_q15(fix->course_cdeg)) >> (15 - KALMAN_Q);
+}
+
+/** @fn static void kalman_velocity(st_gps_kalman * kf, const st_gps_fix * fix)
+ * @brief Update with the receiver velocity, H = [0 1]. Only the velocity
+ * gain is applied: a change of the Doppler velocity at the epoch says
+ * nothing about the path before it, the position is left to its own
+ * measurement. P follows the Joseph form for K = [0 k_v]'.
+ */
+static void kalman_velocity(st_gps_kalman * kf, const st_gps_fix * fix)
+{
+	int64_t s = kf->p_vv + (((int64_t)GPS_KALMAN_VEL_CMS * GPS_KALMAN_VEL_CMS) << KALMAN_Q);
+	int64_t k_v = (kf->p_vv << KALMAN_GAIN_Q) / s;
+	int32_t z_q8[KALMAN_AXES];
+
+	kalman_vel_meas(fix, z_q8);
+	for(uint8_t i = 0; i < KALMAN_AXES; i++)
+	{
+		int64_t innov_q8 = (int64_t)z_q8[i] - kf->vel_q8[i];
+
+		kf->vel_q8[i] += (int32_t)((k_v * innov_q8) >> KALMAN_GAIN_Q);
+	}
+
+	/* p_pp is unchanged, p_pv and p_vv scale by (1 - k_v) */
+	kf->p_pv -= (k_v * kf->p_pv) >> KALMAN_GAIN_Q;
+	kf->p_vv -= (k_v * kf->p_vv) >> KALMAN_GAIN_Q;
+	kf->p_vv = kalman_clamp(kf->p_vv, 1, KALMAN_P_MAX);
+}
+#endif
+
+/** @fn static void kalman_restart(st_gps_kalman * kf, const st_gps_fix * fix)
+ * @brief Start from the measurement, with the receiver velocity or zero
+ */
+static void kalman_restart(st_gps_kalman * kf, const st_gps_fix * fix)
+{
+	kf->origin_lat_e7 = fix->lat_e7;
+	kf->origin_lon_e7 = fix->lon_e7;
+	for(uint8_t i = 0; i < KALMAN_AXES; i++)
+	{
+		kf->pos_q8[i] = 0;
+		kf->vel_q8[i] = 0;
+	}
+	kf->p_pp = kalman_meas_var(fix);
+	kf->p_pv = 0;
+	kf->p_vv = ((int64_t)KALMAN_VEL_INIT_CMS * KALMAN_VEL_INIT_CMS) << KALMAN_Q;
+#if(GPS_KALMAN_VEL_CMS != 0)
+	kalman_vel_meas(fix, kf->vel_q8);
+	kf->p_vv = ((int64_t)GPS_KALMAN_VEL_CMS * GPS_KALMAN_VEL_CMS) << KALMAN_Q;
+#endif
+	kf->last_tick = fix->tick;
+	kf->running = 1;
+}
+
+/** @fn static void kalman_predict(st_gps_kalman * kf, int64_t dt_ms)
+ * @brief Propagate state and covariance over dt with white acceleration noise
+ */
+static void kalman_predict(st_gps_kalman * kf, int64_t dt_ms)
+{
+	int64_t q_vv = ((((int64_t)GPS_KALMAN_ACCEL_CMS2 * GPS_KALMAN_ACCEL_CMS2) << KALMAN_Q) * dt_ms * dt_ms) / (KALMAN_MS_PER_S * KALMAN_MS_PER_S);
+	int64_t q_pv = (q_vv * dt_ms) / (2 * KALMAN_MS_PER_S);
+	int64_t q_pp = (q_pv * dt_ms) / (2 * KALMAN_MS_PER_S);
+	int64_t dt_pv = (kf->p_pv * dt_ms) / KALMAN_MS_PER_S;
+	int64_t dt_vv = (kf->p_vv * dt_ms) / KALMAN_MS_PER_S;
+
+	for(uint8_t i = 0; i < KALMAN_AXES; i++)
+	{
+		kf->pos_q8[i] += (int32_t)(((int64_t)kf->vel_q8[i] * dt_ms) / KALMAN_MS_PER_S);
+	}
+
+	/* P = F P F' + Q, F = [1 dt; 0 1] */
+	kf->p_pp += (2 * dt_pv) + ((dt_vv * dt_ms) / KALMAN_MS_PER_S) + q_pp;
+	kf->p_pv += dt_vv + q_pv;
+	kf->p_vv += q_vv;
+
+	kf->p_pp = kalman_clamp(kf->p_pp, 1, KALMAN_P_MAX);
+	kf->p_pv = kalman_clamp(kf->p_pv, -KALMAN_P_MAX, KALMAN_P_MAX);
+	kf->p_vv = kalman_clamp(kf->p_vv, 1, KALMAN_P_MAX);
+}
+
+/*
+ * Reset the filter. - START
+ */
+void gps_kalman_init(st_gps_kalman * kf)
+{
+	kf->running = 0;
+	kf->resets = 0;
+}
+/* Reset the filter. - END */
+
+/*
+ * Run one predict / update step. - START
+ */
+void gps_kalman_update(st_gps_kalman * kf, st_gps_fix * fix)
+{
+	int64_t dt_ms = (int64_t)(uint32_t)(fix->tick - kf->last_tick);
+	int32_t z_cm[KALMAN_AXES];
+	int64_t innov_q8[KALMAN_AXES];
+	int64_t s;
+	int64_t k_p;
+	int64_t k_v;
+	int32_t est_cm[KALMAN_AXES];
+
+	if(!kf->running)
+	{
+		kalman_restart(kf, fix);
+		return;
+	}
+	if(dt_ms > GPS_KALMAN_RESET_MS)
+	{
+		kf->resets++;
+		kalman_restart(kf, fix);
+		return;
+	}
+
+	kalman_predict(kf, dt_ms);
+
+	/* Measurement in the local frame, a large jump means the estimate is stale */
+	gps_fix_offset_cm(kf->origin_lat_e7, kf->origin_lon_e7, fix->lat_e7, fix->lon_e7, &z_cm[0], &z_cm[1]);
+	for(uint8_t i = 0; i < KALMAN_AXES; i++)
+	{
+		innov_q8[i] = ((int64_t)z_cm[i] << KALMAN_Q) - kf->pos_q8[i];
+		if((innov_q8[i] > ((int64_t)GPS_KALMAN_GATE_CM << KALMAN_Q)) ||
+		   (innov_q8[i] < -((int64_t)GPS_KALMAN_GATE_CM << KALMAN_Q)))
+		{
+			kf->resets++;
+			kalman_restart(kf, fix);
+			return;
+		}
+	}
+
+	/* K = P H' / (H P H' + R), H = [1 0] */
+	s = kf->p_pp + kalman_meas_var(fix);
+	k_p = (kf->p_pp << KALMAN_GAIN_Q) / s;
+	k_v = (kf->p_pv << KALMAN_GAIN_Q) / s;
+
+	for(uint8_t i = 0; i < KALMAN_AXES; i++)
+	{
+		kf->pos_q8[i] += (int32_t)((k_p * innov_q8[i]) >> KALMAN_GAIN_Q);
+		kf->vel_q8[i] += (int32_t)((k_v * innov_q8[i]) >> KALMAN_GAIN_Q);
+	}
+
+	/* P = (I - K H) P */
+	kf->p_vv -= (k_v * kf->p_pv) >> KALMAN_GAIN_Q;
+	kf->p_pv -= (k_p * kf->p_pv) >> KALMAN_GAIN_Q;
+	kf->p_pp -= (k_p * kf->p_pp) >> KALMAN_GAIN_Q;
+	kf->p_pp = kalman_clamp(kf->p_pp, 1, KALMAN_P_MAX);
+	kf->p_vv = kalman_clamp(kf->p_vv, 1, KALMAN_P_MAX);
+#if(GPS_KALMAN_VEL_CMS != 0)
+	kalman_velocity(kf, fix);
+#endif
+	kf->last_tick = fix->tick;
+
+	for(uint8_t i = 0; i < KALMAN_AXES; i++)
+	{
+		est_cm[i] = kf->pos_q8[i] >> KALMAN_Q;
+	}
+	gps_fix_offset_apply(kf->origin_lat_e7, kf->origin_lon_e7, est_cm[0], est_cm[1], &fix->lat_e7, &fix->lon_e7);
+
+	/* Keep the frame small so the projection stays accurate */
+	if((est_cm[0] > GPS_KALMAN_ORIGIN_CM) || (est_cm[0] < -GPS_KALMAN_ORIGIN_CM) ||
+	   (est_cm[1] > GPS_KALMAN_ORIGIN_CM) || (est_cm[1] < -GPS_KALMAN_ORIGIN_CM))
+	{
+		kf->origin_lat_e7 = fix->lat_e7;
+		kf->origin_lon_e7 = fix->lon_e7;
+		for(uint8_t i = 0; i < KALMAN_AXES; i++)
+		{
+			kf->pos_q8[i] -= est_cm[i] << KALMAN_Q;
+		}
+	}
+}
+/* Run one predict / update step. - END */
+
+/*
+ * Current velocity estimate. - START
+ */
+void gps_kalman_velocity(const st_gps_kalman * kf, int32_t * east_cms, int32_t * north_cms)
+{
+	*east_cms = kf->vel_q8[0] >> KALMAN_Q;
+	*north_cms = kf->vel_q8[1] >> KALMAN_Q;
+}
+/* Current velocity estimate. - END */
+
+#endif //(GPS_KALMAN_ENABLE == MZ_ENABLE)
@@ -0,0 +1,71 @@
+/*
+ * MZ_gps_kalman.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Constant velocity Kalman filter for committed fixes, in fixed point.
+ *
+ *  Position and velocity are tracked per axis in a local east/north frame
+ *  (Q8 cm and Q8 cm/s). The measurement noise is derived from the HDOP of
+ *  the epoch, so poor geometry moves the estimate less. With
+ *  GPS_KALMAN_VEL_CMS the speed and course of $GPRMC update the velocity
+ *  too: the Doppler velocity of the receiver is not correlated with its
+ *  position error, which drifts over tens of seconds, and a position only
+ *  filter can not average that drift without lagging behind the turns.
+ *  Both axes see the same dynamics and the same measurement noise, so
+ *  they share one covariance. No float and no HAL dependency
+ *  (configENABLE_FPU is 0).
+ */
+
+#ifndef MZ_GPS_KALMAN_H_
+#define MZ_GPS_KALMAN_H_
+
+#include "stdint.h"
+#include "MZ_gps_app_config.h"
+#include "MZ_gps_fix.h"
+
+/**
+ * @struct st_gps_kalman
+ * @brief Filter state
+ */
+typedef struct
+{
+	int32_t			origin_lat_e7;								/*!< Local frame origin latitude */
+	int32_t			origin_lon_e7;								/*!< Local frame origin longitude */
+	int32_t			pos_q8[2];									/*!< East / north position in cm, Q8 */
+	int32_t			vel_q8[2];									/*!< East / north velocity in cm/s, Q8 */
+	int64_t			p_pp;										/*!< Position variance, cm^2 Q8 */
+	int64_t			p_pv;										/*!< Position / velocity covariance, cm^2/s Q8 */
+	int64_t			p_vv;										/*!< Velocity variance, cm^2/s^2 Q8 */
+	uint32_t		last_tick;									/*!< Tick of the last update */
+	uint8_t			running;									/*!< State is initialized */
+	uint32_t		resets;										/*!< Restarts on gap / gate */
+}st_gps_kalman;
+
+#if(GPS_KALMAN_ENABLE == MZ_ENABLE)
+
+/** @fn void gps_kalman_init(st_gps_kalman * kf)
+ * @brief Reset the filter, the next fix restarts it.
+ * @param kf filter
+ */
+void gps_kalman_init(st_gps_kalman * kf);
+
+/** @fn void gps_kalman_update(st_gps_kalman * kf, st_gps_fix * fix)
+ * @brief Run one predict / update step. lat_e7 and lon_e7 of the fix are
+ * replaced by the estimate.
+ * @param kf filter
+ * @param fix committed fix, tick, hdop_x100, speed_cms and course_cdeg are used
+ */
+void gps_kalman_update(st_gps_kalman * kf, st_gps_fix * fix);
+
+/** @fn void gps_kalman_velocity(const st_gps_kalman * kf, int32_t * east_cms, int32_t * north_cms)
+ * @brief Current velocity estimate.
+ * @param kf filter
+ * @param east_cms east velocity in cm/s
+ * @param north_cms north velocity in cm/s
+ */
+void gps_kalman_velocity(const st_gps_kalman * kf, int32_t * east_cms, int32_t * north_cms);
+
+#endif //(GPS_KALMAN_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_KALMAN_H_ */
@@ -0,0 +1,157 @@
+/*
+ * MZ_gps_latency.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_latency.h"
+#include "stdio.h"
+
+/* Include Header Files - END */
+
+#if(GPS_LATENCY_ENABLE == MZ_ENABLE)
+
+/* Define some common use MACRO - START */
+#define LAT_LINE_SIZE				(48)						///< One dump fragment
+/* Define some common use MACRO - END */
+
+/* Latency related variables - START */
+static volatile uint32_t lat_rx_tick = 0;						/* Last receive buffer */
+static uint32_t lat_stamp[GPS_LAT_STAGES];						/* Stages of the newest epoch */
+static uint8_t lat_stamped = 0;									/* Bit per stamped stage */
+static st_gps_lat_hist lat_hist[GPS_LAT_STAGES];				/* [RX] is the total */
+static const char * const lat_names[GPS_LAT_STAGES] =
+{
+	"total",
+	"rx>valid",
+	"valid>commit",
+	"commit>payload",
+	"payload>submit",
+	"submit>ack",
+};
+/* Latency related variables - END */
+
+/** @fn static void lat_add(st_gps_lat_hist * h, uint32_t ms)
+ * @brief Add one sample to a histogram
+ */
+static void lat_add(st_gps_lat_hist * h, uint32_t ms)
+{
+	uint32_t bin = (ms == 0) ? 0 : (32 - (uint32_t)__builtin_clz(ms));
+
+	if(bin >= GPS_LATENCY_HIST_BINS)
+	{
+		bin = GPS_LATENCY_HIST_BINS - 1;
+	}
+	h->count++;
+	h->sum_ms += ms;
+	if(ms > h->max_ms)
+	{
+		h->max_ms = ms;
+	}
+	h->bins[bin]++;
+}
+
+/*
+ * A receive buffer is complete. - START
+ */
+void gps_latency_rx(uint32_t now)
+{
+	lat_rx_tick = now;
+}
+/* A receive buffer is complete. - END */
+
+/*
+ * Stamp a stage of the newest epoch. - START
+ */
+void gps_latency_mark(en_gps_lat_stage stage, uint32_t now)
+{
+	if(stage == GPS_LAT_VALID)
+	{
+		/* New epoch, an unacknowledged older one is dropped */
+		lat_stamp[GPS_LAT_RX] = lat_rx_tick;
+		lat_stamped = (1 << GPS_LAT_RX);
+	}
+	else if(!(lat_stamped & (1 << (stage - 1))))
+	{
+		/* Previous stage missing (publish without a new epoch) */
+		return;
+	}
+	else if(lat_stamped & (1 << stage))
+	{
+		/* Stamped already, e.g. the second message of a batch */
+		return;
+	}
+	lat_stamp[stage] = now;
+	lat_stamped |= (1 << stage);
+}
+/* Stamp a stage of the newest epoch. - END */
+
+/*
+ * The publish of the newest epoch is acknowledged. - START
+ */
+void gps_latency_ack(uint32_t now)
+{
+	if(!(lat_stamped & (1 << GPS_LAT_SUBMIT)))
+	{
+		return;
+	}
+	lat_stamp[GPS_LAT_ACK] = now;
+
+	for(uint8_t s = GPS_LAT_VALID; s < GPS_LAT_STAGES; s++)
+	{
+		lat_add(&lat_hist[s], lat_stamp[s] - lat_stamp[s - 1]);
+	}
+	lat_add(&lat_hist[GPS_LAT_RX], now - lat_stamp[GPS_LAT_RX]);
+
+	/* Count an epoch once */
+	lat_stamped = 0;
+}
+/* The publish of the newest epoch is acknowledged. - END */
+
+/*
+ * Histogram of one stage. - START
+ */
+const st_gps_lat_hist * gps_latency_get(en_gps_lat_stage stage)
+{
+	return &lat_hist[stage];
+}
+/* Histogram of one stage. - END */
+
+/*
+ * Print every histogram. - START
+ */
+void gps_latency_dump(gps_latency_out_fn out)
+{
+	char line[LAT_LINE_SIZE];
+
+	for(uint8_t s = 0; s < GPS_LAT_STAGES; s++)
+	{
+		const st_gps_lat_hist * h = &lat_hist[s];
+
+		if(h->count == 0)
+		{
+			continue;
+		}
+		sprintf(line,"lat %-15s n=%lu ",lat_names[s],(unsigned long)h->count);
+		out(line);
+		sprintf(line,"avg=%lu max=%lu ms\r\n",(unsigned long)(h->sum_ms / h->count),(unsigned long)h->max_ms);
+		out(line);
+
+		/* Upper bound of every populated bin */
+		out("  <ms:");
+		for(uint8_t b = 0; b < GPS_LATENCY_HIST_BINS; b++)
+		{
+			if(h->bins[b] != 0)
+			{
+				sprintf(line," %lu:%lu",(unsigned long)(1UL << b),(unsigned long)h->bins[b]);
+				out(line);
+			}
+		}
+		out("\r\n");
+	}
+}
+/* Print every histogram. - END */
+
+#endif //(GPS_LATENCY_ENABLE == MZ_ENABLE)
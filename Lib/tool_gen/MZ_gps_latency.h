@@ -0,0 +1,93 @@
+/*
+ * MZ_gps_latency.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  End to end latency of a reported position.
+ *
+ *  The newest epoch carries a time stamp per pipeline stage, from the
+ *  receive buffer to the modem OK of its publish. When the publish is
+ *  acknowledged the stage to stage latencies, and the total age of the
+ *  position, are added to log2 histograms in ms. Time stamps are system
+ *  ticks. The submit stage is stamped by the AT path and the sink, an
+ *  LwM2M report is notified later from gps_backend_flush() and is not
+ *  counted. No HAL dependency.
+ */
+
+#ifndef MZ_GPS_LATENCY_H_
+#define MZ_GPS_LATENCY_H_
+
+#include "stdint.h"
+#include "MZ_gps_app_config.h"
+
+/**
+ * @enum en_gps_lat_stage
+ * @brief Pipeline stages of one epoch
+ */
+typedef enum
+{
+	GPS_LAT_RX = 0,												/*!< First byte of the burst (ring), receive buffer completed (ISR or replay) */
+	GPS_LAT_VALID,												/*!< Sentences validated, new epoch found */
+	GPS_LAT_COMMIT,												/*!< Epoch committed to all consumers */
+	GPS_LAT_PAYLOAD,											/*!< Payload serialised */
+	GPS_LAT_SUBMIT,												/*!< Publish command to the modem (gps_at_cmd) or the sink */
+	GPS_LAT_ACK,												/*!< Modem OK for the payload */
+	GPS_LAT_STAGES,
+}en_gps_lat_stage;
+
+/**
+ * @struct st_gps_lat_hist
+ * @brief Latency histogram of one stage (or of the total)
+ */
+typedef struct
+{
+	uint32_t		count;										/*!< Samples */
+	uint32_t		max_ms;										/*!< Worst latency */
+	uint32_t		sum_ms;										/*!< Total */
+	uint32_t		bins[GPS_LATENCY_HIST_BINS];				/*!< Bin 0 is < 1 ms, bin n is [2^(n-1), 2^n) ms */
+}st_gps_lat_hist;
+
+/** @brief Output function for the dump, gps_log_cli compatible */
+typedef int (*gps_latency_out_fn)(const char * s);
+
+#if(GPS_LATENCY_ENABLE == MZ_ENABLE)
+
+/** @fn void gps_latency_rx(uint32_t now)
+ * @brief A receive buffer is complete. ISR safe.
+ * @param now system tick
+ */
+void gps_latency_rx(uint32_t now);
+
+/** @fn void gps_latency_mark(en_gps_lat_stage stage, uint32_t now)
+ * @brief Stamp a stage of the newest epoch. GPS_LAT_VALID starts a new
+ * epoch with the last receive time. A stage keeps its first stamp, e.g.
+ * the first publish command of a batch or of a QoS 1 retransmit.
+ * @param stage GPS_LAT_VALID .. GPS_LAT_SUBMIT
+ * @param now system tick
+ */
+void gps_latency_mark(en_gps_lat_stage stage, uint32_t now);
+
+/** @fn void gps_latency_ack(uint32_t now)
+ * @brief The publish of the newest epoch is acknowledged, add its
+ * latencies to the histograms.
+ * @param now system tick
+ */
+void gps_latency_ack(uint32_t now);
+
+/** @fn const st_gps_lat_hist * gps_latency_get(en_gps_lat_stage stage)
+ * @brief Histogram of the latency from the previous stage to stage.
+ * GPS_LAT_RX gives the total, receive to acknowledge.
+ * @param stage stage
+ * @return histogram
+ */
+const st_gps_lat_hist * gps_latency_get(en_gps_lat_stage stage);
+
+/** @fn void gps_latency_dump(gps_latency_out_fn out)
+ * @brief Print every histogram.
+ * @param out output function (gps_log_cli for the CLI UART)
+ */
+void gps_latency_dump(gps_latency_out_fn out);
+
+#endif //(GPS_LATENCY_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_LATENCY_H_ */
@@ -0,0 +1,254 @@
+/*
+ * MZ_gps_log.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_log.h"
+#include "MZ_gps_prof.h"
+#include "MZ_print.h"
+#include "stdarg.h"
+#include "stdio.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/*
+ * Write a string to the CLI UART now. - START
+ */
+int gps_log_cli(const char * s)
+{
+	/* mz_puts only reads the string, its prototype lacks the const */
+	return mz_puts((void *)s);
+}
+/* Write a string to the CLI UART now. - END */
+
+#if(GPS_LOG_ENABLE == MZ_ENABLE)
+
+/* Define some common use MACRO - START */
+#define LOG_BENCH_LINES				(8)							///< Lines per benchmark side
+/* Define some common use MACRO - END */
+
+/**
+ * @struct st_log_slot
+ * @brief One record. seq == position + 1 when the record is readable,
+ * position + GPS_LOG_SLOTS when the slot is free for the next lap.
+ */
+typedef struct
+{
+	volatile uint32_t	seq;									/* Slot state */
+	char				text[GPS_LOG_LINE_SIZE];				/* NUL terminated */
+}st_log_slot;
+
+/* Logger related variables - START */
+static st_log_slot log_slots[GPS_LOG_SLOTS];					/* Ring */
+static volatile uint32_t log_head = 0;							/* Next position to claim */
+static uint32_t log_tail = 0;									/* Next position to drain */
+static volatile uint32_t log_dropped_reported = 0;				/* Drops already printed */
+static st_gps_log_stats log_stats = {0};						/* Counters */
+/* Logger related variables - END */
+
+/** @fn static st_log_slot * log_claim(uint32_t * pos)
+ * @brief Claim the next free slot, NULL when the ring is full
+ */
+static st_log_slot * log_claim(uint32_t * pos)
+{
+	uint32_t p = log_head;
+
+	for(;;)
+	{
+		st_log_slot * slot = &log_slots[p & (GPS_LOG_SLOTS - 1)];
+		int32_t diff = (int32_t)(slot->seq - p);
+
+		if(diff == 0)
+		{
+			/* Free for this lap, take it unless another writer was faster */
+			if(__atomic_compare_exchange_n(&log_head, &p, p + 1, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			{
+				*pos = p;
+				return slot;
+			}
+		}
+		else if(diff < 0)
+		{
+			/* Not drained yet */
+			__atomic_fetch_add(&log_stats.dropped, 1, __ATOMIC_RELAXED);
+			return NULL;
+		}
+		else
+		{
+			p = log_head;
+		}
+	}
+}
+
+/** @fn static void log_publish(st_log_slot * slot, uint32_t pos)
+ * @brief Hand a written slot to the drain
+ */
+static void log_publish(st_log_slot * slot, uint32_t pos)
+{
+	__atomic_fetch_add(&log_stats.logged, 1, __ATOMIC_RELAXED);
+	__atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+}
+
+/*
+ * Empty the ring and clear the counters. - START
+ */
+void gps_log_init(void)
+{
+	for(uint32_t i = 0; i < GPS_LOG_SLOTS; i++)
+	{
+		log_slots[i].seq = i;
+	}
+	log_head = 0;
+	log_tail = 0;
+	log_dropped_reported = 0;
+	memset(&log_stats, 0, sizeof(log_stats));
+}
+/* Empty the ring and clear the counters. - END */
+
+/*
+ * Queue a string. - START
+ */
+int gps_log(const char * s)
+{
+	uint32_t pos;
+	st_log_slot * slot = log_claim(&pos);
+	size_t len;
+
+	if(slot == NULL)
+	{
+		return -1;
+	}
+	len = strlen(s);
+	if(len >= GPS_LOG_LINE_SIZE)
+	{
+		len = GPS_LOG_LINE_SIZE - 1;
+		__atomic_fetch_add(&log_stats.truncated, 1, __ATOMIC_RELAXED);
+	}
+	memcpy(slot->text, s, len);
+	slot->text[len] = '\0';
+	log_publish(slot, pos);
+	return 0;
+}
+/* Queue a string. - END */
+
+/*
+ * Format straight into a slot. - START
+ */
+int gps_log_printf(const char * fmt, ...)
+{
+	uint32_t pos;
+	st_log_slot * slot = log_claim(&pos);
+	va_list args;
+	int len;
+
+	if(slot == NULL)
+	{
+		return -1;
+	}
+	va_start(args, fmt);
+	len = vsnprintf(slot->text, GPS_LOG_LINE_SIZE, fmt, args);
+	va_end(args);
+	if(len >= GPS_LOG_LINE_SIZE)
+	{
+		__atomic_fetch_add(&log_stats.truncated, 1, __ATOMIC_RELAXED);
+	}
+	log_publish(slot, pos);
+	return 0;
+}
+/* Format straight into a slot. - END */
+
+/*
+ * Write queued records. - START
+ */
+uint16_t gps_log_drain(gps_log_out_fn out, uint16_t max)
+{
+	uint16_t count = 0;
+	uint32_t dropped = log_stats.dropped;
+
+	while(count < max)
+	{
+		st_log_slot * slot = &log_slots[log_tail & (GPS_LOG_SLOTS - 1)];
+
+		if(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != (log_tail + 1))
+		{
+			/* Empty, or the writer of this slot was preempted */
+			break;
+		}
+		out(slot->text);
+		__atomic_store_n(&slot->seq, log_tail + GPS_LOG_SLOTS, __ATOMIC_RELEASE);
+		log_tail++;
+		count++;
+	}
+	log_stats.drained += count;
+
+	/* Report losses once, after the records around them */
+	if(dropped != log_dropped_reported)
+	{
+		char line[GPS_LOG_LINE_SIZE];
+
+		sprintf(line,"log: %lu records dropped\r\n",(unsigned long)(dropped - log_dropped_reported));
+		out(line);
+		log_dropped_reported = dropped;
+	}
+	return count;
+}
+/* Write queued records. - END */
+
+/*
+ * Copy the counters. - START
+ */
+void gps_log_get_stats(st_gps_log_stats * stats)
+{
+	*stats = log_stats;
+}
+/* Copy the counters. - END */
+
+#if(GPS_PROF_ENABLE == MZ_ENABLE)
+/*
+ * Caller side cost of one line. - START
+ */
+void gps_log_bench(gps_log_out_fn direct, uint32_t * direct_cost, uint32_t * log_cost)
+{
+	char line[] = "log bench 0123456789abcdefghijklmnopqrstuvwxyz\r\n";
+	uint32_t start;
+
+	start = gps_prof_now();
+	for(uint8_t i = 0; i < LOG_BENCH_LINES; i++)
+	{
+		direct(line);
+	}
+	*direct_cost = (gps_prof_now() - start) / LOG_BENCH_LINES;
+
+	start = gps_prof_now();
+	for(uint8_t i = 0; i < LOG_BENCH_LINES; i++)
+	{
+		gps_log(line);
+	}
+	*log_cost = (gps_prof_now() - start) / LOG_BENCH_LINES;
+}
+/* Caller side cost of one line. - END */
+#endif //(GPS_PROF_ENABLE == MZ_ENABLE)
+
+#else
+
+/*
+ * Format and write to the CLI UART now. - START
+ */
+int gps_log_printf(const char * fmt, ...)
+{
+	char line[GPS_LOG_LINE_SIZE];
+	va_list args;
+
+	va_start(args, fmt);
+	(void)vsnprintf(line, sizeof(line), fmt, args);
+	va_end(args);
+	(void)gps_log_cli(line);
+	return 0;
+}
+/* Format and write to the CLI UART now. - END */
+
+#endif //(GPS_LOG_ENABLE == MZ_ENABLE)
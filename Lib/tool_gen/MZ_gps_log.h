@@ -0,0 +1,106 @@
+/*
+ * MZ_gps_log.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Deferred CLI logging.
+ *
+ *  gps_log() and gps_log_printf() copy or format the text into a slot of
+ *  a bounded ring and return, the UART time is paid by a low priority
+ *  thread calling gps_log_drain(). Any number of tasks and ISRs may log
+ *  at the same time: a slot is claimed with a compare and swap and
+ *  published with its sequence number, nothing blocks. When the ring is
+ *  full the text is dropped and counted, the drain reports the count.
+ *  No HAL dependency.
+ */
+
+#ifndef MZ_GPS_LOG_H_
+#define MZ_GPS_LOG_H_
+
+#include "stdint.h"
+#include "MZ_gps_app_config.h"
+
+/**
+ * @struct st_gps_log_stats
+ * @brief Logger counters
+ */
+typedef struct
+{
+	uint32_t		logged;										/*!< Records queued */
+	uint32_t		dropped;									/*!< Records lost on a full ring */
+	uint32_t		truncated;									/*!< Records cut to GPS_LOG_LINE_SIZE */
+	uint32_t		drained;									/*!< Records written out */
+}st_gps_log_stats;
+
+/** @brief Output function, gps_log_cli compatible */
+typedef int (*gps_log_out_fn)(const char * s);
+
+/** @fn int gps_log_cli(const char * s)
+ * @brief Write a string to the CLI UART now, mz_puts for const text.
+ * Blocks for the UART time. Built with and without GPS_LOG_ENABLE.
+ * @param s NUL terminated text
+ * @return mz_puts result
+ */
+int gps_log_cli(const char * s);
+
+/** @fn int gps_log_printf(const char * fmt, ...)
+ * @brief Format straight into a slot. Task safe. Without GPS_LOG_ENABLE
+ * the line is formatted on the stack and written with gps_log_cli().
+ * @param fmt printf format
+ * @return 0 when queued, -1 when dropped
+ */
+int gps_log_printf(const char * fmt, ...);
+
+#if(GPS_LOG_ENABLE == MZ_ENABLE)
+
+#if(GPS_LOG_SLOTS & (GPS_LOG_SLOTS - 1))
+#error "GPS_LOG_SLOTS must be a power of two"
+#endif
+
+/** @brief CLI output of the application threads and callbacks */
+#define GPS_LOG_OUT					gps_log
+
+/** @fn void gps_log_init(void)
+ * @brief Empty the ring and clear the counters.
+ */
+void gps_log_init(void);
+
+/** @fn int gps_log(const char * s)
+ * @brief Queue a string. Task and ISR safe, gps_log_cli compatible.
+ * @param s NUL terminated text
+ * @return 0 when queued, -1 when dropped
+ */
+int gps_log(const char * s);
+
+/** @fn uint16_t gps_log_drain(gps_log_out_fn out, uint16_t max)
+ * @brief Write queued records, oldest first. Single consumer.
+ * @param out output function (gps_log_cli for the CLI UART)
+ * @param max most records to write in this call
+ * @return records written
+ */
+uint16_t gps_log_drain(gps_log_out_fn out, uint16_t max);
+
+/** @fn void gps_log_get_stats(st_gps_log_stats * stats)
+ * @brief Copy the counters.
+ * @param stats destination
+ */
+void gps_log_get_stats(st_gps_log_stats * stats);
+
+#if(GPS_PROF_ENABLE == MZ_ENABLE)
+/** @fn void gps_log_bench(gps_log_out_fn direct, uint32_t * direct_cost, uint32_t * log_cost)
+ * @brief Caller side cost of one line, written with direct and with
+ * gps_log(), in profiler time base units. Leaves records in the ring.
+ * @param direct synchronous output (gps_log_cli)
+ * @param direct_cost average cost of direct
+ * @param log_cost average cost of gps_log
+ */
+void gps_log_bench(gps_log_out_fn direct, uint32_t * direct_cost, uint32_t * log_cost);
+#endif
+
+#else
+
+#define GPS_LOG_OUT					gps_log_cli
+
+#endif //(GPS_LOG_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_LOG_H_ */
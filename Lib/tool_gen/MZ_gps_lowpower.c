@@ -0,0 +1,219 @@
+/*
+ * MZ_gps_lowpower.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_lowpower.h"
+#if defined(__arm__)
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+/* Include Header Files - END */
+
+#if(GPS_LP_ENABLE == MZ_ENABLE)
+
+/* Define some common use MACRO - START */
+#define LP_LPTIM_MASK				(0xFFFFUL)					///< 16 bit counter
+#define LP_LPTIM_IRQ_PRIO			(15)						///< Lowest, only wakes the core
+#define LP_MIN_COUNTS				(2)							///< Closest compare, CMP write takes 2 LSE cycles
+#define LP_MAX_TICKS				((uint32_t)GPS_LP_MAX_IDLE_MS)	///< Fits the 16 bit counter (2 s)
+/* Define some common use MACRO - END */
+
+/*
+ * Keep the part of the current tick that elapsed. - START
+ */
+uint32_t gps_lp_clock_enter(st_gps_lp_clock * c, uint32_t elapsed, uint32_t period, uint32_t idle)
+{
+	uint64_t span = (uint64_t)idle * GPS_LP_LSE_HZ;
+	uint64_t part = ((uint64_t)elapsed * GPS_LP_LSE_HZ) + c->sub;
+
+	/* One tick is LSE_HZ units of rem, one LSE count TICK_HZ units */
+	c->rem += (uint32_t)(part / period);
+	c->sub = (uint32_t)(part % period);
+	if(span <= ((uint64_t)c->rem + LP_MIN_COUNTS * GPS_LP_TICK_HZ))
+	{
+		return LP_MIN_COUNTS;
+	}
+	return (uint32_t)((span - c->rem) / GPS_LP_TICK_HZ);
+}
+/* Keep the part of the current tick that elapsed. - END */
+
+/*
+ * Whole ticks of a sleep. - START
+ */
+uint32_t gps_lp_clock_ticks(st_gps_lp_clock * c, uint32_t counts, uint32_t max)
+{
+	uint64_t total = ((uint64_t)counts * GPS_LP_TICK_HZ) + c->rem;
+	uint32_t ticks = (uint32_t)(total / GPS_LP_LSE_HZ);
+
+	if(ticks > max)
+	{
+		/* Woken late by the compare latency, credit it on the next sleep */
+		ticks = max;
+	}
+	c->rem = (uint32_t)(total - ((uint64_t)ticks * GPS_LP_LSE_HZ));
+	return ticks;
+}
+/* Whole ticks of a sleep. - END */
+
+#if defined(__arm__)
+
+extern void SystemClock_Config(void);
+
+/* Low power related variables - START */
+static st_gps_lp_clock lp_clock = {0};							/* Tick fraction carried between sleeps */
+static volatile uint32_t lp_locks = 0;							/* Stop locks held */
+static st_gps_lp_stats lp_stats = {0};							/* Counters */
+static uint8_t lp_ready = 0;									/* LPTIM1 running */
+/* Low power related variables - END */
+
+/** @fn static uint32_t lp_lptim_read(void)
+ * @brief LPTIM1 counter, read twice as it runs on an asynchronous clock
+ */
+static uint32_t lp_lptim_read(void)
+{
+	uint32_t a;
+	uint32_t b;
+
+	do
+	{
+		a = LPTIM1->CNT;
+		b = LPTIM1->CNT;
+	}while(a != b);
+	return a;
+}
+
+/*
+ * Start LPTIM1 on the LSE. - START
+ */
+void gps_lp_init(void)
+{
+	__HAL_RCC_LPTIM1_CONFIG(RCC_LPTIM1CLKSOURCE_LSE);
+	__HAL_RCC_LPTIM1_CLK_ENABLE();
+	__HAL_RCC_LPTIM1_CLK_SLEEP_ENABLE();
+
+	/* Free running 16 bit counter, compare match wakes the core */
+	LPTIM1->CR = 0;
+	LPTIM1->CFGR = 0;
+	LPTIM1->IER = LPTIM_IER_CMPMIE;
+	LPTIM1->CR = LPTIM_CR_ENABLE;
+	LPTIM1->ARR = LP_LPTIM_MASK;
+	while(!(LPTIM1->ISR & LPTIM_ISR_ARROK)){}
+	LPTIM1->ICR = LPTIM_ICR_ARROKCF;
+	LPTIM1->CR |= LPTIM_CR_CNTSTRT;
+
+	HAL_NVIC_SetPriority(LPTIM1_IRQn, LP_LPTIM_IRQ_PRIO, 0);
+	HAL_NVIC_EnableIRQ(LPTIM1_IRQn);
+
+	/* HSI16 right after STOP2, the PLL is restarted from it */
+	__HAL_RCC_WAKEUPSTOP_CLK_CONFIG(RCC_STOP_WAKEUPCLOCK_HSI);
+	lp_ready = 1;
+}
+/* Start LPTIM1 on the LSE. - END */
+
+/*
+ * Keep the MCU out of STOP2. - START
+ */
+void gps_lp_stop_lock(void)
+{
+	__atomic_fetch_add(&lp_locks, 1, __ATOMIC_RELAXED);
+}
+/* Keep the MCU out of STOP2. - END */
+
+/*
+ * Release a stop lock. - START
+ */
+void gps_lp_stop_unlock(void)
+{
+	__atomic_fetch_sub(&lp_locks, 1, __ATOMIC_RELAXED);
+}
+/* Release a stop lock. - END */
+
+/*
+ * portSUPPRESS_TICKS_AND_SLEEP. - START
+ */
+void gps_lp_suppress_ticks_and_sleep(uint32_t idle)
+{
+	uint32_t start;
+	uint32_t counts;
+	uint32_t ticks;
+
+	if((idle < GPS_LP_MIN_IDLE_MS) || (lp_locks != 0) || !lp_ready)
+	{
+		/* Not worth a clock restart, traffic that STOP2 would cut or no LPTIM1 yet */
+		if(lp_locks != 0)
+		{
+			lp_stats.locked++;
+		}
+		__DSB();
+		__WFI();
+		return;
+	}
+	if(idle > LP_MAX_TICKS)
+	{
+		idle = LP_MAX_TICKS;
+	}
+
+	__disable_irq();
+	if(eTaskConfirmSleepModeStatus() == eAbortSleep)
+	{
+		lp_stats.aborted++;
+		__enable_irq();
+		return;
+	}
+
+	/* Freeze both tick sources, keep the part of the tick already gone */
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+	counts = gps_lp_clock_enter(&lp_clock, SysTick->LOAD - SysTick->VAL, SysTick->LOAD + 1, idle);
+	HAL_SuspendTick();
+
+	start = lp_lptim_read();
+	LPTIM1->ICR = LPTIM_ICR_CMPOKCF;
+	LPTIM1->CMP = (start + counts) & LP_LPTIM_MASK;
+	while(!(LPTIM1->ISR & LPTIM_ISR_CMPOK)){}
+
+	HAL_PWREx_EnterSTOP2Mode(PWR_STOPENTRY_WFI);
+
+	/* Any interrupt ends STOP2, it runs once interrupts are enabled again */
+	SystemClock_Config();
+	counts = (lp_lptim_read() - start) & LP_LPTIM_MASK;
+	ticks = gps_lp_clock_ticks(&lp_clock, counts, idle);
+
+	vTaskStepTick(ticks);
+	uwTick += ticks * (1000UL / GPS_LP_TICK_HZ);
+	lp_stats.stops++;
+	lp_stats.stop_ms += ticks * (1000UL / GPS_LP_TICK_HZ);
+
+	HAL_ResumeTick();
+	SysTick->VAL = 0;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+	__enable_irq();
+}
+/* portSUPPRESS_TICKS_AND_SLEEP. - END */
+
+/*
+ * LPTIM1 interrupt. - START
+ */
+void gps_lp_lptim_irq(void)
+{
+	LPTIM1->ICR = LPTIM_ICR_CMPMCF;
+}
+/* LPTIM1 interrupt. - END */
+
+/*
+ * Copy the idle counters. - START
+ */
+void gps_lp_get_stats(st_gps_lp_stats * stats)
+{
+	*stats = lp_stats;
+}
+/* Copy the idle counters. - END */
+
+#endif //defined(__arm__)
+
+#endif //(GPS_LP_ENABLE == MZ_ENABLE)
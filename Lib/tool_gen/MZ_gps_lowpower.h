@@ -0,0 +1,130 @@
+/*
+ * MZ_gps_lowpower.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Tickless idle in STOP2.
+ *
+ *  FreeRTOSConfig.h maps portSUPPRESS_TICKS_AND_SLEEP to
+ *  gps_lp_suppress_ticks_and_sleep(). When the idle time is long enough
+ *  and nothing holds a stop lock, SysTick and the HAL time base (TIM1) are
+ *  stopped, LPTIM1 (LSE, 32768 Hz) is armed for the expected idle time and
+ *  the core enters STOP2. LPTIM1, LPUART1 (start bit, see gps_uart_init)
+ *  or any other wake up source ends the sleep. The system clock is
+ *  restored and the RTOS and HAL ticks are stepped by the time LPTIM1
+ *  counted. Shorter idle periods or a held lock sleep with WFI only.
+ *
+ *  The LSE count to tick conversion keeps the fraction of a tick, also
+ *  the part of the tick already elapsed when the sleep started, so the
+ *  RTOS time does not drift however the sleeps are cut. That part has no
+ *  target dependency and is the host model of the compensation.
+ *
+ *  Energy per fix on target:
+ *  1. Build with GPS_LP_ENABLE, no debugger attached (a debug session
+ *     keeps the core clocks running in STOP).
+ *  2. Supply the board through the IDD jumper with a current analyser
+ *     (or a shunt and a scope), receiver and modem powered as in the
+ *     field.
+ *  3. Let the fix rate settle, record the current over N >= 60 epochs
+ *     and read gps_lp_get_stats() before and after.
+ *  4. Energy per fix = V * (integral of I over the window) / N. The stop
+ *     residency, stop_ms / window, tells how much of the window was
+ *     spent in STOP2; aborted and locked show what kept the MCU awake.
+ */
+
+#ifndef MZ_GPS_LOWPOWER_H_
+#define MZ_GPS_LOWPOWER_H_
+
+#include "stdint.h"
+#include "MZ_gps_app_config.h"
+
+#define GPS_LP_LSE_HZ				(32768UL)				///< LPTIM1 clock
+#define GPS_LP_TICK_HZ				(1000UL)				///< configTICK_RATE_HZ
+
+/**
+ * @struct st_gps_lp_clock
+ * @brief LSE count to RTOS tick conversion
+ */
+typedef struct
+{
+	uint32_t		rem;										/*!< Time not credited yet, 1/(LSE_HZ * TICK_HZ) s */
+	uint32_t		sub;										/*!< Below one rem unit, 1/period of a unit */
+}st_gps_lp_clock;
+
+/**
+ * @struct st_gps_lp_stats
+ * @brief Idle counters
+ */
+typedef struct
+{
+	uint32_t		stops;										/*!< STOP2 entries */
+	uint32_t		stop_ms;									/*!< Time credited after STOP2 */
+	uint32_t		aborted;									/*!< Sleeps cancelled by a ready task */
+	uint32_t		locked;										/*!< Idle periods kept in WFI by a stop lock */
+}st_gps_lp_stats;
+
+#if(GPS_LP_ENABLE == MZ_ENABLE)
+
+/** @fn uint32_t gps_lp_clock_enter(st_gps_lp_clock * c, uint32_t elapsed, uint32_t period, uint32_t idle)
+ * @brief Keep the part of the current tick that elapsed before the sleep.
+ * @param c conversion state
+ * @param elapsed SysTick counts since the last tick
+ * @param period SysTick counts per tick
+ * @param idle ticks to sleep
+ * @return LSE counts to the tick boundary idle ticks ahead
+ */
+uint32_t gps_lp_clock_enter(st_gps_lp_clock * c, uint32_t elapsed, uint32_t period, uint32_t idle);
+
+/** @fn uint32_t gps_lp_clock_ticks(st_gps_lp_clock * c, uint32_t counts, uint32_t max)
+ * @brief Whole ticks of a sleep, the fraction is kept for the next one.
+ * @param c conversion state
+ * @param counts LSE counts slept
+ * @param max ticks the kernel allows to step, the excess is kept
+ * @return ticks to step
+ */
+uint32_t gps_lp_clock_ticks(st_gps_lp_clock * c, uint32_t counts, uint32_t max);
+
+/** @fn void gps_lp_init(void)
+ * @brief Start LPTIM1 on the LSE. The idle task only uses WFI before.
+ */
+void gps_lp_init(void);
+
+/** @fn void gps_lp_stop_lock(void)
+ * @brief Keep the MCU out of STOP2 (DMA or UART traffic in flight).
+ * Task and ISR safe, calls nest.
+ */
+void gps_lp_stop_lock(void);
+
+/** @fn void gps_lp_stop_unlock(void)
+ * @brief Release a gps_lp_stop_lock().
+ */
+void gps_lp_stop_unlock(void);
+
+/** @fn void gps_lp_suppress_ticks_and_sleep(uint32_t idle)
+ * @brief portSUPPRESS_TICKS_AND_SLEEP, called by the idle task.
+ * @param idle expected idle time in ticks
+ */
+void gps_lp_suppress_ticks_and_sleep(uint32_t idle);
+
+/** @fn void gps_lp_lptim_irq(void)
+ * @brief LPTIM1 interrupt, wake up from STOP2.
+ */
+void gps_lp_lptim_irq(void);
+
+/** @fn void gps_lp_get_stats(st_gps_lp_stats * stats)
+ * @brief Copy the idle counters.
+ * @param stats destination
+ */
+void gps_lp_get_stats(st_gps_lp_stats * stats);
+
+#define GPS_LP_STOP_LOCK()			gps_lp_stop_lock()
+#define GPS_LP_STOP_UNLOCK()		gps_lp_stop_unlock()
+
+#else
+
+#define GPS_LP_STOP_LOCK()
+#define GPS_LP_STOP_UNLOCK()
+
+#endif //(GPS_LP_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_LOWPOWER_H_ */
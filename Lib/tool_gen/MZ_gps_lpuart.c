@@ -0,0 +1,235 @@
+/*
+ * MZ_gps_lpuart.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_lpuart.h"
+#include "string.h"
+#if defined(__arm__)
+#include "main.h"
+#include "MZ_sys_cmsis_os2.h"
+#include "MZ_gps_trace.h"
+#include "MZ_gps_latency.h"
+#endif
+
+/* Include Header Files - END */
+
+#if(GPS_LPUART_RING_ENABLE == MZ_ENABLE)
+
+/* Define some common use MACRO - START */
+#define LPU_RING_MASK				(GPS_LPUART_RING_SIZE - 1)	///< Ring index mask
+/* Define some common use MACRO - END */
+
+/* Stop mode receive related variables - START */
+static uint8_t lpu_ring[GPS_LPUART_RING_SIZE];					/* Received bytes */
+static volatile uint32_t lpu_head = 0;							/* Written by the interrupt */
+static volatile uint32_t lpu_tail = 0;							/* Written by the thread */
+static uint8_t lpu_in_burst = 0;								/* Bytes since the last idle line */
+static uint32_t lpu_burst_bytes = 0;							/* Bytes of the current burst */
+static st_gps_lpuart_stats lpu_stats = {0};						/* Counters */
+#if defined(__arm__)
+static mz_semaphore_t lpu_sem;									/* Released at the end of a burst */
+static uint32_t lpu_duty_cyc = 0;								/* DWT at the last duty sample */
+static uint32_t lpu_duty_tick = 0;								/* Tick at the last duty sample */
+static uint32_t lpu_start_tick = 0;								/* First byte of the current burst */
+static volatile uint32_t lpu_burst_tick = 0;					/* First byte of the last closed burst */
+#endif
+/* Stop mode receive related variables - END */
+
+/*
+ * Add one received byte to the ring. - START
+ */
+void gps_lpuart_rx_byte(uint8_t b)
+{
+	uint32_t head = lpu_head;
+
+	if(!lpu_in_burst)
+	{
+		lpu_in_burst = 1;
+		lpu_burst_bytes = 0;
+	}
+	lpu_stats.bytes++;
+	lpu_burst_bytes++;
+
+	if((head - __atomic_load_n(&lpu_tail, __ATOMIC_ACQUIRE)) >= GPS_LPUART_RING_SIZE)
+	{
+		lpu_stats.dropped++;
+		return;
+	}
+	lpu_ring[head & LPU_RING_MASK] = b;
+	__atomic_store_n(&lpu_head, head + 1, __ATOMIC_RELEASE);
+}
+/* Add one received byte to the ring. - END */
+
+/*
+ * Idle line after a burst. - START
+ */
+uint8_t gps_lpuart_rx_idle(void)
+{
+	if(!lpu_in_burst)
+	{
+		return 0;
+	}
+	lpu_in_burst = 0;
+	lpu_stats.bursts++;
+	return 1;
+}
+/* Idle line after a burst. - END */
+
+/*
+ * Take whole lines from the ring. - START
+ */
+uint16_t gps_lpuart_read(char * buf, uint16_t size)
+{
+	uint32_t tail = lpu_tail;
+	uint32_t avail = __atomic_load_n(&lpu_head, __ATOMIC_ACQUIRE) - tail;
+	uint32_t n = (avail < (uint32_t)(size - 1)) ? avail : (uint32_t)(size - 1);
+	uint32_t first = GPS_LPUART_RING_SIZE - (tail & LPU_RING_MASK);
+	uint32_t take = n;
+
+	if(first > n)
+	{
+		first = n;
+	}
+	memcpy(buf, &lpu_ring[tail & LPU_RING_MASK], first);
+	memcpy(&buf[first], lpu_ring, n - first);
+
+	/* Whole lines only, unless one line fills the buffer */
+	while((take != 0) && (buf[take - 1] != '\n'))
+	{
+		take--;
+	}
+	if((take == 0) && (n == (uint32_t)(size - 1)))
+	{
+		take = n;
+	}
+
+	buf[take] = '\0';
+	__atomic_store_n(&lpu_tail, tail + take, __ATOMIC_RELEASE);
+	return (uint16_t)take;
+}
+/* Take whole lines from the ring. - END */
+
+/*
+ * Copy the receive counters. - START
+ */
+void gps_lpuart_get_stats(st_gps_lpuart_stats * stats)
+{
+	*stats = lpu_stats;
+}
+/* Copy the receive counters. - END */
+
+#if defined(__arm__)
+
+/*
+ * Enable the LPUART1 receive interrupts. - START
+ */
+mz_error_t gps_lpuart_init(void)
+{
+	if(!mz_sem_create(&lpu_sem, 1, 0))
+	{
+		return MZ_FAIL;
+	}
+
+	/* Core cycles for the duty cycle, CYCCNT is shared, never reset here */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	lpu_duty_cyc = DWT->CYCCNT;
+	lpu_duty_tick = HAL_GetTick();
+
+	LPUART1->ICR = USART_ICR_IDLECF | USART_ICR_ORECF;
+	LPUART1->CR1 |= USART_CR1_RXNEIE | USART_CR1_IDLEIE;
+	return MZ_OK;
+}
+/* Enable the LPUART1 receive interrupts. - END */
+
+/*
+ * LPUART1 receive interrupt. - START
+ */
+void gps_lpuart_irq(void)
+{
+	uint32_t isr = LPUART1->ISR;
+
+	if(isr & USART_ISR_WUF)
+	{
+		LPUART1->ICR = USART_ICR_WUCF;
+		lpu_stats.wakes++;
+	}
+	if(isr & (USART_ISR_ORE | USART_ISR_FE | USART_ISR_NE | USART_ISR_PE))
+	{
+		/* Cleared here so the HAL handler does not abort the receive */
+		if(isr & USART_ISR_ORE)
+		{
+			lpu_stats.overruns++;
+		}
+		LPUART1->ICR = USART_ICR_ORECF | USART_ICR_FECF | USART_ICR_NCF | USART_ICR_PECF;
+	}
+	if(isr & USART_ISR_RXNE)
+	{
+		if(!lpu_in_burst)
+		{
+			lpu_start_tick = HAL_GetTick();
+		}
+		gps_lpuart_rx_byte((uint8_t)LPUART1->RDR);
+	}
+	if(isr & USART_ISR_IDLE)
+	{
+		LPUART1->ICR = USART_ICR_IDLECF;
+		if(gps_lpuart_rx_idle())
+		{
+			lpu_burst_tick = lpu_start_tick;
+			GPS_TRACE(GPS_TRACE_UART_RX, lpu_burst_bytes);
+#if(GPS_LATENCY_ENABLE == MZ_ENABLE)
+			/* The position is as old as the first byte of the burst */
+			gps_latency_rx(lpu_start_tick);
+#endif
+			(void)mz_sem_release(&lpu_sem);
+		}
+	}
+}
+/* LPUART1 receive interrupt. - END */
+
+/*
+ * Tick of the first byte of the last burst. - START
+ */
+uint32_t gps_lpuart_burst_tick(void)
+{
+	return lpu_burst_tick;
+}
+/* Tick of the first byte of the last burst. - END */
+
+/*
+ * Block until a burst is complete. - START
+ */
+uint8_t gps_lpuart_wait(uint32_t timeout)
+{
+	return (osOK == (osStatus_t)mz_sem_wait(&lpu_sem, timeout));
+}
+/* Block until a burst is complete. - END */
+
+/*
+ * Core running time since the last call. - START
+ */
+uint32_t gps_lpuart_duty(void)
+{
+	uint32_t cyc = DWT->CYCCNT;
+	uint32_t tick = HAL_GetTick();
+	uint64_t wall = (uint64_t)(SystemCoreClock / 1000) * (tick - lpu_duty_tick);
+	uint32_t permille = 0;
+
+	if(wall != 0)
+	{
+		permille = (uint32_t)(((uint64_t)(cyc - lpu_duty_cyc) * 1000) / wall);
+	}
+	lpu_duty_cyc = cyc;
+	lpu_duty_tick = tick;
+	return (permille > 1000) ? 1000 : permille;
+}
+/* Core running time since the last call. - END */
+
+#endif //defined(__arm__)
+
+#endif //(GPS_LPUART_RING_ENABLE == MZ_ENABLE)
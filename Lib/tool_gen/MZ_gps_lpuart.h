@@ -0,0 +1,108 @@
+/*
+ * MZ_gps_lpuart.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  LPUART1 stop mode receive.
+ *
+ *  LPUART1 runs on the LSE and is the only UART that keeps receiving in
+ *  STOP2. In this mode the receiver bytes are taken one by one from the
+ *  LPUART1 interrupt into a ring, with no HAL receive in flight:
+ *  - a start bit wakes the MCU (wake up is armed in gps_uart_init when
+ *    GPS_LP_ENABLE is set), the byte lands in RDR while the system clock
+ *    restarts and is read right after, one byte time (1 ms at 9600) is
+ *    far longer than the restart;
+ *  - the MCU goes back to STOP2 between bytes. Staying in Sleep for the
+ *    burst would cost more: Sleep at 80 MHz for one byte time takes
+ *    about five times the charge of a STOP2 exit;
+ *  - the idle line after the burst wakes the GPS thread, which takes
+ *    the burst in line aligned chunks and commits the epoch once.
+ *  The GPS thread blocks on the burst instead of polling every 10 ms.
+ *
+ *  gps_lpuart_duty() gives the share of time the core was running
+ *  (DWT cycles against the tick time, the core clock is gated in Sleep
+ *  and STOP2). Keep the debugger detached, it keeps the clocks running.
+ */
+
+#ifndef MZ_GPS_LPUART_H_
+#define MZ_GPS_LPUART_H_
+
+#include "stdint.h"
+#include "MZ_gps_app_config.h"
+#include "MZ_error_handler.h"
+
+/**
+ * @struct st_gps_lpuart_stats
+ * @brief Receive counters
+ */
+typedef struct
+{
+	uint32_t		bytes;										/*!< Bytes received */
+	uint32_t		bursts;										/*!< Bursts closed by an idle line */
+	uint32_t		dropped;									/*!< Bytes lost on a full ring */
+	uint32_t		overruns;									/*!< Bytes lost in the peripheral */
+	uint32_t		wakes;										/*!< STOP2 exits on a start bit */
+}st_gps_lpuart_stats;
+
+#if(GPS_LPUART_RING_ENABLE == MZ_ENABLE)
+
+/** @fn void gps_lpuart_rx_byte(uint8_t b)
+ * @brief Add one received byte to the ring. Interrupt side.
+ * @param b received byte
+ */
+void gps_lpuart_rx_byte(uint8_t b);
+
+/** @fn uint8_t gps_lpuart_rx_idle(void)
+ * @brief Idle line after a burst. Interrupt side.
+ * @return 1 when a burst was closed
+ */
+uint8_t gps_lpuart_rx_idle(void);
+
+/** @fn uint16_t gps_lpuart_read(char * buf, uint16_t size)
+ * @brief Take whole lines from the ring. A line longer than the buffer
+ * is cut, an incomplete last line stays in the ring. Thread side.
+ * @param buf destination, NUL terminated
+ * @param size size of buf
+ * @return number of characters taken, 0 when no whole line is available
+ */
+uint16_t gps_lpuart_read(char * buf, uint16_t size);
+
+/** @fn void gps_lpuart_get_stats(st_gps_lpuart_stats * stats)
+ * @brief Copy the receive counters.
+ * @param stats destination
+ */
+void gps_lpuart_get_stats(st_gps_lpuart_stats * stats);
+
+/** @fn mz_error_t gps_lpuart_init(void)
+ * @brief Enable the byte and idle line interrupts of LPUART1.
+ * @return MZ_OK/MZ_FAIL
+ */
+mz_error_t gps_lpuart_init(void);
+
+/** @fn void gps_lpuart_irq(void)
+ * @brief LPUART1 receive interrupt, called before the MonoZ handler.
+ */
+void gps_lpuart_irq(void);
+
+/** @fn uint32_t gps_lpuart_burst_tick(void)
+ * @brief HAL tick of the first byte of the last closed burst.
+ * @return tick in ms
+ */
+uint32_t gps_lpuart_burst_tick(void);
+
+/** @fn uint8_t gps_lpuart_wait(uint32_t timeout)
+ * @brief Block until a burst is complete.
+ * @param timeout ms
+ * @return 1 when a burst is ready, 0 on timeout
+ */
+uint8_t gps_lpuart_wait(uint32_t timeout);
+
+/** @fn uint32_t gps_lpuart_duty(void)
+ * @brief Core running time since the last call.
+ * @return permille, the window must stay below 2^32 core cycles (53 s)
+ */
+uint32_t gps_lpuart_duty(void);
+
+#endif //(GPS_LPUART_RING_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_LPUART_H_ */
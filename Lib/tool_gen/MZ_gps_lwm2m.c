@@ -0,0 +1,353 @@
+/*
+ * MZ_gps_lwm2m.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_lwm2m.h"
+#include "stdlib.h"
+#include "string.h"
+#if(MZ_LWM2M_ENABLE == MZ_ENABLE)
+#include "main.h"
+#include "MZ_Lwm2m_public.h"
+#endif
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define LWM2M_TLV_RESOURCE			(0xC0)						///< TLV type, resource with value
+#define LWM2M_TLV_LEN8				(0x08)						///< Length in one byte after the id
+#define LWM2M_TLV_LEN_MAX			(7)							///< Longest length inside the type byte
+#define LWM2M_RES_LAT				(0)							///< Object 6 resources
+#define LWM2M_RES_LON				(1)
+#define LWM2M_RES_ALT				(2)
+#define LWM2M_RES_RADIUS			(3)
+#define LWM2M_RES_TIMESTAMP			(5)
+#define LWM2M_RES_SPEED				(6)
+#define LWM2M_UERE_CM				(500)						///< Range error, radius is HDOP times this
+#define LWM2M_COAP_HEADER			(4)							///< Version, type, token length, code, message id
+/* Define some common use MACRO - END */
+
+/** @fn static uint16_t lwm2m_tlv(uint8_t * out, uint8_t id, uint64_t val, uint8_t len)
+ * @brief One resource TLV, the value big endian in len bytes
+ */
+static uint16_t lwm2m_tlv(uint8_t * out, uint8_t id, uint64_t val, uint8_t len)
+{
+	uint16_t n = 0;
+
+	if(len <= LWM2M_TLV_LEN_MAX)
+	{
+		out[n++] = LWM2M_TLV_RESOURCE | len;
+		out[n++] = id;
+	}
+	else
+	{
+		out[n++] = LWM2M_TLV_RESOURCE | LWM2M_TLV_LEN8;
+		out[n++] = id;
+		out[n++] = len;
+	}
+	for(uint8_t i = len; i > 0; i--)
+	{
+		out[n++] = (uint8_t)(val >> ((i - 1) * 8));
+	}
+	return n;
+}
+
+/** @fn static uint64_t lwm2m_f64(double v)
+ * @brief Bits of a 64 bit float
+ */
+static uint64_t lwm2m_f64(double v)
+{
+	uint64_t bits;
+
+	memcpy(&bits, &v, sizeof(bits));
+	return bits;
+}
+
+/** @fn static uint64_t lwm2m_f32(float v)
+ * @brief Bits of a 32 bit float
+ */
+static uint64_t lwm2m_f32(float v)
+{
+	uint32_t bits;
+
+	memcpy(&bits, &v, sizeof(bits));
+	return bits;
+}
+
+/*
+ * Object 6 resources of a fix. - START
+ */
+uint16_t gps_lwm2m_obj6(const st_gps_fix * fix, uint8_t * out, uint16_t size)
+{
+	uint16_t n = 0;
+
+	if(size < GPS_LWM2M_OBJ6_SIZE)
+	{
+		return 0;
+	}
+
+	/* 32 bit floats would round the position to about 2 m */
+	n += lwm2m_tlv(&out[n], LWM2M_RES_LAT, lwm2m_f64((double)fix->lat_e7 / 1e7), 8);
+	n += lwm2m_tlv(&out[n], LWM2M_RES_LON, lwm2m_f64((double)fix->lon_e7 / 1e7), 8);
+	n += lwm2m_tlv(&out[n], LWM2M_RES_ALT, lwm2m_f32((float)fix->alt_cm / 100.0f), 4);
+	n += lwm2m_tlv(&out[n], LWM2M_RES_RADIUS, lwm2m_f32((float)((uint32_t)fix->hdop_x100 * LWM2M_UERE_CM) / 10000.0f), 4);
+	n += lwm2m_tlv(&out[n], LWM2M_RES_TIMESTAMP, gps_fix_to_unix(fix), 4);
+	n += lwm2m_tlv(&out[n], LWM2M_RES_SPEED, lwm2m_f32((float)fix->speed_cms / 100.0f), 4);
+	return n;
+}
+/* Object 6 resources of a fix. - END */
+
+/*
+ * Size of a CoAP notification. - START
+ */
+uint16_t gps_lwm2m_coap_size(uint16_t payload, uint8_t token_len, uint32_t seq)
+{
+	uint16_t n = LWM2M_COAP_HEADER + token_len;
+
+	/* Observe (6) and Content-Format (12), deltas below 13 fit the option byte */
+	n += 1 + ((seq == 0) ? 0 : (seq < 0x100) ? 1 : (seq < 0x10000) ? 2 : 3);
+	n += 1 + ((GPS_LWM2M_COAP_FORMAT_TLV < 0x100) ? 1 : 2);
+	if(payload != 0)
+	{
+		n += 1 + payload;
+	}
+	return n;
+}
+/* Size of a CoAP notification. - END */
+
+/*
+ * Not observed, default attributes. - START
+ */
+void gps_lwm2m_reset(st_gps_lwm2m * o, uint32_t pmin_s, uint32_t pmax_s)
+{
+	memset(o, 0, sizeof(*o));
+	o->pmin_s = pmin_s;
+	o->pmax_s = pmax_s;
+}
+/* Not observed, default attributes. - END */
+
+/*
+ * Take pmin / pmax from a Write-Attributes query. - START
+ */
+void gps_lwm2m_attributes(st_gps_lwm2m * o, const char * attr)
+{
+	const char * p = attr;
+
+	while(*p != '\0')
+	{
+		if(0 == strncmp(p, "pmin=", 5))
+		{
+			o->pmin_s = strtoul(p + 5, NULL, 10);
+		}
+		else if(0 == strncmp(p, "pmax=", 5))
+		{
+			o->pmax_s = strtoul(p + 5, NULL, 10);
+		}
+
+		/* Next attribute */
+		while((*p != '\0') && (*p != '&') && (*p != ';') && (*p != ','))
+		{
+			p++;
+		}
+		if(*p != '\0')
+		{
+			p++;
+		}
+	}
+}
+/* Take pmin / pmax from a Write-Attributes query. - END */
+
+/*
+ * Observation started or cancelled. - START
+ */
+void gps_lwm2m_observe(st_gps_lwm2m * o, uint8_t on, uint32_t now_ms)
+{
+	o->observed = on;
+	o->pending = 0;
+	o->last_ms = now_ms;
+	o->seq = 0;
+}
+/* Observation started or cancelled. - END */
+
+/*
+ * The location is to be reported. - START
+ */
+void gps_lwm2m_report(st_gps_lwm2m * o)
+{
+	o->stats.reports++;
+	if(!o->observed)
+	{
+		o->stats.unobserved++;
+		return;
+	}
+	o->pending = 1;
+}
+/* The location is to be reported. - END */
+
+/*
+ * A notification is due. - START
+ */
+uint8_t gps_lwm2m_due(const st_gps_lwm2m * o, uint32_t now_ms)
+{
+	uint32_t elapsed = now_ms - o->last_ms;
+
+	if(!o->observed)
+	{
+		return 0;
+	}
+	if(o->pending && (elapsed >= (o->pmin_s * 1000)))
+	{
+		return 1;
+	}
+	/* The last value again, the server knows the client is alive */
+	return (o->pmax_s != 0) && (elapsed >= (o->pmax_s * 1000));
+}
+/* A notification is due. - END */
+
+/*
+ * A notification was sent. - START
+ */
+void gps_lwm2m_sent(st_gps_lwm2m * o, uint32_t now_ms, uint16_t payload)
+{
+	o->pending = 0;
+	o->last_ms = now_ms;
+	o->seq++;
+	o->stats.notifies++;
+	o->stats.payload_bytes += payload;
+	o->stats.coap_bytes += gps_lwm2m_coap_size(payload, GPS_LWM2M_TOKEN_LEN, o->seq);
+}
+/* A notification was sent. - END */
+
+#if(MZ_LWM2M_ENABLE == MZ_ENABLE)
+
+/* Define some common use MACRO - START */
+#define LWM2M_LOC_OBJ				(19)						///< Host object carrying the location
+#define LWM2M_LOC_INST				(0)
+/* Define some common use MACRO - END */
+
+/* LwM2M location related variables - START */
+static st_gps_lwm2m lwm2m_obs;									/* Observation of 19/0/0 */
+static uint16_t lwm2m_len = 0;									/* TLV length of the last location */
+static char lwm2m_hex[(GPS_LWM2M_OBJ6_SIZE * 2) + 1];			/* Hex value of 19/0/0 */
+/* LwM2M location related variables - END */
+
+/*
+ * Location not observed yet. - START
+ */
+void gps_lwm2m_init(void)
+{
+	gps_lwm2m_reset(&lwm2m_obs, GPS_LWM2M_PMIN_S, GPS_LWM2M_PMAX_S);
+	lwm2m_len = 0;
+}
+/* Location not observed yet. - END */
+
+/*
+ * LwM2M event of the MonoZ client. - START
+ */
+void gps_lwm2m_event(void * evnt)
+{
+	st_lw_event * ev = (st_lw_event *)evnt;
+
+	switch(ev->lw_event)
+	{
+		case LW_EV_OBSERVE:
+			if((ev->lw_Obj_id == LWM2M_LOC_OBJ) && (ev->lw_Obj_Ins_id == LWM2M_LOC_INST))
+			{
+				gps_lwm2m_observe(&lwm2m_obs, 1, HAL_GetTick());
+			}
+		break;
+		case LW_EV_OBSERVE_CANCEL:
+			if(ev->lw_Obj_id == LWM2M_LOC_OBJ)
+			{
+				gps_lwm2m_observe(&lwm2m_obs, 0, HAL_GetTick());
+			}
+		break;
+		case LW_EV_REG_FINISH:
+			/* The client dropped all observations */
+			gps_lwm2m_observe(&lwm2m_obs, 0, HAL_GetTick());
+		break;
+		case LW_EV_WRITE_ATTRIBUTE:
+			if(ev->lw_Obj_id == LWM2M_LOC_OBJ)
+			{
+				gps_lwm2m_attributes(&lwm2m_obs, ev->lw_val);
+			}
+		break;
+		case LW_EV_CLIENT_NOTIFY_SEND_ACK:
+			lwm2m_obs.stats.acks++;
+		break;
+		case LW_EV_NOTIFY_FAIL:
+		case LW_EV_NOTIFY_NOT_SEND:
+			lwm2m_obs.stats.fails++;
+		break;
+		default:
+		break;
+	}
+}
+/* LwM2M event of the MonoZ client. - END */
+
+/*
+ * Report a location. - START
+ */
+void gps_lwm2m_set(const st_gps_fix * fix)
+{
+	static const char hex[] = "0123456789ABCDEF";
+	uint8_t tlv[GPS_LWM2M_OBJ6_SIZE];
+
+	lwm2m_len = gps_lwm2m_obj6(fix, tlv, sizeof(tlv));
+	for(uint16_t i = 0; i < lwm2m_len; i++)
+	{
+		lwm2m_hex[i * 2] = hex[tlv[i] >> 4];
+		lwm2m_hex[(i * 2) + 1] = hex[tlv[i] & 0x0F];
+	}
+	lwm2m_hex[lwm2m_len * 2] = '\0';
+
+	/* Reads and a new observation get the newest location */
+	(void)mz_set_value_Ob19_0_0(lwm2m_hex);
+	gps_lwm2m_report(&lwm2m_obs);
+}
+/* Report a location. - END */
+
+/*
+ * A notification is due. - START
+ */
+uint8_t gps_lwm2m_pending(uint32_t now_ms)
+{
+	return (lwm2m_len != 0) && gps_lwm2m_due(&lwm2m_obs, now_ms);
+}
+/* A notification is due. - END */
+
+/*
+ * Notify the location. - START
+ */
+mz_error_t gps_lwm2m_notify(uint32_t now_ms)
+{
+	mz_error_t status = mz_notify_Ob19_0_0();
+
+	if(MZ_OK == status)
+	{
+		gps_lwm2m_sent(&lwm2m_obs, now_ms, lwm2m_len);
+	}
+	else
+	{
+		/* Dropped, the next report or pmax sends it again */
+		lwm2m_obs.stats.fails++;
+		lwm2m_obs.pending = 0;
+		lwm2m_obs.last_ms = now_ms;
+	}
+	return status;
+}
+/* Notify the location. - END */
+
+/*
+ * Copy the notification counters. - START
+ */
+void gps_lwm2m_get_stats(st_gps_lwm2m_stats * stats)
+{
+	*stats = lwm2m_obs.stats;
+}
+/* Copy the notification counters. - END */
+
+#endif //(MZ_LWM2M_ENABLE == MZ_ENABLE)
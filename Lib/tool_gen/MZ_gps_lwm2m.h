@@ -0,0 +1,171 @@
+/*
+ * MZ_gps_lwm2m.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Location reports as LwM2M Object 6, the LwM2M telemetry backend
+ *  (MZ_gps_backend.h).
+ *
+ *  A report sets the Object 6 resources Latitude (0), Longitude (1),
+ *  Altitude (2), Radius (3), Timestamp (5) and Speed (6), OMA-TLV
+ *  encoded, latitude and longitude as 64 bit floats, the rest as 32 bit.
+ *  It is only sent while the server observes it, and not before pmin or
+ *  later than pmax after the previous notification, both set by the
+ *  server with Write-Attributes (GPS_LWM2M_PMIN_S / GPS_LWM2M_PMAX_S
+ *  until then). The MonoZ LwM2M client only carries host object 19, so
+ *  the TLV goes hex encoded into 19/0/0 (mz_set_value_Ob19_0_0, reads
+ *  and observe responses get the newest) and is notified with
+ *  mz_notify_Ob19_0_0(), the server side decodes it as /6/0.
+ *  gps_lwm2m_event() takes the LwM2M events from mz_pro_default_callback.
+ *  Encoder, attributes and notification timing have no HAL dependency.
+ */
+
+#ifndef MZ_GPS_LWM2M_H_
+#define MZ_GPS_LWM2M_H_
+
+#include "stdint.h"
+#include "MZ_error_handler.h"
+#include "MZ_gps_app_config.h"
+#include "MZ_gps_fix.h"
+
+#define GPS_LWM2M_OBJ6_SIZE			(48)					///< Largest Object 6 TLV
+#define GPS_LWM2M_COAP_FORMAT_TLV	(11542)					///< CoAP Content-Format of OMA-TLV
+
+/**
+ * @struct st_gps_lwm2m_stats
+ * @brief Notification counters
+ */
+typedef struct
+{
+	uint32_t		reports;									/*!< Reports from the application */
+	uint32_t		notifies;									/*!< Notifications sent */
+	uint32_t		unobserved;									/*!< Reports while nobody observes, only readable */
+	uint32_t		fails;										/*!< Notifications the client refused */
+	uint32_t		acks;										/*!< Confirmable notifications acknowledged */
+	uint32_t		payload_bytes;								/*!< TLV bytes sent */
+	uint32_t		coap_bytes;									/*!< CoAP message bytes sent, estimated */
+}st_gps_lwm2m_stats;
+
+/**
+ * @struct st_gps_lwm2m
+ * @brief Observation of the location
+ */
+typedef struct
+{
+	uint8_t				observed;								/*!< The server observes the location */
+	uint8_t				pending;								/*!< A report waits for pmin */
+	uint32_t			pmin_s;									/*!< Minimum period */
+	uint32_t			pmax_s;									/*!< Maximum period, 0 = none */
+	uint32_t			last_ms;								/*!< Last notification */
+	uint32_t			seq;									/*!< Observe sequence number */
+	st_gps_lwm2m_stats	stats;									/*!< Counters */
+}st_gps_lwm2m;
+
+/** @fn uint16_t gps_lwm2m_obj6(const st_gps_fix * fix, uint8_t * out, uint16_t size)
+ * @brief Object 6 instance resources of a fix as OMA-TLV.
+ * @param fix fix
+ * @param out output
+ * @param size size of out, GPS_LWM2M_OBJ6_SIZE
+ * @return TLV length, 0 when out is too small
+ */
+uint16_t gps_lwm2m_obj6(const st_gps_fix * fix, uint8_t * out, uint16_t size);
+
+/** @fn uint16_t gps_lwm2m_coap_size(uint16_t payload, uint8_t token_len, uint32_t seq)
+ * @brief Size of a CoAP notification, header, token, Observe and
+ * Content-Format options and payload.
+ * @param payload payload length
+ * @param token_len token length
+ * @param seq observe sequence number
+ * @return bytes
+ */
+uint16_t gps_lwm2m_coap_size(uint16_t payload, uint8_t token_len, uint32_t seq);
+
+/** @fn void gps_lwm2m_reset(st_gps_lwm2m * o, uint32_t pmin_s, uint32_t pmax_s)
+ * @brief Not observed, default attributes.
+ * @param o observation
+ * @param pmin_s minimum period
+ * @param pmax_s maximum period, 0 = none
+ */
+void gps_lwm2m_reset(st_gps_lwm2m * o, uint32_t pmin_s, uint32_t pmax_s);
+
+/** @fn void gps_lwm2m_attributes(st_gps_lwm2m * o, const char * attr)
+ * @brief Take pmin / pmax from a Write-Attributes query, other
+ * attributes are ignored.
+ * @param o observation
+ * @param attr e.g. "pmin=10&pmax=300", '&', ';' or ',' separated
+ */
+void gps_lwm2m_attributes(st_gps_lwm2m * o, const char * attr);
+
+/** @fn void gps_lwm2m_observe(st_gps_lwm2m * o, uint8_t on, uint32_t now_ms)
+ * @brief Observation started or cancelled. The observe response carries
+ * the current value, pmin and pmax count from it.
+ * @param o observation
+ * @param on 1 when started
+ * @param now_ms current time
+ */
+void gps_lwm2m_observe(st_gps_lwm2m * o, uint8_t on, uint32_t now_ms);
+
+/** @fn void gps_lwm2m_report(st_gps_lwm2m * o)
+ * @brief The location changed and is to be reported.
+ * @param o observation
+ */
+void gps_lwm2m_report(st_gps_lwm2m * o);
+
+/** @fn uint8_t gps_lwm2m_due(const st_gps_lwm2m * o, uint32_t now_ms)
+ * @brief A notification is due: a report older than pmin, or pmax.
+ * @param o observation
+ * @param now_ms current time
+ * @return 1 when due
+ */
+uint8_t gps_lwm2m_due(const st_gps_lwm2m * o, uint32_t now_ms);
+
+/** @fn void gps_lwm2m_sent(st_gps_lwm2m * o, uint32_t now_ms, uint16_t payload)
+ * @brief A notification was sent.
+ * @param o observation
+ * @param now_ms current time
+ * @param payload TLV length
+ */
+void gps_lwm2m_sent(st_gps_lwm2m * o, uint32_t now_ms, uint16_t payload);
+
+#if(MZ_LWM2M_ENABLE == MZ_ENABLE)
+
+/** @fn void gps_lwm2m_init(void)
+ * @brief Location not observed until the server asks.
+ */
+void gps_lwm2m_init(void);
+
+/** @fn void gps_lwm2m_event(void * evnt)
+ * @brief LwM2M event of the MonoZ client, st_lw_event.
+ * @param evnt event
+ */
+void gps_lwm2m_event(void * evnt);
+
+/** @fn void gps_lwm2m_set(const st_gps_fix * fix)
+ * @brief Report a location, it is notified when due.
+ * @param fix fix
+ */
+void gps_lwm2m_set(const st_gps_fix * fix);
+
+/** @fn uint8_t gps_lwm2m_pending(uint32_t now_ms)
+ * @brief A notification is due, ask from the thread loop.
+ * @param now_ms current tick
+ * @return 1 when due
+ */
+uint8_t gps_lwm2m_pending(uint32_t now_ms);
+
+/** @fn mz_error_t gps_lwm2m_notify(uint32_t now_ms)
+ * @brief Notify the location set last.
+ * @param now_ms current tick
+ * @return MZ_OK when the client took it
+ */
+mz_error_t gps_lwm2m_notify(uint32_t now_ms);
+
+/** @fn void gps_lwm2m_get_stats(st_gps_lwm2m_stats * stats)
+ * @brief Copy the notification counters.
+ * @param stats output
+ */
+void gps_lwm2m_get_stats(st_gps_lwm2m_stats * stats);
+
+#endif //(MZ_LWM2M_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_LWM2M_H_ */
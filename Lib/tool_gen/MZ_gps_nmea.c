@@ -0,0 +1,176 @@
+/*
+ * MZ_gps_nmea.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_nmea.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define NMEA_ID_LEN					(6)							///< "$GPRMC"
+#define NMEA_TYPE_OFFSET			(3)							///< Sentence type after "$" and the talker id
+#define NMEA_RMC_FIELDS				(10)						///< Fields used up to the date
+#define NMEA_GGA_FIELDS				(10)						///< Fields used up to the altitude
+#define NMEA_GSA_FIELDS				(18)						///< Fields used up to VDOP
+/* Define some common use MACRO - END */
+
+/** @fn static int8_t nmea_hex(char c)
+ * @brief Value of one hex digit, -1 if not a digit
+ */
+static int8_t nmea_hex(char c)
+{
+	if((c >= '0') && (c <= '9'))
+	{
+		return (int8_t)(c - '0');
+	}
+	if((c >= 'A') && (c <= 'F'))
+	{
+		return (int8_t)(c - 'A' + 10);
+	}
+	if((c >= 'a') && (c <= 'f'))
+	{
+		return (int8_t)(c - 'a' + 10);
+	}
+	return -1;
+}
+
+/*
+ * Validate and decode one sentence. - START
+ */
+en_gps_nmea_sentence gps_nmea_parse_sentence(const char * s, uint16_t len, st_gps_fix * fix)
+{
+	const char * field[GPS_NMEA_MAX_FIELDS];
+	uint8_t count = 1;
+	uint8_t sum = 0;
+	uint16_t i;
+	int8_t hi;
+	int8_t lo;
+
+	if((len < NMEA_ID_LEN) || (s[0] != '$'))
+	{
+		return GPS_NMEA_INVALID;
+	}
+
+	/* Checksum over everything between '$' and '*', field starts on the way */
+	field[0] = s;
+	for(i = 1; (i < len) && (s[i] != '*'); i++)
+	{
+		sum ^= (uint8_t)s[i];
+		if((s[i] == ',') && (count < GPS_NMEA_MAX_FIELDS))
+		{
+			field[count++] = &s[i + 1];
+		}
+	}
+	if((i + 2) >= len)
+	{
+		return GPS_NMEA_INVALID;
+	}
+	hi = nmea_hex(s[i + 1]);
+	lo = nmea_hex(s[i + 2]);
+	if((hi < 0) || (lo < 0) || (sum != (uint8_t)((hi << 4) | lo)))
+	{
+		return GPS_NMEA_INVALID;
+	}
+
+	/* Fields end at ',' or '*', the fix helpers stop on both */
+	if(0 == strncmp(&s[NMEA_TYPE_OFFSET], "RMC", 3))
+	{
+		/* $GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A
+		   time, status A/V, latitude, N/S, longitude, E/W, knots, track angle, ddmmyy */
+		if(count < NMEA_RMC_FIELDS)
+		{
+			return GPS_NMEA_INVALID;
+		}
+		fix->utc_time = (uint32_t)gps_fix_parse_scaled(field[1], 3);
+		fix->utc_ms = (uint16_t)(fix->utc_time % 1000);
+		fix->utc_time /= 1000;
+		fix->valid = (field[2][0] == 'A') ? GPS_FIX_VALID : GPS_FIX_INVALID;
+		fix->lat_e7 = gps_fix_parse_coord(field[3], field[4][0]);
+		fix->lon_e7 = gps_fix_parse_coord(field[5], field[6][0]);
+		fix->speed_cms = gps_fix_knots_to_cms(gps_fix_parse_scaled(field[7], 3));
+		fix->course_cdeg = (uint16_t)gps_fix_parse_scaled(field[8], 2);
+		fix->utc_date = (uint32_t)gps_fix_parse_scaled(field[9], 0);
+		return GPS_NMEA_RMC;
+	}
+	if(0 == strncmp(&s[NMEA_TYPE_OFFSET], "GGA", 3))
+	{
+		/* $GPGGA,101902.00,2951.91860,N,07752.38737,E,1,05,3.95,248.4,M,-36.3,M,,*7A
+		   7 = satellites in use, 9 = altitude above mean sea level in m */
+		if(count < NMEA_GGA_FIELDS)
+		{
+			return GPS_NMEA_INVALID;
+		}
+		fix->sats = (uint8_t)gps_fix_parse_scaled(field[7], 0);
+		fix->alt_cm = gps_fix_parse_scaled(field[9], 2);
+		return GPS_NMEA_GGA;
+	}
+	if(0 == strncmp(&s[NMEA_TYPE_OFFSET], "GSA", 3))
+	{
+		/* $GPGSA,A,3,06,02,19,24,17,,,,,,,,4.73,3.95,2.60*05
+		   mode, nav mode, 12 satellite ids, PDOP, HDOP, VDOP */
+		if(count < NMEA_GSA_FIELDS)
+		{
+			return GPS_NMEA_INVALID;
+		}
+		fix->pdop_x100 = (uint16_t)gps_fix_parse_scaled(field[15], 2);
+		fix->hdop_x100 = (uint16_t)gps_fix_parse_scaled(field[16], 2);
+		fix->vdop_x100 = (uint16_t)gps_fix_parse_scaled(field[17], 2);
+		return GPS_NMEA_GSA;
+	}
+	return GPS_NMEA_OTHER;
+}
+/* Validate and decode one sentence. - END */
+
+/*
+ * Decode every sentence of a receive buffer. - START
+ */
+void gps_nmea_parse_buffer(const char * buf, uint16_t len, st_gps_fix * fix, st_gps_nmea_stats * stats)
+{
+	uint16_t start = 0;
+
+	while(start < len)
+	{
+		const char * line = memchr(&buf[start], '$', len - start);
+		const char * end;
+		uint16_t line_len;
+		en_gps_nmea_sentence type;
+
+		if(line == NULL)
+		{
+			break;
+		}
+		start = (uint16_t)(line - buf);
+
+		/* Sentence ends at CR/LF or at the next '$' */
+		end = line + 1;
+		while((end < &buf[len]) && (*end != '\r') && (*end != '\n') && (*end != '$'))
+		{
+			end++;
+		}
+		line_len = (uint16_t)(end - line);
+
+		type = gps_nmea_parse_sentence(line, line_len, fix);
+		if(stats != NULL)
+		{
+			if(type == GPS_NMEA_INVALID)
+			{
+				stats->invalid++;
+			}
+			else if(type == GPS_NMEA_OTHER)
+			{
+				stats->other++;
+			}
+			else
+			{
+				stats->decoded++;
+			}
+		}
+		start += line_len;
+	}
+}
+/* Decode every sentence of a receive buffer. - END */
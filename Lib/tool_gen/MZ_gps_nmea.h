@@ -0,0 +1,64 @@
+/*
+ * MZ_gps_nmea.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  NMEA 0183 sentence parser. Sentences are validated (start, checksum,
+ *  field count) and decoded straight from the receive buffer into a
+ *  st_gps_fix, without copying lines or fields. Any talker id is accepted
+ *  ($GP, $GN, $GL...). No HAL or MonoZ dependency, the module only needs
+ *  the C library and builds as is for a host.
+ */
+
+#ifndef MZ_GPS_NMEA_H_
+#define MZ_GPS_NMEA_H_
+
+#include "stdint.h"
+#include "MZ_gps_fix.h"
+
+#define GPS_NMEA_MAX_FIELDS			(24)					///< Fields kept per sentence, the rest is ignored
+
+/**
+ * @enum en_gps_nmea_sentence
+ * @brief Result of one sentence
+ */
+typedef enum
+{
+	GPS_NMEA_INVALID = 0,										/*!< Bad framing, checksum or field count */
+	GPS_NMEA_RMC,												/*!< Recommended minimum data */
+	GPS_NMEA_GGA,												/*!< Fix data */
+	GPS_NMEA_GSA,												/*!< DOP and active satellites */
+	GPS_NMEA_OTHER,												/*!< Valid sentence that is not decoded */
+}en_gps_nmea_sentence;
+
+/**
+ * @struct st_gps_nmea_stats
+ * @brief Parser counters
+ */
+typedef struct
+{
+	uint32_t		decoded;									/*!< RMC / GGA / GSA sentences applied to the fix */
+	uint32_t		other;										/*!< Valid sentences that are not decoded */
+	uint32_t		invalid;									/*!< Rejected sentences */
+}st_gps_nmea_stats;
+
+/** @fn en_gps_nmea_sentence gps_nmea_parse_sentence(const char * s, uint16_t len, st_gps_fix * fix)
+ * @brief Validate and decode one sentence.
+ * @param s sentence starting at '$', without line end
+ * @param len sentence length
+ * @param fix updated with the decoded fields
+ * @return sentence type, GPS_NMEA_INVALID leaves the fix untouched
+ */
+en_gps_nmea_sentence gps_nmea_parse_sentence(const char * s, uint16_t len, st_gps_fix * fix);
+
+/** @fn void gps_nmea_parse_buffer(const char * buf, uint16_t len, st_gps_fix * fix, st_gps_nmea_stats * stats)
+ * @brief Decode every sentence of a receive buffer. Partial sentences at
+ * the start or end of the buffer fail the checksum and are dropped.
+ * @param buf receive buffer
+ * @param len number of characters in buf
+ * @param fix updated with the decoded fields
+ * @param stats counters, may be NULL
+ */
+void gps_nmea_parse_buffer(const char * buf, uint16_t len, st_gps_fix * fix, st_gps_nmea_stats * stats);
+
+#endif /* MZ_GPS_NMEA_H_ */
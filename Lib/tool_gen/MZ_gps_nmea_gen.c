@@ -0,0 +1,527 @@
+/*
+ * MZ_gps_nmea_gen.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_nmea_gen.h"
+#include "MZ_gps_ubx.h"
+#include "stdio.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define GEN_LINE_SIZE				(128)						///< One sentence with CR LF
+#define GEN_FIELD_SIZE				(16)						///< One formatted field
+#define GEN_CS_PER_DAY				(8640000UL)					///< 1/100 s per day
+#define GEN_QUARTER_CDEG			(9000)
+#define GEN_HALF_CDEG				(18000)
+#define GEN_FULL_CDEG				(36000)
+#define GEN_CDEG_TO_E7				(100000L)					///< 1/100 degree in 1e-7 degree
+#define GEN_ALT_CM					(24840)						///< Reported altitude
+#define GEN_GEOID_CM				(-3630)						///< Reported geoid separation
+#define GEN_COURSE_MIN_CMS			(10)						///< Course is left empty below this, as at rest
+#define GEN_GSA_SATS				(12)						///< Satellite fields of $GPGSA
+#define GEN_GPS_EPOCH_UNIX			(315964800UL)				///< 1980-01-06 in unix time
+#define GEN_GPS_LEAP_S				(18UL)						///< GPS - UTC
+#define GEN_WEEK_S					(604800UL)
+#define GEN_POSLLH_LEN				(28)						///< NAV-POSLLH payload
+#define GEN_PMREQ_LEN				(8)							///< RXM-PMREQ payload
+#define GEN_PMREQ_BACKUP			(0x02)						///< RXM-PMREQ flags, enter backup
+#define GEN_BACKUP_FOREVER_CS		(0x7FFFFFFFUL)				///< Duration 0, only a reset would wake it
+#define GEN_RST_LEN					(4)							///< CFG-RST payload
+#define GEN_RST_EPH					(0x0001)					///< CFG-RST navBbrMask, clear the ephemeris
+#define GEN_RST_ALL					(0xFFFF)					///< Clear everything
+#define GEN_AID_INI_LEN				(48)						///< AID-INI payload
+#define GEN_AID_INI_POS_TIME		(0x03)						///< AID-INI flags, position and time valid
+/* Define some common use MACRO - END */
+
+/**
+ * @struct st_gen_sat
+ * @brief One satellite of the $GxGSV block
+ */
+typedef struct
+{
+	uint8_t			prn;
+	uint8_t			elev;
+	uint16_t		az;
+	uint8_t			snr;
+}st_gen_sat;
+
+/* Sky of the example in gps_app_thread */
+static const st_gen_sat gen_gps_sky[] =
+{
+	{ 2, 62, 243, 34}, { 3,  0,  33,  0}, { 6, 65,  30, 32}, {11, 64, 227, 32},
+	{17, 27,  62, 23}, {19, 41,  45, 29}, {20, 25, 174, 20}, {24, 34, 262, 32},
+	{28, 42, 121, 19},
+};
+
+static const st_gen_sat gen_glonass_sky[] =
+{
+	{65, 48, 310, 30}, {71, 22,  95, 24}, {72, 57,  18, 33}, {80, 13, 201, 18},
+};
+
+/* Satellites in use, the strongest of the sky first */
+static const uint8_t gen_gsa_prn[GEN_GSA_SATS] = { 6, 2, 19, 24, 17, 12, 11, 28, 20, 3, 1, 4 };
+
+#define GEN_GPS_SATS				(sizeof(gen_gps_sky) / sizeof(gen_gps_sky[0]))
+#define GEN_GLONASS_SATS			(sizeof(gen_glonass_sky) / sizeof(gen_glonass_sky[0]))
+
+/** @fn static int32_t gen_cos_q15(int32_t cdeg)
+ * @brief Cosine of any angle in 1/100 degree, Q15
+ */
+static int32_t gen_cos_q15(int32_t cdeg)
+{
+	cdeg %= GEN_FULL_CDEG;
+	if(cdeg < 0)
+	{
+		cdeg += GEN_FULL_CDEG;
+	}
+	if(cdeg > GEN_HALF_CDEG)
+	{
+		cdeg = GEN_FULL_CDEG - cdeg;
+	}
+	if(cdeg <= GEN_QUARTER_CDEG)
+	{
+		return gps_fix_cos_q15(cdeg * GEN_CDEG_TO_E7);
+	}
+	return -gps_fix_cos_q15((GEN_HALF_CDEG - cdeg) * GEN_CDEG_TO_E7);
+}
+
+/** @fn static void gen_coord(char * out, int32_t v_e7, uint8_t deg_digits)
+ * @brief 1e-7 degree to NMEA (d)ddmm.mmmmm
+ */
+static void gen_coord(char * out, int32_t v_e7, uint8_t deg_digits)
+{
+	uint32_t mag = (v_e7 < 0) ? (uint32_t)(-(int64_t)v_e7) : (uint32_t)v_e7;
+	uint32_t deg = mag / 10000000UL;
+	uint32_t min_e5 = (((mag % 10000000UL) * 60UL) + 50UL) / 100UL;
+
+	/* Rounded up to a full degree */
+	if(min_e5 >= 6000000UL)
+	{
+		deg++;
+		min_e5 -= 6000000UL;
+	}
+	sprintf(out,"%0*lu%02lu.%05lu",deg_digits,(unsigned long)deg,(unsigned long)(min_e5 / 100000UL),(unsigned long)(min_e5 % 100000UL));
+}
+
+/** @fn static uint16_t gen_put(st_gps_nmea_gen * gen, char * buf, uint16_t size, uint16_t pos, const char * body)
+ * @brief Frame one sentence body, inject the configured faults and append it
+ */
+static uint16_t gen_put(st_gps_nmea_gen * gen, char * buf, uint16_t size, uint16_t pos, const char * body)
+{
+	char line[GEN_LINE_SIZE];
+	uint8_t sum = 0;
+	uint16_t len;
+
+	for(const char * p = body; *p != '\0'; p++)
+	{
+		sum ^= (uint8_t)*p;
+	}
+
+	gen->sentence_count++;
+	if((gen->cfg.corrupt_every != 0) && ((gen->sentence_count % gen->cfg.corrupt_every) == 0))
+	{
+		sum ^= 0x55;
+	}
+
+	len = (uint16_t)snprintf(line, sizeof(line), "$%s*%02X\r\n", body, sum);
+	if(len >= sizeof(line))
+	{
+		return pos;
+	}
+
+	if((gen->cfg.drop_every != 0) && ((gen->sentence_count % gen->cfg.drop_every) == 0))
+	{
+		/* Lose one byte in the middle of the sentence */
+		memmove(&line[len / 2], &line[(len / 2) + 1], len - (len / 2));
+		len--;
+	}
+
+	if((uint32_t)(pos + len) >= size)
+	{
+		return pos;
+	}
+	memcpy(&buf[pos], line, len + 1);
+	return pos + len;
+}
+
+/** @fn static uint16_t gen_gsv(st_gps_nmea_gen * gen, char * buf, uint16_t size, uint16_t pos, const char * talker, const st_gen_sat * sky, uint8_t count)
+ * @brief Satellites in view, four per sentence
+ */
+static uint16_t gen_gsv(st_gps_nmea_gen * gen, char * buf, uint16_t size, uint16_t pos, const char * talker, const st_gen_sat * sky, uint8_t count)
+{
+	char body[GEN_LINE_SIZE];
+	uint8_t lines = (count + 3) / 4;
+
+	for(uint8_t l = 0; l < lines; l++)
+	{
+		int n = sprintf(body,"%sGSV,%u,%u,%02u",talker,lines,l + 1,count);
+
+		for(uint8_t i = l * 4; (i < count) && (i < ((l + 1) * 4)); i++)
+		{
+			if(sky[i].snr != 0)
+			{
+				n += sprintf(&body[n],",%02u,%02u,%03u,%02u",sky[i].prn,sky[i].elev,sky[i].az,sky[i].snr);
+			}
+			else
+			{
+				n += sprintf(&body[n],",%02u,%02u,%03u,",sky[i].prn,sky[i].elev,sky[i].az);
+			}
+		}
+		pos = gen_put(gen, buf, size, pos, body);
+	}
+	return pos;
+}
+
+/** @fn static void gen_update_fix(st_gps_nmea_gen * gen)
+ * @brief Refresh the truth fix from the trajectory state
+ */
+static void gen_update_fix(st_gps_nmea_gen * gen)
+{
+	uint32_t s = gen->time_cs / 100;
+
+	gps_fix_offset_apply(gen->cfg.lat_e7, gen->cfg.lon_e7, gen->east_cm, gen->north_cm, &gen->fix.lat_e7, &gen->fix.lon_e7);
+	gen->fix.utc_time = ((s / 3600) * 10000) + (((s / 60) % 60) * 100) + (s % 60);
+	gen->fix.utc_ms = (uint16_t)((gen->time_cs % 100) * 10);
+	gen->fix.course_cdeg = (uint16_t)gen->course_cdeg;
+}
+
+/** @fn static void gen_start(st_gps_nmea_gen * gen)
+ * @brief Begin a receiver start, its kind depends on the ephemeris age
+ */
+static void gen_start(st_gps_nmea_gen * gen)
+{
+	uint16_t secs;
+
+	if(!gen->has_eph && !gen->has_pos)
+	{
+		gen->start = GPS_NMEA_GEN_START_COLD;
+		secs = (gen->cfg.cold_s != 0) ? gen->cfg.cold_s : GPS_NMEA_GEN_COLD_S;
+	}
+	else if(!gen->has_eph || ((gen->run_cs - gen->eph_cs) > (GPS_NMEA_GEN_EPH_VALID_S * 100UL)))
+	{
+		gen->start = GPS_NMEA_GEN_START_WARM;
+		secs = (gen->cfg.warm_s != 0) ? gen->cfg.warm_s : GPS_NMEA_GEN_WARM_S;
+	}
+	else
+	{
+		gen->start = GPS_NMEA_GEN_START_HOT;
+		secs = (gen->cfg.hot_s != 0) ? gen->cfg.hot_s : GPS_NMEA_GEN_HOT_S;
+	}
+	gen->start_cs = gen->run_cs;
+	gen->fix_cs = gen->run_cs + (secs * 100UL);
+	gen->tracking = 0;
+}
+
+/** @fn static uint8_t gen_power_step(st_gps_nmea_gen * gen)
+ * @brief Receiver state of the current epoch, 0 = silent, 1 = void, 2 = fix
+ */
+static uint8_t gen_power_step(st_gps_nmea_gen * gen)
+{
+	if(!gen->powered)
+	{
+		if((int32_t)(gen->run_cs - gen->wake_cs) < 0)
+		{
+			return 0;
+		}
+		/* Backup period over, the receiver wakes by itself */
+		gen->powered = 1;
+		gen_start(gen);
+	}
+
+	if(gen->sky_blocked || ((int32_t)(gen->run_cs - gen->fix_cs) < 0))
+	{
+		return 1;
+	}
+
+	if(!gen->tracking)
+	{
+		gen->tracking = 1;
+		gen->track_cs = gen->run_cs;
+	}
+	if((gen->run_cs - gen->track_cs) >= (GPS_NMEA_GEN_EPH_TRACK_S * 100UL))
+	{
+		/* Long enough to decode the ephemeris subframes */
+		gen->has_eph = 1;
+		gen->has_pos = 1;
+		gen->eph_cs = gen->run_cs;
+	}
+	return 2;
+}
+
+/*
+ * Initialize a generator. - START
+ */
+void gps_nmea_gen_init(st_gps_nmea_gen * gen, const st_gps_nmea_gen_cfg * cfg)
+{
+	memset(gen, 0, sizeof(*gen));
+	gen->cfg = *cfg;
+	if((gen->cfg.rate_hz == 0) || (gen->cfg.rate_hz > 10))
+	{
+		gen->cfg.rate_hz = 1;
+	}
+
+	gen->time_cs = (((cfg->utc_time / 10000) * 3600) + (((cfg->utc_time / 100) % 100) * 60) + (cfg->utc_time % 100)) * 100;
+	gen->course_cdeg = cfg->course_cdeg % GEN_FULL_CDEG;
+
+	gen->fix.utc_date = cfg->utc_date;
+	gen->fix.speed_cms = cfg->speed_cms;
+	gen->fix.hdop_x100 = cfg->hdop_x100;
+	gen->fix.pdop_x100 = cfg->hdop_x100 + 90;
+	gen->fix.vdop_x100 = cfg->hdop_x100 + 50;
+	gen->fix.alt_cm = GEN_ALT_CM;
+	gen->fix.sats = 6;
+	gen->fix.valid = GPS_FIX_VALID;
+	gen_update_fix(gen);
+
+	/* Tracking with a fresh ephemeris from the start */
+	gen->powered = 1;
+	gen->tracking = 1;
+	gen->has_eph = 1;
+	gen->has_pos = 1;
+	gen->start = GPS_NMEA_GEN_START_HOT;
+}
+/* Initialize a generator. - END */
+
+/*
+ * Write the current epoch and advance. - START
+ */
+uint16_t gps_nmea_gen_epoch(st_gps_nmea_gen * gen, char * buf, uint16_t size)
+{
+	const st_gps_fix * f = &gen->fix;
+	const char * talker = gen->cfg.glonass ? "GN" : "GP";
+	uint32_t s = gen->time_cs / 100;
+	uint32_t knots_x1000 = ((uint32_t)f->speed_cms * 36000UL) / 1852UL;
+	uint32_t kmh_x1000 = (uint32_t)f->speed_cms * 36UL;
+	uint32_t dt_cs = 100 / gen->cfg.rate_hz;
+	char body[GEN_LINE_SIZE];
+	char t[GEN_FIELD_SIZE];
+	char lat[GEN_FIELD_SIZE];
+	char lon[GEN_FIELD_SIZE];
+	char course[GEN_FIELD_SIZE];
+	char ns = (f->lat_e7 < 0) ? 'S' : 'N';
+	char ew = (f->lon_e7 < 0) ? 'W' : 'E';
+	uint16_t pos = 0;
+	uint8_t state;
+
+	if(size == 0)
+	{
+		return 0;
+	}
+	buf[0] = '\0';
+
+	state = gen_power_step(gen);
+	if(state == 0)
+	{
+		goto advance;
+	}
+
+	sprintf(t,"%02lu%02lu%02lu.%02lu",(unsigned long)(s / 3600),(unsigned long)((s / 60) % 60),(unsigned long)(s % 60),(unsigned long)(gen->time_cs % 100));
+	gen_coord(lat, f->lat_e7, 2);
+	gen_coord(lon, f->lon_e7, 3);
+
+	if(state == 1)
+	{
+		/* Searching, the shapes of a NEO-6M without a fix */
+		if(gen->cfg.sentences & GPS_NMEA_GEN_RMC)
+		{
+			sprintf(body,"%sRMC,%s,V,,,,,,,%06lu,,,N",talker,t,(unsigned long)f->utc_date);
+			pos = gen_put(gen, buf, size, pos, body);
+		}
+		if(gen->cfg.sentences & GPS_NMEA_GEN_VTG)
+		{
+			sprintf(body,"%sVTG,,,,,,,,,N",talker);
+			pos = gen_put(gen, buf, size, pos, body);
+		}
+		if(gen->cfg.sentences & GPS_NMEA_GEN_GGA)
+		{
+			sprintf(body,"%sGGA,%s,,,,,0,00,99.99,,,,,,",talker,t);
+			pos = gen_put(gen, buf, size, pos, body);
+		}
+		if(gen->cfg.sentences & GPS_NMEA_GEN_GSA)
+		{
+			sprintf(body,"%sGSA,A,1,,,,,,,,,,,,,99.99,99.99,99.99",talker);
+			pos = gen_put(gen, buf, size, pos, body);
+		}
+		if(gen->cfg.sentences & GPS_NMEA_GEN_GLL)
+		{
+			sprintf(body,"%sGLL,,,,,%s,V,N",talker,t);
+			pos = gen_put(gen, buf, size, pos, body);
+		}
+		goto advance;
+	}
+
+	/* Course over ground, empty at rest like the receiver leaves it */
+	course[0] = '\0';
+	if(f->speed_cms >= GEN_COURSE_MIN_CMS)
+	{
+		sprintf(course,"%u.%02u",f->course_cdeg / 100,f->course_cdeg % 100);
+	}
+
+	if(gen->cfg.sentences & GPS_NMEA_GEN_RMC)
+	{
+		sprintf(body,"%sRMC,%s,A,%s,%c,%s,%c,%lu.%03lu,%s,%06lu,,,A",talker,t,lat,ns,lon,ew,
+				(unsigned long)(knots_x1000 / 1000),(unsigned long)(knots_x1000 % 1000),
+				course,(unsigned long)f->utc_date);
+		pos = gen_put(gen, buf, size, pos, body);
+	}
+	if(gen->cfg.sentences & GPS_NMEA_GEN_VTG)
+	{
+		sprintf(body,"%sVTG,%s,T,,M,%lu.%03lu,N,%lu.%03lu,K,A",talker,course,
+				(unsigned long)(knots_x1000 / 1000),(unsigned long)(knots_x1000 % 1000),
+				(unsigned long)(kmh_x1000 / 1000),(unsigned long)(kmh_x1000 % 1000));
+		pos = gen_put(gen, buf, size, pos, body);
+	}
+	if(gen->cfg.sentences & GPS_NMEA_GEN_GGA)
+	{
+		sprintf(body,"%sGGA,%s,%s,%c,%s,%c,1,%02u,%u.%02u,%ld.%ld,M,%ld.%ld,M,,",talker,t,lat,ns,lon,ew,f->sats,
+				f->hdop_x100 / 100,f->hdop_x100 % 100,
+				(long)(f->alt_cm / 100),(long)((f->alt_cm % 100) / 10),
+				(long)(GEN_GEOID_CM / 100),(long)((-GEN_GEOID_CM % 100) / 10));
+		pos = gen_put(gen, buf, size, pos, body);
+	}
+	if(gen->cfg.sentences & GPS_NMEA_GEN_GSA)
+	{
+		/* The first sats entries of the sky are the ones in use */
+		int n = sprintf(body,"%sGSA,A,3",talker);
+
+		for(uint8_t i = 0; i < GEN_GSA_SATS; i++)
+		{
+			n += (i < f->sats) ? sprintf(&body[n],",%02u",gen_gsa_prn[i]) : sprintf(&body[n],",");
+		}
+		sprintf(&body[n],",%u.%02u,%u.%02u,%u.%02u",
+				f->pdop_x100 / 100,f->pdop_x100 % 100,f->hdop_x100 / 100,f->hdop_x100 % 100,f->vdop_x100 / 100,f->vdop_x100 % 100);
+		pos = gen_put(gen, buf, size, pos, body);
+	}
+	if(gen->cfg.sentences & GPS_NMEA_GEN_GSV)
+	{
+		pos = gen_gsv(gen, buf, size, pos, "GP", gen_gps_sky, GEN_GPS_SATS);
+		if(gen->cfg.glonass)
+		{
+			pos = gen_gsv(gen, buf, size, pos, "GL", gen_glonass_sky, GEN_GLONASS_SATS);
+		}
+	}
+	if(gen->cfg.sentences & GPS_NMEA_GEN_GLL)
+	{
+		sprintf(body,"%sGLL,%s,%c,%s,%c,%s,A,A",talker,lat,ns,lon,ew,t);
+		pos = gen_put(gen, buf, size, pos, body);
+	}
+
+advance:
+	/* Move along the trajectory, also while the receiver is off */
+	{
+		int32_t dist_cm = (int32_t)(((uint32_t)gen->cfg.speed_cms * dt_cs) / 100);
+
+		gen->east_cm += (int32_t)(((int64_t)dist_cm * gen_cos_q15(gen->course_cdeg - GEN_QUARTER_CDEG)) >> 15);
+		gen->north_cm += (int32_t)(((int64_t)dist_cm * gen_cos_q15(gen->course_cdeg)) >> 15);
+		gen->course_cdeg = (gen->course_cdeg + ((gen->cfg.turn_cdeg_s * (int32_t)dt_cs) / 100) + GEN_FULL_CDEG) % GEN_FULL_CDEG;
+		gen->time_cs = (gen->time_cs + dt_cs) % GEN_CS_PER_DAY;
+		gen->run_cs += dt_cs;
+		gen_update_fix(gen);
+	}
+
+	return pos;
+}
+/* Write the current epoch and advance. - END */
+
+/*
+ * UBX frame sent to the receiver. - START
+ */
+uint8_t gps_nmea_gen_ubx_input(st_gps_nmea_gen * gen, const uint8_t * buf, uint16_t len)
+{
+	uint16_t plen = gps_ubx_check(buf, len);
+
+	if(plen == 0xFFFF)
+	{
+		return 0;
+	}
+
+	if((buf[2] == GPS_UBX_CLASS_RXM) && (buf[3] == GPS_UBX_RXM_PMREQ) && (plen >= GEN_PMREQ_LEN))
+	{
+		uint32_t duration_ms = gps_ubx_get_u32(&buf[6]);
+
+		if(gps_ubx_get_u32(&buf[10]) & GEN_PMREQ_BACKUP)
+		{
+			gen->powered = 0;
+			gen->tracking = 0;
+			gen->wake_cs = gen->run_cs + ((duration_ms != 0) ? ((duration_ms + 9) / 10) : GEN_BACKUP_FOREVER_CS);
+		}
+	}
+	else if((buf[2] == GPS_UBX_CLASS_CFG) && (buf[3] == GPS_UBX_CFG_RST) && (plen >= GEN_RST_LEN))
+	{
+		uint16_t bbr = (uint16_t)(buf[6] | (buf[7] << 8));
+
+		if(bbr & GEN_RST_EPH)
+		{
+			gen->has_eph = 0;
+		}
+		if(bbr == GEN_RST_ALL)
+		{
+			gen->has_pos = 0;
+		}
+		/* Restarts right away, also out of backup */
+		gen->powered = 1;
+		gen_start(gen);
+	}
+	else if((buf[2] == GPS_UBX_CLASS_AID) && (buf[3] == GPS_UBX_AID_INI) && (plen >= GEN_AID_INI_LEN))
+	{
+		if((gps_ubx_get_u32(&buf[6 + 44]) & GEN_AID_INI_POS_TIME) == GEN_AID_INI_POS_TIME)
+		{
+			gen->has_pos = 1;
+			if(gen->powered && (gen->start == GPS_NMEA_GEN_START_COLD) && ((int32_t)(gen->run_cs - gen->fix_cs) < 0))
+			{
+				/* Search narrowed to the satellites in view */
+				uint16_t secs = (gen->cfg.warm_s != 0) ? gen->cfg.warm_s : GPS_NMEA_GEN_WARM_S;
+
+				gen->start = GPS_NMEA_GEN_START_WARM;
+				gen->fix_cs = gen->start_cs + (secs * 100UL);
+			}
+		}
+	}
+	return 1;
+}
+/* UBX frame sent to the receiver. - END */
+
+/*
+ * Start or end a sky outage. - START
+ */
+void gps_nmea_gen_sky(st_gps_nmea_gen * gen, uint8_t visible)
+{
+	if(visible && gen->sky_blocked)
+	{
+		gen_start(gen);
+	}
+	gen->sky_blocked = !visible;
+	if(!visible)
+	{
+		gen->tracking = 0;
+	}
+}
+/* Start or end a sky outage. - END */
+
+/*
+ * UBX NAV-POSLLH frame of the current epoch. - START
+ */
+uint16_t gps_nmea_gen_ubx_posllh(const st_gps_nmea_gen * gen, uint8_t * buf, uint16_t size)
+{
+	uint8_t payload[GEN_POSLLH_LEN];
+	uint32_t unix_s = gps_fix_to_unix(&gen->fix);
+	uint32_t tow_ms = (((unix_s - GEN_GPS_EPOCH_UNIX + GEN_GPS_LEAP_S) % GEN_WEEK_S) * 1000UL) + ((gen->time_cs % 100) * 10UL);
+	int32_t hmsl_mm = gen->fix.alt_cm * 10;
+
+	gps_ubx_put_u32(&payload[0], tow_ms);
+	gps_ubx_put_u32(&payload[4], (uint32_t)gen->fix.lon_e7);
+	gps_ubx_put_u32(&payload[8], (uint32_t)gen->fix.lat_e7);
+	gps_ubx_put_u32(&payload[12], (uint32_t)(hmsl_mm + (GEN_GEOID_CM * 10)));
+	gps_ubx_put_u32(&payload[16], (uint32_t)hmsl_mm);
+	gps_ubx_put_u32(&payload[20], (uint32_t)gen->fix.hdop_x100 * 25UL);
+	gps_ubx_put_u32(&payload[24], (uint32_t)gen->fix.vdop_x100 * 25UL);
+
+	return gps_ubx_frame(GPS_UBX_CLASS_NAV, GPS_UBX_NAV_POSLLH, payload, GEN_POSLLH_LEN, buf, size);
+}
+/* UBX NAV-POSLLH frame of the current epoch. - END */
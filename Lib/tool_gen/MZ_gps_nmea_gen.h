@@ -0,0 +1,153 @@
+/*
+ * MZ_gps_nmea_gen.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Synthetic receiver output for load and soak testing.
+ *
+ *  Epochs are generated from a scripted trajectory (start point, speed and
+ *  turn rate) at 1..10 Hz, in the line shapes of a NEO-6M ($GPRMC, $GPVTG,
+ *  $GPGGA, $GPGSA, $GPGSV, $GPGLL) or with the $GN talker and a GLONASS
+ *  $GLGSV block. Checksum errors and dropped bytes can be injected every
+ *  Nth sentence. A UBX NAV-POSLLH frame of the same epoch is available
+ *  for binary protocol tests. Integer math only, no HAL dependency.
+ *
+ *  The receiver power states are emulated for power save tests. An
+ *  UBX RXM-PMREQ frame puts the receiver in backup for its duration, it
+ *  is silent and wakes by itself. After power up or a sky outage it
+ *  outputs void sentences until the start is over : hot start while the
+ *  ephemeris is fresh, warm start with an old one, cold start before the
+ *  first one. The ephemeris is refreshed by continuous tracking. UBX
+ *  CFG-RST restarts the receiver with the ephemeris cleared (navBbrMask
+ *  bit 0, warm start) or everything cleared (0xFFFF, cold start), UBX
+ *  AID-INI with position and time turns a cold start into a warm one.
+ */
+
+#ifndef MZ_GPS_NMEA_GEN_H_
+#define MZ_GPS_NMEA_GEN_H_
+
+#include "stdint.h"
+#include "MZ_gps_fix.h"
+
+#define GPS_NMEA_GEN_RMC			(0x01)					///< Sentence mask bits
+#define GPS_NMEA_GEN_VTG			(0x02)
+#define GPS_NMEA_GEN_GGA			(0x04)
+#define GPS_NMEA_GEN_GSA			(0x08)
+#define GPS_NMEA_GEN_GSV			(0x10)
+#define GPS_NMEA_GEN_GLL			(0x20)
+#define GPS_NMEA_GEN_ALL			(0x3F)
+
+#define GPS_NMEA_GEN_HOT_S			(1)						///< NEO-6M start times, used when the cfg leaves them 0
+#define GPS_NMEA_GEN_WARM_S			(28)
+#define GPS_NMEA_GEN_COLD_S			(32)
+#define GPS_NMEA_GEN_EPH_TRACK_S	(36)					///< Continuous tracking that refreshes the ephemeris
+#define GPS_NMEA_GEN_EPH_VALID_S	(7200)					///< Ephemeris age that still gives a hot start
+
+/**
+ * @enum en_gps_nmea_gen_start
+ * @brief Kind of the last receiver start
+ */
+typedef enum
+{
+	GPS_NMEA_GEN_START_HOT = 0,									/*!< Fresh ephemeris */
+	GPS_NMEA_GEN_START_WARM,									/*!< Time, position and almanac only */
+	GPS_NMEA_GEN_START_COLD,									/*!< Nothing known */
+}en_gps_nmea_gen_start;
+
+/**
+ * @struct st_gps_nmea_gen_cfg
+ * @brief Trajectory and stream shape
+ */
+typedef struct
+{
+	int32_t			lat_e7;										/*!< Start latitude */
+	int32_t			lon_e7;										/*!< Start longitude */
+	uint32_t		utc_time;									/*!< Start time hhmmss */
+	uint32_t		utc_date;									/*!< Date ddmmyy */
+	uint16_t		speed_cms;									/*!< Constant speed */
+	uint16_t		course_cdeg;								/*!< Start course */
+	int16_t			turn_cdeg_s;								/*!< Course change per second */
+	uint16_t		hdop_x100;									/*!< Reported HDOP */
+	uint8_t			rate_hz;									/*!< Epochs per second, 1..10 */
+	uint8_t			sentences;									/*!< GPS_NMEA_GEN_* mask */
+	uint8_t			glonass;									/*!< Use $GN and add a $GLGSV block */
+	uint16_t		corrupt_every;								/*!< Every Nth sentence has a wrong checksum, 0 = off */
+	uint16_t		drop_every;									/*!< Every Nth sentence loses a byte, 0 = off */
+	uint16_t		hot_s;										/*!< Hot start time, 0 = GPS_NMEA_GEN_HOT_S */
+	uint16_t		warm_s;										/*!< Warm start time, 0 = GPS_NMEA_GEN_WARM_S */
+	uint16_t		cold_s;										/*!< Cold start time, 0 = GPS_NMEA_GEN_COLD_S */
+}st_gps_nmea_gen_cfg;
+
+/**
+ * @struct st_gps_nmea_gen
+ * @brief Generator state
+ */
+typedef struct
+{
+	st_gps_nmea_gen_cfg		cfg;								/*!< Stream shape */
+	st_gps_fix				fix;								/*!< Truth of the current epoch */
+	int32_t					east_cm;							/*!< Position from the start point */
+	int32_t					north_cm;
+	int32_t					course_cdeg;						/*!< Current course */
+	uint32_t				time_cs;							/*!< Time of day in 1/100 s */
+	uint32_t				sentence_count;						/*!< Sentences written */
+	uint32_t				run_cs;								/*!< Time since init, does not wrap at midnight */
+	uint32_t				start_cs;							/*!< run_cs the current start began */
+	uint32_t				fix_cs;								/*!< run_cs of the first fix of the current start */
+	uint32_t				wake_cs;							/*!< run_cs the backup period ends */
+	uint32_t				track_cs;							/*!< run_cs continuous tracking started */
+	uint32_t				eph_cs;								/*!< run_cs the ephemeris was last refreshed */
+	uint8_t					powered;							/*!< 0 in backup */
+	uint8_t					tracking;							/*!< Fix output since track_cs */
+	uint8_t					has_eph;							/*!< An ephemeris was ever collected */
+	uint8_t					has_pos;							/*!< Position and time known, from tracking or aiding */
+	uint8_t					sky_blocked;						/*!< No satellite visible */
+	en_gps_nmea_gen_start	start;								/*!< Kind of the last start */
+}st_gps_nmea_gen;
+
+/** @fn void gps_nmea_gen_init(st_gps_nmea_gen * gen, const st_gps_nmea_gen_cfg * cfg)
+ * @brief Initialize a generator.
+ * @param gen generator
+ * @param cfg trajectory and stream shape
+ */
+void gps_nmea_gen_init(st_gps_nmea_gen * gen, const st_gps_nmea_gen_cfg * cfg);
+
+/** @fn uint16_t gps_nmea_gen_epoch(st_gps_nmea_gen * gen, char * buf, uint16_t size)
+ * @brief Write the sentences of the current epoch and advance the
+ * trajectory to the next one. Sentences that do not fit are left out.
+ * @param gen generator
+ * @param buf output, NUL terminated
+ * @param size size of buf
+ * @return number of characters written
+ */
+uint16_t gps_nmea_gen_epoch(st_gps_nmea_gen * gen, char * buf, uint16_t size);
+
+/** @fn uint8_t gps_nmea_gen_ubx_input(st_gps_nmea_gen * gen, const uint8_t * buf, uint16_t len)
+ * @brief UBX frame sent to the receiver. RXM-PMREQ with the backup flag,
+ * CFG-RST and AID-INI are emulated, other valid frames are accepted
+ * without effect.
+ * @param gen generator
+ * @param buf frame
+ * @param len frame length
+ * @return 1 when the frame is valid
+ */
+uint8_t gps_nmea_gen_ubx_input(st_gps_nmea_gen * gen, const uint8_t * buf, uint16_t len);
+
+/** @fn void gps_nmea_gen_sky(st_gps_nmea_gen * gen, uint8_t visible)
+ * @brief Start or end a sky outage (tunnel, indoor). The fix is lost and
+ * comes back after a start of the kind the ephemeris age gives.
+ * @param gen generator
+ * @param visible 0 while no satellite is visible
+ */
+void gps_nmea_gen_sky(st_gps_nmea_gen * gen, uint8_t visible);
+
+/** @fn uint16_t gps_nmea_gen_ubx_posllh(const st_gps_nmea_gen * gen, uint8_t * buf, uint16_t size)
+ * @brief UBX NAV-POSLLH frame of the current epoch.
+ * @param gen generator
+ * @param buf output
+ * @param size size of buf
+ * @return frame length, 0 when buf is too small
+ */
+uint16_t gps_nmea_gen_ubx_posllh(const st_gps_nmea_gen * gen, uint8_t * buf, uint16_t size);
+
+#endif /* MZ_GPS_NMEA_GEN_H_ */
@@ -0,0 +1,116 @@
+/*
+ * MZ_gps_payload.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_payload.h"
+#include "MZ_gps_time.h"
+#include "stdio.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define MZ_MZTT_KEY1			"latitude"
+#define MZ_MZTT_KEY2			"longitude"
+#define MZ_MZTT_KEY3			"PDOP"
+#define MZ_MZTT_KEY4			"HDOP"
+#define MZ_MZTT_KEY5			"VDOP"
+#define MZ_MZTT_KEY_FENCE		"geofence"
+#define MZ_MZTT_KEY_FENCE_EV	"event"
+#define GPS_PAYLOAD_END			(26)						///< Ctrl-Z, end of the MonoZ payload
+/* Define some common use MACRO - END */
+
+#if(GPS_TIME_ENABLE == MZ_ENABLE)
+/** @fn static int gps_payload_ts_open(char * buff)
+ * @brief Timestamped payload opening - START
+ * Writes the {"ts":ms,"values": prefix from the RTC. The caller closes it
+ * with one more '}'.
+ * @param buff payload buffer
+ * @return characters written, 0 when the RTC does not carry GPS time yet
+ */
+static int gps_payload_ts_open(char * buff)
+{
+	uint32_t sec;
+	uint16_t ms;
+
+	if(!gps_time_now(&sec, &ms))
+	{
+		return 0;
+	}
+	return sprintf(buff,"{\"ts\":%lu%03u,\"values\":",(unsigned long)sec,ms);
+}
+/* Timestamped payload opening - END */
+#endif
+
+/*
+ * Fix snapshot. - START
+ */
+int gps_payload_fix(const st_gps_fix * pos, const st_gps_fix * dop, char * buff)
+{
+	int len = 0;
+#if(GPS_TIME_ENABLE == MZ_ENABLE)
+	/* Timestamped from the RTC, also while the receiver is off */
+	int ts = len = gps_payload_ts_open(buff);
+#endif
+
+	len += sprintf(&buff[len],"{\"%s\":",MZ_MZTT_KEY1);
+	len += gps_fix_format_e7(&buff[len], pos->lat_e7);
+	len += sprintf(&buff[len],",\"%s\":",MZ_MZTT_KEY2);
+	len += gps_fix_format_e7(&buff[len], pos->lon_e7);
+	len += sprintf(&buff[len],",\"%s\":%u.%02u,\"%s\":%u.%02u,\"%s\":%u.%02u}",
+					MZ_MZTT_KEY3,dop->pdop_x100 / 100,dop->pdop_x100 % 100,
+					MZ_MZTT_KEY4,dop->hdop_x100 / 100,dop->hdop_x100 % 100,
+					MZ_MZTT_KEY5,dop->vdop_x100 / 100,dop->vdop_x100 % 100);
+#if(GPS_TIME_ENABLE == MZ_ENABLE)
+	if(ts != 0)
+	{
+		buff[len++] = '}';
+	}
+#endif
+	return len + sprintf(&buff[len],"%c",GPS_PAYLOAD_END);
+}
+/* Fix snapshot. - END */
+
+/*
+ * Track batch. - START
+ */
+int gps_payload_batch(const st_gps_fix * fixes, uint16_t count, char * buff)
+{
+	int len = 0;
+
+	buff[len++] = '[';
+	for(uint16_t i = 0; i < count; i++)
+	{
+		len += sprintf(&buff[len],"%s{\"ts\":%lu000,\"values\":{\"%s\":",(i == 0) ? "" : ",",(unsigned long)gps_fix_to_unix(&fixes[i]),MZ_MZTT_KEY1);
+		len += gps_fix_format_e7(&buff[len], fixes[i].lat_e7);
+		len += sprintf(&buff[len],",\"%s\":",MZ_MZTT_KEY2);
+		len += gps_fix_format_e7(&buff[len], fixes[i].lon_e7);
+		len += sprintf(&buff[len],",\"%s\":%u.%02u}}",MZ_MZTT_KEY4,fixes[i].hdop_x100 / 100,fixes[i].hdop_x100 % 100);
+	}
+	return len + sprintf(&buff[len],"]%c",GPS_PAYLOAD_END);
+}
+/* Track batch. - END */
+
+/*
+ * Geofence transition. - START
+ */
+int gps_payload_geofence(uint16_t id, uint8_t enter, char * buff)
+{
+	int len = 0;
+#if(GPS_TIME_ENABLE == MZ_ENABLE)
+	int ts = len = gps_payload_ts_open(buff);
+#endif
+
+	len += sprintf(&buff[len],"{\"%s\":%u,\"%s\":\"%s\"}",MZ_MZTT_KEY_FENCE,id,MZ_MZTT_KEY_FENCE_EV,enter ? "enter" : "exit");
+#if(GPS_TIME_ENABLE == MZ_ENABLE)
+	if(ts != 0)
+	{
+		buff[len++] = '}';
+	}
+#endif
+	return len + sprintf(&buff[len],"%c",GPS_PAYLOAD_END);
+}
+/* Geofence transition. - END */
@@ -0,0 +1,56 @@
+/*
+ * MZ_gps_payload.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  JSON telemetry payloads of the GPS application: the fix snapshot, the
+ *  simplified track batch and the geofence event. Each payload ends with
+ *  the Ctrl-Z (26) the MonoZ publish expects. With GPS_TIME_ENABLE the
+ *  snapshot and the event are wrapped as {"ts":ms,"values":{...}} from the
+ *  RTC once it carries GPS time, the batch has a timestamp per point from
+ *  its UTC fields. No HAL dependency, the buffers are sized by the caller
+ *  with the sizes below.
+ */
+
+#ifndef MZ_GPS_PAYLOAD_H_
+#define MZ_GPS_PAYLOAD_H_
+
+#include "stdint.h"
+#include "MZ_gps_app_config.h"
+#include "MZ_gps_fix.h"
+
+#define GPS_PAYLOAD_TOPIC			"\"v1/devices/me/telemetry\""	///< Publish topic of every payload
+#define GPS_PAYLOAD_FIX_SIZE		(200)					///< Fix snapshot buffer
+#define GPS_PAYLOAD_POINT_SIZE		(96)					///< One point of a batch
+#define GPS_PAYLOAD_BATCH_SIZE(n)	(((n) * GPS_PAYLOAD_POINT_SIZE) + 8)	///< Batch buffer for n points
+#define GPS_PAYLOAD_FENCE_SIZE		(96)					///< Geofence event buffer
+
+/** @fn int gps_payload_fix(const st_gps_fix * pos, const st_gps_fix * dop, char * buff)
+ * @brief Fix snapshot, latitude, longitude, PDOP, HDOP and VDOP.
+ * @param pos fix the position is taken from, e.g. the smoothed one
+ * @param dop fix the dilutions are taken from
+ * @param buff output, GPS_PAYLOAD_FIX_SIZE
+ * @return characters written, Ctrl-Z included
+ */
+int gps_payload_fix(const st_gps_fix * pos, const st_gps_fix * dop, char * buff);
+
+/** @fn int gps_payload_batch(const st_gps_fix * fixes, uint16_t count, char * buff)
+ * @brief Track batch, an array of {"ts":ms,"values":{...}} with latitude,
+ * longitude and HDOP of each point.
+ * @param fixes points, oldest first
+ * @param count number of points
+ * @param buff output, GPS_PAYLOAD_BATCH_SIZE(count)
+ * @return characters written, Ctrl-Z included
+ */
+int gps_payload_batch(const st_gps_fix * fixes, uint16_t count, char * buff);
+
+/** @fn int gps_payload_geofence(uint16_t id, uint8_t enter, char * buff)
+ * @brief Geofence transition.
+ * @param id fence id
+ * @param enter 1 for enter, 0 for exit
+ * @param buff output, GPS_PAYLOAD_FENCE_SIZE
+ * @return characters written, Ctrl-Z included
+ */
+int gps_payload_geofence(uint16_t id, uint8_t enter, char * buff);
+
+#endif /* MZ_GPS_PAYLOAD_H_ */
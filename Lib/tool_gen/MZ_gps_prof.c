@@ -0,0 +1,125 @@
+/*
+ * MZ_gps_prof.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_prof.h"
+#include "stdio.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+#if(GPS_PROF_ENABLE == MZ_ENABLE)
+
+/* Define some common use MACRO - START */
+#define PROF_LINE_SIZE				(48)						///< One dump fragment
+/* Define some common use MACRO - END */
+
+/* Profiler related variables - START */
+static st_gps_prof_probe prof_probes[GPS_PROF_PROBES];			/* Probe tables */
+static const char * const prof_names[GPS_PROF_PROBES] =
+{
+	"parse",
+	"commit",
+	"payload",
+	"publish",
+	"uart_isr",
+	"trace",
+};
+/* Profiler related variables - END */
+
+/*
+ * Start the time base and clear all probes. - START
+ */
+void gps_prof_init(void)
+{
+#if defined(__arm__)
+	/* Trace must be enabled for the DWT cycle counter to run */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+	memset(prof_probes, 0, sizeof(prof_probes));
+	for(uint8_t i = 0; i < GPS_PROF_PROBES; i++)
+	{
+		prof_probes[i].min = 0xFFFFFFFF;
+	}
+}
+/* Start the time base and clear all probes. - END */
+
+/*
+ * Add one duration to a probe. - START
+ */
+void gps_prof_record(en_gps_prof_probe id, uint32_t duration)
+{
+	st_gps_prof_probe * p = &prof_probes[id];
+	uint32_t bin = (duration == 0) ? 0 : (31 - (uint32_t)__builtin_clz(duration));
+
+	if(bin >= GPS_PROF_HIST_BINS)
+	{
+		bin = GPS_PROF_HIST_BINS - 1;
+	}
+
+	p->count++;
+	p->sum += duration;
+	if(duration < p->min)
+	{
+		p->min = duration;
+	}
+	if(duration > p->max)
+	{
+		p->max = duration;
+	}
+	p->hist[bin]++;
+}
+/* Add one duration to a probe. - END */
+
+/*
+ * Statistics of one probe. - START
+ */
+const st_gps_prof_probe * gps_prof_get(en_gps_prof_probe id)
+{
+	return &prof_probes[id];
+}
+/* Statistics of one probe. - END */
+
+/*
+ * Print every probe. - START
+ */
+void gps_prof_dump(gps_prof_out_fn out)
+{
+	char line[PROF_LINE_SIZE];
+
+	for(uint8_t i = 0; i < GPS_PROF_PROBES; i++)
+	{
+		const st_gps_prof_probe * p = &prof_probes[i];
+
+		if(p->count == 0)
+		{
+			continue;
+		}
+		sprintf(line,"prof %-8s n=%lu ",prof_names[i],(unsigned long)p->count);
+		out(line);
+		sprintf(line,"min=%lu avg=%lu max=%lu %s\r\n",(unsigned long)p->min,(unsigned long)(p->sum / p->count),(unsigned long)p->max,GPS_PROF_UNIT);
+		out(line);
+
+		/* Histogram, only the populated range */
+		out("  log2:");
+		for(uint8_t b = 0; b < GPS_PROF_HIST_BINS; b++)
+		{
+			if(p->hist[b] != 0)
+			{
+				sprintf(line," %u:%lu",b,(unsigned long)p->hist[b]);
+				out(line);
+			}
+		}
+		out("\r\n");
+	}
+}
+/* Print every probe. - END */
+
+#endif //(GPS_PROF_ENABLE == MZ_ENABLE)
@@ -0,0 +1,111 @@
+/*
+ * MZ_gps_prof.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Hot path profiling probes.
+ *
+ *  GPS_PROF_BEGIN / GPS_PROF_END bracket a block and record its duration
+ *  in the table of the probe : count, min, max, sum and a log2 histogram.
+ *  On target the time base is the Cortex-M4 DWT cycle counter, on a host
+ *  it is the monotonic clock in ns. A probe must only be used from one
+ *  context (thread or ISR). With GPS_PROF_ENABLE off the macros expand to
+ *  nothing and the module is empty.
+ */
+
+#ifndef MZ_GPS_PROF_H_
+#define MZ_GPS_PROF_H_
+
+#include "stdint.h"
+#include "MZ_gps_app_config.h"
+
+/**
+ * @enum en_gps_prof_probe
+ * @brief Profiled blocks
+ */
+typedef enum
+{
+	GPS_PROF_PARSE = 0,											/*!< NMEA buffer parse */
+	GPS_PROF_COMMIT,											/*!< Epoch commit and its consumers */
+	GPS_PROF_PAYLOAD,											/*!< Payload build */
+	GPS_PROF_PUBLISH,											/*!< AT publish sequence */
+	GPS_PROF_UART_ISR,											/*!< LPUART1 receive complete callback */
+	GPS_PROF_TRACE,												/*!< One trace record, the commit event */
+	GPS_PROF_PROBES,
+}en_gps_prof_probe;
+
+/**
+ * @struct st_gps_prof_probe
+ * @brief Statistics of one probe, in time base units
+ */
+typedef struct
+{
+	uint32_t		count;										/*!< Recorded blocks */
+	uint32_t		min;										/*!< Shortest */
+	uint32_t		max;										/*!< Longest */
+	uint64_t		sum;										/*!< Total */
+	uint32_t		hist[GPS_PROF_HIST_BINS];					/*!< Bin n counts durations in [2^n, 2^(n+1)) */
+}st_gps_prof_probe;
+
+/** @brief Output function for the dump, gps_log_cli compatible */
+typedef int (*gps_prof_out_fn)(const char * s);
+
+#if(GPS_PROF_ENABLE == MZ_ENABLE)
+
+#if defined(__arm__)
+#include "stm32l4xx.h"
+#define GPS_PROF_UNIT				"cyc"					///< Time base unit
+/** @brief Current time base value */
+static inline uint32_t gps_prof_now(void)
+{
+	return DWT->CYCCNT;
+}
+#else
+#include "time.h"
+#define GPS_PROF_UNIT				"ns"					///< Time base unit
+/** @brief Current time base value */
+static inline uint32_t gps_prof_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec);
+}
+#endif
+
+#define GPS_PROF_BEGIN(id)			uint32_t gps_prof_start_##id = gps_prof_now()
+#define GPS_PROF_END(id)			gps_prof_record((id), gps_prof_now() - gps_prof_start_##id)
+
+/** @fn void gps_prof_init(void)
+ * @brief Start the time base and clear all probes.
+ */
+void gps_prof_init(void);
+
+/** @fn void gps_prof_record(en_gps_prof_probe id, uint32_t duration)
+ * @brief Add one duration to a probe.
+ * @param id probe
+ * @param duration time base units
+ */
+void gps_prof_record(en_gps_prof_probe id, uint32_t duration);
+
+/** @fn const st_gps_prof_probe * gps_prof_get(en_gps_prof_probe id)
+ * @brief Statistics of one probe.
+ * @param id probe
+ * @return probe table
+ */
+const st_gps_prof_probe * gps_prof_get(en_gps_prof_probe id);
+
+/** @fn void gps_prof_dump(gps_prof_out_fn out)
+ * @brief Print every probe, one line each.
+ * @param out output function (gps_log_cli for the CLI UART)
+ */
+void gps_prof_dump(gps_prof_out_fn out);
+
+#else
+
+#define GPS_PROF_BEGIN(id)
+#define GPS_PROF_END(id)
+
+#endif //(GPS_PROF_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_PROF_H_ */
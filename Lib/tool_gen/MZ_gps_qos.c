@@ -0,0 +1,255 @@
+/*
+ * MZ_gps_qos.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_qos.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/** @fn static uint32_t qos_rto(uint8_t tries)
+ * @brief Retransmit timeout after a number of sends
+ */
+static uint32_t qos_rto(uint8_t tries)
+{
+	return (uint32_t)GPS_MQTT_QOS1_RTO_MS << (tries - 1);
+}
+
+/** @fn static void qos_due_now(st_gps_qos_slot * s)
+ * @brief Send a message again without waiting for its timeout
+ */
+static void qos_due_now(st_gps_qos_slot * s)
+{
+	if(s->tries != 0)
+	{
+		s->sent_ms -= qos_rto(s->tries);
+	}
+}
+
+/** @fn static st_gps_qos_slot * qos_find(st_gps_qos * q, uint16_t id)
+ * @brief Slot of a packet id, NULL when it is not in flight
+ */
+static st_gps_qos_slot * qos_find(st_gps_qos * q, uint16_t id)
+{
+	for(uint8_t i = 0; i < GPS_MQTT_QOS1_WINDOW; i++)
+	{
+		if(q->slot[i].used && (q->slot[i].id == id))
+		{
+			return &q->slot[i];
+		}
+	}
+	return NULL;
+}
+
+/*
+ * Empty window. - START
+ */
+void gps_qos_init(st_gps_qos * q)
+{
+	memset(q, 0, sizeof(*q));
+}
+/* Empty window. - END */
+
+/*
+ * The message fits a slot. - START
+ */
+uint8_t gps_qos_fits(const char * topic, const char * payload)
+{
+	return (strlen(topic) < GPS_MQTT_QOS1_TOPIC_SIZE) && (strlen(payload) < GPS_MQTT_QOS1_PAYLOAD_SIZE);
+}
+/* The message fits a slot. - END */
+
+/*
+ * Copy a message into the window. - START
+ */
+uint8_t gps_qos_queue(st_gps_qos * q, const char * topic, const char * payload)
+{
+	st_gps_qos_slot * s = NULL;
+
+	if(!gps_qos_fits(topic, payload))
+	{
+		return 0;
+	}
+	for(uint8_t i = 0; (i < GPS_MQTT_QOS1_WINDOW) && (s == NULL); i++)
+	{
+		if(!q->slot[i].used)
+		{
+			s = &q->slot[i];
+		}
+	}
+	if(s == NULL)
+	{
+		q->stats.full++;
+		return 0;
+	}
+
+	/* Packet id 0 is not allowed, an id still in flight is skipped */
+	do
+	{
+		q->id = (q->id == 0xFFFF) ? 1 : (q->id + 1);
+	}while(NULL != qos_find(q, q->id));
+
+	strcpy(s->topic, topic);
+	strcpy(s->payload, payload);
+	s->used = 1;
+	s->tries = 0;
+	s->id = q->id;
+	q->stats.queued++;
+	return 1;
+}
+/* Copy a message into the window. - END */
+
+/*
+ * A message is to be sent. - START
+ */
+uint8_t gps_qos_due(const st_gps_qos * q, uint32_t now_ms)
+{
+	for(uint8_t i = 0; i < GPS_MQTT_QOS1_WINDOW; i++)
+	{
+		const st_gps_qos_slot * s = &q->slot[i];
+
+		if(s->used && ((s->tries == 0) || ((now_ms - s->sent_ms) >= qos_rto(s->tries))))
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+/* A message is to be sent. - END */
+
+/*
+ * Next message to send. - START
+ */
+st_gps_qos_slot * gps_qos_next(st_gps_qos * q, uint32_t now_ms)
+{
+	st_gps_qos_slot * next = NULL;
+
+	for(uint8_t i = 0; i < GPS_MQTT_QOS1_WINDOW; i++)
+	{
+		st_gps_qos_slot * s = &q->slot[i];
+
+		if(!s->used || ((s->tries != 0) && ((now_ms - s->sent_ms) < qos_rto(s->tries))))
+		{
+			continue;
+		}
+		if(s->tries >= GPS_MQTT_QOS1_TRIES)
+		{
+			/* No PUBACK after the last try */
+			s->used = 0;
+			q->stats.lost++;
+			continue;
+		}
+		/* Oldest first */
+		if((next == NULL) || ((uint16_t)(q->id - s->id) > (uint16_t)(q->id - next->id)))
+		{
+			next = s;
+		}
+	}
+	if(next == NULL)
+	{
+		return NULL;
+	}
+
+	if(next->tries != 0)
+	{
+		q->stats.retries++;
+	}
+	next->tries++;
+	next->sent_ms = now_ms;
+	q->stats.sends++;
+	return next;
+}
+/* Next message to send. - END */
+
+/*
+ * The modem did not take the message. - START
+ */
+void gps_qos_unsent(st_gps_qos * q, st_gps_qos_slot * s)
+{
+	s->tries--;
+	q->stats.sends--;
+	if(s->tries != 0)
+	{
+		q->stats.retries--;
+	}
+	qos_due_now(s);
+}
+/* The modem did not take the message. - END */
+
+/*
+ * Outcome of a PUBLISH. - START
+ */
+void gps_qos_result(st_gps_qos * q, uint16_t id, uint8_t result, uint32_t now_ms)
+{
+	st_gps_qos_slot * s = qos_find(q, id);
+
+	if(s == NULL)
+	{
+		if(GPS_QOS_RESULT_ACKED == result)
+		{
+			q->stats.dup_acks++;
+		}
+		return;
+	}
+
+	switch(result)
+	{
+		case GPS_QOS_RESULT_ACKED:
+			/* The round trip of a retried message is ambiguous */
+			if(s->tries == 1)
+			{
+				q->stats.rtt_last_ms = now_ms - s->sent_ms;
+				if(q->stats.rtt_last_ms > q->stats.rtt_max_ms)
+				{
+					q->stats.rtt_max_ms = q->stats.rtt_last_ms;
+				}
+			}
+			s->used = 0;
+			q->stats.acked++;
+		break;
+		case GPS_QOS_RESULT_RETRY:
+			/* The modem sent it again, wait a full timeout from now */
+			s->sent_ms = now_ms;
+		break;
+		default:
+			/* Sent again when its own timeout expires */
+			q->stats.failed++;
+		break;
+	}
+}
+/* Outcome of a PUBLISH. - END */
+
+/*
+ * The session is gone. - START
+ */
+void gps_qos_session_lost(st_gps_qos * q)
+{
+	/* A new session does not deliver the PUBACKs of the old one */
+	for(uint8_t i = 0; i < GPS_MQTT_QOS1_WINDOW; i++)
+	{
+		if(q->slot[i].used)
+		{
+			qos_due_now(&q->slot[i]);
+		}
+	}
+}
+/* The session is gone. - END */
+
+/*
+ * Messages in the window. - START
+ */
+uint8_t gps_qos_in_flight(const st_gps_qos * q)
+{
+	uint8_t n = 0;
+
+	for(uint8_t i = 0; i < GPS_MQTT_QOS1_WINDOW; i++)
+	{
+		n += q->slot[i].used;
+	}
+	return n;
+}
+/* Messages in the window. - END */
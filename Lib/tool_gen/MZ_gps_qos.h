@@ -0,0 +1,145 @@
+/*
+ * MZ_gps_qos.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  MQTT QoS 1 in-flight window of the BG96 telemetry backend.
+ *
+ *  A published message is copied into a fixed table of
+ *  GPS_MQTT_QOS1_WINDOW slots with its packet id (1 .. 65535), so the
+ *  publisher does not wait for the PUBACK : the modem takes the PUBLISH,
+ *  the PUBACK comes later as the +QMTPUB URC and frees the slot by its
+ *  packet id. A message without PUBACK is sent again with the same
+ *  packet id after GPS_MQTT_QOS1_RTO_MS, doubled per retry, and dropped
+ *  after GPS_MQTT_QOS1_TRIES sends. After a lost session all messages in
+ *  flight are sent again. A full table takes no new message, the
+ *  messages in it are not given up for newer ones.
+ *  Everything here is portable, the AT commands and URC parsing are in
+ *  MZ_gps_backend.c. Host builds only (GPS_MQTT_QOS1_ENABLE), the MonoZ
+ *  library does not pass the +QMTPUB URC to the application.
+ */
+
+#ifndef MZ_GPS_QOS_H_
+#define MZ_GPS_QOS_H_
+
+#include "stdint.h"
+#include "MZ_gps_app_config.h"
+
+#define GPS_QOS_RESULT_ACKED			(0)						///< +QMTPUB result, PUBACK received
+#define GPS_QOS_RESULT_RETRY			(1)						///< +QMTPUB result, the modem sends again
+#define GPS_QOS_RESULT_FAILED			(2)						///< +QMTPUB result, no PUBACK
+
+/**
+ * @struct st_gps_qos_stats
+ * @brief QoS 1 counters
+ */
+typedef struct
+{
+	uint32_t		queued;										/*!< Messages taken */
+	uint32_t		full;										/*!< Messages refused by a full table */
+	uint32_t		sends;										/*!< PUBLISH sent, retries included */
+	uint32_t		retries;									/*!< PUBLISH sent again */
+	uint32_t		acked;										/*!< PUBACK received */
+	uint32_t		dup_acks;									/*!< PUBACK of a message no longer in flight */
+	uint32_t		failed;										/*!< No PUBACK reported by the modem */
+	uint32_t		lost;										/*!< Messages dropped after GPS_MQTT_QOS1_TRIES */
+	uint32_t		rtt_last_ms;								/*!< Round trip of the last first try PUBACK */
+	uint32_t		rtt_max_ms;									/*!< Longest round trip */
+}st_gps_qos_stats;
+
+/**
+ * @struct st_gps_qos_slot
+ * @brief One message in flight
+ */
+typedef struct
+{
+	uint8_t			used;										/*!< Slot holds a message */
+	uint8_t			tries;										/*!< Sends so far */
+	uint16_t		id;											/*!< Packet id */
+	uint32_t		sent_ms;									/*!< Last send */
+	char			topic[GPS_MQTT_QOS1_TOPIC_SIZE];			/*!< Quoted topic */
+	char			payload[GPS_MQTT_QOS1_PAYLOAD_SIZE];		/*!< Payload ended by Ctrl-Z */
+}st_gps_qos_slot;
+
+/**
+ * @struct st_gps_qos
+ * @brief In-flight window
+ */
+typedef struct
+{
+	uint16_t			id;										/*!< Last packet id */
+	st_gps_qos_slot		slot[GPS_MQTT_QOS1_WINDOW];				/*!< Messages in flight */
+	st_gps_qos_stats	stats;									/*!< Counters */
+}st_gps_qos;
+
+/** @fn void gps_qos_init(st_gps_qos * q)
+ * @brief Empty window.
+ * @param q window
+ */
+void gps_qos_init(st_gps_qos * q);
+
+/** @fn uint8_t gps_qos_fits(const char * topic, const char * payload)
+ * @brief The message fits a slot.
+ * @param topic quoted topic
+ * @param payload payload ended by Ctrl-Z
+ * @return 1 when gps_qos_queue() can keep it
+ */
+uint8_t gps_qos_fits(const char * topic, const char * payload);
+
+/** @fn uint8_t gps_qos_queue(st_gps_qos * q, const char * topic, const char * payload)
+ * @brief Copy a message into the window, it gets the next packet id.
+ * @param q window
+ * @param topic quoted topic
+ * @param payload payload ended by Ctrl-Z
+ * @return 1 when taken, 0 when the table is full or the message too long
+ */
+uint8_t gps_qos_queue(st_gps_qos * q, const char * topic, const char * payload);
+
+/** @fn uint8_t gps_qos_due(const st_gps_qos * q, uint32_t now_ms)
+ * @brief A message is to be sent, new or after its retransmit timeout.
+ * @param q window
+ * @param now_ms current time
+ * @return 1 when gps_qos_next() has a message
+ */
+uint8_t gps_qos_due(const st_gps_qos * q, uint32_t now_ms);
+
+/** @fn st_gps_qos_slot * gps_qos_next(st_gps_qos * q, uint32_t now_ms)
+ * @brief Next message to send, counted as sent. Messages out of tries are
+ * dropped on the way.
+ * @param q window
+ * @param now_ms current time
+ * @return slot to publish, NULL when nothing is due
+ */
+st_gps_qos_slot * gps_qos_next(st_gps_qos * q, uint32_t now_ms);
+
+/** @fn void gps_qos_unsent(st_gps_qos * q, st_gps_qos_slot * s)
+ * @brief The modem did not take the message from gps_qos_next(), it is due
+ * again at once and the send does not count as a try.
+ * @param q window
+ * @param s slot
+ */
+void gps_qos_unsent(st_gps_qos * q, st_gps_qos_slot * s);
+
+/** @fn void gps_qos_result(st_gps_qos * q, uint16_t id, uint8_t result, uint32_t now_ms)
+ * @brief Outcome of a PUBLISH from the +QMTPUB URC.
+ * @param q window
+ * @param id packet id
+ * @param result GPS_QOS_RESULT_*
+ * @param now_ms current time
+ */
+void gps_qos_result(st_gps_qos * q, uint16_t id, uint8_t result, uint32_t now_ms);
+
+/** @fn void gps_qos_session_lost(st_gps_qos * q)
+ * @brief The session is gone, every message in flight is due again.
+ * @param q window
+ */
+void gps_qos_session_lost(st_gps_qos * q);
+
+/** @fn uint8_t gps_qos_in_flight(const st_gps_qos * q)
+ * @brief Messages in the window.
+ * @param q window
+ * @return used slots
+ */
+uint8_t gps_qos_in_flight(const st_gps_qos * q);
+
+#endif /* MZ_GPS_QOS_H_ */
@@ -0,0 +1,336 @@
+/*
+ * MZ_gps_radio.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_radio.h"
+#include "string.h"
+#if(GPS_RADIO_ENABLE == MZ_ENABLE)
+#include "MZ_gps_at.h"
+#include "MZ_gps_lowpower.h"
+#include "MZ_gps_trace.h"
+#include "MZ_sys_cmsis_os2.h"
+#include "MZ_Simcom_AT_include.h"
+#include "MZ_timer.h"
+#include "main.h"
+#include "stdio.h"
+#endif
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define RADIO_T3_VALUE_MAX			(31)						///< 5 bit timer value
+#define RADIO_T3_OFF				(0xFFFFFFFFUL)				///< Deactivated timer
+#define RADIO_EDRX_ACT_WB_S1		(4)							///< AT+CEDRXS AcT, E-UTRAN WB-S1 (LTE-M)
+#define RADIO_CMD_SIZE				(48)						///< Longest emulated request
+/* Define some common use MACRO - END */
+
+/**
+ * @struct st_radio_unit
+ * @brief Timer unit of a GPRS Timer bit string
+ */
+typedef struct
+{
+	uint8_t		code;											/*!< Bits 8 to 6 */
+	uint32_t	sec;											/*!< Unit in seconds */
+}st_radio_unit;
+
+/* Radio scheduler related variables - START */
+/* GPRS Timer 3 units, ascending */
+static const st_radio_unit radio_t3_units[] =
+{
+	{3, 2}, {4, 30}, {5, 60}, {0, 600}, {1, 3600}, {2, 36000}, {6, 1152000},
+};
+/* GPRS Timer 2 units, ascending */
+static const st_radio_unit radio_t2_units[] =
+{
+	{0, 2}, {1, 60}, {2, 360},
+};
+/* WB-S1 eDRX cycles in ms, index is the value */
+static const uint32_t radio_edrx_ms[16] =
+{
+	5120, 10240, 20480, 40960, 61440, 81920, 102400, 122880,
+	143360, 163840, 327680, 655360, 1310720, 2621440, 5242880, 10485760,
+};
+/* Radio scheduler related variables - END */
+
+/** @fn static void radio_bits(uint32_t value, uint8_t count, char * out)
+ * @brief Write count bits of value, MSB first, and a terminator
+ */
+static void radio_bits(uint32_t value, uint8_t count, char * out)
+{
+	for(uint8_t i = 0; i < count; i++)
+	{
+		out[i] = (value & (1UL << (count - 1 - i))) ? '1' : '0';
+	}
+	out[count] = '\0';
+}
+
+/*
+ * Encode a GPRS Timer 3 / Timer 2 value. - START
+ */
+uint32_t gps_radio_t3_encode(uint32_t sec, uint8_t timer3, char * out)
+{
+	const st_radio_unit * units = timer3 ? radio_t3_units : radio_t2_units;
+	uint8_t count = timer3 ? (sizeof(radio_t3_units) / sizeof(radio_t3_units[0]))
+						   : (sizeof(radio_t2_units) / sizeof(radio_t2_units[0]));
+	uint32_t value = RADIO_T3_VALUE_MAX;
+	uint8_t u;
+
+	/* The finest unit that reaches sec rounds up the least */
+	for(u = 0; u < count; u++)
+	{
+		value = (sec + units[u].sec - 1) / units[u].sec;
+		if(value <= RADIO_T3_VALUE_MAX)
+		{
+			break;
+		}
+	}
+	if(u == count)
+	{
+		u = count - 1;
+		value = RADIO_T3_VALUE_MAX;
+	}
+
+	radio_bits(((uint32_t)units[u].code << 5) | value, 8, out);
+	return value * units[u].sec;
+}
+/* Encode a GPRS Timer 3 / Timer 2 value. - END */
+
+/*
+ * Decode a GPRS Timer 3 / Timer 2 value. - START
+ */
+uint32_t gps_radio_t3_decode(const char * bits, uint8_t timer3)
+{
+	const st_radio_unit * units = timer3 ? radio_t3_units : radio_t2_units;
+	uint8_t count = timer3 ? (sizeof(radio_t3_units) / sizeof(radio_t3_units[0]))
+						   : (sizeof(radio_t2_units) / sizeof(radio_t2_units[0]));
+	uint32_t raw = 0;
+
+	for(uint8_t i = 0; i < 8; i++)
+	{
+		raw = (raw << 1) | (bits[i] == '1');
+	}
+	for(uint8_t u = 0; u < count; u++)
+	{
+		if(units[u].code == (raw >> 5))
+		{
+			return (raw & RADIO_T3_VALUE_MAX) * units[u].sec;
+		}
+	}
+	return RADIO_T3_OFF;
+}
+/* Decode a GPRS Timer 3 / Timer 2 value. - END */
+
+/*
+ * Encode an eDRX cycle. - START
+ */
+uint32_t gps_radio_edrx_encode(uint32_t ms, char * out)
+{
+	int8_t v = 15;
+
+	while((v >= 0) && (radio_edrx_ms[v] > ms))
+	{
+		v--;
+	}
+	if(v < 0)
+	{
+		radio_bits(0, 4, out);
+		return 0;
+	}
+	radio_bits((uint32_t)v, 4, out);
+	return radio_edrx_ms[v];
+}
+/* Encode an eDRX cycle. - END */
+
+/*
+ * Derive the timers from the upload interval. - START
+ */
+void gps_radio_plan(st_gps_radio * r, uint32_t flush_ms, uint32_t active_ms, uint32_t now_ms)
+{
+	memset(r, 0, sizeof(*r));
+
+	if(flush_ms >= GPS_RADIO_PSM_MIN_MS)
+	{
+		/* Sleep between uploads, paging only during the active time */
+		r->psm = 1;
+		r->active_ms = 1000 * gps_radio_t3_encode((active_ms + 999) / 1000, 0, r->t3324);
+		r->tau_s = gps_radio_t3_encode((uint32_t)(((uint64_t)flush_ms * GPS_RADIO_TAU_FLUSHES + 999) / 1000), 1, r->t3412);
+		r->edrx_ms = gps_radio_edrx_encode(r->active_ms / 2, r->edrx);
+	}
+	else
+	{
+		/* Too short for PSM to pay off, page as rarely as the interval allows */
+		r->edrx_ms = gps_radio_edrx_encode(flush_ms, r->edrx);
+	}
+
+	r->state = GPS_RADIO_IDLE;
+	r->since = now_ms;
+}
+/* Derive the timers from the upload interval. - END */
+
+/** @fn static void radio_enter(st_gps_radio * r, en_gps_radio_state state, uint32_t now_ms)
+ * @brief Count the time of the current state and change it
+ */
+static void radio_enter(st_gps_radio * r, en_gps_radio_state state, uint32_t now_ms)
+{
+	r->stats.ms[r->state] += now_ms - r->since;
+	r->since = now_ms;
+	r->state = state;
+}
+
+/*
+ * Follow the active time into PSM. - START
+ */
+void gps_radio_update(st_gps_radio * r, uint32_t now_ms)
+{
+	if(r->psm && (r->state == GPS_RADIO_IDLE) && ((now_ms - r->since) >= r->active_ms))
+	{
+		/* T3324 ran out at since + active_ms */
+		radio_enter(r, GPS_RADIO_PSM, r->since + r->active_ms);
+	}
+	radio_enter(r, r->state, now_ms);
+}
+/* Follow the active time into PSM. - END */
+
+/*
+ * Traffic without a wake up. - START
+ */
+uint8_t gps_radio_awake(st_gps_radio * r, uint32_t now_ms)
+{
+	gps_radio_update(r, now_ms);
+	return (r->state != GPS_RADIO_PSM);
+}
+/* Traffic without a wake up. - END */
+
+/*
+ * Copy the scheduler counters. - START
+ */
+void gps_radio_get_stats(st_gps_radio * r, uint32_t now_ms, st_gps_radio_stats * stats)
+{
+	gps_radio_update(r, now_ms);
+	*stats = r->stats;
+}
+/* Copy the scheduler counters. - END */
+
+#if(GPS_RADIO_ENABLE == MZ_ENABLE)
+
+/** @fn static mz_error_t radio_request(st_gps_radio * r)
+ * @brief Send the PSM and eDRX settings
+ */
+static mz_error_t radio_request(st_gps_radio * r)
+{
+	mz_error_t status;
+#if(GPS_MODEM_EMU_ENABLE == MZ_ENABLE)
+	char cmd[RADIO_CMD_SIZE];
+
+	if(r->psm)
+	{
+		sprintf(cmd, "AT+CPSMS=1,,,\"%s\",\"%s\"\r\n", r->t3412, r->t3324);
+	}
+	else
+	{
+		sprintf(cmd, "AT+CPSMS=0\r\n");
+	}
+	status = gps_at_cmd(cmd, AT_TIME_1SEC, AT_TIME_1SEC);
+	sprintf(cmd, "AT+CEDRXS=%u,%u,\"%s\"\r\n", (r->edrx_ms != 0) ? 1 : 0, RADIO_EDRX_ACT_WB_S1, r->edrx);
+	status |= gps_at_cmd(cmd, AT_TIME_1SEC, AT_TIME_1SEC);
+#else
+	char tau[GPS_RADIO_T3_SIZE + 2];
+	char active[GPS_RADIO_T3_SIZE + 2];
+	char cycle[GPS_RADIO_EDRX_SIZE + 2];
+
+	sprintf(tau, "\"%s\"", r->t3412);
+	sprintf(active, "\"%s\"", r->t3324);
+	sprintf(cycle, "\"%s\"", r->edrx);
+
+	/* The modem UART1 can not wake the MCU from STOP2 */
+	GPS_LP_STOP_LOCK();
+	status = mz_raw_at_write_cpsms(r->psm, "", "", tau, active);
+	status |= mz_raw_at_write_cedrxs((r->edrx_ms != 0) ? 1 : 0, RADIO_EDRX_ACT_WB_S1, cycle);
+	GPS_LP_STOP_UNLOCK();
+#endif
+	return status;
+}
+
+/** @fn static mz_error_t radio_wake(st_gps_radio * r)
+ * @brief Wake up pulse, then AT until the modem answers
+ */
+static mz_error_t radio_wake(st_gps_radio * r)
+{
+	uint32_t start = HAL_GetTick();
+	uint32_t latency;
+
+#if(GPS_MODEM_EMU_ENABLE == MZ_ENABLE)
+	gps_at_emu_wake();
+#else
+	HAL_GPIO_WritePin(MODEM_WAKEUP_GPIO_Port, MODEM_WAKEUP_Pin, GPIO_PIN_SET);
+	osDelay(GPS_RADIO_WAKE_PULSE_MS);
+	HAL_GPIO_WritePin(MODEM_WAKEUP_GPIO_Port, MODEM_WAKEUP_Pin, GPIO_PIN_RESET);
+#endif
+
+	while((HAL_GetTick() - start) < GPS_RADIO_WAKE_TIMEOUT_MS)
+	{
+		if(MZ_OK == gps_at_cmd("AT\r\n", AT_TIME_1SEC, AT_TIME_1SEC))
+		{
+			latency = HAL_GetTick() - start;
+			r->stats.wakes++;
+			r->stats.wake_last_ms = latency;
+			if(latency > r->stats.wake_max_ms)
+			{
+				r->stats.wake_max_ms = latency;
+			}
+			return MZ_OK;
+		}
+	}
+	r->stats.wake_fails++;
+	GPS_TRACE(GPS_TRACE_AT_FAIL, MZ_FAIL);
+	return MZ_FAIL;
+}
+
+/*
+ * Plan and request the timers. - START
+ */
+mz_error_t gps_radio_init(st_gps_radio * r)
+{
+	gps_radio_plan(r, GPS_RADIO_FLUSH_MS, GPS_RADIO_ACTIVE_MS, HAL_GetTick());
+	return radio_request(r);
+}
+/* Plan and request the timers. - END */
+
+/*
+ * An upload starts. - START
+ */
+mz_error_t gps_radio_begin(st_gps_radio * r)
+{
+	mz_error_t status = MZ_OK;
+
+	r->stats.uploads++;
+	gps_radio_update(r, HAL_GetTick());
+	if(r->state == GPS_RADIO_PSM)
+	{
+		radio_enter(r, GPS_RADIO_WAKING, HAL_GetTick());
+		status = radio_wake(r);
+	}
+	radio_enter(r, (MZ_OK == status) ? GPS_RADIO_CONNECTED : GPS_RADIO_PSM, HAL_GetTick());
+	return status;
+}
+/* An upload starts. - END */
+
+/*
+ * The upload is done. - START
+ */
+void gps_radio_end(st_gps_radio * r)
+{
+	/* A modem that did not wake up is still in PSM */
+	if(r->state == GPS_RADIO_CONNECTED)
+	{
+		radio_enter(r, GPS_RADIO_IDLE, HAL_GetTick());
+	}
+}
+/* The upload is done. - END */
+
+#endif //(GPS_RADIO_ENABLE == MZ_ENABLE)
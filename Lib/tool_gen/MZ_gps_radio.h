@@ -0,0 +1,166 @@
+/*
+ * MZ_gps_radio.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Modem power save scheduling.
+ *
+ *  The PSM and eDRX timers are requested once (AT+CPSMS / AT+CEDRXS),
+ *  matched to the upload interval GPS_RADIO_FLUSH_MS :
+ *  - interval of GPS_RADIO_PSM_MIN_MS or more : PSM. T3324 (active time)
+ *    is GPS_RADIO_ACTIVE_MS, T3412 (periodic TAU) covers
+ *    GPS_RADIO_TAU_FLUSHES intervals so no TAU falls between two
+ *    uploads, the eDRX cycle leaves two paging occasions in the active
+ *    time.
+ *  - shorter interval : no PSM, the longest eDRX cycle within the
+ *    interval.
+ *  Every upload is bracketed by gps_radio_begin() / gps_radio_end().
+ *  Only gps_radio_begin() wakes the modem out of PSM (MODEM_WAKEUP
+ *  pulse, then AT until it answers), other traffic asks
+ *  gps_radio_awake() and waits for the next upload. The state of the
+ *  modem is derived from the requested timers, the network can grant
+ *  other values (+CEREG). Time in each state and the wake up latency
+ *  are counted. With GPS_MODEM_EMU_ENABLE, MZ_gps_at.c emulates PSM and
+ *  its wake up latency.
+ */
+
+#ifndef MZ_GPS_RADIO_H_
+#define MZ_GPS_RADIO_H_
+
+#include "stdint.h"
+#include "MZ_error_handler.h"
+#include "MZ_gps_app_config.h"
+
+#define GPS_RADIO_T3_SIZE			(9)						///< GPRS Timer 2/3 bit string and terminator
+#define GPS_RADIO_EDRX_SIZE			(5)						///< eDRX value bit string and terminator
+
+/**
+ * @enum en_gps_radio_state
+ * @brief Modem radio state
+ */
+typedef enum
+{
+	GPS_RADIO_CONNECTED = 0,									/*!< Upload in progress */
+	GPS_RADIO_IDLE,												/*!< Active time, eDRX paging */
+	GPS_RADIO_PSM,												/*!< Power saving mode */
+	GPS_RADIO_WAKING,											/*!< Wake up pulse sent, no answer yet */
+	GPS_RADIO_STATES,
+}en_gps_radio_state;
+
+/**
+ * @struct st_gps_radio_stats
+ * @brief Scheduler counters
+ */
+typedef struct
+{
+	uint32_t		ms[GPS_RADIO_STATES];						/*!< Time in each state */
+	uint32_t		uploads;									/*!< gps_radio_begin calls */
+	uint32_t		wakes;										/*!< Wake ups out of PSM */
+	uint32_t		wake_fails;									/*!< Wake ups without an answer */
+	uint32_t		wake_last_ms;								/*!< Last wake up latency */
+	uint32_t		wake_max_ms;								/*!< Longest wake up latency */
+}st_gps_radio_stats;
+
+/**
+ * @struct st_gps_radio
+ * @brief Scheduler state
+ */
+typedef struct
+{
+	en_gps_radio_state	state;									/*!< Derived modem state */
+	uint32_t			since;									/*!< State time counted up to here */
+	uint8_t				psm;									/*!< PSM requested */
+	uint32_t			active_ms;								/*!< Granted T3324 as requested */
+	uint32_t			tau_s;									/*!< T3412 as requested */
+	uint32_t			edrx_ms;								/*!< eDRX cycle, 0 = off */
+	char				t3324[GPS_RADIO_T3_SIZE];				/*!< Requested active time */
+	char				t3412[GPS_RADIO_T3_SIZE];				/*!< Requested periodic TAU */
+	char				edrx[GPS_RADIO_EDRX_SIZE];				/*!< Requested eDRX cycle */
+	st_gps_radio_stats	stats;									/*!< Counters */
+}st_gps_radio;
+
+/** @fn uint32_t gps_radio_t3_encode(uint32_t sec, uint8_t timer3, char * out)
+ * @brief Smallest GPRS Timer 3 (T3412) or Timer 2 (T3324) value not
+ * below sec, 3GPP TS 24.008 10.5.7.4a / 10.5.7.4.
+ * @param sec wanted time
+ * @param timer3 1 for Timer 3, 0 for Timer 2
+ * @param out bit string, GPS_RADIO_T3_SIZE
+ * @return encoded time in seconds
+ */
+uint32_t gps_radio_t3_encode(uint32_t sec, uint8_t timer3, char * out);
+
+/** @fn uint32_t gps_radio_t3_decode(const char * bits, uint8_t timer3)
+ * @brief Seconds of a GPRS Timer 3 or Timer 2 bit string.
+ * @param bits 8 characters '0' / '1'
+ * @param timer3 1 for Timer 3, 0 for Timer 2
+ * @return time in seconds, 0xFFFFFFFF when deactivated
+ */
+uint32_t gps_radio_t3_decode(const char * bits, uint8_t timer3);
+
+/** @fn uint32_t gps_radio_edrx_encode(uint32_t ms, char * out)
+ * @brief Longest E-UTRAN WB-S1 eDRX cycle not above ms, TS 24.008
+ * 10.5.5.32.
+ * @param ms longest wanted cycle
+ * @param out bit string, GPS_RADIO_EDRX_SIZE
+ * @return cycle in ms, 0 when even the shortest one is too long
+ */
+uint32_t gps_radio_edrx_encode(uint32_t ms, char * out);
+
+/** @fn void gps_radio_plan(st_gps_radio * r, uint32_t flush_ms, uint32_t active_ms, uint32_t now_ms)
+ * @brief Derive the timers from the upload interval, the modem is taken
+ * as idle from now on.
+ * @param r scheduler
+ * @param flush_ms upload interval
+ * @param active_ms wanted active time after an upload
+ * @param now_ms current time
+ */
+void gps_radio_plan(st_gps_radio * r, uint32_t flush_ms, uint32_t active_ms, uint32_t now_ms);
+
+/** @fn void gps_radio_update(st_gps_radio * r, uint32_t now_ms)
+ * @brief Follow the active time into PSM and count the state time.
+ * @param r scheduler
+ * @param now_ms current time
+ */
+void gps_radio_update(st_gps_radio * r, uint32_t now_ms);
+
+/** @fn uint8_t gps_radio_awake(st_gps_radio * r, uint32_t now_ms)
+ * @brief Traffic now does not cost a wake up.
+ * @param r scheduler
+ * @param now_ms current time
+ * @return 1 when the modem is not in PSM
+ */
+uint8_t gps_radio_awake(st_gps_radio * r, uint32_t now_ms);
+
+/** @fn void gps_radio_get_stats(st_gps_radio * r, uint32_t now_ms, st_gps_radio_stats * stats)
+ * @brief Copy the counters, state time up to now.
+ * @param r scheduler
+ * @param now_ms current time
+ * @param stats output
+ */
+void gps_radio_get_stats(st_gps_radio * r, uint32_t now_ms, st_gps_radio_stats * stats);
+
+#if(GPS_RADIO_ENABLE == MZ_ENABLE)
+
+/** @fn mz_error_t gps_radio_init(st_gps_radio * r)
+ * @brief Plan the timers for GPS_RADIO_FLUSH_MS and request them.
+ * @param r scheduler
+ * @return MZ_OK when the modem accepted both settings
+ */
+mz_error_t gps_radio_init(st_gps_radio * r);
+
+/** @fn mz_error_t gps_radio_begin(st_gps_radio * r)
+ * @brief An upload starts, wake the modem when it is in PSM.
+ * @param r scheduler
+ * @return MZ_OK when the modem answers
+ */
+mz_error_t gps_radio_begin(st_gps_radio * r);
+
+/** @fn void gps_radio_end(st_gps_radio * r)
+ * @brief The upload is done, the active time starts.
+ * @param r scheduler
+ */
+void gps_radio_end(st_gps_radio * r);
+
+#endif //(GPS_RADIO_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_RADIO_H_ */
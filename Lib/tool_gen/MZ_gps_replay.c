@@ -0,0 +1,215 @@
+/*
+ * MZ_gps_replay.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_replay.h"
+#include "MZ_gps_nmea_gen.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+#if(GPS_REPLAY_ENABLE == MZ_ENABLE)
+
+/* Built in trace : ten 1 Hz epochs heading north east at about 6 m/s */
+static const char gps_replay_default_trace[] =
+	"$GPRMC,101902.00,A,2951.91860,N,07752.38737,E,11.500,45.00,300322,,,A*67\r\n"
+	"$GPGGA,101902.00,2951.91860,N,07752.38737,E,1,06,1.20,248.4,M,-36.3,M,,*75\r\n"
+	"$GPGSA,A,3,06,02,19,24,17,12,,,,,,,2.10,1.20,1.70*0B\r\n"
+	"$GPRMC,101903.00,A,2951.92160,N,07752.39037,E,11.500,45.00,300322,,,A*6A\r\n"
+	"$GPGGA,101903.00,2951.92160,N,07752.39037,E,1,06,1.20,248.4,M,-36.3,M,,*78\r\n"
+	"$GPGSA,A,3,06,02,19,24,17,12,,,,,,,2.10,1.20,1.70*0B\r\n"
+	"$GPRMC,101904.00,A,2951.92460,N,07752.39337,E,11.500,45.00,300322,,,A*6B\r\n"
+	"$GPGGA,101904.00,2951.92460,N,07752.39337,E,1,06,1.20,248.4,M,-36.3,M,,*79\r\n"
+	"$GPGSA,A,3,06,02,19,24,17,12,,,,,,,2.10,1.20,1.70*0B\r\n"
+	"$GPRMC,101905.00,A,2951.92760,N,07752.39637,E,11.500,45.00,300322,,,A*6C\r\n"
+	"$GPGGA,101905.00,2951.92760,N,07752.39637,E,1,06,1.20,248.4,M,-36.3,M,,*7E\r\n"
+	"$GPGSA,A,3,06,02,19,24,17,12,,,,,,,2.10,1.20,1.70*0B\r\n"
+	"$GPRMC,101906.00,A,2951.93060,N,07752.39937,E,11.500,45.00,300322,,,A*66\r\n"
+	"$GPGGA,101906.00,2951.93060,N,07752.39937,E,1,06,1.20,248.4,M,-36.3,M,,*74\r\n"
+	"$GPGSA,A,3,06,02,19,24,17,12,,,,,,,2.10,1.20,1.70*0B\r\n"
+	"$GPRMC,101907.00,A,2951.93360,N,07752.40237,E,11.500,45.00,300322,,,A*61\r\n"
+	"$GPGGA,101907.00,2951.93360,N,07752.40237,E,1,06,1.20,248.4,M,-36.3,M,,*73\r\n"
+	"$GPGSA,A,3,06,02,19,24,17,12,,,,,,,2.10,1.20,1.70*0B\r\n"
+	"$GPRMC,101908.00,A,2951.93660,N,07752.40537,E,11.500,45.00,300322,,,A*6C\r\n"
+	"$GPGGA,101908.00,2951.93660,N,07752.40537,E,1,06,1.20,248.4,M,-36.3,M,,*7E\r\n"
+	"$GPGSA,A,3,06,02,19,24,17,12,,,,,,,2.10,1.20,1.70*0B\r\n"
+	"$GPRMC,101909.00,A,2951.93960,N,07752.40837,E,11.500,45.00,300322,,,A*6F\r\n"
+	"$GPGGA,101909.00,2951.93960,N,07752.40837,E,1,06,1.20,248.4,M,-36.3,M,,*7D\r\n"
+	"$GPGSA,A,3,06,02,19,24,17,12,,,,,,,2.10,1.20,1.70*0B\r\n"
+	"$GPRMC,101910.00,A,2951.94260,N,07752.41137,E,11.500,45.00,300322,,,A*63\r\n"
+	"$GPGGA,101910.00,2951.94260,N,07752.41137,E,1,06,1.20,248.4,M,-36.3,M,,*71\r\n"
+	"$GPGSA,A,3,06,02,19,24,17,12,,,,,,,2.10,1.20,1.70*0B\r\n"
+	"$GPRMC,101911.00,A,2951.94560,N,07752.41437,E,11.500,45.00,300322,,,A*60\r\n"
+	"$GPGGA,101911.00,2951.94560,N,07752.41437,E,1,06,1.20,248.4,M,-36.3,M,,*72\r\n"
+	"$GPGSA,A,3,06,02,19,24,17,12,,,,,,,2.10,1.20,1.70*0B\r\n";
+
+/* Define some common use MACRO - START */
+#if(GPS_REPLAY_SYNTH == MZ_ENABLE)
+#define REPLAY_PERIOD_MS			(1000 / GPS_REPLAY_RATE_HZ)	///< One generated epoch
+#define REPLAY_EPOCH_SIZE			(640)						///< Largest generated epoch
+#else
+#define REPLAY_PERIOD_MS			(GPS_REPLAY_PERIOD_MS)
+#endif
+/* Define some common use MACRO - END */
+
+/* Replay related variables - START */
+static const char * replay_trace = NULL;						/* Trace in use */
+static const char * replay_pos = NULL;							/* Start of the next epoch */
+static const char * replay_pending = NULL;						/* Part of the epoch not delivered yet */
+static uint16_t replay_pending_len = 0;							/* Length of replay_pending */
+static uint32_t replay_last_ms = 0;								/* Time of the last epoch */
+static uint8_t replay_started = 0;								/* First epoch was sent */
+#if(GPS_REPLAY_SYNTH == MZ_ENABLE)
+static st_gps_nmea_gen replay_gen;								/* Synthetic receiver */
+static char replay_epoch[REPLAY_EPOCH_SIZE];					/* Last generated epoch */
+#endif
+/* Replay related variables - END */
+
+#if(GPS_REPLAY_SYNTH != MZ_ENABLE)
+/** @fn static const char * replay_next_epoch(const char * p)
+ * @brief Start of the epoch after the one at p (next RMC sentence)
+ */
+static const char * replay_next_epoch(const char * p)
+{
+	const char * next = p;
+
+	while(NULL != (next = strchr(next + 1, '$')))
+	{
+		if(0 == strncmp(next + 3, "RMC", 3))
+		{
+			return next;
+		}
+	}
+	return p + strlen(p);
+}
+#endif
+
+/** @fn static void replay_load_epoch(void)
+ * @brief Make the next epoch of the trace or of the generator pending
+ */
+static void replay_load_epoch(void)
+{
+#if(GPS_REPLAY_SYNTH == MZ_ENABLE)
+	replay_pending_len = gps_nmea_gen_epoch(&replay_gen, replay_epoch, sizeof(replay_epoch));
+	replay_pending = replay_epoch;
+#else
+	const char * end;
+
+	if(*replay_pos == '\0')
+	{
+		replay_pos = replay_trace;
+	}
+	end = replay_next_epoch(replay_pos);
+	replay_pending = replay_pos;
+	replay_pending_len = (uint16_t)(end - replay_pos);
+	replay_pos = end;
+#endif
+}
+
+/** @fn static uint16_t replay_deliver(char * buf, uint16_t size, uint16_t len)
+ * @brief Copy len characters of the pending epoch into the receive buffer
+ */
+static uint16_t replay_deliver(char * buf, uint16_t size, uint16_t len)
+{
+	uint16_t copy = len;
+
+	/* A too long epoch is cut, the parser drops the partial sentence */
+	if(copy > (size - 1))
+	{
+		copy = size - 1;
+	}
+	memcpy(buf, replay_pending, copy);
+	buf[copy] = '\0';
+	replay_pending += len;
+	replay_pending_len -= len;
+
+	return copy;
+}
+
+/*
+ * NMEA trace to replay. - START
+ * NOTE : This function can be modified, the gps_replay_source can be
+ *        implemented in the user file also.
+ */
+__attribute__((weak)) const char * gps_replay_source(void)
+{
+	return gps_replay_default_trace;
+}
+/* NMEA trace to replay. - END */
+
+/*
+ * Restart the replay from the first epoch. - START
+ */
+void gps_replay_init(void)
+{
+#if(GPS_REPLAY_SYNTH == MZ_ENABLE)
+	/* Trajectory of the built in trace, stream shape from MZ_gps_app_config.h */
+	static const st_gps_nmea_gen_cfg cfg =
+	{
+		.lat_e7 = 298653100,
+		.lon_e7 = 778731228,
+		.utc_time = 101902,
+		.utc_date = 300322,
+		.speed_cms = 600,
+		.course_cdeg = 4500,
+		.turn_cdeg_s = 0,
+		.hdop_x100 = 120,
+		.rate_hz = GPS_REPLAY_RATE_HZ,
+		.sentences = GPS_NMEA_GEN_RMC | GPS_NMEA_GEN_GGA | GPS_NMEA_GEN_GSA,
+		.glonass = (GPS_REPLAY_GLONASS == MZ_ENABLE),
+		.corrupt_every = GPS_REPLAY_CORRUPT_EVERY,
+		.drop_every = GPS_REPLAY_DROP_EVERY,
+	};
+
+	gps_nmea_gen_init(&replay_gen, &cfg);
+	replay_trace = replay_epoch;
+#else
+	replay_trace = gps_replay_source();
+#endif
+	replay_pos = replay_trace;
+	replay_pending_len = 0;
+	replay_started = 0;
+}
+/* Restart the replay from the first epoch. - END */
+
+/*
+ * Copy the next epoch when it is due. - START
+ */
+uint16_t gps_replay_poll(char * buf, uint16_t size, uint32_t now_ms)
+{
+	if((replay_trace == NULL) || (size == 0))
+	{
+		return 0;
+	}
+
+	/* Rest of a split epoch goes out on the next read */
+	if(replay_pending_len > 0)
+	{
+		return replay_deliver(buf, size, replay_pending_len);
+	}
+
+	if(replay_started && ((now_ms - replay_last_ms) < REPLAY_PERIOD_MS))
+	{
+		return 0;
+	}
+	replay_started = 1;
+	replay_last_ms = now_ms;
+
+	replay_load_epoch();
+	if(replay_pending_len == 0)
+	{
+		return 0;
+	}
+#if(GPS_REPLAY_SPLIT == MZ_ENABLE)
+	return replay_deliver(buf, size, replay_pending_len / 2);
+#else
+	return replay_deliver(buf, size, replay_pending_len);
+#endif
+}
+/* Copy the next epoch when it is due. - END */
+
+#endif //(GPS_REPLAY_ENABLE == MZ_ENABLE)
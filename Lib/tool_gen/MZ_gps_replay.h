@@ -0,0 +1,50 @@
+/*
+ * MZ_gps_replay.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Recorded NMEA replay in place of the LPUART1 receiver.
+ *
+ *  With GPS_REPLAY_ENABLE the GPS thread takes its receive buffer from a
+ *  trace in flash, one epoch (from one RMC to the next) per
+ *  GPS_REPLAY_PERIOD_MS, and runs the normal parse / commit / publish path.
+ *  Task timing, timers and the publish path can be exercised and profiled
+ *  on a board without an antenna or receiver, with repeatable input.
+ *  The trace loops. With GPS_REPLAY_SYNTH the epochs come from the
+ *  synthetic receiver (MZ_gps_nmea_gen.c) at GPS_REPLAY_RATE_HZ, with the
+ *  configured faults, and GPS_REPLAY_SPLIT delivers every epoch in two
+ *  reads to exercise sentences cut between buffers. No HAL dependency.
+ */
+
+#ifndef MZ_GPS_REPLAY_H_
+#define MZ_GPS_REPLAY_H_
+
+#include "stdint.h"
+#include "MZ_gps_app_config.h"
+
+#if(GPS_REPLAY_ENABLE == MZ_ENABLE)
+
+/** @fn void gps_replay_init(void)
+ * @brief Restart the replay from the first epoch of the trace.
+ */
+void gps_replay_init(void);
+
+/** @fn uint16_t gps_replay_poll(char * buf, uint16_t size, uint32_t now_ms)
+ * @brief Copy the next epoch into buf when it is due.
+ * @param buf receive buffer, NUL terminated on output
+ * @param size size of buf
+ * @param now_ms current time in ms
+ * @return number of characters copied, 0 when no epoch is due
+ */
+uint16_t gps_replay_poll(char * buf, uint16_t size, uint32_t now_ms);
+
+/** @fn const char * gps_replay_source(void)
+ * @brief NMEA trace to replay, NUL terminated. Weak, a built in trace is
+ * used unless the application provides its own.
+ * @return trace
+ */
+const char * gps_replay_source(void);
+
+#endif //(GPS_REPLAY_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_REPLAY_H_ */
@@ -0,0 +1,128 @@
+/*
+ * MZ_gps_report_policy.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_report_policy.h"
+
+/* Include Header Files - END */
+
+#if(GPS_REPORT_POLICY_ENABLE == MZ_ENABLE)
+
+/* Define some common use MACRO - START */
+#define REPORT_FULL_TURN_CDEG			(36000)					///< 360 degree
+#define REPORT_HALF_TURN_CDEG			(18000)					///< 180 degree
+/* Define some common use MACRO - END */
+
+/* Report policy related variables - START */
+static st_gps_report_cfg report_cfg =
+{
+	.min_interval_ms = GPS_REPORT_MIN_INTERVAL_MS,
+	.max_silence_ms = GPS_REPORT_MAX_SILENCE_MS,
+	.distance_m = GPS_REPORT_DISTANCE_M,
+	.heading_cdeg = GPS_REPORT_HEADING_CDEG,
+	.heading_min_cms = GPS_REPORT_HEADING_MIN_CMS,
+	.speed_delta_cms = GPS_REPORT_SPEED_DELTA_CMS,
+};
+static st_gps_fix report_last;									/* Last published fix */
+static uint8_t report_have_last = 0;							/* report_last is valid */
+/* Report policy related variables - END */
+
+/*
+ * Set the thresholds and forget the last published fix. - START
+ */
+void gps_report_policy_init(const st_gps_report_cfg * cfg)
+{
+	if(cfg != 0)
+	{
+		report_cfg = *cfg;
+	}
+	report_have_last = 0;
+}
+/* Set the thresholds and forget the last published fix. - END */
+
+/*
+ * Decide if a committed fix has to be published. - START
+ */
+en_gps_report_reason gps_report_policy_check(const st_gps_fix * fix)
+{
+	en_gps_report_reason reason = GPS_REPORT_NONE;
+	uint32_t elapsed;
+
+	if(!report_have_last)
+	{
+		reason = GPS_REPORT_FIRST;
+		goto publish;
+	}
+
+	elapsed = fix->tick - report_last.tick;
+	if(elapsed < report_cfg.min_interval_ms)
+	{
+		return GPS_REPORT_NONE;
+	}
+	if(elapsed >= report_cfg.max_silence_ms)
+	{
+		reason = GPS_REPORT_SILENCE;
+		goto publish;
+	}
+
+	/* Distance deadband, compared squared in cm */
+	{
+		int32_t east_cm;
+		int32_t north_cm;
+		int64_t limit_cm = (int64_t)report_cfg.distance_m * 100;
+
+		gps_fix_offset_cm(report_last.lat_e7, report_last.lon_e7, fix->lat_e7, fix->lon_e7, &east_cm, &north_cm);
+		if((((int64_t)east_cm * east_cm) + ((int64_t)north_cm * north_cm)) >= (limit_cm * limit_cm))
+		{
+			reason = GPS_REPORT_DISTANCE;
+			goto publish;
+		}
+	}
+
+	/* Heading deadband, only meaningful while moving */
+	if((fix->speed_cms >= report_cfg.heading_min_cms) && (report_last.speed_cms >= report_cfg.heading_min_cms))
+	{
+		int32_t diff = (int32_t)fix->course_cdeg - (int32_t)report_last.course_cdeg;
+
+		diff = ((diff % REPORT_FULL_TURN_CDEG) + REPORT_FULL_TURN_CDEG + REPORT_HALF_TURN_CDEG) % REPORT_FULL_TURN_CDEG;
+		diff -= REPORT_HALF_TURN_CDEG;
+		if(diff < 0)
+		{
+			diff = -diff;
+		}
+		if(diff >= report_cfg.heading_cdeg)
+		{
+			reason = GPS_REPORT_HEADING;
+			goto publish;
+		}
+	}
+
+	/* Speed deadband */
+	{
+		int32_t dv = (int32_t)fix->speed_cms - (int32_t)report_last.speed_cms;
+
+		if(dv < 0)
+		{
+			dv = -dv;
+		}
+		if(dv >= report_cfg.speed_delta_cms)
+		{
+			reason = GPS_REPORT_SPEED;
+			goto publish;
+		}
+	}
+
+	return GPS_REPORT_NONE;
+
+	publish :
+	report_last = *fix;
+	report_have_last = 1;
+	return reason;
+}
+/* Decide if a committed fix has to be published. - END */
+
+#endif //(GPS_REPORT_POLICY_ENABLE == MZ_ENABLE)
@@ -0,0 +1,66 @@
+/*
+ * MZ_gps_report_policy.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Adaptive reporting policy. Every committed fix is compared with the last
+ *  published one and a publish is requested when the vehicle moved, turned
+ *  or changed speed enough, or when the silence interval is over. A minimum
+ *  interval limits the publish rate. All checks are integer math.
+ *  No HAL dependency.
+ */
+
+#ifndef MZ_GPS_REPORT_POLICY_H_
+#define MZ_GPS_REPORT_POLICY_H_
+
+#include "stdint.h"
+#include "MZ_gps_app_config.h"
+#include "MZ_gps_fix.h"
+
+/**
+ * @enum en_gps_report_reason
+ * @brief Why a fix has to be published
+ */
+typedef enum
+{
+	GPS_REPORT_NONE = 0,										/*!< Do not publish */
+	GPS_REPORT_FIRST,											/*!< First fix after reset */
+	GPS_REPORT_DISTANCE,										/*!< Moved more than distance_m */
+	GPS_REPORT_HEADING,											/*!< Turned more than heading_cdeg */
+	GPS_REPORT_SPEED,											/*!< Speed changed more than speed_delta_cms */
+	GPS_REPORT_SILENCE,											/*!< max_silence_ms elapsed */
+}en_gps_report_reason;
+
+/**
+ * @struct st_gps_report_cfg
+ * @brief Policy thresholds
+ */
+typedef struct
+{
+	uint32_t		min_interval_ms;							/*!< Minimum time between two publishes */
+	uint32_t		max_silence_ms;								/*!< Maximum time without a publish */
+	uint32_t		distance_m;									/*!< Distance deadband */
+	uint16_t		heading_cdeg;								/*!< Heading deadband in 1/100 degree */
+	uint16_t		heading_min_cms;							/*!< Speed below which heading is noise */
+	uint16_t		speed_delta_cms;							/*!< Speed deadband */
+}st_gps_report_cfg;
+
+#if(GPS_REPORT_POLICY_ENABLE == MZ_ENABLE)
+
+/** @fn void gps_report_policy_init(const st_gps_report_cfg * cfg)
+ * @brief Set the thresholds and forget the last published fix.
+ * @param cfg thresholds, NULL for the GPS_REPORT_* defaults
+ */
+void gps_report_policy_init(const st_gps_report_cfg * cfg);
+
+/** @fn en_gps_report_reason gps_report_policy_check(const st_gps_fix * fix)
+ * @brief Decide if a committed fix has to be published. When the answer is
+ * not GPS_REPORT_NONE the fix becomes the new reference.
+ * @param fix committed fix, tick is used as time base
+ * @return publish reason
+ */
+en_gps_report_reason gps_report_policy_check(const st_gps_fix * fix);
+
+#endif //(GPS_REPORT_POLICY_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_REPORT_POLICY_H_ */
@@ -0,0 +1,217 @@
+/*
+ * MZ_gps_rxpm.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_rxpm.h"
+#include "MZ_gps_ubx.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+#if(GPS_RXPM_ENABLE == MZ_ENABLE)
+
+/* Define some common use MACRO - START */
+#define RXPM_RXM_LEN				(2)							///< CFG-RXM payload
+#define RXPM_RXM_POWER_SAVE			(1)							///< CFG-RXM lpMode
+#define RXPM_PM2_LEN				(44)						///< CFG-PM2 payload (u-blox 6)
+#define RXPM_PM2_UPDATE_EPH			(1UL << 12)					///< CFG-PM2 flags, wake up for ephemeris updates
+#define RXPM_PM2_CYCLIC				(1UL << 17)					///< CFG-PM2 flags, cyclic tracking instead of on/off
+#define RXPM_PM2_SEARCH_MS			(10000UL)					///< Retry period without a fix
+#define RXPM_PM2_ON_S				(2)							///< Tracking time per cycle
+#define RXPM_PMREQ_LEN				(8)							///< RXM-PMREQ payload
+#define RXPM_PMREQ_BACKUP			(0x02)						///< RXM-PMREQ flags, enter backup
+#define RXPM_MARGIN_MS				(1000)						///< Added to the TTFF estimate, one epoch
+#define RXPM_LEAD_MAX_MS			(GPS_RXPM_PERIOD_MS / 2)	///< Upper bound of the lead time
+/* Define some common use MACRO - END */
+
+/** @fn static void rxpm_ttff_sample(st_gps_rxpm * pm, uint32_t ttff)
+ * @brief Add one TTFF to the estimate and derive the lead time
+ */
+static void rxpm_ttff_sample(st_gps_rxpm * pm, uint32_t ttff)
+{
+	int32_t err;
+	uint32_t lead;
+
+	pm->stats.ttff_last = ttff;
+	if(ttff > pm->stats.ttff_max)
+	{
+		pm->stats.ttff_max = ttff;
+	}
+
+	if(pm->ttff_samples == 0)
+	{
+		pm->ttff_samples = 1;
+		pm->ttff_avg = ttff;
+		pm->ttff_dev = ttff / 2;
+	}
+	else
+	{
+		err = (int32_t)(ttff - pm->ttff_avg);
+		pm->ttff_avg = (uint32_t)((int32_t)pm->ttff_avg + (err / 8));
+		err = (err < 0) ? -err : err;
+		pm->ttff_dev = (uint32_t)((int32_t)pm->ttff_dev + ((err - (int32_t)pm->ttff_dev) / 4));
+	}
+
+	lead = pm->ttff_avg + (4 * pm->ttff_dev) + RXPM_MARGIN_MS;
+	if(lead < GPS_RXPM_LEAD_MIN_MS)
+	{
+		lead = GPS_RXPM_LEAD_MIN_MS;
+	}
+	if(lead > RXPM_LEAD_MAX_MS)
+	{
+		lead = RXPM_LEAD_MAX_MS;
+	}
+	pm->lead_ms = lead;
+}
+
+#if(GPS_RXPM_CYCLIC == MZ_ENABLE)
+/** @fn static uint16_t rxpm_config_frame(uint8_t step, uint8_t * out, uint16_t size)
+ * @brief Power save configuration, CFG-PM2 first then CFG-RXM to enter it
+ */
+static uint16_t rxpm_config_frame(uint8_t step, uint8_t * out, uint16_t size)
+{
+	uint8_t payload[RXPM_PM2_LEN];
+
+	memset(payload, 0, sizeof(payload));
+	if(step == 0)
+	{
+		payload[0] = 1;											/* version */
+		gps_ubx_put_u32(&payload[4], RXPM_PM2_CYCLIC | RXPM_PM2_UPDATE_EPH);
+		gps_ubx_put_u32(&payload[8], GPS_RXPM_CYCLIC_UPDATE_MS);
+		gps_ubx_put_u32(&payload[12], RXPM_PM2_SEARCH_MS);
+		gps_ubx_put_u16(&payload[20], RXPM_PM2_ON_S);
+		return gps_ubx_frame(GPS_UBX_CLASS_CFG, GPS_UBX_CFG_PM2, payload, RXPM_PM2_LEN, out, size);
+	}
+	payload[0] = 8;												/* reserved1, always 8 */
+	payload[1] = RXPM_RXM_POWER_SAVE;
+	return gps_ubx_frame(GPS_UBX_CLASS_CFG, GPS_UBX_CFG_RXM, payload, RXPM_RXM_LEN, out, size);
+}
+#endif
+
+/*
+ * Start with the receiver on and searching. - START
+ */
+void gps_rxpm_init(st_gps_rxpm * pm, uint32_t now_ms)
+{
+	memset(pm, 0, sizeof(*pm));
+#if(GPS_RXPM_CYCLIC == MZ_ENABLE)
+	pm->state = GPS_RXPM_CONFIG;
+#else
+	pm->state = GPS_RXPM_ACQUIRE;
+#endif
+	pm->on_ms = now_ms;
+	pm->lead_ms = GPS_RXPM_LEAD_INIT_MS;
+
+	/* Collect a fresh ephemeris before the first backup */
+	pm->eph_ms = now_ms - GPS_RXPM_EPH_REFRESH_MS;
+}
+/* Start with the receiver on and searching. - END */
+
+/*
+ * A valid fix was committed. - START
+ */
+void gps_rxpm_fix(st_gps_rxpm * pm, uint32_t now_ms)
+{
+	if(pm->state == GPS_RXPM_CONFIG)
+	{
+		return;
+	}
+
+	if(pm->state != GPS_RXPM_TRACK)
+	{
+		/* A fix while OFF means the receiver woke early, no TTFF then */
+		if(pm->state == GPS_RXPM_ACQUIRE)
+		{
+			rxpm_ttff_sample(pm, now_ms - pm->on_ms);
+		}
+		pm->state = GPS_RXPM_TRACK;
+		pm->track_ms = now_ms;
+	}
+
+	if((now_ms - pm->track_ms) >= GPS_RXPM_EPH_ON_MS)
+	{
+		pm->eph_ms = now_ms;
+	}
+}
+/* A valid fix was committed. - END */
+
+/*
+ * A report was sent. - START
+ */
+void gps_rxpm_reported(st_gps_rxpm * pm, uint32_t now_ms)
+{
+	pm->deadline_ms = now_ms + GPS_RXPM_PERIOD_MS;
+	pm->deadline_set = 1;
+	pm->missed = 0;
+}
+/* A report was sent. - END */
+
+/*
+ * Advance the power state. - START
+ */
+uint16_t gps_rxpm_poll(st_gps_rxpm * pm, uint32_t now_ms, uint8_t * out, uint16_t size)
+{
+#if(GPS_RXPM_CYCLIC == MZ_ENABLE)
+	if(pm->state == GPS_RXPM_CONFIG)
+	{
+		uint16_t len = rxpm_config_frame(pm->config_step++, out, size);
+
+		if(pm->config_step >= 2)
+		{
+			pm->state = GPS_RXPM_ACQUIRE;
+		}
+		return len;
+	}
+	/* The receiver runs its cycle itself */
+	return 0;
+#else
+	int32_t off;
+
+	if((pm->state == GPS_RXPM_OFF) && ((int32_t)(now_ms - pm->wake_ms) >= 0))
+	{
+		/* Backup period over, the receiver is starting */
+		pm->state = GPS_RXPM_ACQUIRE;
+		pm->on_ms = pm->wake_ms;
+	}
+
+	if(pm->state != GPS_RXPM_TRACK)
+	{
+		if(pm->deadline_set && !pm->missed && ((int32_t)(now_ms - pm->deadline_ms) >= 0))
+		{
+			pm->missed = 1;
+			pm->stats.misses++;
+		}
+		return 0;
+	}
+
+	/* Tracking : power down until the lead time before the deadline */
+	if(!pm->deadline_set || ((now_ms - pm->eph_ms) >= GPS_RXPM_EPH_REFRESH_MS))
+	{
+		return 0;
+	}
+	off = (int32_t)(pm->deadline_ms - pm->lead_ms - now_ms);
+	if(off < (int32_t)GPS_RXPM_MIN_OFF_MS)
+	{
+		return 0;
+	}
+
+	{
+		uint8_t payload[RXPM_PMREQ_LEN];
+
+		gps_ubx_put_u32(&payload[0], (uint32_t)off);
+		gps_ubx_put_u32(&payload[4], RXPM_PMREQ_BACKUP);
+		pm->state = GPS_RXPM_OFF;
+		pm->wake_ms = now_ms + (uint32_t)off;
+		pm->stats.offs++;
+		pm->stats.off_ms += (uint32_t)off;
+		return gps_ubx_frame(GPS_UBX_CLASS_RXM, GPS_UBX_RXM_PMREQ, payload, RXPM_PMREQ_LEN, out, size);
+	}
+#endif
+}
+/* Advance the power state. - END */
+
+#endif //(GPS_RXPM_ENABLE == MZ_ENABLE)
@@ -0,0 +1,118 @@
+/*
+ * MZ_gps_rxpm.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Receiver power save orchestration.
+ *
+ *  Two ways to keep the receiver out of continuous tracking:
+ *  - cyclic (GPS_RXPM_CYCLIC) : CFG-PM2 cyclic tracking with a fix every
+ *    GPS_RXPM_CYCLIC_UPDATE_MS, then CFG-RXM power save mode. The
+ *    receiver runs the cycle itself, movement is still seen between
+ *    reports at the update rate.
+ *  - on/off (default) : after each report the receiver is put in backup
+ *    with RXM-PMREQ until the next report deadline minus a lead time,
+ *    it wakes by itself and has a fix ready for the deadline. The lead
+ *    time follows the measured time to first fix, smoothed like a
+ *    retransmission timeout : lead = avg + 4 * dev + margin. A fix that
+ *    is not ready at the deadline counts as a miss and its long TTFF
+ *    raises the lead. The receiver stays on for GPS_RXPM_EPH_ON_MS of
+ *    continuous tracking every GPS_RXPM_EPH_REFRESH_MS so its ephemeris
+ *    stays fresh enough for hot starts. Movement reports only happen
+ *    while the receiver is on.
+ *  Frames go to the receiver through gps_rxpm_poll(). All times are
+ *  passed in ms, no HAL dependency. MZ_gps_nmea_gen.c emulates the
+ *  receiver start states for host tests.
+ */
+
+#ifndef MZ_GPS_RXPM_H_
+#define MZ_GPS_RXPM_H_
+
+#include "stdint.h"
+#include "MZ_gps_app_config.h"
+
+#define GPS_RXPM_FRAME_SIZE			(64)					///< Largest frame from gps_rxpm_poll (CFG-PM2)
+
+/**
+ * @enum en_gps_rxpm_state
+ * @brief Receiver power state
+ */
+typedef enum
+{
+	GPS_RXPM_CONFIG = 0,										/*!< Power save frames still to send */
+	GPS_RXPM_ACQUIRE,											/*!< On, no fix yet */
+	GPS_RXPM_TRACK,												/*!< On, fix available */
+	GPS_RXPM_OFF,												/*!< Backup until wake_ms */
+}en_gps_rxpm_state;
+
+/**
+ * @struct st_gps_rxpm_stats
+ * @brief Orchestration counters
+ */
+typedef struct
+{
+	uint32_t		offs;										/*!< Backup periods */
+	uint32_t		off_ms;										/*!< Time in backup */
+	uint32_t		misses;										/*!< Deadlines without a fix */
+	uint32_t		ttff_last;									/*!< Last time to first fix */
+	uint32_t		ttff_max;									/*!< Longest time to first fix */
+}st_gps_rxpm_stats;
+
+/**
+ * @struct st_gps_rxpm
+ * @brief Orchestrator state
+ */
+typedef struct
+{
+	en_gps_rxpm_state	state;									/*!< Receiver power state */
+	uint8_t				config_step;							/*!< Next configuration frame */
+	uint8_t				deadline_set;							/*!< A report deadline is pending */
+	uint8_t				missed;									/*!< Current deadline already counted */
+	uint32_t			deadline_ms;							/*!< Next report */
+	uint32_t			on_ms;									/*!< Power up of the current start */
+	uint32_t			wake_ms;								/*!< End of the backup period */
+	uint32_t			track_ms;								/*!< Continuous tracking since */
+	uint32_t			eph_ms;									/*!< Last ephemeris refresh */
+	uint32_t			lead_ms;								/*!< Wake up before the deadline */
+	uint32_t			ttff_avg;								/*!< Smoothed time to first fix */
+	uint32_t			ttff_dev;								/*!< Smoothed deviation */
+	uint8_t				ttff_samples;							/*!< 0 until the first sample */
+	st_gps_rxpm_stats	stats;									/*!< Counters */
+}st_gps_rxpm;
+
+#if(GPS_RXPM_ENABLE == MZ_ENABLE)
+
+/** @fn void gps_rxpm_init(st_gps_rxpm * pm, uint32_t now_ms)
+ * @brief Start with the receiver on and searching.
+ * @param pm orchestrator
+ * @param now_ms current time
+ */
+void gps_rxpm_init(st_gps_rxpm * pm, uint32_t now_ms);
+
+/** @fn void gps_rxpm_fix(st_gps_rxpm * pm, uint32_t now_ms)
+ * @brief A valid fix was committed.
+ * @param pm orchestrator
+ * @param now_ms current time
+ */
+void gps_rxpm_fix(st_gps_rxpm * pm, uint32_t now_ms);
+
+/** @fn void gps_rxpm_reported(st_gps_rxpm * pm, uint32_t now_ms)
+ * @brief A report was sent, the next one is due GPS_RXPM_PERIOD_MS later.
+ * @param pm orchestrator
+ * @param now_ms current time
+ */
+void gps_rxpm_reported(st_gps_rxpm * pm, uint32_t now_ms);
+
+/** @fn uint16_t gps_rxpm_poll(st_gps_rxpm * pm, uint32_t now_ms, uint8_t * out, uint16_t size)
+ * @brief Advance the power state, call it at least every second.
+ * @param pm orchestrator
+ * @param now_ms current time
+ * @param out UBX frame to send to the receiver
+ * @param size size of out, GPS_RXPM_FRAME_SIZE
+ * @return frame length, 0 when nothing is to be sent
+ */
+uint16_t gps_rxpm_poll(st_gps_rxpm * pm, uint32_t now_ms, uint8_t * out, uint16_t size);
+
+#endif //(GPS_RXPM_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_RXPM_H_ */
@@ -0,0 +1,570 @@
+/*
+ * MZ_gps_sdlog.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_sdlog.h"
+#include "MZ_gps_lowpower.h"
+#include "main.h"
+
+#include "string.h"
+
+/* Include Header Files - END */
+
+#if(GPS_SDLOG_ENABLE == MZ_ENABLE)
+
+/* Define some common use MACRO - START */
+#define SDLOG_BUF_COUNT				(2)							///< Double buffer
+#define SDLOG_BUF_SIZE				(GPS_SDLOG_BLOCKS_PER_BUF * GPS_SDLOG_BLOCK_SIZE)	///< Bytes per half
+#define SDLOG_HDR_SIZE				(sizeof(st_gps_sdlog_block_hdr))	///< Block header size
+#define SDLOG_REC_HDR_SIZE			(2)							///< Record type + length
+#define SDLOG_REC_MAX_PAYLOAD		(255)						///< Record length fits in one byte
+#define SDLOG_SCAN_LIMIT			((GPS_SDLOG_SUPER_EVERY + 1) * GPS_SDLOG_BLOCKS_PER_BUF)	///< Blocks scanned past the superblock head
+#define SDLOG_INIT_TIMEOUT			(1000)						///< Blocking card access timeout during init (ms)
+#define SDLOG_SDMMC_CLOCK_DIV		(2)							///< 48 MHz / (2 + 2) = 12 MHz card clock
+#define SDLOG_DMA_IRQ_PRIO			(5)							///< Same priority as SDMMC1_IRQn
+
+#define SDLOG_XFER_NONE				(0)							///< No transfer in flight
+#define SDLOG_XFER_DATA				(1)							///< Data burst in flight
+#define SDLOG_XFER_SUPER			(2)							///< Superblock write in flight
+/* Define some common use MACRO - END */
+
+/**
+ * @enum en_sdlog_buf_state
+ * @brief State of one half of the double buffer
+ */
+typedef enum
+{
+	SDLOG_BUF_FREE,												/*!< Empty, can be filled */
+	SDLOG_BUF_FILLING,											/*!< Being filled by the writer */
+	SDLOG_BUF_READY,											/*!< Closed, waiting for the card */
+	SDLOG_BUF_TX,												/*!< DMA transfer in flight */
+}en_sdlog_buf_state;
+
+/**
+ * @struct st_sdlog_buf
+ * @brief Bookkeeping of one half of the double buffer
+ */
+typedef struct
+{
+	en_sdlog_buf_state	state;									/*!< Buffer state */
+	uint32_t			first_seq;								/*!< Sequence of the first block */
+	uint16_t			blocks;									/*!< Blocks to be written */
+	uint16_t			sent;									/*!< Blocks already on the card */
+	uint32_t			opened_tick;							/*!< Tick when filling started */
+}st_sdlog_buf;
+
+/**
+ * @struct st_sdlog_super
+ * @brief Superblock image
+ */
+typedef struct __attribute__((packed))
+{
+	uint32_t		magic;										/*!< GPS_SDLOG_SUPER_MAGIC */
+	uint32_t		gen;										/*!< Incremented on every superblock write */
+	uint32_t		head_seq;									/*!< First sequence not yet durable */
+	uint32_t		start_block;								/*!< GPS_SDLOG_START_BLOCK of the writer */
+	uint32_t		ring_blocks;								/*!< GPS_SDLOG_RING_BLOCKS of the writer */
+}st_sdlog_super;
+
+/* SD logger related variables - START */
+extern SD_HandleTypeDef hsd1;
+static DMA_HandleTypeDef sdlog_hdma_tx;
+
+static uint8_t sdlog_buf[SDLOG_BUF_COUNT][SDLOG_BUF_SIZE] __attribute__((aligned(4)));
+static uint8_t sdlog_super_buf[GPS_SDLOG_BLOCK_SIZE] __attribute__((aligned(4)));
+static st_sdlog_buf sdlog_ctx[SDLOG_BUF_COUNT];
+
+static uint8_t sdlog_ready = 0;									/* Card initialized and head recovered */
+static uint8_t sdlog_fill = 0;									/* Buffer being filled */
+static uint16_t sdlog_blk = 0;									/* Block being filled inside sdlog_fill */
+static uint16_t sdlog_off = 0;									/* Write offset inside that block */
+static uint32_t sdlog_assign_seq = 0;							/* Sequence for the next opened block */
+static uint32_t sdlog_durable_seq = 0;							/* Blocks before this are on the card */
+static uint32_t sdlog_super_gen = 0;							/* Generation of the last superblock */
+static uint32_t sdlog_bursts_since_super = 0;					/* Bursts since the last superblock */
+
+static uint8_t sdlog_xfer = SDLOG_XFER_NONE;					/* Transfer type in flight */
+static uint8_t sdlog_xfer_buf = 0;								/* Buffer of the data transfer in flight */
+static uint16_t sdlog_xfer_blocks = 0;							/* Blocks of the data transfer in flight */
+static volatile uint8_t sdlog_xfer_done = 0;					/* Set from the SDMMC1 interrupt */
+static volatile uint8_t sdlog_xfer_error = 0;					/* Set from the SDMMC1 interrupt */
+
+static st_gps_sdlog_stats sdlog_stats;
+/* SD logger related variables - END */
+
+/** @fn static uint32_t sdlog_block_addr(uint32_t seq)
+ * @brief Card block address of a sequence number
+ */
+static uint32_t sdlog_block_addr(uint32_t seq)
+{
+	return GPS_SDLOG_START_BLOCK + (seq % GPS_SDLOG_RING_BLOCKS);
+}
+
+/** @fn static mz_error_t sdlog_wait_transfer_state(void)
+ * @brief Blocking wait for the card to leave programming state (init only)
+ */
+static mz_error_t sdlog_wait_transfer_state(void)
+{
+	uint32_t start = HAL_GetTick();
+
+	while(HAL_SD_CARD_TRANSFER != HAL_SD_GetCardState(&hsd1))
+	{
+		if((HAL_GetTick() - start) > SDLOG_INIT_TIMEOUT)
+		{
+			return MZ_FAIL;
+		}
+	}
+	return MZ_OK;
+}
+
+/** @fn static mz_error_t sdlog_read_block(uint32_t addr, uint8_t * dst)
+ * @brief Blocking single block read (init only)
+ */
+static mz_error_t sdlog_read_block(uint32_t addr, uint8_t * dst)
+{
+	if(HAL_OK != HAL_SD_ReadBlocks(&hsd1, dst, addr, 1, SDLOG_INIT_TIMEOUT))
+	{
+		return MZ_FAIL;
+	}
+	return sdlog_wait_transfer_state();
+}
+
+/** @fn static void sdlog_open_block(void)
+ * @brief Start a new block in the fill buffer
+ */
+static void sdlog_open_block(void)
+{
+	st_gps_sdlog_block_hdr * hdr = (st_gps_sdlog_block_hdr *)&sdlog_buf[sdlog_fill][sdlog_blk * GPS_SDLOG_BLOCK_SIZE];
+
+	if(sdlog_blk == 0)
+	{
+		sdlog_ctx[sdlog_fill].state = SDLOG_BUF_FILLING;
+		sdlog_ctx[sdlog_fill].first_seq = sdlog_assign_seq;
+		sdlog_ctx[sdlog_fill].blocks = 0;
+		sdlog_ctx[sdlog_fill].sent = 0;
+		sdlog_ctx[sdlog_fill].opened_tick = HAL_GetTick();
+	}
+
+	hdr->magic = GPS_SDLOG_BLOCK_MAGIC;
+	hdr->seq = sdlog_assign_seq++;
+	hdr->used = SDLOG_HDR_SIZE;
+	hdr->reserved = 0;
+	sdlog_off = SDLOG_HDR_SIZE;
+}
+
+/** @fn static void sdlog_close_block(void)
+ * @brief Finish the current block: record its length and pad the tail
+ */
+static void sdlog_close_block(void)
+{
+	uint8_t * blk = &sdlog_buf[sdlog_fill][sdlog_blk * GPS_SDLOG_BLOCK_SIZE];
+
+	((st_gps_sdlog_block_hdr *)blk)->used = sdlog_off;
+	memset(&blk[sdlog_off], GPS_SDLOG_REC_PAD, GPS_SDLOG_BLOCK_SIZE - sdlog_off);
+	sdlog_blk++;
+}
+
+/** @fn static uint8_t sdlog_close_buffer(void)
+ * @brief Hand the fill buffer to the card and switch to the other half
+ * @return 1 if a free buffer is available for filling, 0 otherwise
+ */
+static uint8_t sdlog_close_buffer(void)
+{
+	uint8_t other = sdlog_fill ^ 1;
+
+	sdlog_ctx[sdlog_fill].blocks = sdlog_blk;
+	sdlog_ctx[sdlog_fill].state = SDLOG_BUF_READY;
+
+	if(SDLOG_BUF_FREE != sdlog_ctx[other].state)
+	{
+		/* Both halves are busy, keep the closed buffer as fill target so
+		 * that the writer can detect it and drop */
+		return 0;
+	}
+
+	sdlog_fill = other;
+	sdlog_blk = 0;
+	sdlog_open_block();
+	return 1;
+}
+
+/** @fn static void sdlog_service(void)
+ * @brief Consume transfer completion flags set by the interrupt
+ */
+static void sdlog_service(void)
+{
+	if(SDLOG_XFER_NONE == sdlog_xfer)
+	{
+		return;
+	}
+
+	if(sdlog_xfer_error)
+	{
+		sdlog_stats.errors++;
+		if(SDLOG_XFER_DATA == sdlog_xfer)
+		{
+			/* Drop the burst, the ring just gets a hole */
+			sdlog_ctx[sdlog_xfer_buf].state = SDLOG_BUF_FREE;
+			sdlog_durable_seq = sdlog_ctx[sdlog_xfer_buf].first_seq + sdlog_ctx[sdlog_xfer_buf].blocks;
+		}
+	}
+	else if(sdlog_xfer_done)
+	{
+		if(SDLOG_XFER_DATA == sdlog_xfer)
+		{
+			st_sdlog_buf * b = &sdlog_ctx[sdlog_xfer_buf];
+
+			b->sent += sdlog_xfer_blocks;
+			sdlog_stats.blocks_written += sdlog_xfer_blocks;
+			if(b->sent >= b->blocks)
+			{
+				b->state = SDLOG_BUF_FREE;
+				sdlog_durable_seq = b->first_seq + b->blocks;
+				sdlog_bursts_since_super++;
+			}
+			else
+			{
+				/* Burst was split at the ring end, rest goes next */
+				b->state = SDLOG_BUF_READY;
+			}
+		}
+	}
+	else
+	{
+		return;
+	}
+
+	sdlog_xfer_done = 0;
+	sdlog_xfer_error = 0;
+	sdlog_xfer = SDLOG_XFER_NONE;
+	GPS_LP_STOP_UNLOCK();
+
+	/* The fill pointer may be parked on a closed buffer, reopen if possible */
+	if((SDLOG_BUF_FILLING != sdlog_ctx[sdlog_fill].state) &&
+	   (SDLOG_BUF_FREE == sdlog_ctx[sdlog_fill ^ 1].state))
+	{
+		sdlog_fill ^= 1;
+		sdlog_blk = 0;
+		sdlog_open_block();
+	}
+}
+
+/** @fn static void sdlog_kick(void)
+ * @brief Start the next card transfer if the card is idle
+ */
+static void sdlog_kick(void)
+{
+	uint8_t sel = 0xFF;
+	uint32_t addr;
+	uint32_t n;
+
+	if(SDLOG_XFER_NONE != sdlog_xfer)
+	{
+		return;
+	}
+
+	/* Oldest ready buffer first */
+	for(uint8_t i = 0; i < SDLOG_BUF_COUNT; i++)
+	{
+		if(SDLOG_BUF_READY == sdlog_ctx[i].state)
+		{
+			if((sel == 0xFF) || ((int32_t)(sdlog_ctx[i].first_seq - sdlog_ctx[sel].first_seq) < 0))
+			{
+				sel = i;
+			}
+		}
+	}
+
+	if((sel == 0xFF) && (sdlog_bursts_since_super < GPS_SDLOG_SUPER_EVERY))
+	{
+		return;
+	}
+
+	/* Card still programming the previous burst - try again on next poll */
+	if(HAL_SD_CARD_TRANSFER != HAL_SD_GetCardState(&hsd1))
+	{
+		return;
+	}
+
+	if(sel != 0xFF)
+	{
+		st_sdlog_buf * b = &sdlog_ctx[sel];
+
+		addr = sdlog_block_addr(b->first_seq + b->sent);
+		n = b->blocks - b->sent;
+		if((addr + n) > (GPS_SDLOG_START_BLOCK + GPS_SDLOG_RING_BLOCKS))
+		{
+			n = (GPS_SDLOG_START_BLOCK + GPS_SDLOG_RING_BLOCKS) - addr;
+		}
+
+		sdlog_xfer = SDLOG_XFER_DATA;
+		GPS_LP_STOP_LOCK();
+		sdlog_xfer_buf = sel;
+		sdlog_xfer_blocks = (uint16_t)n;
+		b->state = SDLOG_BUF_TX;
+		if(HAL_OK != HAL_SD_WriteBlocks_DMA(&hsd1, &sdlog_buf[sel][b->sent * GPS_SDLOG_BLOCK_SIZE], addr, n))
+		{
+			sdlog_xfer_error = 1;
+		}
+		sdlog_stats.bursts++;
+	}
+	else
+	{
+		st_sdlog_super * s = (st_sdlog_super *)sdlog_super_buf;
+
+		sdlog_super_gen++;
+		memset(sdlog_super_buf, 0, sizeof(sdlog_super_buf));
+		s->magic = GPS_SDLOG_SUPER_MAGIC;
+		s->gen = sdlog_super_gen;
+		s->head_seq = sdlog_durable_seq;
+		s->start_block = GPS_SDLOG_START_BLOCK;
+		s->ring_blocks = GPS_SDLOG_RING_BLOCKS;
+
+		sdlog_bursts_since_super = 0;
+		sdlog_xfer = SDLOG_XFER_SUPER;
+		GPS_LP_STOP_LOCK();
+		if(HAL_OK != HAL_SD_WriteBlocks_DMA(&hsd1, sdlog_super_buf, GPS_SDLOG_SUPER_BLOCK + (sdlog_super_gen & 1), 1))
+		{
+			sdlog_xfer_error = 1;
+		}
+	}
+}
+
+/** @fn static void sdlog_write_record(uint8_t type, const uint8_t * data, uint32_t len)
+ * @brief Append one record to the fill buffer or drop it
+ */
+static void sdlog_write_record(uint8_t type, const uint8_t * data, uint32_t len)
+{
+	uint8_t * dst;
+
+	sdlog_service();
+
+	if(SDLOG_BUF_FILLING != sdlog_ctx[sdlog_fill].state)
+	{
+		sdlog_stats.dropped_bytes += len;
+		return;
+	}
+
+	if((sdlog_off + SDLOG_REC_HDR_SIZE + len) > GPS_SDLOG_BLOCK_SIZE)
+	{
+		sdlog_close_block();
+		if(sdlog_blk >= GPS_SDLOG_BLOCKS_PER_BUF)
+		{
+			uint8_t ok = sdlog_close_buffer();
+
+			sdlog_kick();
+			if(!ok)
+			{
+				sdlog_stats.dropped_bytes += len;
+				return;
+			}
+		}
+		else
+		{
+			sdlog_open_block();
+		}
+	}
+
+	dst = &sdlog_buf[sdlog_fill][(sdlog_blk * GPS_SDLOG_BLOCK_SIZE) + sdlog_off];
+	dst[0] = type;
+	dst[1] = (uint8_t)len;
+	memcpy(&dst[SDLOG_REC_HDR_SIZE], data, len);
+	sdlog_off += (uint16_t)(SDLOG_REC_HDR_SIZE + len);
+}
+
+/*
+ * Initialize SDMMC1 with DMA and recover the ring head from the card. - START
+ */
+mz_error_t gps_sdlog_init(void)
+{
+	uint32_t head = 0;
+	uint32_t best_gen = 0;
+
+	/* SDMMC1 TX DMA : DMA2 channel 4, request 7 */
+#if defined(__arm__)
+	/* RCC is a register block, the host card stub needs no clock */
+	__HAL_RCC_DMA2_CLK_ENABLE();
+#endif
+	sdlog_hdma_tx.Instance = DMA2_Channel4;
+	sdlog_hdma_tx.Init.Request = DMA_REQUEST_7;
+	sdlog_hdma_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+	sdlog_hdma_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+	sdlog_hdma_tx.Init.MemInc = DMA_MINC_ENABLE;
+	sdlog_hdma_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+	sdlog_hdma_tx.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+	sdlog_hdma_tx.Init.Mode = DMA_NORMAL;
+	sdlog_hdma_tx.Init.Priority = DMA_PRIORITY_LOW;
+	if(HAL_OK != HAL_DMA_Init(&sdlog_hdma_tx))
+	{
+		return MZ_FAIL;
+	}
+	__HAL_LINKDMA(&hsd1, hdmatx, sdlog_hdma_tx);
+	HAL_NVIC_SetPriority(DMA2_Channel4_IRQn, SDLOG_DMA_IRQ_PRIO, 0);
+	HAL_NVIC_EnableIRQ(DMA2_Channel4_IRQn);
+
+	hsd1.Instance = SDMMC1;
+	hsd1.Init.ClockEdge = SDMMC_CLOCK_EDGE_RISING;
+	hsd1.Init.ClockBypass = SDMMC_CLOCK_BYPASS_DISABLE;
+	hsd1.Init.ClockPowerSave = SDMMC_CLOCK_POWER_SAVE_DISABLE;
+	hsd1.Init.BusWide = SDMMC_BUS_WIDE_1B;
+	hsd1.Init.HardwareFlowControl = SDMMC_HARDWARE_FLOW_CONTROL_ENABLE;
+	hsd1.Init.ClockDiv = SDLOG_SDMMC_CLOCK_DIV;
+	if(HAL_OK != HAL_SD_Init(&hsd1))
+	{
+		return MZ_FAIL;
+	}
+	if(HAL_OK != HAL_SD_ConfigWideBusOperation(&hsd1, SDMMC_BUS_WIDE_4B))
+	{
+		return MZ_FAIL;
+	}
+
+	/* Newest valid superblock gives the durable head */
+	for(uint8_t i = 0; i < 2; i++)
+	{
+		st_sdlog_super * s = (st_sdlog_super *)sdlog_super_buf;
+
+		if(MZ_OK != sdlog_read_block(GPS_SDLOG_SUPER_BLOCK + i, sdlog_super_buf))
+		{
+			return MZ_FAIL;
+		}
+		if((GPS_SDLOG_SUPER_MAGIC == s->magic) &&
+		   (GPS_SDLOG_START_BLOCK == s->start_block) &&
+		   (GPS_SDLOG_RING_BLOCKS == s->ring_blocks) &&
+		   (s->gen >= best_gen))
+		{
+			best_gen = s->gen;
+			head = s->head_seq;
+		}
+	}
+
+	/* Walk over the bursts written after that superblock */
+	for(uint32_t i = 0; i < SDLOG_SCAN_LIMIT; i++)
+	{
+		st_gps_sdlog_block_hdr * hdr = (st_gps_sdlog_block_hdr *)sdlog_buf[0];
+
+		if(MZ_OK != sdlog_read_block(sdlog_block_addr(head), sdlog_buf[0]))
+		{
+			return MZ_FAIL;
+		}
+		if((GPS_SDLOG_BLOCK_MAGIC != hdr->magic) || (head != hdr->seq))
+		{
+			break;
+		}
+		head++;
+	}
+
+	memset(sdlog_ctx, 0, sizeof(sdlog_ctx));
+	memset(&sdlog_stats, 0, sizeof(sdlog_stats));
+	sdlog_super_gen = best_gen;
+	sdlog_assign_seq = head;
+	sdlog_durable_seq = head;
+	sdlog_fill = 0;
+	sdlog_blk = 0;
+	sdlog_open_block();
+	sdlog_ready = 1;
+
+	return MZ_OK;
+}
+/* Initialize SDMMC1 with DMA and recover the ring head from the card. - END */
+
+/*
+ * Queue raw NMEA bytes. - START
+ */
+void gps_sdlog_write_nmea(const char * buf, uint32_t len)
+{
+	const uint32_t max = GPS_SDLOG_BLOCK_SIZE - SDLOG_HDR_SIZE - SDLOG_REC_HDR_SIZE;
+	const uint32_t chunk_max = (max < SDLOG_REC_MAX_PAYLOAD) ? max : SDLOG_REC_MAX_PAYLOAD;
+
+	if(!sdlog_ready)
+	{
+		return;
+	}
+
+	while(len > 0)
+	{
+		uint32_t chunk = (len > chunk_max) ? chunk_max : len;
+
+		sdlog_write_record(GPS_SDLOG_REC_NMEA, (const uint8_t *)buf, chunk);
+		buf += chunk;
+		len -= chunk;
+	}
+}
+/* Queue raw NMEA bytes. - END */
+
+/*
+ * Queue one committed fix. - START
+ */
+void gps_sdlog_write_fix(const st_gps_fix * fix)
+{
+	if(!sdlog_ready)
+	{
+		return;
+	}
+
+	sdlog_write_record(GPS_SDLOG_REC_FIX, (const uint8_t *)fix, sizeof(st_gps_fix));
+}
+/* Queue one committed fix. - END */
+
+/*
+ * Start pending transfers and flush aged data. - START
+ */
+void gps_sdlog_poll(void)
+{
+	if(!sdlog_ready)
+	{
+		return;
+	}
+
+	sdlog_service();
+
+	/* Push out a partially filled buffer that is getting old */
+	if((SDLOG_BUF_FILLING == sdlog_ctx[sdlog_fill].state) &&
+	   ((sdlog_blk > 0) || (sdlog_off > SDLOG_HDR_SIZE)) &&
+	   ((HAL_GetTick() - sdlog_ctx[sdlog_fill].opened_tick) >= GPS_SDLOG_FLUSH_MS) &&
+	   (SDLOG_BUF_FREE == sdlog_ctx[sdlog_fill ^ 1].state))
+	{
+		if(sdlog_off > SDLOG_HDR_SIZE)
+		{
+			sdlog_close_block();
+		}
+		else
+		{
+			/* Empty block was opened but never used, give its sequence back */
+			sdlog_assign_seq--;
+		}
+		(void)sdlog_close_buffer();
+	}
+
+	sdlog_kick();
+}
+/* Start pending transfers and flush aged data. - END */
+
+/*
+ * Copy the logger counters. - START
+ */
+void gps_sdlog_get_stats(st_gps_sdlog_stats * stats)
+{
+	*stats = sdlog_stats;
+	stats->next_seq = sdlog_durable_seq;
+}
+/* Copy the logger counters. - END */
+
+/* SD card interrupt callbacks - START */
+void HAL_SD_TxCpltCallback(SD_HandleTypeDef *hsd)
+{
+	(void)hsd;
+	sdlog_xfer_done = 1;
+}
+
+void HAL_SD_ErrorCallback(SD_HandleTypeDef *hsd)
+{
+	(void)hsd;
+	sdlog_xfer_error = 1;
+}
+/* SD card interrupt callbacks - END */
+
+#endif //(GPS_SDLOG_ENABLE == MZ_ENABLE)
@@ -0,0 +1,107 @@
+/*
+ * MZ_gps_sdlog.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Filesystem free ring logger on the SDMMC1 card.
+ *
+ *  Records are packed into 512 byte blocks of a double buffer. A full half
+ *  (or a half older than GPS_SDLOG_FLUSH_MS) is written with one multi-block
+ *  DMA transfer while the other half keeps filling, so the writer never
+ *  waits for the card. When both halves are busy the record is dropped and
+ *  counted instead.
+ *
+ *  Card layout:
+ *  	GPS_SDLOG_SUPER_BLOCK + 0/1		ping-pong superblocks (newest wins)
+ *  	GPS_SDLOG_START_BLOCK ...		ring of GPS_SDLOG_RING_BLOCKS data blocks
+ *
+ *  Every data block carries its global sequence number. At boot the head is
+ *  taken from the newest superblock and then advanced over the blocks that
+ *  were written after it, so at most GPS_SDLOG_SUPER_EVERY bursts are scanned.
+ */
+
+#ifndef MZ_GPS_SDLOG_H_
+#define MZ_GPS_SDLOG_H_
+
+#include "MZ_error_handler.h"
+#include "MZ_gps_app_config.h"
+#include "MZ_gps_fix.h"
+
+#define GPS_SDLOG_BLOCK_SIZE		(512)						///< SD block size
+#define GPS_SDLOG_BLOCK_MAGIC		(0x4C535047UL)				///< "GPSL" data block marker
+#define GPS_SDLOG_SUPER_MAGIC		(0x53535047UL)				///< "GPSS" superblock marker
+
+/**
+ * @enum en_gps_sdlog_rec
+ * @brief Record types stored in a data block
+ */
+typedef enum
+{
+	GPS_SDLOG_REC_PAD = 0,										/*!< Unused tail of a block */
+	GPS_SDLOG_REC_NMEA = 1,										/*!< Raw NMEA bytes */
+	GPS_SDLOG_REC_FIX = 2,										/*!< st_gps_fix image */
+}en_gps_sdlog_rec;
+
+/**
+ * @struct st_gps_sdlog_block_hdr
+ * @brief Header at the start of every data block, followed by
+ * [type:1][len:1][payload:len] records
+ */
+typedef struct __attribute__((packed))
+{
+	uint32_t		magic;										/*!< GPS_SDLOG_BLOCK_MAGIC */
+	uint32_t		seq;										/*!< Global block sequence number */
+	uint16_t		used;										/*!< Bytes used in this block including header */
+	uint16_t		reserved;									/*!< Reserved, 0 */
+}st_gps_sdlog_block_hdr;
+
+/**
+ * @struct st_gps_sdlog_stats
+ * @brief Logger counters
+ */
+typedef struct
+{
+	uint32_t		next_seq;									/*!< Sequence of the next block to be written */
+	uint32_t		blocks_written;								/*!< Blocks written since boot */
+	uint32_t		bursts;										/*!< DMA transfers started since boot */
+	uint32_t		dropped_bytes;								/*!< Bytes dropped because both buffers were busy */
+	uint32_t		errors;										/*!< Failed transfers */
+}st_gps_sdlog_stats;
+
+#if(GPS_SDLOG_ENABLE == MZ_ENABLE)
+
+/** @fn mz_error_t gps_sdlog_init(void)
+ * @brief Initialize SDMMC1 with DMA and recover the ring head from the card.
+ * Blocking, call once before the application thread starts.
+ * @return MZ_OK/MZ_FAIL
+ */
+mz_error_t gps_sdlog_init(void);
+
+/** @fn void gps_sdlog_write_nmea(const char * buf, uint32_t len)
+ * @brief Queue raw NMEA bytes. Never blocks.
+ * @param buf raw bytes
+ * @param len number of bytes
+ */
+void gps_sdlog_write_nmea(const char * buf, uint32_t len);
+
+/** @fn void gps_sdlog_write_fix(const st_gps_fix * fix)
+ * @brief Queue one committed fix. Never blocks.
+ * @param fix committed fix
+ */
+void gps_sdlog_write_fix(const st_gps_fix * fix);
+
+/** @fn void gps_sdlog_poll(void)
+ * @brief Start pending transfers and flush aged data. Call periodically from
+ * the application thread.
+ */
+void gps_sdlog_poll(void);
+
+/** @fn void gps_sdlog_get_stats(st_gps_sdlog_stats * stats)
+ * @brief Copy the logger counters.
+ * @param stats destination
+ */
+void gps_sdlog_get_stats(st_gps_sdlog_stats * stats);
+
+#endif //(GPS_SDLOG_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_SDLOG_H_ */
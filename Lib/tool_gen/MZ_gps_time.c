@@ -0,0 +1,337 @@
+/*
+ * MZ_gps_time.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_time.h"
+#include "string.h"
+#if((GPS_TIME_ENABLE == MZ_ENABLE) && defined(__arm__))
+#include "main.h"
+#include "MZ_rtc.h"
+#include "MZ_gps_log.h"
+#endif
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define TIME_FIT_MIN				(8)							///< Fewest samples for a drift fit
+#define TIME_CAL_STEP_DIV			(1048576LL)					///< One calibration unit is 2^-20
+#define TIME_PPB					(1000000000LL)				///< ppb per unit rate
+#if((GPS_TIME_CAL_WINDOW_S * 1000LL / GPS_TIME_SAMPLE_MS) > 1024)
+#error "GPS_TIME_CAL_WINDOW_S / GPS_TIME_SAMPLE_MS above 1024 overflows the drift fit"
+#endif
+/* Define some common use MACRO - END */
+
+/*
+ * Start the discipline. - START
+ */
+void gps_time_reset(st_gps_time * t, uint8_t set, int16_t cal_units, uint16_t frac_hz)
+{
+	memset(t, 0, sizeof(*t));
+	t->set = set;
+	t->cal_units = cal_units;
+	t->frac_hz = frac_hz;
+	t->stats.cal_ppb = gps_time_cal_ppb(cal_units);
+}
+/* Start the discipline. - END */
+
+/*
+ * Rate change of a calibration value. - START
+ */
+int32_t gps_time_cal_ppb(int16_t cal_units)
+{
+	return (int32_t)(((int64_t)cal_units * TIME_PPB) / TIME_CAL_STEP_DIV);
+}
+/* Rate change of a calibration value. - END */
+
+/** @fn static int16_t time_cal_units(int64_t ppb)
+ * @brief Nearest calibration value for a rate change
+ */
+static int16_t time_cal_units(int64_t ppb)
+{
+	int64_t units = ppb * TIME_CAL_STEP_DIV;
+
+	units = (units + ((units < 0) ? -(TIME_PPB / 2) : (TIME_PPB / 2))) / TIME_PPB;
+	if(units < GPS_TIME_CAL_UNITS_MIN)
+	{
+		units = GPS_TIME_CAL_UNITS_MIN;
+	}
+	if(units > GPS_TIME_CAL_UNITS_MAX)
+	{
+		units = GPS_TIME_CAL_UNITS_MAX;
+	}
+	return (int16_t)units;
+}
+
+/*
+ * Compare the RTC with GPS time. - START
+ */
+void gps_time_sample(st_gps_time * t, uint64_t gps_ms, uint64_t rtc_ms, st_gps_time_action * act)
+{
+	int64_t err = (int64_t)(rtc_ms - gps_ms);
+	int64_t ts;
+	int64_t den;
+	int32_t e;
+	int32_t frac;
+
+	memset(act, 0, sizeof(*act));
+	t->stats.samples++;
+
+	if(!t->set || (err >= GPS_TIME_STEP_MS) || (err <= -GPS_TIME_STEP_MS))
+	{
+		/* The caller sets the calendar and samples again */
+		t->set = 1;
+		t->n = 0;
+		t->stats.steps++;
+		t->stats.phase_max_ms = 0;
+		act->step = 1;
+		return;
+	}
+
+	e = (int32_t)err;
+	t->stats.phase_ms = e;
+	if(((e < 0) ? -e : e) > t->stats.phase_max_ms)
+	{
+		t->stats.phase_max_ms = (e < 0) ? -e : e;
+	}
+
+	/* Fit the free running error, shifts inside the window are added back */
+	if(t->n == 0)
+	{
+		t->win_ms = gps_ms;
+		t->off_us = 0;
+		t->st = 0;
+		t->se = 0;
+		t->stt = 0;
+		t->ste = 0;
+	}
+	ts = (int64_t)((gps_ms - t->win_ms + 500) / 1000);
+	err = e + (t->off_us / 1000);
+	t->n++;
+	t->st += ts;
+	t->se += err;
+	t->stt += ts * ts;
+	t->ste += ts * err;
+
+	if(((gps_ms - t->win_ms) >= ((uint64_t)GPS_TIME_CAL_WINDOW_S * 1000)) && (t->n >= TIME_FIT_MIN))
+	{
+		den = ((int64_t)t->n * t->stt) - (t->st * t->st);
+		if(den > 0)
+		{
+			/* ms per s is 1e6 ppb */
+			t->stats.drift_ppb = (int32_t)(((((int64_t)t->n * t->ste) - (t->st * t->se)) * 1000000) / den);
+			act->cal_units = time_cal_units((int64_t)gps_time_cal_ppb(t->cal_units) - t->stats.drift_ppb);
+			if(act->cal_units != t->cal_units)
+			{
+				act->cal = 1;
+				t->cal_units = act->cal_units;
+				t->stats.cal_ppb = gps_time_cal_ppb(t->cal_units);
+				t->stats.cals++;
+			}
+		}
+		t->n = 0;
+	}
+
+	if(((e < 0) ? -e : e) >= GPS_TIME_SHIFT_MS)
+	{
+		/* Whole second fractions only, the remainder stays in the phase */
+		frac = ((e * (int32_t)t->frac_hz) + ((e < 0) ? -500 : 500)) / 1000;
+		if(frac >= (int32_t)t->frac_hz)
+		{
+			frac = t->frac_hz - 1;
+		}
+		if(frac <= -(int32_t)t->frac_hz)
+		{
+			frac = 1 - t->frac_hz;
+		}
+		act->shift_frac = frac;
+		t->off_us += (frac * 1000000) / t->frac_hz;
+		t->stats.shifts++;
+	}
+}
+/* Compare the RTC with GPS time. - END */
+
+#if((GPS_TIME_ENABLE == MZ_ENABLE) && defined(__arm__))
+
+/* Define some common use MACRO - START */
+#define TIME_BKP_REG				(RTC_BKP_DR31)				///< Backup register of the GPS time mark
+#define TIME_BKP_MAGIC				(0x47505354UL)				///< "GPST", RTC was set from GPS time
+/* Define some common use MACRO - END */
+
+/* RTC discipline related variables - START */
+extern RTC_HandleTypeDef hrtc;									/* RTC handle of the MonoZ lib */
+static st_gps_time time_ctx;									/* Discipline state */
+static uint32_t time_sample_tick = 0;							/* Tick of the last sample */
+static uint8_t time_sampled = 0;								/* A sample was taken */
+/* RTC discipline related variables - END */
+
+/** @fn static uint8_t time_rtc_read(uint64_t * ms)
+ * @brief RTC calendar and second fraction as ms since 1970
+ */
+static uint8_t time_rtc_read(uint64_t * ms)
+{
+	RTC_TimeTypeDef tm;
+	RTC_DateTypeDef dt;
+	st_gps_fix f;
+	uint32_t sec;
+
+	/* The date read unlocks the shadow registers, after the time */
+	if((HAL_OK != HAL_RTC_GetTime(&hrtc, &tm, RTC_FORMAT_BIN)) ||
+	   (HAL_OK != HAL_RTC_GetDate(&hrtc, &dt, RTC_FORMAT_BIN)))
+	{
+		return 0;
+	}
+
+	memset(&f, 0, sizeof(f));
+	f.utc_date = ((uint32_t)dt.Date * 10000) + ((uint32_t)dt.Month * 100) + dt.Year;
+	f.utc_time = ((uint32_t)tm.Hours * 10000) + ((uint32_t)tm.Minutes * 100) + tm.Seconds;
+	sec = gps_fix_to_unix(&f);
+	if(sec == 0)
+	{
+		return 0;
+	}
+
+	/* SubSeconds counts down, above SecondFraction right after a shift */
+	*ms = ((uint64_t)sec * 1000) + (uint64_t)(int64_t)((((int32_t)tm.SecondFraction - (int32_t)tm.SubSeconds) * 1000) /
+															(int32_t)(tm.SecondFraction + 1));
+	return 1;
+}
+
+/** @fn static void time_rtc_set(uint64_t ms)
+ * @brief Calendar to the second of ms
+ */
+static void time_rtc_set(uint64_t ms)
+{
+	uint32_t days = (uint32_t)(ms / 86400000ULL);
+	uint32_t sec = (uint32_t)((ms / 1000) % 86400);
+	uint32_t z = days + 719468;
+	uint32_t era = z / 146097;
+	uint32_t doe = z - (era * 146097);
+	uint32_t yoe = (doe - (doe / 1460) + (doe / 36524) - (doe / 146096)) / 365;
+	uint32_t doy = doe - ((365 * yoe) + (yoe / 4) - (yoe / 100));
+	uint32_t mp = ((5 * doy) + 2) / 153;
+	uint32_t m = (mp < 10) ? (mp + 3) : (mp - 9);
+	uint32_t y = yoe + (era * 400) + ((m <= 2) ? 1 : 0);
+	mzd_time dt;
+
+	/* Civil date from days, March based year */
+	dt.YY = (char)(y - 2000);
+	dt.MM = (char)m;
+	dt.DD = (char)(doy - (((153 * mp) + 2) / 5) + 1);
+	dt.hh = (char)(sec / 3600);
+	dt.mm = (char)((sec / 60) % 60);
+	dt.ss = (char)(sec % 60);
+	dt.zz = 0;
+	(void)MZ_RTC_set(dt);
+	HAL_RTCEx_BKUPWrite(&hrtc, TIME_BKP_REG, TIME_BKP_MAGIC);
+}
+
+/** @fn static void time_rtc_apply(const st_gps_time_action * act)
+ * @brief Shift and calibration of a sample
+ */
+static void time_rtc_apply(const st_gps_time_action * act)
+{
+	if(act->cal)
+	{
+		(void)HAL_RTCEx_SetSmoothCalib(&hrtc, RTC_SMOOTHCALIB_PERIOD_32SEC,
+										(act->cal_units > 0) ? RTC_SMOOTHCALIB_PLUSPULSES_SET : RTC_SMOOTHCALIB_PLUSPULSES_RESET,
+										(uint32_t)((act->cal_units > 0) ? (512 - act->cal_units) : -act->cal_units));
+#if(GPS_LOG_ENABLE == MZ_ENABLE)
+		gps_log_printf("rtc: drift %ld ppb, calibration %ld ppb, phase %ld ms\r\n",
+						(long)time_ctx.stats.drift_ppb, (long)time_ctx.stats.cal_ppb, (long)time_ctx.stats.phase_ms);
+#endif
+	}
+	if(act->shift_frac > 0)
+	{
+		/* RTC ahead, take the fraction off */
+		(void)HAL_RTCEx_SetSynchroShift(&hrtc, RTC_SHIFTADD1S_RESET, (uint32_t)act->shift_frac);
+	}
+	else if(act->shift_frac < 0)
+	{
+		/* RTC behind, one second on and the rest off */
+		(void)HAL_RTCEx_SetSynchroShift(&hrtc, RTC_SHIFTADD1S_SET, (uint32_t)(time_ctx.frac_hz + act->shift_frac));
+	}
+}
+
+/*
+ * Take over the RTC. - START
+ */
+void gps_time_init(void)
+{
+	uint32_t calr = RTC->CALR;
+	int16_t units = (int16_t)(((calr & RTC_CALR_CALP) ? 512 : 0) - (int16_t)(calr & RTC_CALR_CALM));
+
+	gps_time_reset(&time_ctx, (TIME_BKP_MAGIC == HAL_RTCEx_BKUPRead(&hrtc, TIME_BKP_REG)), units,
+					(uint16_t)((RTC->PRER & RTC_PRER_PREDIV_S) + 1));
+}
+/* Take over the RTC. - END */
+
+/*
+ * Compare the RTC with a committed fix. - START
+ */
+void gps_time_fix(const st_gps_fix * fix, uint32_t epoch_tick)
+{
+	st_gps_time_action act;
+	uint64_t gps_ms;
+	uint64_t rtc_ms;
+	uint32_t sec = gps_fix_to_unix(fix);
+
+	if((sec == 0) || (time_sampled && ((HAL_GetTick() - time_sample_tick) < GPS_TIME_SAMPLE_MS)))
+	{
+		return;
+	}
+	time_sampled = 1;
+	time_sample_tick = HAL_GetTick();
+
+	/* GPS time now, from the epoch and the ticks since */
+	gps_ms = ((uint64_t)sec * 1000) + fix->utc_ms + GPS_TIME_OUT_DELAY_MS + (HAL_GetTick() - epoch_tick);
+	if(!time_rtc_read(&rtc_ms))
+	{
+		rtc_ms = 0;
+	}
+	gps_time_sample(&time_ctx, gps_ms, rtc_ms, &act);
+
+	if(act.step)
+	{
+		time_rtc_set(gps_ms + (HAL_GetTick() - time_sample_tick));
+		gps_ms += HAL_GetTick() - time_sample_tick;
+		if(!time_rtc_read(&rtc_ms))
+		{
+			return;
+		}
+		gps_time_sample(&time_ctx, gps_ms, rtc_ms, &act);
+	}
+	time_rtc_apply(&act);
+}
+/* Compare the RTC with a committed fix. - END */
+
+/*
+ * Current UTC from the RTC. - START
+ */
+uint8_t gps_time_now(uint32_t * sec, uint16_t * ms)
+{
+	uint64_t now;
+
+	if(!time_ctx.set || !time_rtc_read(&now))
+	{
+		return 0;
+	}
+	*sec = (uint32_t)(now / 1000);
+	*ms = (uint16_t)(now % 1000);
+	return 1;
+}
+/* Current UTC from the RTC. - END */
+
+/*
+ * Copy the discipline counters. - START
+ */
+void gps_time_get_stats(st_gps_time_stats * stats)
+{
+	*stats = time_ctx.stats;
+}
+/* Copy the discipline counters. - END */
+
+#endif //((GPS_TIME_ENABLE == MZ_ENABLE) && defined(__arm__))
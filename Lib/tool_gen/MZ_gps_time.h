@@ -0,0 +1,139 @@
+/*
+ * MZ_gps_time.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  RTC discipline from GPS time.
+ *
+ *  Every GPS_TIME_SAMPLE_MS a committed fix is compared with the RTC.
+ *  The UTC of $GPRMC is taken to be current GPS_TIME_OUT_DELAY_MS
+ *  before the first byte of its receive burst (gps_lpuart). Without the
+ *  ring receive the commit tick is used instead, which is late by up to
+ *  one receive buffer.
+ *  - no GPS time yet, or an error of GPS_TIME_STEP_MS : the calendar is
+ *    set (MZ_RTC_set) and the second fraction aligned with a synchro
+ *    shift.
+ *  - otherwise the error is fitted against time over
+ *    GPS_TIME_CAL_WINDOW_S, the slope is the RTC drift. It is removed
+ *    with the smooth calibration (0.954 ppm steps, +-487 ppm) and a
+ *    phase error of GPS_TIME_SHIFT_MS or more is shifted out.
+ *  While the receiver is off the calibrated RTC keeps the time,
+ *  gps_time_now() timestamps payloads from it. The GPS time mark and the
+ *  calibration survive a reset in the backup domain.
+ *  The discipline itself (gps_time_sample) has no HAL dependency, it
+ *  returns what is to be done with the RTC.
+ */
+
+#ifndef MZ_GPS_TIME_H_
+#define MZ_GPS_TIME_H_
+
+#include "stdint.h"
+#include "MZ_gps_app_config.h"
+#include "MZ_gps_fix.h"
+
+#define GPS_TIME_CAL_UNITS_MIN		(-511)					///< CALP = 0, CALM = 511
+#define GPS_TIME_CAL_UNITS_MAX		(512)					///< CALP = 1, CALM = 0
+
+/**
+ * @struct st_gps_time_stats
+ * @brief Discipline counters
+ */
+typedef struct
+{
+	int32_t			phase_ms;									/*!< Last RTC minus GPS time */
+	int32_t			phase_max_ms;								/*!< Largest phase error since the last step */
+	int32_t			drift_ppb;									/*!< Last fitted drift, RTC fast is positive */
+	int32_t			cal_ppb;									/*!< Programmed calibration */
+	uint32_t		samples;									/*!< Comparisons */
+	uint32_t		steps;										/*!< Calendar sets */
+	uint32_t		shifts;										/*!< Second fraction shifts */
+	uint32_t		cals;										/*!< Calibration updates */
+}st_gps_time_stats;
+
+/**
+ * @struct st_gps_time
+ * @brief Discipline state
+ */
+typedef struct
+{
+	uint8_t				set;									/*!< RTC carries GPS time */
+	int16_t				cal_units;								/*!< CALP * 512 - CALM */
+	uint16_t			frac_hz;								/*!< Second fractions of a synchro shift, PREDIV_S + 1 */
+	int32_t				off_us;									/*!< Shifted out inside the fit window */
+	uint32_t			n;										/*!< Samples in the fit window */
+	uint64_t			win_ms;									/*!< GPS time of the first sample */
+	int64_t				st;										/*!< Sum of t (s) */
+	int64_t				se;										/*!< Sum of error (ms) */
+	int64_t				stt;									/*!< Sum of t * t */
+	int64_t				ste;									/*!< Sum of t * error */
+	st_gps_time_stats	stats;									/*!< Counters */
+}st_gps_time;
+
+/**
+ * @struct st_gps_time_action
+ * @brief What is to be done with the RTC after a sample
+ */
+typedef struct
+{
+	uint8_t			step;										/*!< Set the calendar and align the fraction */
+	int32_t			shift_frac;									/*!< Move the RTC back by this many 1 / frac_hz s, 0 = none */
+	uint8_t			cal;										/*!< Program cal_units */
+	int16_t			cal_units;									/*!< CALP * 512 - CALM */
+}st_gps_time_action;
+
+/** @fn void gps_time_reset(st_gps_time * t, uint8_t set, int16_t cal_units, uint16_t frac_hz)
+ * @brief Start the discipline.
+ * @param t discipline
+ * @param set RTC already carries GPS time
+ * @param cal_units calibration in the RTC
+ * @param frac_hz synchro shift steps per second, PREDIV_S + 1
+ */
+void gps_time_reset(st_gps_time * t, uint8_t set, int16_t cal_units, uint16_t frac_hz);
+
+/** @fn int32_t gps_time_cal_ppb(int16_t cal_units)
+ * @brief Rate change of a smooth calibration value.
+ * @param cal_units CALP * 512 - CALM
+ * @return ppb, faster is positive
+ */
+int32_t gps_time_cal_ppb(int16_t cal_units);
+
+/** @fn void gps_time_sample(st_gps_time * t, uint64_t gps_ms, uint64_t rtc_ms, st_gps_time_action * act)
+ * @brief Compare the RTC with GPS time at the same instant.
+ * @param t discipline
+ * @param gps_ms GPS time in ms since 1970
+ * @param rtc_ms RTC time in ms since 1970
+ * @param act what is to be done with the RTC
+ */
+void gps_time_sample(st_gps_time * t, uint64_t gps_ms, uint64_t rtc_ms, st_gps_time_action * act);
+
+#if(GPS_TIME_ENABLE == MZ_ENABLE)
+
+/** @fn void gps_time_init(void)
+ * @brief Take over an RTC that was set from GPS before a reset.
+ */
+void gps_time_init(void);
+
+/** @fn void gps_time_fix(const st_gps_fix * fix, uint32_t epoch_tick)
+ * @brief A fix was committed, compare the RTC when a sample is due.
+ * @param fix fix with UTC date and time
+ * @param epoch_tick HAL tick when the fix time was current
+ */
+void gps_time_fix(const st_gps_fix * fix, uint32_t epoch_tick);
+
+/** @fn uint8_t gps_time_now(uint32_t * sec, uint16_t * ms)
+ * @brief Current UTC from the RTC.
+ * @param sec seconds since 1970
+ * @param ms milliseconds
+ * @return 1 when the RTC carries GPS time, 0 otherwise
+ */
+uint8_t gps_time_now(uint32_t * sec, uint16_t * ms);
+
+/** @fn void gps_time_get_stats(st_gps_time_stats * stats)
+ * @brief Copy the discipline counters.
+ * @param stats output
+ */
+void gps_time_get_stats(st_gps_time_stats * stats);
+
+#endif //(GPS_TIME_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_TIME_H_ */
@@ -0,0 +1,181 @@
+/*
+ * MZ_gps_trace.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_trace.h"
+#include "main.h"
+#include "stdio.h"
+#include "string.h"
+#if defined(__arm__)
+#include "MZ_common.h"
+#else
+#include "time.h"
+#endif
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define TRACE_LINE_SIZE				(80)						///< One decoded record
+#define TRACE_ID_MASK				(0xFFUL)
+#define TRACE_ARG_SHIFT				(8)
+#if defined(__arm__)
+#define TRACE_TS_HZ					(SystemCoreClock)			///< DWT cycle counter
+#else
+#define TRACE_TS_HZ					(1000000000UL)				///< Monotonic clock in ns
+#endif
+/* Define some common use MACRO - END */
+
+/* Trace related variables - START */
+static const char * const trace_names[GPS_TRACE_EVENTS] =
+{
+	"boot",
+	"error",
+	"hardfault",
+	"uart_rx",
+	"commit",
+	"publish",
+	"publish_done",
+	"at_fail",
+};
+/* Trace related variables - END */
+
+#if(GPS_TRACE_ENABLE == MZ_ENABLE)
+
+/* Trace ring variables - START */
+#if defined(__arm__)
+st_gps_trace_buf gps_trace_buf MZ_VAR_NOINIT;					/* Not static, the debugger dumps it by name */
+#else
+st_gps_trace_buf gps_trace_buf;
+#endif
+/* Trace ring variables - END */
+
+/** @fn static inline uint32_t trace_now(void)
+ * @brief Time stamp of a record
+ */
+static inline uint32_t trace_now(void)
+{
+#if defined(__arm__)
+	return DWT->CYCCNT;
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec);
+#endif
+}
+
+/*
+ * Open the ring after a reset. - START
+ */
+void gps_trace_init(void)
+{
+	uint32_t reset_flags = 0;
+
+#if defined(__arm__)
+	/* The cycle counter is the time stamp, it is not cleared here */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	reset_flags = RCC->CSR >> 24;
+#endif
+
+	if(gps_trace_buf.magic != GPS_TRACE_MAGIC)
+	{
+		/* Power on or a corrupted ring */
+		memset(&gps_trace_buf, 0, sizeof(gps_trace_buf));
+		gps_trace_buf.magic = GPS_TRACE_MAGIC;
+	}
+	else
+	{
+		gps_trace_buf.boots++;
+	}
+	gps_trace_buf.ts_hz = TRACE_TS_HZ;
+	gps_trace_event(GPS_TRACE_BOOT, reset_flags);
+}
+/* Open the ring after a reset. - END */
+
+/*
+ * Write one record. - START
+ */
+void gps_trace_event(uint8_t id, uint32_t arg)
+{
+	/* LDREX / STREX on the Cortex-M4, a preempting writer takes the next slot */
+	uint32_t slot = __atomic_fetch_add(&gps_trace_buf.head, 1, __ATOMIC_RELAXED) & (GPS_TRACE_RECORDS - 1);
+	st_gps_trace_rec * rec = &gps_trace_buf.rec[slot];
+
+	rec->tick = HAL_GetTick();
+	rec->ts = trace_now();
+	rec->id_arg = (arg << TRACE_ARG_SHIFT) | id;
+}
+/* Write one record. - END */
+
+/*
+ * The ring of this device. - START
+ */
+const st_gps_trace_buf * gps_trace_get(void)
+{
+	return &gps_trace_buf;
+}
+/* The ring of this device. - END */
+
+#endif //(GPS_TRACE_ENABLE == MZ_ENABLE)
+
+/*
+ * Print the records of a ring. - START
+ */
+void gps_trace_decode(const st_gps_trace_buf * buf, uint32_t last, gps_trace_out_fn out)
+{
+	char line[TRACE_LINE_SIZE];
+	uint32_t head = buf->head;
+	uint32_t count = (head < GPS_TRACE_RECORDS) ? head : GPS_TRACE_RECORDS;
+	uint32_t prev_ts = 0;
+	uint32_t prev_tick = 0;
+	/* Records closer than this are timed by their cycle stamps */
+	uint32_t span_ms = (buf->ts_hz >= 1000U) ? (uint32_t)(0xFFFFFFFFULL / (buf->ts_hz / 1000U)) : 0;
+
+	if(buf->magic != GPS_TRACE_MAGIC)
+	{
+		out("trace: no valid ring\r\n");
+		return;
+	}
+	if((last != 0) && (last < count))
+	{
+		count = last;
+	}
+
+	sprintf(line,"trace: %lu records, %lu resets, stamp %lu Hz\r\n",(unsigned long)head,(unsigned long)buf->boots,(unsigned long)buf->ts_hz);
+	out(line);
+	for(uint32_t n = head - count; n != head; n++)
+	{
+		const st_gps_trace_rec * rec = &buf->rec[n & (GPS_TRACE_RECORDS - 1)];
+		uint32_t id = rec->id_arg & TRACE_ID_MASK;
+		uint32_t arg = rec->id_arg >> TRACE_ARG_SHIFT;
+
+		/* Cycles since the previous record while the stamp can not have wrapped,
+		   else the raw stamp : the first record, boots and long gaps */
+		if((n == (head - count)) || (id == GPS_TRACE_BOOT) || ((rec->tick - prev_tick) >= span_ms))
+		{
+			sprintf(line,"%6lu %10lu ms @%10lu ",(unsigned long)n,(unsigned long)rec->tick,(unsigned long)rec->ts);
+		}
+		else
+		{
+			sprintf(line,"%6lu %10lu ms +%10lu ",(unsigned long)n,(unsigned long)rec->tick,(unsigned long)(rec->ts - prev_ts));
+		}
+		out(line);
+		if(id < GPS_TRACE_EVENTS)
+		{
+			sprintf(line,"%-12s 0x%06lX\r\n",trace_names[id],(unsigned long)arg);
+		}
+		else
+		{
+			sprintf(line,"event%-7lu 0x%06lX\r\n",(unsigned long)id,(unsigned long)arg);
+		}
+		out(line);
+		prev_ts = rec->ts;
+		prev_tick = rec->tick;
+	}
+}
+/* Print the records of a ring. - END */
@@ -0,0 +1,117 @@
+/*
+ * MZ_gps_trace.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Post-mortem event trace.
+ *
+ *  Events are 12 byte records (HAL tick, cycle stamp, event id, 24 bit
+ *  argument) in a ring placed in the .mz_RamBlock_noinit section, so the
+ *  records written before a hang in Error_Handler, a hard fault or a
+ *  watchdog reset are still there after the reset. A slot is claimed with
+ *  one atomic add, the writer never blocks and can be a task or an ISR.
+ *  The cycle stamp is the DWT cycle counter on target and the monotonic
+ *  clock in ns on a host. It wraps every 2^32 counts (53 s at 80 MHz), so
+ *  records are put in order and lined up with the log by the HAL tick,
+ *  the cycle stamp resolves the time between records that are closer.
+ *
+ *  gps_trace_decode() has no target dependency: on a host it decodes a
+ *  raw image of the ring read with the debugger, e.g.
+ *  "dump binary memory trace.bin &gps_trace_buf (&gps_trace_buf + 1)",
+ *  which Host/tools/gps_trace_dump prints.
+ */
+
+#ifndef MZ_GPS_TRACE_H_
+#define MZ_GPS_TRACE_H_
+
+#include "stdint.h"
+#include "MZ_gps_app_config.h"
+
+#define GPS_TRACE_MAGIC				(0x54524332UL)				///< "TRC2", ring content is valid
+
+/**
+ * @enum en_gps_trace_event
+ * @brief Event ids
+ */
+typedef enum
+{
+	GPS_TRACE_BOOT = 0,											/*!< Ring opened, arg = reset flags (RCC CSR >> 24) */
+	GPS_TRACE_ERROR,											/*!< Error_Handler, arg = caller address */
+	GPS_TRACE_HARDFAULT,										/*!< Hard fault */
+	GPS_TRACE_UART_RX,											/*!< GPS receive buffer complete */
+	GPS_TRACE_COMMIT,											/*!< Epoch committed, arg = UTC hhmmss */
+	GPS_TRACE_PUBLISH,											/*!< Publish started, arg = payload length */
+	GPS_TRACE_PUBLISH_DONE,										/*!< Publish finished, arg = status */
+	GPS_TRACE_AT_FAIL,											/*!< AT command failed, arg = status */
+	GPS_TRACE_EVENTS,
+}en_gps_trace_event;
+
+/**
+ * @struct st_gps_trace_rec
+ * @brief One record
+ */
+typedef struct
+{
+	uint32_t		tick;										/*!< HAL_GetTick() */
+	uint32_t		ts;											/*!< Cycle stamp */
+	uint32_t		id_arg;										/*!< Event id in bits 0..7, argument in bits 8..31 */
+}st_gps_trace_rec;
+
+/**
+ * @struct st_gps_trace_buf
+ * @brief Ring, survives resets
+ */
+typedef struct
+{
+	uint32_t			magic;									/*!< GPS_TRACE_MAGIC when the ring is valid */
+	uint32_t			boots;									/*!< Resets seen by the ring */
+	uint32_t			ts_hz;									/*!< Cycle stamp rate of the last boot */
+	volatile uint32_t	head;									/*!< Records ever written, the slot is head % GPS_TRACE_RECORDS */
+	st_gps_trace_rec	rec[GPS_TRACE_RECORDS];					/*!< Records */
+}st_gps_trace_buf;
+
+/** @brief Output function for the decoder, gps_log_cli compatible */
+typedef int (*gps_trace_out_fn)(const char * s);
+
+/** @fn void gps_trace_decode(const st_gps_trace_buf * buf, uint32_t last, gps_trace_out_fn out)
+ * @brief Print the records of a ring, oldest first.
+ * @param buf ring (live or a raw image)
+ * @param last number of newest records to print, 0 = all
+ * @param out output function
+ */
+void gps_trace_decode(const st_gps_trace_buf * buf, uint32_t last, gps_trace_out_fn out);
+
+#if(GPS_TRACE_ENABLE == MZ_ENABLE)
+
+#if(GPS_TRACE_RECORDS & (GPS_TRACE_RECORDS - 1))
+#error "GPS_TRACE_RECORDS must be a power of two"
+#endif
+
+#define GPS_TRACE(id, arg)			gps_trace_event((id), (uint32_t)(arg))
+
+/** @fn void gps_trace_init(void)
+ * @brief Open the ring after a reset: keep its records when valid, else
+ * clear it. Writes a GPS_TRACE_BOOT record.
+ */
+void gps_trace_init(void);
+
+/** @fn void gps_trace_event(uint8_t id, uint32_t arg)
+ * @brief Write one record. Task and ISR safe, lock free.
+ * @param id event id
+ * @param arg argument, the low 24 bits are kept
+ */
+void gps_trace_event(uint8_t id, uint32_t arg);
+
+/** @fn const st_gps_trace_buf * gps_trace_get(void)
+ * @brief The ring of this device.
+ * @return ring
+ */
+const st_gps_trace_buf * gps_trace_get(void);
+
+#else
+
+#define GPS_TRACE(id, arg)
+
+#endif //(GPS_TRACE_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_TRACE_H_ */
@@ -0,0 +1,181 @@
+/*
+ * MZ_gps_track_simplify.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_track_simplify.h"
+
+/* Include Header Files - END */
+
+#if(GPS_TRACK_BATCH_ENABLE == MZ_ENABLE)
+
+/** @fn static uint32_t simplify_isqrt(uint64_t v)
+ * @brief Integer square root
+ */
+static uint32_t simplify_isqrt(uint64_t v)
+{
+	uint64_t res = 0;
+	uint64_t bit = (uint64_t)1 << 62;
+
+	while(bit > v)
+	{
+		bit >>= 2;
+	}
+	while(bit != 0)
+	{
+		if(v >= (res + bit))
+		{
+			v -= res + bit;
+			res = (res >> 1) + bit;
+		}
+		else
+		{
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+	return (uint32_t)res;
+}
+
+/** @fn static uint8_t simplify_segment_ok(const st_gps_simplify * ctx, int32_t pe, int32_t pn)
+ * @brief Check that every held point is within tolerance of anchor -> (pe, pn)
+ */
+static uint8_t simplify_segment_ok(const st_gps_simplify * ctx, int32_t pe, int32_t pn)
+{
+	int64_t len2 = ((int64_t)pe * pe) + ((int64_t)pn * pn);
+	int64_t tol = ctx->tol_cm;
+	int64_t tol_len = tol * simplify_isqrt((uint64_t)len2);
+
+	for(uint16_t i = 0; i < ctx->count; i++)
+	{
+		int64_t we = ctx->window[i].east_cm;
+		int64_t wn = ctx->window[i].north_cm;
+		int64_t dot = (we * pe) + (wn * pn);
+
+		if(dot <= 0)
+		{
+			/* Behind the anchor : distance to the anchor */
+			if(((we * we) + (wn * wn)) > (tol * tol))
+			{
+				return 0;
+			}
+		}
+		else if(dot >= len2)
+		{
+			/* Beyond the new point : distance to the new point */
+			int64_t de = we - pe;
+			int64_t dn = wn - pn;
+
+			if(((de * de) + (dn * dn)) > (tol * tol))
+			{
+				return 0;
+			}
+		}
+		else
+		{
+			/* Perpendicular distance : |cross| / len <= tol */
+			int64_t cross = (pe * wn) - (pn * we);
+
+			if(cross < 0)
+			{
+				cross = -cross;
+			}
+			if(cross > tol_len)
+			{
+				return 0;
+			}
+		}
+	}
+	return 1;
+}
+
+/** @fn static void simplify_reanchor(st_gps_simplify * ctx)
+ * @brief Emit the newest held point and make it the anchor
+ */
+static void simplify_reanchor(st_gps_simplify * ctx)
+{
+	if(ctx->last_pending)
+	{
+		ctx->emit(&ctx->last);
+		ctx->out_points++;
+		ctx->last_pending = 0;
+	}
+	ctx->anchor = ctx->last;
+	ctx->count = 0;
+}
+
+/*
+ * Initialize a simplifier. - START
+ */
+void gps_simplify_init(st_gps_simplify * ctx, uint32_t tol_cm, gps_simplify_emit_cb emit)
+{
+	ctx->count = 0;
+	ctx->have_anchor = 0;
+	ctx->last_pending = 0;
+	ctx->tol_cm = tol_cm;
+	ctx->emit = emit;
+	ctx->in_points = 0;
+	ctx->out_points = 0;
+}
+/* Initialize a simplifier. - END */
+
+/*
+ * Feed one fix. - START
+ */
+void gps_simplify_push(st_gps_simplify * ctx, const st_gps_fix * fix)
+{
+	int32_t pe;
+	int32_t pn;
+
+	ctx->in_points++;
+
+	if(!ctx->have_anchor)
+	{
+		ctx->anchor = *fix;
+		ctx->last = *fix;
+		ctx->have_anchor = 1;
+		ctx->last_pending = 0;
+		ctx->count = 0;
+		ctx->emit(fix);
+		ctx->out_points++;
+		return;
+	}
+
+	gps_fix_offset_cm(ctx->anchor.lat_e7, ctx->anchor.lon_e7, fix->lat_e7, fix->lon_e7, &pe, &pn);
+
+	/* Close the segment when it gets too long, the window is full or the
+	 * held points do not fit the new segment */
+	if((ctx->count > 0) &&
+	   ((pe > GPS_SIMPLIFY_MAX_SEG_CM) || (pe < -GPS_SIMPLIFY_MAX_SEG_CM) ||
+		(pn > GPS_SIMPLIFY_MAX_SEG_CM) || (pn < -GPS_SIMPLIFY_MAX_SEG_CM) ||
+		(ctx->count >= GPS_SIMPLIFY_WINDOW) ||
+		!simplify_segment_ok(ctx, pe, pn)))
+	{
+		simplify_reanchor(ctx);
+		gps_fix_offset_cm(ctx->anchor.lat_e7, ctx->anchor.lon_e7, fix->lat_e7, fix->lon_e7, &pe, &pn);
+	}
+
+	ctx->window[ctx->count].east_cm = pe;
+	ctx->window[ctx->count].north_cm = pn;
+	ctx->count++;
+	ctx->last = *fix;
+	ctx->last_pending = 1;
+}
+/* Feed one fix. - END */
+
+/*
+ * Emit the newest point and continue from it. - START
+ */
+void gps_simplify_flush(st_gps_simplify * ctx)
+{
+	if(ctx->have_anchor)
+	{
+		simplify_reanchor(ctx);
+	}
+}
+/* Emit the newest point and continue from it. - END */
+
+#endif //(GPS_TRACK_BATCH_ENABLE == MZ_ENABLE)
@@ -0,0 +1,80 @@
+/*
+ * MZ_gps_track_simplify.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Streaming track simplification (opening window).
+ *
+ *  The simplifier keeps an anchor point and the offsets of the points seen
+ *  since then, in cm of a local east/north frame centred on the anchor.
+ *  Every new point closes a candidate segment anchor -> point; when one of
+ *  the held points is further than the tolerance from that segment, the
+ *  previous point is emitted and becomes the new anchor. The work per point
+ *  is bounded by GPS_SIMPLIFY_WINDOW, so there is no end of batch spike.
+ *  No HAL dependency.
+ */
+
+#ifndef MZ_GPS_TRACK_SIMPLIFY_H_
+#define MZ_GPS_TRACK_SIMPLIFY_H_
+
+#include "stdint.h"
+#include "MZ_gps_app_config.h"
+#include "MZ_gps_fix.h"
+
+/** @brief Called for every point that is kept */
+typedef void (*gps_simplify_emit_cb)(const st_gps_fix * fix);
+
+/**
+ * @struct st_gps_simplify_pt
+ * @brief Held point offset from the anchor
+ */
+typedef struct
+{
+	int32_t			east_cm;									/*!< East offset in cm */
+	int32_t			north_cm;									/*!< North offset in cm */
+}st_gps_simplify_pt;
+
+/**
+ * @struct st_gps_simplify
+ * @brief Simplifier context
+ */
+typedef struct
+{
+	st_gps_fix				anchor;								/*!< Start of the open segment */
+	st_gps_fix				last;								/*!< Newest point, emitted when the segment closes */
+	st_gps_simplify_pt		window[GPS_SIMPLIFY_WINDOW];		/*!< Points held since the anchor */
+	uint16_t				count;								/*!< Held points */
+	uint8_t					have_anchor;						/*!< Anchor is set */
+	uint8_t					last_pending;						/*!< last has not been emitted */
+	uint32_t				tol_cm;								/*!< Cross-track tolerance */
+	gps_simplify_emit_cb	emit;								/*!< Output callback */
+	uint32_t				in_points;							/*!< Points pushed */
+	uint32_t				out_points;							/*!< Points emitted */
+}st_gps_simplify;
+
+#if(GPS_TRACK_BATCH_ENABLE == MZ_ENABLE)
+
+/** @fn void gps_simplify_init(st_gps_simplify * ctx, uint32_t tol_cm, gps_simplify_emit_cb emit)
+ * @brief Initialize a simplifier.
+ * @param ctx context
+ * @param tol_cm cross-track tolerance in cm
+ * @param emit output callback
+ */
+void gps_simplify_init(st_gps_simplify * ctx, uint32_t tol_cm, gps_simplify_emit_cb emit);
+
+/** @fn void gps_simplify_push(st_gps_simplify * ctx, const st_gps_fix * fix)
+ * @brief Feed one fix. May emit the previous point.
+ * @param ctx context
+ * @param fix new fix
+ */
+void gps_simplify_push(st_gps_simplify * ctx, const st_gps_fix * fix);
+
+/** @fn void gps_simplify_flush(st_gps_simplify * ctx)
+ * @brief Emit the newest point (end of a batch) and continue from it.
+ * @param ctx context
+ */
+void gps_simplify_flush(st_gps_simplify * ctx);
+
+#endif //(GPS_TRACK_BATCH_ENABLE == MZ_ENABLE)
+
+#endif /* MZ_GPS_TRACK_SIMPLIFY_H_ */
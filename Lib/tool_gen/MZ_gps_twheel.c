@@ -0,0 +1,280 @@
+/*
+ * MZ_gps_twheel.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_twheel.h"
+#include "MZ_gps_prof.h"
+#include "string.h"
+#if defined(__arm__)
+#include "stm32l4xx.h"
+#endif
+
+/* Include Header Files - END */
+
+#if(GPS_TWHEEL_ENABLE == MZ_ENABLE)
+
+/* Define some common use MACRO - START */
+#define TW_SLOT_MASK				(GPS_TW_SLOTS - 1)
+#define TW_BENCH_SPREAD				(5000)						///< Timeouts of the benchmark timers, ticks
+
+#if defined(__arm__)
+#define TW_LOCK()					uint32_t tw_primask = __get_PRIMASK(); __disable_irq()
+#define TW_UNLOCK()					__set_PRIMASK(tw_primask)
+#define TW_RELOCK()					tw_primask = __get_PRIMASK(); __disable_irq()
+#else
+#define TW_LOCK()
+#define TW_UNLOCK()
+#define TW_RELOCK()
+#endif
+/* Define some common use MACRO - END */
+
+/** @fn static void tw_link(st_gps_twheel * tw, st_gps_tw_timer * t)
+ * @brief Put a timer in the slot of its expiry, wheel locked
+ */
+static void tw_link(st_gps_twheel * tw, st_gps_tw_timer * t)
+{
+	uint32_t delta = t->expires - tw->now;
+	st_gps_tw_timer ** head;
+	uint8_t level = 0;
+
+	if((int32_t)delta < 0)
+	{
+		/* Late, run on the current tick */
+		head = &tw->slots[0][tw->now & TW_SLOT_MASK];
+	}
+	else
+	{
+		while((level < (GPS_TW_LEVELS - 1)) && (delta >= (1UL << (GPS_TW_SLOT_BITS * (level + 1)))))
+		{
+			level++;
+		}
+		head = &tw->slots[level][(t->expires >> (GPS_TW_SLOT_BITS * level)) & TW_SLOT_MASK];
+	}
+
+	t->next = *head;
+	if(*head != NULL)
+	{
+		(*head)->pprev = &t->next;
+	}
+	*head = t;
+	t->pprev = head;
+}
+
+/** @fn static void tw_unlink(st_gps_tw_timer * t)
+ * @brief Remove a timer from its slot, wheel locked
+ */
+static void tw_unlink(st_gps_tw_timer * t)
+{
+	*t->pprev = t->next;
+	if(t->next != NULL)
+	{
+		t->next->pprev = t->pprev;
+	}
+	t->next = NULL;
+	t->pprev = NULL;
+}
+
+/** @fn static uint32_t tw_cascade(st_gps_twheel * tw, uint8_t level)
+ * @brief Move the timers of the current slot of a level one level down,
+ * returns the slot index
+ */
+static uint32_t tw_cascade(st_gps_twheel * tw, uint8_t level)
+{
+	uint32_t index = (tw->now >> (GPS_TW_SLOT_BITS * level)) & TW_SLOT_MASK;
+	st_gps_tw_timer * t = tw->slots[level][index];
+
+	tw->slots[level][index] = NULL;
+	while(t != NULL)
+	{
+		st_gps_tw_timer * next = t->next;
+
+		tw_link(tw, t);
+		t = next;
+	}
+	return index;
+}
+
+/*
+ * Empty a wheel. - START
+ */
+void gps_tw_init(st_gps_twheel * tw, uint32_t now)
+{
+	memset(tw, 0, sizeof(st_gps_twheel));
+	/* now counts as processed, tw->now is the next tick to run */
+	tw->now = now + 1;
+}
+/* Empty a wheel. - END */
+
+/*
+ * Prepare a stopped timer. - START
+ */
+void gps_tw_timer_init(st_gps_tw_timer * t, gps_tw_cb cb, void * arg)
+{
+	memset(t, 0, sizeof(st_gps_tw_timer));
+	t->cb = cb;
+	t->arg = arg;
+}
+/* Prepare a stopped timer. - END */
+
+/*
+ * Start or restart a timer. - START
+ */
+void gps_tw_start(st_gps_twheel * tw, st_gps_tw_timer * t, uint32_t ticks, uint32_t period)
+{
+	TW_LOCK();
+
+	if(t->pprev != NULL)
+	{
+		tw_unlink(t);
+		tw->active--;
+	}
+	if(ticks == 0)
+	{
+		ticks = 1;
+	}
+	if(ticks > GPS_TW_MAX_TICKS)
+	{
+		ticks = GPS_TW_MAX_TICKS;
+	}
+	t->expires = tw->now - 1 + ticks;
+	t->period = period;
+	tw_link(tw, t);
+	tw->active++;
+
+	TW_UNLOCK();
+}
+/* Start or restart a timer. - END */
+
+/*
+ * Stop a timer. - START
+ */
+void gps_tw_stop(st_gps_twheel * tw, st_gps_tw_timer * t)
+{
+	TW_LOCK();
+
+	if(t->pprev != NULL)
+	{
+		tw_unlink(t);
+		tw->active--;
+	}
+
+	TW_UNLOCK();
+}
+/* Stop a timer. - END */
+
+/*
+ * Check if a timer is running. - START
+ */
+uint8_t gps_tw_running(const st_gps_tw_timer * t)
+{
+	return (t->pprev != NULL) ? 1 : 0;
+}
+/* Check if a timer is running. - END */
+
+/*
+ * Move the wheel up to now. - START
+ */
+void gps_tw_advance(st_gps_twheel * tw, uint32_t now)
+{
+	TW_LOCK();
+
+	while((int32_t)(now - tw->now) >= 0)
+	{
+		uint32_t index = tw->now & TW_SLOT_MASK;
+		st_gps_tw_timer * due;
+		st_gps_tw_timer * t;
+
+		/* Level 0 wrapped, bring the next range down */
+		for(uint8_t level = 1; (index == 0) && (level < GPS_TW_LEVELS); level++)
+		{
+			if(tw_cascade(tw, level) != 0)
+			{
+				break;
+			}
+		}
+
+		/* The due timers leave the slot before the tick counts as run, so a
+		   timer started from a callback is timed from this tick */
+		due = tw->slots[0][index];
+		tw->slots[0][index] = NULL;
+		if(due != NULL)
+		{
+			due->pprev = &due;
+		}
+		tw->now++;
+
+		while((t = due) != NULL)
+		{
+			tw_unlink(t);
+			tw->active--;
+			tw->expired++;
+			if(t->period != 0)
+			{
+				t->expires += t->period;
+				tw_link(tw, t);
+				tw->active++;
+			}
+
+			/* The callback may start or stop timers, including this one */
+			TW_UNLOCK();
+			t->cb(t->arg);
+			TW_RELOCK();
+		}
+	}
+
+	TW_UNLOCK();
+}
+/* Move the wheel up to now. - END */
+
+#if(GPS_PROF_ENABLE == MZ_ENABLE)
+/** @fn static void tw_bench_cb(void * arg)
+ * @brief Empty callback of the benchmark timers
+ */
+static void tw_bench_cb(void * arg)
+{
+	(void)arg;
+}
+
+/*
+ * Measure start, stop and expiry. - START
+ */
+void gps_tw_bench(st_gps_tw_timer * timers, uint16_t count, st_gps_tw_bench * res)
+{
+	static st_gps_twheel bench_wheel;
+	uint32_t start;
+	uint32_t expired;
+
+	gps_tw_init(&bench_wheel, 0);
+	for(uint16_t i = 0; i < count; i++)
+	{
+		gps_tw_timer_init(&timers[i], tw_bench_cb, NULL);
+	}
+
+	start = gps_prof_now();
+	for(uint16_t i = 0; i < count; i++)
+	{
+		gps_tw_start(&bench_wheel, &timers[i], 1 + ((i * 7919UL) % TW_BENCH_SPREAD), 0);
+	}
+	res->start = (gps_prof_now() - start) / count;
+
+	start = gps_prof_now();
+	for(uint16_t i = 0; i < count; i += 2)
+	{
+		gps_tw_stop(&bench_wheel, &timers[i]);
+	}
+	res->stop = (gps_prof_now() - start) / ((count + 1) / 2);
+
+	/* Expiry includes the empty ticks and the cascades on the way */
+	start = gps_prof_now();
+	gps_tw_advance(&bench_wheel, TW_BENCH_SPREAD);
+	expired = bench_wheel.expired;
+	res->expire = (expired != 0) ? ((gps_prof_now() - start) / expired) : 0;
+}
+/* Measure start, stop and expiry. - END */
+#endif //(GPS_PROF_ENABLE == MZ_ENABLE)
+
+#endif //(GPS_TWHEEL_ENABLE == MZ_ENABLE)
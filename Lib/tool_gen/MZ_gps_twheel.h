@@ -0,0 +1,124 @@
+/*
+ * MZ_gps_twheel.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Hierarchical timer wheel.
+ *
+ *  Any number of application timers share one periodic MonoZ timer that
+ *  calls gps_tw_advance(). Timers are caller owned nodes linked into
+ *  GPS_TW_LEVELS wheels of 64 slots each, level n holding the timers due
+ *  within 64^(n+1) ticks. Start and stop are O(1); a timer moves down one
+ *  level when the wheel below wraps. Callbacks run in the context calling
+ *  gps_tw_advance(), with the wheel unlocked, and may start or stop any
+ *  timer; a timer started from a callback is timed from the tick being
+ *  run. The wheel is locked by masking interrupts on target, it can be
+ *  used from tasks and ISRs. No HAL dependency.
+ */
+
+#ifndef MZ_GPS_TWHEEL_H_
+#define MZ_GPS_TWHEEL_H_
+
+#include "stdint.h"
+#include "MZ_gps_app_config.h"
+
+#define GPS_TW_SLOT_BITS			(6)						///< 64 slots per level
+#define GPS_TW_SLOTS				(1 << GPS_TW_SLOT_BITS)
+#define GPS_TW_MAX_TICKS			((1UL << (GPS_TW_SLOT_BITS * GPS_TW_LEVELS)) - 1)	///< Longest timeout
+
+/** @brief Timer callback */
+typedef void (*gps_tw_cb)(void * arg);
+
+/**
+ * @struct st_gps_tw_timer
+ * @brief One timer, owned by the caller
+ */
+typedef struct st_gps_tw_timer
+{
+	struct st_gps_tw_timer *	next;							/*!< Slot list */
+	struct st_gps_tw_timer **	pprev;							/*!< Link pointing to this timer, NULL when stopped */
+	uint32_t					expires;						/*!< Wheel tick of expiry */
+	uint32_t					period;							/*!< Reload in ticks, 0 = one shot */
+	gps_tw_cb					cb;								/*!< Expiry callback */
+	void *						arg;							/*!< Callback argument */
+}st_gps_tw_timer;
+
+/**
+ * @struct st_gps_twheel
+ * @brief Wheel
+ */
+typedef struct
+{
+	uint32_t			now;									/*!< Current wheel tick */
+	uint32_t			active;									/*!< Running timers */
+	uint32_t			expired;								/*!< Callbacks called */
+	st_gps_tw_timer *	slots[GPS_TW_LEVELS][GPS_TW_SLOTS];		/*!< Slot lists */
+}st_gps_twheel;
+
+/**
+ * @struct st_gps_tw_bench
+ * @brief Average costs, profiler time base units
+ */
+typedef struct
+{
+	uint32_t		start;										/*!< gps_tw_start */
+	uint32_t		stop;										/*!< gps_tw_stop */
+	uint32_t		expire;										/*!< Per expired timer in gps_tw_advance */
+}st_gps_tw_bench;
+
+/** @fn void gps_tw_init(st_gps_twheel * tw, uint32_t now)
+ * @brief Empty a wheel.
+ * @param tw wheel
+ * @param now current wheel tick
+ */
+void gps_tw_init(st_gps_twheel * tw, uint32_t now);
+
+/** @fn void gps_tw_timer_init(st_gps_tw_timer * t, gps_tw_cb cb, void * arg)
+ * @brief Prepare a stopped timer.
+ * @param t timer
+ * @param cb expiry callback
+ * @param arg callback argument
+ */
+void gps_tw_timer_init(st_gps_tw_timer * t, gps_tw_cb cb, void * arg);
+
+/** @fn void gps_tw_start(st_gps_twheel * tw, st_gps_tw_timer * t, uint32_t ticks, uint32_t period)
+ * @brief Start or restart a timer.
+ * @param tw wheel
+ * @param t timer
+ * @param ticks first expiry from now, clamped to 1..GPS_TW_MAX_TICKS
+ * @param period reload in ticks, 0 = one shot
+ */
+void gps_tw_start(st_gps_twheel * tw, st_gps_tw_timer * t, uint32_t ticks, uint32_t period);
+
+/** @fn void gps_tw_stop(st_gps_twheel * tw, st_gps_tw_timer * t)
+ * @brief Stop a timer, nothing when it is not running.
+ * @param tw wheel
+ * @param t timer
+ */
+void gps_tw_stop(st_gps_twheel * tw, st_gps_tw_timer * t);
+
+/** @fn uint8_t gps_tw_running(const st_gps_tw_timer * t)
+ * @brief Check if a timer is running.
+ * @param t timer
+ * @return 1 when running
+ */
+uint8_t gps_tw_running(const st_gps_tw_timer * t);
+
+/** @fn void gps_tw_advance(st_gps_twheel * tw, uint32_t now)
+ * @brief Move the wheel up to now and call every expired timer.
+ * @param tw wheel
+ * @param now current wheel tick
+ */
+void gps_tw_advance(st_gps_twheel * tw, uint32_t now);
+
+#if(GPS_PROF_ENABLE == MZ_ENABLE)
+/** @fn void gps_tw_bench(st_gps_tw_timer * timers, uint16_t count, st_gps_tw_bench * res)
+ * @brief Measure start, stop and expiry on a private wheel.
+ * @param timers scratch timers
+ * @param count number of scratch timers
+ * @param res average costs
+ */
+void gps_tw_bench(st_gps_tw_timer * timers, uint16_t count, st_gps_tw_bench * res);
+#endif
+
+#endif /* MZ_GPS_TWHEEL_H_ */
@@ -0,0 +1,111 @@
+/*
+ * MZ_gps_ubx.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_ubx.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/*
+ * Build one UBX frame. - START
+ */
+uint16_t gps_ubx_frame(uint8_t cls, uint8_t id, const uint8_t * payload, uint16_t len, uint8_t * out, uint16_t size)
+{
+	uint8_t ck_a = 0;
+	uint8_t ck_b = 0;
+
+	if((uint32_t)size < ((uint32_t)len + GPS_UBX_OVERHEAD))
+	{
+		return 0;
+	}
+
+	out[0] = GPS_UBX_SYNC1;
+	out[1] = GPS_UBX_SYNC2;
+	out[2] = cls;
+	out[3] = id;
+	gps_ubx_put_u16(&out[4], len);
+	if(len > 0)
+	{
+		memcpy(&out[6], payload, len);
+	}
+
+	/* Fletcher checksum over class, id, length and payload */
+	for(uint16_t i = 2; i < (len + 6); i++)
+	{
+		ck_a += out[i];
+		ck_b += ck_a;
+	}
+	out[len + 6] = ck_a;
+	out[len + 7] = ck_b;
+
+	return len + GPS_UBX_OVERHEAD;
+}
+/* Build one UBX frame. - END */
+
+/*
+ * Validate one UBX frame. - START
+ */
+uint16_t gps_ubx_check(const uint8_t * buf, uint16_t len)
+{
+	uint8_t ck_a = 0;
+	uint8_t ck_b = 0;
+	uint16_t plen;
+
+	if((len < GPS_UBX_OVERHEAD) || (buf[0] != GPS_UBX_SYNC1) || (buf[1] != GPS_UBX_SYNC2))
+	{
+		return 0xFFFF;
+	}
+	plen = (uint16_t)(buf[4] | (buf[5] << 8));
+	if(((uint32_t)plen + GPS_UBX_OVERHEAD) > len)
+	{
+		return 0xFFFF;
+	}
+
+	for(uint16_t i = 2; i < (plen + 6); i++)
+	{
+		ck_a += buf[i];
+		ck_b += ck_a;
+	}
+	if((buf[plen + 6] != ck_a) || (buf[plen + 7] != ck_b))
+	{
+		return 0xFFFF;
+	}
+	return plen;
+}
+/* Validate one UBX frame. - END */
+
+/*
+ * Store a little endian 32 bit field. - START
+ */
+void gps_ubx_put_u32(uint8_t * p, uint32_t v)
+{
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+	p[2] = (uint8_t)(v >> 16);
+	p[3] = (uint8_t)(v >> 24);
+}
+/* Store a little endian 32 bit field. - END */
+
+/*
+ * Store a little endian 16 bit field. - START
+ */
+void gps_ubx_put_u16(uint8_t * p, uint16_t v)
+{
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+}
+/* Store a little endian 16 bit field. - END */
+
+/*
+ * Load a little endian 32 bit field. - START
+ */
+uint32_t gps_ubx_get_u32(const uint8_t * p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+/* Load a little endian 32 bit field. - END */
@@ -0,0 +1,75 @@
+/*
+ * MZ_gps_ubx.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  u-blox UBX binary protocol framing : sync chars, class / id, little
+ *  endian length, payload and 8 bit Fletcher checksum. No HAL dependency.
+ */
+
+#ifndef MZ_GPS_UBX_H_
+#define MZ_GPS_UBX_H_
+
+#include "stdint.h"
+
+#define GPS_UBX_SYNC1				(0xB5)					///< First sync char
+#define GPS_UBX_SYNC2				(0x62)					///< Second sync char
+#define GPS_UBX_OVERHEAD			(8)						///< Sync, class, id, length and checksum
+
+#define GPS_UBX_CLASS_NAV			(0x01)					///< Navigation results
+#define GPS_UBX_CLASS_RXM			(0x02)					///< Receiver manager
+#define GPS_UBX_CLASS_ACK			(0x05)					///< Ack / nak
+#define GPS_UBX_CLASS_CFG			(0x06)					///< Configuration
+#define GPS_UBX_CLASS_AID			(0x0B)					///< Assist now aiding
+
+#define GPS_UBX_NAV_POSLLH			(0x02)					///< Geodetic position
+#define GPS_UBX_RXM_PMREQ			(0x41)					///< Power management request
+#define GPS_UBX_CFG_RST				(0x04)					///< Receiver reset
+#define GPS_UBX_CFG_RXM				(0x11)					///< Receiver power mode
+#define GPS_UBX_CFG_PM2				(0x3B)					///< Power save mode settings
+#define GPS_UBX_AID_INI				(0x01)					///< Position, time and clock aiding
+#define GPS_UBX_ACK_NAK				(0x00)					///< Message not acknowledged
+#define GPS_UBX_ACK_ACK				(0x01)					///< Message acknowledged
+
+/** @fn uint16_t gps_ubx_frame(uint8_t cls, uint8_t id, const uint8_t * payload, uint16_t len, uint8_t * out, uint16_t size)
+ * @brief Build one UBX frame.
+ * @param cls message class
+ * @param id message id
+ * @param payload payload, may be NULL when len is 0
+ * @param len payload length
+ * @param out output buffer
+ * @param size size of out
+ * @return frame length, 0 when out is too small
+ */
+uint16_t gps_ubx_frame(uint8_t cls, uint8_t id, const uint8_t * payload, uint16_t len, uint8_t * out, uint16_t size);
+
+/** @fn uint16_t gps_ubx_check(const uint8_t * buf, uint16_t len)
+ * @brief Validate one UBX frame.
+ * @param buf frame, starting at the sync chars
+ * @param len number of bytes in buf
+ * @return payload length, 0xFFFF when the frame is not valid
+ */
+uint16_t gps_ubx_check(const uint8_t * buf, uint16_t len);
+
+/** @fn void gps_ubx_put_u32(uint8_t * p, uint32_t v)
+ * @brief Store a little endian 32 bit field.
+ * @param p field position
+ * @param v value
+ */
+void gps_ubx_put_u32(uint8_t * p, uint32_t v);
+
+/** @fn void gps_ubx_put_u16(uint8_t * p, uint16_t v)
+ * @brief Store a little endian 16 bit field.
+ * @param p field position
+ * @param v value
+ */
+void gps_ubx_put_u16(uint8_t * p, uint16_t v);
+
+/** @fn uint32_t gps_ubx_get_u32(const uint8_t * p)
+ * @brief Load a little endian 32 bit field.
+ * @param p field position
+ * @return value
+ */
+uint32_t gps_ubx_get_u32(const uint8_t * p);
+
+#endif /* MZ_GPS_UBX_H_ */
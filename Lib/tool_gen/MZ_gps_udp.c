@@ -0,0 +1,361 @@
+/*
+ * MZ_gps_udp.c
+ *
+ *  Created on: 19-Oct-2026
+ */
+
+/* Include Header Files - START */
+
+#include "MZ_gps_udp.h"
+#include "string.h"
+
+/* Include Header Files - END */
+
+/* Define some common use MACRO - START */
+#define UDP_HDOP_MAX				(255)						///< HDOP * 10 saturates
+#define UDP_SPEED_UNIT_CMS			(50)						///< Speed unit, 0.5 m/s
+#define UDP_SPEED_MAX				(255)
+#define UDP_DT_MAX					(0xFFFF)					///< Seconds after the first point saturate
+/* Define some common use MACRO - END */
+
+/** @fn static void udp_put16(uint8_t * p, uint16_t v)
+ * @brief Big endian 16 bit
+ */
+static void udp_put16(uint8_t * p, uint16_t v)
+{
+	p[0] = (uint8_t)(v >> 8);
+	p[1] = (uint8_t)v;
+}
+
+/** @fn static void udp_put32(uint8_t * p, uint32_t v)
+ * @brief Big endian 32 bit
+ */
+static void udp_put32(uint8_t * p, uint32_t v)
+{
+	p[0] = (uint8_t)(v >> 24);
+	p[1] = (uint8_t)(v >> 16);
+	p[2] = (uint8_t)(v >> 8);
+	p[3] = (uint8_t)v;
+}
+
+/** @fn static uint16_t udp_get16(const uint8_t * p)
+ * @brief Big endian 16 bit
+ */
+static uint16_t udp_get16(const uint8_t * p)
+{
+	return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+/** @fn static uint32_t udp_get32(const uint8_t * p)
+ * @brief Big endian 32 bit
+ */
+static uint32_t udp_get32(const uint8_t * p)
+{
+	return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+/** @fn static uint32_t udp_rto(uint8_t tries)
+ * @brief Retransmit timeout after a number of sends
+ */
+static uint32_t udp_rto(uint8_t tries)
+{
+	return (uint32_t)GPS_UDP_RTO_MS << (tries - 1);
+}
+
+/** @fn static st_gps_udp_slot * udp_slot_free(st_gps_udp * u)
+ * @brief A free slot, made by dropping a frame out of tries or else the
+ * oldest one
+ */
+static st_gps_udp_slot * udp_slot_free(st_gps_udp * u)
+{
+	st_gps_udp_slot * oldest = &u->slot[0];
+
+	for(uint8_t i = 0; i < GPS_UDP_WINDOW; i++)
+	{
+		if(!u->slot[i].used)
+		{
+			return &u->slot[i];
+		}
+	}
+	for(uint8_t i = 0; i < GPS_UDP_WINDOW; i++)
+	{
+		if(u->slot[i].tries >= GPS_UDP_TRIES)
+		{
+			u->stats.lost++;
+			return &u->slot[i];
+		}
+		if((uint16_t)(u->seq - u->slot[i].seq) > (uint16_t)(u->seq - oldest->seq))
+		{
+			oldest = &u->slot[i];
+		}
+	}
+	u->stats.overflow++;
+	return oldest;
+}
+
+/*
+ * Empty window. - START
+ */
+void gps_udp_init(st_gps_udp * u, uint32_t dev_id)
+{
+	memset(u, 0, sizeof(*u));
+	u->dev_id = dev_id;
+}
+/* Empty window. - END */
+
+/*
+ * Frame the fixes of one report. - START
+ */
+uint16_t gps_udp_queue(st_gps_udp * u, const st_gps_fix * fixes, uint16_t n)
+{
+	uint16_t frames = 0;
+
+	while(n != 0)
+	{
+		uint16_t cnt = (n > GPS_UDP_POINTS_MAX) ? GPS_UDP_POINTS_MAX : n;
+		st_gps_udp_slot * s = udp_slot_free(u);
+		uint32_t base = gps_fix_to_unix(&fixes[0]);
+		uint8_t * p = &s->frame[GPS_UDP_HEADER_SIZE];
+
+		s->frame[0] = GPS_UDP_VERSION | GPS_UDP_TYPE_DATA;
+		udp_put16(&s->frame[1], u->seq);
+		udp_put32(&s->frame[3], u->dev_id);
+		udp_put32(&s->frame[7], base);
+		s->frame[11] = (uint8_t)cnt;
+		for(uint16_t i = 0; i < cnt; i++)
+		{
+			uint32_t dt = gps_fix_to_unix(&fixes[i]) - base;
+			uint32_t hdop = (fixes[i].hdop_x100 + 5) / 10;
+			uint32_t speed = (fixes[i].speed_cms + (UDP_SPEED_UNIT_CMS / 2)) / UDP_SPEED_UNIT_CMS;
+
+			udp_put16(&p[0], (uint16_t)((dt > UDP_DT_MAX) ? UDP_DT_MAX : dt));
+			udp_put32(&p[2], (uint32_t)fixes[i].lat_e7);
+			udp_put32(&p[6], (uint32_t)fixes[i].lon_e7);
+			p[10] = (uint8_t)((hdop > UDP_HDOP_MAX) ? UDP_HDOP_MAX : hdop);
+			p[11] = (uint8_t)((speed > UDP_SPEED_MAX) ? UDP_SPEED_MAX : speed);
+			p += GPS_UDP_POINT_SIZE;
+		}
+
+		s->used = 1;
+		s->tries = 0;
+		s->seq = u->seq++;
+		s->len = GPS_UDP_HEADER_SIZE + (cnt * GPS_UDP_POINT_SIZE);
+		u->stats.frames++;
+		u->stats.points += cnt;
+
+		fixes += cnt;
+		n -= cnt;
+		frames++;
+	}
+	return frames;
+}
+/* Frame the fixes of one report. - END */
+
+/*
+ * A frame is to be sent. - START
+ */
+uint8_t gps_udp_due(const st_gps_udp * u, uint32_t now_ms)
+{
+	for(uint8_t i = 0; i < GPS_UDP_WINDOW; i++)
+	{
+		const st_gps_udp_slot * s = &u->slot[i];
+
+		if(s->used && (s->tries < GPS_UDP_TRIES) && ((s->tries == 0) || ((now_ms - s->sent_ms) >= udp_rto(s->tries))))
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+/* A frame is to be sent. - END */
+
+/*
+ * Next frame to send. - START
+ */
+uint16_t gps_udp_next(st_gps_udp * u, uint32_t now_ms, const uint8_t ** frame)
+{
+	st_gps_udp_slot * next = NULL;
+
+	for(uint8_t i = 0; i < GPS_UDP_WINDOW; i++)
+	{
+		st_gps_udp_slot * s = &u->slot[i];
+
+		if(!s->used || ((s->tries != 0) && ((now_ms - s->sent_ms) < udp_rto(s->tries))))
+		{
+			continue;
+		}
+		if(s->tries >= GPS_UDP_TRIES)
+		{
+			/* No ACK after the last try */
+			s->used = 0;
+			u->stats.lost++;
+			continue;
+		}
+		/* Oldest first */
+		if((next == NULL) || ((uint16_t)(u->seq - s->seq) > (uint16_t)(u->seq - next->seq)))
+		{
+			next = s;
+		}
+	}
+	if(next == NULL)
+	{
+		return 0;
+	}
+
+	if(next->tries != 0)
+	{
+		u->stats.retries++;
+	}
+	next->tries++;
+	next->sent_ms = now_ms;
+	u->stats.sends++;
+	u->stats.air_bytes += next->len + GPS_UDP_IP_OVERHEAD;
+	*frame = next->frame;
+	return next->len;
+}
+/* Next frame to send. - END */
+
+/*
+ * A datagram from the server. - START
+ */
+void gps_udp_ack(st_gps_udp * u, const uint8_t * data, uint16_t len, uint32_t now_ms)
+{
+	uint16_t seq;
+
+	u->stats.ack_bytes += len + GPS_UDP_IP_OVERHEAD;
+	if((len != GPS_UDP_ACK_SIZE) || (data[0] != (GPS_UDP_VERSION | GPS_UDP_TYPE_ACK)))
+	{
+		return;
+	}
+
+	seq = udp_get16(&data[1]);
+	for(uint8_t i = 0; i < GPS_UDP_WINDOW; i++)
+	{
+		st_gps_udp_slot * s = &u->slot[i];
+
+		if(s->used && (s->seq == seq))
+		{
+			/* The round trip of a retried frame is ambiguous */
+			if(s->tries == 1)
+			{
+				u->stats.rtt_last_ms = now_ms - s->sent_ms;
+				if(u->stats.rtt_last_ms > u->stats.rtt_max_ms)
+				{
+					u->stats.rtt_max_ms = u->stats.rtt_last_ms;
+				}
+			}
+			s->used = 0;
+			u->stats.acked++;
+			return;
+		}
+	}
+	u->stats.dup_acks++;
+}
+/* A datagram from the server. - END */
+
+/*
+ * Decode a DATA frame. - START
+ */
+uint16_t gps_udp_decode(const uint8_t * frame, uint16_t len, uint16_t * seq, uint32_t * dev_id, st_gps_udp_point * pts, uint16_t max)
+{
+	uint16_t n;
+	uint32_t base;
+
+	if((len < GPS_UDP_HEADER_SIZE) || (frame[0] != (GPS_UDP_VERSION | GPS_UDP_TYPE_DATA)))
+	{
+		return 0;
+	}
+	n = frame[11];
+	if((n == 0) || (len != (GPS_UDP_HEADER_SIZE + (n * GPS_UDP_POINT_SIZE))))
+	{
+		return 0;
+	}
+
+	*seq = udp_get16(&frame[1]);
+	*dev_id = udp_get32(&frame[3]);
+	base = udp_get32(&frame[7]);
+	for(uint16_t i = 0; (pts != NULL) && (i < n) && (i < max); i++)
+	{
+		const uint8_t * p = &frame[GPS_UDP_HEADER_SIZE + (i * GPS_UDP_POINT_SIZE)];
+
+		pts[i].utc_s = base + udp_get16(&p[0]);
+		pts[i].lat_e7 = (int32_t)udp_get32(&p[2]);
+		pts[i].lon_e7 = (int32_t)udp_get32(&p[6]);
+		pts[i].hdop_x100 = p[10] * 10;
+		pts[i].speed_cms = p[11] * UDP_SPEED_UNIT_CMS;
+	}
+	return n;
+}
+/* Decode a DATA frame. - END */
+
+/*
+ * Server stand-in. - START
+ */
+uint16_t gps_udp_serve(const uint8_t * frame, uint16_t len, uint8_t * ack, uint16_t size)
+{
+	uint16_t seq;
+	uint32_t dev_id;
+
+	if((size < GPS_UDP_ACK_SIZE) || (0 == gps_udp_decode(frame, len, &seq, &dev_id, NULL, 0)))
+	{
+		return 0;
+	}
+	/* Duplicates are acknowledged again, their ACK may have been lost */
+	ack[0] = GPS_UDP_VERSION | GPS_UDP_TYPE_ACK;
+	udp_put16(&ack[1], seq);
+	return GPS_UDP_ACK_SIZE;
+}
+/* Server stand-in. - END */
+
+/*
+ * Hex string of binary data. - START
+ */
+uint16_t gps_udp_hex(const uint8_t * data, uint16_t len, char * out)
+{
+	static const char hex[] = "0123456789ABCDEF";
+
+	for(uint16_t i = 0; i < len; i++)
+	{
+		out[i * 2] = hex[data[i] >> 4];
+		out[(i * 2) + 1] = hex[data[i] & 0x0F];
+	}
+	out[len * 2] = '\0';
+	return len * 2;
+}
+/* Hex string of binary data. - END */
+
+/** @fn static int8_t udp_nibble(char c)
+ * @brief Value of a hex digit, -1 for other characters
+ */
+static int8_t udp_nibble(char c)
+{
+	if((c >= '0') && (c <= '9'))
+	{
+		return c - '0';
+	}
+	if((c >= 'A') && (c <= 'F'))
+	{
+		return c - 'A' + 10;
+	}
+	if((c >= 'a') && (c <= 'f'))
+	{
+		return c - 'a' + 10;
+	}
+	return -1;
+}
+
+/*
+ * Binary data of a hex string. - START
+ */
+uint16_t gps_udp_unhex(const char * hex, uint8_t * out, uint16_t size)
+{
+	uint16_t n = 0;
+
+	while((n < size) && (udp_nibble(hex[0]) >= 0) && (udp_nibble(hex[1]) >= 0))
+	{
+		out[n++] = (uint8_t)((udp_nibble(hex[0]) << 4) | udp_nibble(hex[1]));
+		hex += 2;
+	}
+	return n;
+}
+/* Binary data of a hex string. - END */
@@ -0,0 +1,184 @@
+/*
+ * MZ_gps_udp.h
+ *
+ *  Created on: 19-Oct-2026
+ *
+ *  Binary fix frames over UDP, the GPS_BACKEND_UDP telemetry backend.
+ *
+ *  The fixes of a report go into one frame (more when there are more than
+ *  GPS_UDP_POINTS_MAX), big endian :
+ *  - DATA : version / type (1), sequence (2), device id (4), UTC of the
+ *    first point in seconds (4), points (1), then 12 bytes per point :
+ *    seconds after the first (2), latitude and longitude in 1e-7 degree
+ *    (4 + 4), HDOP * 10 (1), speed in 0.5 m/s (1).
+ *  - ACK : version / type (1), sequence of the frame (2).
+ *  Up to GPS_UDP_WINDOW frames are in flight, each acknowledged on its
+ *  own. A frame without acknowledgement is sent again after
+ *  GPS_UDP_RTO_MS, doubled per retry, and dropped after GPS_UDP_TRIES
+ *  sends; a full window drops its oldest frame. The device id identifies
+ *  the sender, the source address changes with carrier NAT.
+ *  gps_udp_serve() is the receiving side (server stand-in of the modem
+ *  emulator and of host tests): it decodes a frame and builds its ACK.
+ *  Everything here is portable, the socket commands are in
+ *  MZ_gps_backend.c.
+ */
+
+#ifndef MZ_GPS_UDP_H_
+#define MZ_GPS_UDP_H_
+
+#include "stdint.h"
+#include "MZ_gps_app_config.h"
+#include "MZ_gps_fix.h"
+
+#define GPS_UDP_VERSION				(0x10)					///< Version in the upper nibble of the first byte
+#define GPS_UDP_TYPE_DATA			(0x01)					///< Fix frame
+#define GPS_UDP_TYPE_ACK			(0x02)					///< Acknowledgement
+#define GPS_UDP_HEADER_SIZE			(12)					///< DATA header
+#define GPS_UDP_POINT_SIZE			(12)					///< One point
+#define GPS_UDP_ACK_SIZE			(3)						///< ACK frame
+#define GPS_UDP_FRAME_SIZE			(GPS_UDP_HEADER_SIZE + (GPS_UDP_POINTS_MAX * GPS_UDP_POINT_SIZE))
+#define GPS_UDP_IP_OVERHEAD			(28)					///< IPv4 and UDP headers of a datagram
+
+/**
+ * @struct st_gps_udp_stats
+ * @brief Uplink counters
+ */
+typedef struct
+{
+	uint32_t		frames;										/*!< Frames queued */
+	uint32_t		points;										/*!< Points queued */
+	uint32_t		sends;										/*!< Datagrams sent, retries included */
+	uint32_t		retries;									/*!< Datagrams sent again */
+	uint32_t		acked;										/*!< Frames acknowledged */
+	uint32_t		dup_acks;									/*!< ACKs of frames no longer in flight */
+	uint32_t		lost;										/*!< Frames dropped after GPS_UDP_TRIES */
+	uint32_t		overflow;									/*!< Frames dropped by a full window */
+	uint32_t		air_bytes;									/*!< Uplink bytes with IP / UDP headers */
+	uint32_t		ack_bytes;									/*!< Downlink bytes with IP / UDP headers */
+	uint32_t		rtt_last_ms;								/*!< Round trip of the last first try ACK */
+	uint32_t		rtt_max_ms;									/*!< Longest round trip */
+}st_gps_udp_stats;
+
+/**
+ * @struct st_gps_udp_slot
+ * @brief One frame in flight
+ */
+typedef struct
+{
+	uint8_t			used;										/*!< Slot holds a frame */
+	uint8_t			tries;										/*!< Sends so far */
+	uint16_t		seq;										/*!< Sequence number */
+	uint16_t		len;										/*!< Frame length */
+	uint32_t		sent_ms;									/*!< Last send */
+	uint8_t			frame[GPS_UDP_FRAME_SIZE];					/*!< Frame */
+}st_gps_udp_slot;
+
+/**
+ * @struct st_gps_udp
+ * @brief Uplink window
+ */
+typedef struct
+{
+	uint32_t			dev_id;									/*!< Device id in every frame */
+	uint16_t			seq;									/*!< Next sequence number */
+	st_gps_udp_slot		slot[GPS_UDP_WINDOW];					/*!< Frames in flight */
+	st_gps_udp_stats	stats;									/*!< Counters */
+}st_gps_udp;
+
+/**
+ * @struct st_gps_udp_point
+ * @brief One decoded point
+ */
+typedef struct
+{
+	uint32_t		utc_s;										/*!< Seconds since 1970 */
+	int32_t			lat_e7;										/*!< Latitude */
+	int32_t			lon_e7;										/*!< Longitude */
+	uint16_t		hdop_x100;									/*!< HDOP * 100, 0.1 resolution */
+	uint16_t		speed_cms;									/*!< Speed, 0.5 m/s resolution */
+}st_gps_udp_point;
+
+/** @fn void gps_udp_init(st_gps_udp * u, uint32_t dev_id)
+ * @brief Empty window.
+ * @param u uplink
+ * @param dev_id device id
+ */
+void gps_udp_init(st_gps_udp * u, uint32_t dev_id);
+
+/** @fn uint16_t gps_udp_queue(st_gps_udp * u, const st_gps_fix * fixes, uint16_t n)
+ * @brief Frame the fixes of one report into the window.
+ * @param u uplink
+ * @param fixes fixes, oldest first
+ * @param n number of fixes
+ * @return frames queued
+ */
+uint16_t gps_udp_queue(st_gps_udp * u, const st_gps_fix * fixes, uint16_t n);
+
+/** @fn uint8_t gps_udp_due(const st_gps_udp * u, uint32_t now_ms)
+ * @brief A frame is to be sent, new or after its retransmit timeout.
+ * @param u uplink
+ * @param now_ms current time
+ * @return 1 when gps_udp_next() has a frame
+ */
+uint8_t gps_udp_due(const st_gps_udp * u, uint32_t now_ms);
+
+/** @fn uint16_t gps_udp_next(st_gps_udp * u, uint32_t now_ms, const uint8_t ** frame)
+ * @brief Next frame to send, counted as sent. Frames out of tries are
+ * dropped on the way.
+ * @param u uplink
+ * @param now_ms current time
+ * @param frame output, valid until the next call
+ * @return frame length, 0 when nothing is due
+ */
+uint16_t gps_udp_next(st_gps_udp * u, uint32_t now_ms, const uint8_t ** frame);
+
+/** @fn void gps_udp_ack(st_gps_udp * u, const uint8_t * data, uint16_t len, uint32_t now_ms)
+ * @brief A datagram from the server, ACKs free their frame.
+ * @param u uplink
+ * @param data datagram
+ * @param len length
+ * @param now_ms current time
+ */
+void gps_udp_ack(st_gps_udp * u, const uint8_t * data, uint16_t len, uint32_t now_ms);
+
+/** @fn uint16_t gps_udp_decode(const uint8_t * frame, uint16_t len, uint16_t * seq, uint32_t * dev_id, st_gps_udp_point * pts, uint16_t max)
+ * @brief Decode a DATA frame.
+ * @param frame frame
+ * @param len length
+ * @param seq output sequence number
+ * @param dev_id output device id
+ * @param pts output points, may be NULL
+ * @param max size of pts
+ * @return points in the frame, 0 when it is not a valid DATA frame
+ */
+uint16_t gps_udp_decode(const uint8_t * frame, uint16_t len, uint16_t * seq, uint32_t * dev_id, st_gps_udp_point * pts, uint16_t max);
+
+/** @fn uint16_t gps_udp_serve(const uint8_t * frame, uint16_t len, uint8_t * ack, uint16_t size)
+ * @brief Server stand-in : take a DATA frame and build its ACK.
+ * @param frame received frame
+ * @param len length
+ * @param ack output ACK
+ * @param size size of ack, GPS_UDP_ACK_SIZE
+ * @return ACK length, 0 for frames that are not acknowledged
+ */
+uint16_t gps_udp_serve(const uint8_t * frame, uint16_t len, uint8_t * ack, uint16_t size);
+
+/** @fn uint16_t gps_udp_hex(const uint8_t * data, uint16_t len, char * out)
+ * @brief Hex string of binary data, the form socket AT commands take.
+ * @param data data
+ * @param len length
+ * @param out output, 2 * len + 1
+ * @return characters written
+ */
+uint16_t gps_udp_hex(const uint8_t * data, uint16_t len, char * out);
+
+/** @fn uint16_t gps_udp_unhex(const char * hex, uint8_t * out, uint16_t size)
+ * @brief Binary data of a hex string, stops at the first other character.
+ * @param hex hex string
+ * @param out output
+ * @param size size of out
+ * @return bytes written
+ */
+uint16_t gps_udp_unhex(const char * hex, uint8_t * out, uint16_t size);
+
+#endif /* MZ_GPS_UDP_H_ */